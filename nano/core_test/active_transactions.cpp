@@ -50,6 +50,7 @@ TEST (active_transactions, confirm_active)
 	{
 		nano::lock_guard<nano::mutex> guard (node2.rep_crawler.probable_reps_mutex);
 		node2.rep_crawler.probable_reps.emplace (nano::dev_genesis_key.pub, nano::genesis_amount, *peers.begin ());
+		node2.rep_crawler.update_snapshot ();
 	}
 	ASSERT_TIMELY (5s, election->votes ().size () != 1); // Votes were inserted (except for not_an_account)
 	auto confirm_req_count (election->confirmation_request_count.load ());
@@ -90,6 +91,7 @@ TEST (active_transactions, confirm_frontier)
 	{
 		nano::lock_guard<nano::mutex> guard (node2.rep_crawler.probable_reps_mutex);
 		node2.rep_crawler.probable_reps.emplace (nano::dev_genesis_key.pub, nano::genesis_amount, *peers.begin ());
+		node2.rep_crawler.update_snapshot ();
 	}
 
 	nano::genesis genesis;
@@ -874,6 +874,49 @@ TEST (block_store, account_count)
 	ASSERT_EQ (1, store->account.count (transaction));
 }
 
+TEST (block_store, get_many)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::open_block block1 (0, 1, 0, nano::keypair ().prv, 0, 0);
+	block1.sideband_set ({});
+	nano::open_block block2 (0, 2, 0, nano::keypair ().prv, 0, 0);
+	block2.sideband_set ({});
+	nano::account_info info1 (block1.hash (), 1, block1.hash (), 10, 0, 1, nano::epoch::epoch_0);
+	nano::account_info info2 (block2.hash (), 2, block2.hash (), 20, 0, 1, nano::epoch::epoch_0);
+	{
+		auto transaction (store->tx_begin_write ());
+		store->block.put (transaction, block1.hash (), block1);
+		store->block.put (transaction, block2.hash (), block2);
+		store->account.put (transaction, 300, info1);
+		store->account.put (transaction, 100, info2);
+		// Writes are visible to batched reads within the same transaction
+		auto blocks (store->block.get_many (transaction, { block2.hash () }));
+		ASSERT_EQ (1, blocks.size ());
+		ASSERT_NE (nullptr, blocks[0]);
+	}
+	auto transaction (store->tx_begin_read ());
+	// Results are in argument order regardless of key order, including duplicates and missing keys
+	auto accounts (store->account.get_many (transaction, { 300, 200, 100, 300 }));
+	ASSERT_EQ (4, accounts.size ());
+	ASSERT_TRUE (accounts[0]);
+	ASSERT_EQ (info1, *accounts[0]);
+	ASSERT_FALSE (accounts[1]);
+	ASSERT_TRUE (accounts[2]);
+	ASSERT_EQ (info2, *accounts[2]);
+	ASSERT_TRUE (accounts[3]);
+	ASSERT_EQ (info1, *accounts[3]);
+	auto blocks (store->block.get_many (transaction, { block2.hash (), nano::block_hash (0), block1.hash () }));
+	ASSERT_EQ (3, blocks.size ());
+	ASSERT_NE (nullptr, blocks[0]);
+	ASSERT_EQ (block2, *blocks[0]);
+	ASSERT_EQ (nullptr, blocks[1]);
+	ASSERT_NE (nullptr, blocks[2]);
+	ASSERT_EQ (block1, *blocks[2]);
+	ASSERT_TRUE (store->block.get_many (transaction, {}).empty ());
+}
+
 TEST (block_store, cemented_count_cache)
 {
 	nano::logger_mt logger;
@@ -1842,6 +1885,36 @@ TEST (mdb_block_store, upgrade_v20_v21)
 	ASSERT_LT (19, store.version.get (transaction));
 }
 
+TEST (mdb_block_store, upgrade_v21_v22)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		return;
+	}
+	auto path (nano::unique_path ());
+	nano::genesis genesis;
+	nano::logger_mt logger;
+	nano::stat stats;
+	{
+		nano::mdb_store store (logger, path);
+		nano::ledger ledger (store, stats);
+		auto transaction (store.tx_begin_write ());
+		store.initialize (transaction, genesis, ledger.cache);
+		// Delete account heights table
+		ASSERT_FALSE (mdb_drop (store.env.tx (transaction), store.account_heights_handle, 1));
+		store.version.put (transaction, 21);
+	}
+	// Upgrading should create the table
+	nano::mdb_store store (logger, path);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_NE (store.account_heights_handle, 0);
+
+	// Version should be correct
+	auto transaction (store.tx_begin_read ());
+	ASSERT_LT (21, store.version.get (transaction));
+}
+
 TEST (mdb_block_store, upgrade_backup)
 {
 	if (nano::rocksdb_config::using_rocksdb_in_tests ())
@@ -1959,6 +2032,39 @@ TEST (block_store, final_vote)
 	}
 }
 
+TEST (block_store, account_height)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_FALSE (store->init_error ());
+	nano::account account1 (1);
+	nano::account account2 (2);
+	auto transaction (store->tx_begin_write ());
+	store->account_height.put (transaction, account2, 1, nano::block_hash (4));
+	store->account_height.put (transaction, account1, 256, nano::block_hash (3));
+	store->account_height.put (transaction, account1, 2, nano::block_hash (2));
+	store->account_height.put (transaction, account1, 1, nano::block_hash (1));
+	ASSERT_EQ (nano::block_hash (3), store->account_height.get (transaction, account1, 256));
+	ASSERT_TRUE (store->account_height.get (transaction, account1, 3).is_zero ());
+	// Entries of an account are ordered by height
+	std::vector<std::pair<nano::account, uint64_t>> keys;
+	for (auto i (store->account_height.begin (transaction, nano::account_height_key (account1, 0))), n (store->account_height.end ()); i != n; ++i)
+	{
+		keys.emplace_back (i->first.account (), i->first.height ());
+	}
+	ASSERT_EQ ((std::vector<std::pair<nano::account, uint64_t>>{ { account1, 1 }, { account1, 2 }, { account1, 256 }, { account2, 1 } }), keys);
+	store->account_height.del (transaction, account1, 2);
+	ASSERT_FALSE (store->account_height.exists (transaction, account1, 2));
+	ASSERT_TRUE (store->account_height.exists (transaction, account1, 1));
+	// Clearing removes the build cursor as well
+	ASSERT_EQ (nano::uint512_union (0), store->account_height.cursor (transaction));
+	store->account_height.cursor_put (transaction, nano::uint512_union (account1, nano::block_hash (5)));
+	ASSERT_EQ (nano::uint512_union (account1, nano::block_hash (5)), store->account_height.cursor (transaction));
+	store->account_height.clear (transaction);
+	ASSERT_EQ (store->account_height.begin (transaction), store->account_height.end ());
+	ASSERT_EQ (nano::uint512_union (0), store->account_height.cursor (transaction));
+}
+
 // Ledger versions are not forward compatible
 TEST (block_store, incompatible_version)
 {
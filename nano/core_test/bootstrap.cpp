@@ -1908,3 +1908,53 @@ TEST (bulk_pull_account, basics)
 		ASSERT_EQ (nullptr, block_data.second.get ());
 	}
 }
+
+TEST (bootstrap_peer_scores, ranking)
+{
+	nano::bootstrap_peer_scores scores;
+	nano::tcp_endpoint fast (boost::asio::ip::address_v6::loopback (), 1000);
+	nano::tcp_endpoint slow (boost::asio::ip::address_v6::loopback (), 1001);
+	nano::tcp_endpoint unknown (boost::asio::ip::address_v6::loopback (), 1002);
+	scores.connected (fast, 10ms);
+	scores.session (fast, 5000.0);
+	scores.connected (slow, 500ms);
+	scores.session (slow, 50.0);
+	ASSERT_EQ (2, scores.size ());
+	ASSERT_EQ (1.0, scores.score (unknown));
+	ASSERT_GT (scores.score (fast), scores.score (unknown));
+	ASSERT_LT (scores.score (slow), scores.score (unknown));
+	// Failures and invalid blocks lower the score
+	auto const fast_score (scores.score (fast));
+	scores.failed (fast);
+	ASSERT_LT (scores.score (fast), fast_score);
+	auto const failed_score (scores.score (fast));
+	scores.invalid_block (fast);
+	ASSERT_LT (scores.score (fast), failed_score);
+	// Peers with a bad history keep a small chance of being retried
+	for (auto i (0); i < 100; ++i)
+	{
+		scores.failed (slow);
+	}
+	ASSERT_EQ (nano::bootstrap_peer_scores::score_min, scores.score (slow));
+}
+
+TEST (bootstrap_peer_scores, select)
+{
+	nano::bootstrap_peer_scores scores;
+	nano::tcp_endpoint fast (boost::asio::ip::address_v6::loopback (), 1000);
+	nano::tcp_endpoint slow (boost::asio::ip::address_v6::loopback (), 1001);
+	scores.session (fast, 10000.0);
+	scores.session (slow, 10.0);
+	std::vector<nano::tcp_endpoint> candidates{ slow, fast };
+	auto fast_count (0);
+	for (auto i (0); i < 1000; ++i)
+	{
+		if (scores.select (candidates) == fast)
+		{
+			++fast_count;
+		}
+	}
+	// Connections are allocated in proportion to the score, 1000 to 1 here
+	ASSERT_GT (fast_count, 980);
+	ASSERT_EQ (slow, scores.select ({ slow }));
+}
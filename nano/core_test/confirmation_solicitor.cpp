@@ -120,8 +120,10 @@ TEST (confirmation_solicitor, bypass_max_requests_cap)
 	ASSERT_FALSE (solicitor.add (*election));
 	ASSERT_FALSE (solicitor.broadcast (*election));
 	solicitor.flush ();
+	// Requests to the same endpoint can be coalesced into fewer messages, count the requested hashes instead
+	node2.network.coalescer.flush ();
 	// All requests went through, the last one would normally not go through due to the cap but a vote for a different hash does not count towards the cap
-	ASSERT_EQ (max_representatives + 1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+	ASSERT_EQ (max_representatives + 1, node2.stats.count (nano::stat::type::coalescer, nano::stat::detail::coalescer_req_hashes, nano::stat::dir::out));
 
 	solicitor.prepare (representatives);
 	auto election2 (std::make_shared<nano::election> (node2, send, nullptr, nullptr, nano::election_behavior::normal));
@@ -129,8 +131,9 @@ TEST (confirmation_solicitor, bypass_max_requests_cap)
 	ASSERT_FALSE (solicitor.broadcast (*election2));
 
 	solicitor.flush ();
+	node2.network.coalescer.flush ();
 
 	// All requests but one went through, due to the cap
-	ASSERT_EQ (2 * max_representatives + 1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+	ASSERT_EQ (2 * max_representatives + 1, node2.stats.count (nano::stat::type::coalescer, nano::stat::detail::coalescer_req_hashes, nano::stat::dir::out));
 }
 }
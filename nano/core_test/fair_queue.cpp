@@ -0,0 +1,73 @@
+#include <nano/node/fair_queue.hpp>
+#include <nano/node/ingress_policer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST (fair_queue, round_robin)
+{
+	nano::fair_queue<int, std::string> queue;
+	ASSERT_TRUE (queue.empty ());
+	queue.push (1, "a1");
+	queue.push (1, "a2");
+	queue.push (1, "a3");
+	queue.push (2, "b1");
+	ASSERT_EQ (4, queue.size ());
+	ASSERT_EQ (3, queue.size (1));
+	ASSERT_EQ (2, queue.sources ());
+	// A source flooding the queue does not delay the other source
+	ASSERT_EQ ("a1", queue.pop ());
+	ASSERT_EQ ("b1", queue.pop ());
+	ASSERT_EQ ("a2", queue.pop ());
+	ASSERT_EQ ("a3", queue.pop ());
+	ASSERT_TRUE (queue.empty ());
+	ASSERT_EQ (0, queue.sources ());
+}
+
+TEST (fair_queue, weights)
+{
+	nano::fair_queue<int, int> queue ([] (int const & source_a) { return source_a == 1 ? 3 : 1; });
+	for (auto i (0); i < 6; ++i)
+	{
+		queue.push (1, i);
+		queue.push (2, 100 + i);
+	}
+	std::vector<int> expected{ 0, 1, 2, 100, 3, 4, 5, 101, 102, 103, 104, 105 };
+	for (auto value : expected)
+	{
+		ASSERT_EQ (value, queue.pop ());
+	}
+	ASSERT_TRUE (queue.empty ());
+}
+
+TEST (ingress_policer, drop)
+{
+	nano::endpoint endpoint1 (boost::asio::ip::address_v6::loopback (), 1000);
+	nano::endpoint endpoint2 (boost::asio::ip::address_v6::loopback (), 1001);
+	nano::ingress_policer policer (1, 10);
+	for (auto i (0); i < 10; ++i)
+	{
+		ASSERT_FALSE (policer.drop (endpoint1, nano::message_type::publish));
+	}
+	ASSERT_TRUE (policer.drop (endpoint1, nano::message_type::publish));
+	ASSERT_EQ (1, policer.drops (endpoint1));
+	// Buckets are separate for each message type and peer
+	ASSERT_FALSE (policer.drop (endpoint1, nano::message_type::confirm_ack));
+	ASSERT_FALSE (policer.drop (endpoint2, nano::message_type::publish));
+	ASSERT_EQ (0, policer.drops (endpoint2));
+	ASSERT_EQ (2, policer.size ());
+	policer.purge (std::chrono::steady_clock::now () + std::chrono::seconds (1));
+	ASSERT_EQ (0, policer.size ());
+}
+
+TEST (ingress_policer, disabled)
+{
+	nano::endpoint endpoint (boost::asio::ip::address_v6::loopback (), 1000);
+	nano::ingress_policer policer (0, 0);
+	for (auto i (0); i < 1000; ++i)
+	{
+		ASSERT_FALSE (policer.drop (endpoint, nano::message_type::publish));
+	}
+	ASSERT_EQ (0, policer.size ());
+}
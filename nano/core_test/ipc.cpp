@@ -1,5 +1,7 @@
+#include <nano/ipc_flatbuffers_lib/generated/flatbuffers/nanoapi_generated.h>
 #include <nano/lib/ipc_client.hpp>
 #include <nano/lib/tomlconfig.hpp>
+#include <nano/node/ipc/flatbuffers_handler.hpp>
 #include <nano/node/ipc/ipc_access_config.hpp>
 #include <nano/node/ipc/ipc_server.hpp>
 #include <nano/rpc/rpc.hpp>
@@ -11,7 +13,10 @@
 #include <boost/property_tree/json_parser.hpp>
 
 #include <chrono>
+#include <future>
+#include <limits>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -86,6 +91,213 @@ TEST (ipc, synchronous)
 	ipc.stop ();
 }
 
+TEST (ipc, multiplexed)
+{
+	nano::system system (1);
+	system.nodes[0]->config.ipc_config.transport_tcp.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_tcp.port = 24077;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::ipc_client client (system.nodes[0]->io_ctx);
+
+	// Start blocking IPC client in a separate thread
+	std::atomic<bool> call_completed{ false };
+	std::thread client_thread ([&client, &call_completed] () {
+		ASSERT_FALSE (client.connect ("::1", 24077));
+		// All requests are written before any response is read
+		std::vector<std::string> const actions{ "block_count", "version", "unknown_action", "block_count" };
+		for (uint32_t i (0); i < actions.size (); ++i)
+		{
+			std::promise<nano::error> written;
+			client.async_write (nano::ipc::prepare_multiplexed_request (nano::ipc::payload_encoding::json_v1, 100 + i, R"({"action": ")" + actions[i] + R"("})"), [&written] (nano::error err_a, size_t size_a) {
+				written.set_value (err_a);
+			});
+			ASSERT_FALSE (written.get_future ().get ());
+		}
+
+		// Responses may arrive in any order and are matched by request id
+		std::set<uint32_t> request_ids;
+		for (size_t i (0); i < actions.size (); ++i)
+		{
+			auto res (std::make_shared<std::vector<uint8_t>> ());
+			std::promise<nano::error> read;
+			client.async_read_message (res, 5s, [&read] (nano::error err_a, size_t size_a) {
+				read.set_value (err_a);
+			});
+			ASSERT_FALSE (read.get_future ().get ());
+			ASSERT_GE (res->size (), sizeof (uint32_t));
+			auto request_id (boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ())));
+			ASSERT_GE (request_id, 100);
+			ASSERT_LT (request_id, 100 + actions.size ());
+			request_ids.insert (request_id);
+			std::stringstream ss;
+			ss << std::string (res->begin () + sizeof (uint32_t), res->end ());
+			boost::property_tree::ptree response;
+			boost::property_tree::read_json (ss, response);
+			auto const & action (actions[request_id - 100]);
+			if (action == "block_count")
+			{
+				ASSERT_EQ (response.get<int> ("count"), 1);
+			}
+			else if (action == "version")
+			{
+				ASSERT_TRUE (response.get_optional<std::string> ("node_vendor").is_initialized ());
+			}
+			else
+			{
+				ASSERT_EQ (response.get<std::string> ("error"), "Unknown command");
+			}
+		}
+		ASSERT_EQ (request_ids.size (), actions.size ());
+		call_completed = true;
+	});
+	client_thread.detach ();
+
+	ASSERT_TIMELY (5s, call_completed);
+	ipc.stop ();
+}
+
+TEST (ipc, flatbuffers_blocks_info_chunked)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (node, node_rpc_config);
+	std::stringstream ss;
+	ss << R"toml(
+	[[user]]
+	allow = "api_blocks_info"
+	)toml";
+	nano::tomlconfig toml;
+	toml.read (ss);
+	ASSERT_FALSE (ipc.get_access ().deserialize_toml (toml));
+
+	nanoapi::BlocksInfoT request;
+	request.hashes = { nano::genesis_hash.to_string (), "invalid", nano::block_hash (1).to_string () };
+	request.chunk_size = 2;
+	auto request_buffer (nano::ipc::flatbuffer_producer::make_buffer (request));
+	nano::ipc::flatbuffers_handler handler (node, ipc, nullptr, node.config.ipc_config);
+	std::vector<std::shared_ptr<flatbuffers::FlatBufferBuilder>> chunks;
+	std::shared_ptr<flatbuffers::FlatBufferBuilder> last_chunk;
+	handler.process (
+	request_buffer->GetBufferPointer (), request_buffer->GetSize (), [&last_chunk] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb_a) {
+		last_chunk = fbb_a;
+	},
+	[&chunks] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb_a) {
+		chunks.push_back (fbb_a);
+	});
+	ASSERT_EQ (1, chunks.size ());
+	ASSERT_NE (nullptr, last_chunk);
+
+	auto first (nanoapi::GetEnvelope (chunks[0]->GetBufferPointer ())->message_as_BlocksInfoResponse ());
+	ASSERT_NE (nullptr, first);
+	ASSERT_TRUE (first->more ());
+	ASSERT_EQ (2, first->blocks ()->size ());
+	auto genesis_info (first->blocks ()->Get (0));
+	ASSERT_EQ (nullptr, genesis_info->error ());
+	ASSERT_EQ (nano::genesis_account.to_account (), genesis_info->account ()->str ());
+	ASSERT_EQ (1, genesis_info->height ());
+	ASSERT_TRUE (genesis_info->confirmed ());
+	ASSERT_NE (nullptr, genesis_info->block_as_BlockOpen ());
+	ASSERT_NE (nullptr, first->blocks ()->Get (1)->error ());
+
+	auto last (nanoapi::GetEnvelope (last_chunk->GetBufferPointer ())->message_as_BlocksInfoResponse ());
+	ASSERT_NE (nullptr, last);
+	ASSERT_FALSE (last->more ());
+	ASSERT_EQ (1, last->blocks ()->size ());
+	ASSERT_EQ (nano::block_hash (1).to_string (), last->blocks ()->Get (0)->hash ()->str ());
+	ASSERT_NE (nullptr, last->blocks ()->Get (0)->error ());
+	ipc.stop ();
+}
+
+TEST (ipc, flatbuffers_chunk_failure)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (node, node_rpc_config);
+	std::stringstream ss;
+	ss << R"toml(
+	[[user]]
+	allow = "api_blocks_info"
+	)toml";
+	nano::tomlconfig toml;
+	toml.read (ss);
+	ASSERT_FALSE (ipc.get_access ().deserialize_toml (toml));
+
+	nanoapi::BlocksInfoT request;
+	request.hashes = { nano::genesis_hash.to_string (), nano::genesis_hash.to_string (), nano::genesis_hash.to_string (), nano::genesis_hash.to_string () };
+	request.chunk_size = 1;
+	auto request_buffer (nano::ipc::flatbuffer_producer::make_buffer (request));
+	nano::ipc::flatbuffers_handler handler (node, ipc, nullptr, node.config.ipc_config);
+	size_t chunks (0);
+	std::shared_ptr<flatbuffers::FlatBufferBuilder> last_chunk;
+	handler.process (
+	request_buffer->GetBufferPointer (), request_buffer->GetSize (), [&last_chunk] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb_a) {
+		last_chunk = fbb_a;
+	},
+	[&chunks] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &) {
+		// A chunk that cannot be written stops the response instead of being dropped
+		++chunks;
+		throw nano::error ("Response chunk could not be written");
+	});
+	ASSERT_EQ (1, chunks);
+	ASSERT_NE (nullptr, last_chunk);
+	auto error (nanoapi::GetEnvelope (last_chunk->GetBufferPointer ())->message_as_Error ());
+	ASSERT_NE (nullptr, error);
+	ASSERT_EQ ("Response chunk could not be written", error->message ()->str ());
+	ipc.stop ();
+}
+
+TEST (ipc, flatbuffers_chunk_releases_transaction)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (node, node_rpc_config);
+	std::stringstream ss;
+	ss << R"toml(
+	[[user]]
+	allow = "api_frontiers"
+	)toml";
+	nano::tomlconfig toml;
+	toml.read (ss);
+	ASSERT_FALSE (ipc.get_access ().deserialize_toml (toml));
+	nano::account const first (1);
+	nano::account const last (std::numeric_limits<nano::uint256_t>::max ());
+	{
+		auto transaction (node.store.tx_begin_write ());
+		node.store.account.put (transaction, first, nano::account_info (nano::genesis_hash, nano::dev_genesis_key.pub, nano::genesis_hash, 1, 0, 1, nano::epoch::epoch_0));
+	}
+
+	nanoapi::FrontiersT request;
+	request.chunk_size = 1;
+	auto request_buffer (nano::ipc::flatbuffer_producer::make_buffer (request));
+	nano::ipc::flatbuffers_handler handler (node, ipc, nullptr, node.config.ipc_config);
+	size_t chunks (0);
+	std::shared_ptr<flatbuffers::FlatBufferBuilder> last_chunk;
+	handler.process (
+	request_buffer->GetBufferPointer (), request_buffer->GetSize (), [&last_chunk] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb_a) {
+		last_chunk = fbb_a;
+	},
+	[&node, &chunks, &last] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &) {
+		// No snapshot is held while a chunk is written, so the scan resumes on the current ledger
+		if (++chunks == 1)
+		{
+			auto transaction (node.store.tx_begin_write ());
+			node.store.account.put (transaction, last, nano::account_info (nano::genesis_hash, nano::dev_genesis_key.pub, nano::genesis_hash, 1, 0, 1, nano::epoch::epoch_0));
+		}
+	});
+	ASSERT_EQ (2, chunks);
+	ASSERT_NE (nullptr, last_chunk);
+	auto response (nanoapi::GetEnvelope (last_chunk->GetBufferPointer ())->message_as_FrontiersResponse ());
+	ASSERT_NE (nullptr, response);
+	ASSERT_FALSE (response->more ());
+	ASSERT_EQ (1, response->frontiers ()->size ());
+	ASSERT_EQ (last.to_account (), response->frontiers ()->Get (0)->account ()->str ());
+	ipc.stop ();
+}
+
 TEST (ipc, permissions_default_user)
 {
 	// Test empty/nonexistant access config. The default user still exists with default permissions.
@@ -0,0 +1,83 @@
+#include <nano/lib/json_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <sstream>
+
+namespace
+{
+std::string write_json (boost::property_tree::ptree const & tree_a)
+{
+	std::stringstream ostream;
+	boost::property_tree::write_json (ostream, tree_a);
+	return ostream.str ();
+}
+}
+
+TEST (json_writer, matches_ptree)
+{
+	boost::property_tree::ptree tree;
+	nano::json_writer writer;
+	tree.put ("account", "nano_1");
+	writer.put ("account", "nano_1");
+	boost::property_tree::ptree history;
+	writer.begin_array ("history");
+	for (auto i (0); i < 3; ++i)
+	{
+		boost::property_tree::ptree entry;
+		entry.put ("height", std::to_string (i));
+		entry.put ("escaped", "\"a/b\"\\\n\t\x01");
+		entry.put ("non_ascii", "caf\xc3\xa9 \xe2\x82\xac\x7f");
+		history.push_back (std::make_pair ("", entry));
+		writer.push_back (entry);
+	}
+	tree.add_child ("history", history);
+	writer.end_array ();
+	boost::property_tree::ptree blocks;
+	writer.begin_object ("blocks");
+	boost::property_tree::ptree block;
+	block.put ("type", "state");
+	blocks.add_child ("A", block);
+	writer.put_child ("A", block);
+	blocks.put ("B", 42);
+	writer.put ("B", 42);
+	tree.add_child ("blocks", blocks);
+	writer.end_object ();
+	ASSERT_EQ (write_json (tree), writer.finish ());
+}
+
+TEST (json_writer, empty)
+{
+	// Empty containers below the root are written as an empty string by write_json
+	boost::property_tree::ptree tree;
+	nano::json_writer writer;
+	ASSERT_TRUE (writer.empty ());
+	tree.add_child ("accounts", boost::property_tree::ptree ());
+	writer.begin_object ("accounts");
+	writer.end_object ();
+	tree.add_child ("history", boost::property_tree::ptree ());
+	writer.begin_array ("history");
+	writer.end_array ();
+	ASSERT_FALSE (writer.empty ());
+	ASSERT_EQ (write_json (tree), writer.finish ());
+	ASSERT_EQ (write_json (boost::property_tree::ptree ()), nano::json_writer ().finish ());
+}
+
+TEST (json_writer, leading_members)
+{
+	boost::property_tree::ptree tree;
+	boost::property_tree::ptree leading;
+	nano::json_writer writer;
+	tree.put ("deprecated_account_format", "1");
+	leading.put ("deprecated_account_format", "1");
+	boost::property_tree::ptree balances;
+	writer.begin_object ("balances");
+	balances.put ("nano_1", "0");
+	writer.put ("nano_1", "0");
+	writer.end_object ();
+	tree.add_child ("balances", balances);
+	ASSERT_EQ (write_json (tree), writer.finish (leading));
+}
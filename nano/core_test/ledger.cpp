@@ -3391,6 +3391,65 @@ TEST (ledger, pruning_action)
 	ASSERT_EQ (store->block.count (transaction), ledger.cache.block_count - ledger.cache.pruned_count);
 }
 
+TEST (ledger, account_heights)
+{
+	nano::logger_mt logger;
+	auto store = nano::make_store (logger, nano::unique_path ());
+	ASSERT_TRUE (!store->init_error ());
+	nano::stat stats;
+	nano::ledger ledger (*store, stats);
+	nano::genesis genesis;
+	auto transaction (store->tx_begin_write ());
+	store->initialize (transaction, genesis, ledger.cache);
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	nano::state_block send1 (nano::genesis_account, genesis.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (genesis.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send1).code);
+	// Blocks processed once the index is enabled are indexed right away
+	ledger.account_heights = true;
+	nano::state_block send2 (nano::genesis_account, send1.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio * 2, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send1.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send2).code);
+	nano::state_block send3 (nano::genesis_account, send2.hash (), nano::genesis_account, nano::genesis_amount - nano::Gxrb_ratio * 3, nano::genesis_account, nano::dev_genesis_key.prv, nano::dev_genesis_key.pub, *pool.generate (send2.hash ()));
+	ASSERT_EQ (nano::process_result::progress, ledger.process (transaction, send3).code);
+	auto seek = [&ledger, &transaction] (uint64_t height_a, uint64_t offset_a, bool descending_a) {
+		auto result (ledger.hash_at_offset (transaction, nano::genesis_account, height_a, offset_a, descending_a));
+		return result ? result->to_string () : std::string ("none");
+	};
+	ASSERT_EQ (send3.hash (), store->account_height.get (transaction, nano::genesis_account, 4));
+	ASSERT_FALSE (store->account_height.exists (transaction, nano::genesis_account, 2));
+	// Readers walk the chain until the index is complete
+	ASSERT_EQ ("none", seek (4, 1, true));
+	ASSERT_FALSE (ledger.account_heights_build (transaction, 2));
+	ASSERT_FALSE (ledger.account_heights_complete);
+	ASSERT_FALSE (store->account_height.exists (transaction, nano::genesis_account, 2));
+	ASSERT_TRUE (ledger.account_heights_build (transaction, 2));
+	ASSERT_TRUE (ledger.account_heights_complete);
+	ASSERT_EQ (nano::ledger::account_heights_complete_cursor, store->account_height.cursor (transaction));
+	ASSERT_EQ (send1.hash (), store->account_height.get (transaction, nano::genesis_account, 2));
+	ASSERT_EQ (genesis.hash (), store->account_height.get (transaction, nano::genesis_account, 1));
+	ASSERT_EQ (send1.hash ().to_string (), seek (4, 2, true));
+	ASSERT_EQ (send3.hash ().to_string (), seek (1, 3, false));
+	// Past either end of the chain
+	ASSERT_EQ (nano::block_hash (0).to_string (), seek (4, 4, true));
+	ASSERT_EQ (nano::block_hash (0).to_string (), seek (2, 3, false));
+	// Rolled back blocks leave the index
+	ASSERT_FALSE (ledger.rollback (transaction, send3.hash ()));
+	ASSERT_FALSE (store->account_height.exists (transaction, nano::genesis_account, 4));
+	ASSERT_EQ (nano::block_hash (0).to_string (), seek (1, 3, false));
+	// Pruned blocks too, readers then fall back to walking the chain which stops at them
+	ledger.pruning = true;
+	ASSERT_EQ (1, ledger.pruning_action (transaction, send1.hash (), 1));
+	ASSERT_FALSE (store->account_height.exists (transaction, nano::genesis_account, 2));
+	ASSERT_EQ ("none", seek (3, 1, true));
+	// An index marked incomplete is rebuilt over its entries, dropping those for blocks pruned in the meantime
+	store->account_height.put (transaction, nano::genesis_account, 2, send1.hash ());
+	store->account_height.cursor_put (transaction, nano::uint512_union (0));
+	ledger.account_heights_complete = false;
+	ASSERT_TRUE (ledger.account_heights_build (transaction, 16));
+	ASSERT_FALSE (store->account_height.exists (transaction, nano::genesis_account, 2));
+	ASSERT_EQ (send2.hash (), store->account_height.get (transaction, nano::genesis_account, 3));
+	ASSERT_EQ (genesis.hash (), store->account_height.get (transaction, nano::genesis_account, 1));
+}
+
 TEST (ledger, pruning_large_chain)
 {
 	nano::logger_mt logger;
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <thread>
 #include <vector>
 
 namespace
@@ -98,3 +99,69 @@ TEST (memory_pool, validate_cleanup)
 
 	ASSERT_TRUE (nano::purge_singleton_inactive_votes_cache_pool_memory ());
 }
+
+TEST (memory_pool, thread_cached)
+{
+	if (!nano::get_use_memory_pools ())
+	{
+		return;
+	}
+	auto & stats (nano::thread_cached_allocator<nano::vote>::stats ());
+	auto const outstanding (stats.outstanding.load ());
+	{
+		auto vote (nano::make_pooled<nano::vote> ());
+		ASSERT_EQ (outstanding + 1, stats.outstanding);
+	}
+	ASSERT_EQ (outstanding, stats.outstanding);
+	// The allocation just freed is cached by this thread and reused
+	auto const hits (stats.hits.load ());
+	auto const misses (stats.misses.load ());
+	auto vote (nano::make_pooled<nano::vote> ());
+	ASSERT_EQ (hits + 1, stats.hits);
+	ASSERT_EQ (misses, stats.misses);
+}
+
+TEST (memory_pool, thread_cached_cross_thread)
+{
+	if (!nano::get_use_memory_pools ())
+	{
+		return;
+	}
+	auto & stats (nano::thread_cached_allocator<nano::vote>::stats ());
+	auto vote (nano::make_pooled<nano::vote> ());
+	auto const address (vote.get ());
+	auto const returned (stats.returned.load ());
+	std::thread ([vote = std::move (vote)] () mutable {
+		vote.reset ();
+	})
+	.join ();
+	// Freed on another thread, the memory went back to this thread rather than to the cache of the freeing thread
+	ASSERT_EQ (returned + 1, stats.returned);
+	std::vector<std::shared_ptr<nano::vote>> votes;
+	auto found (false);
+	for (auto i (0); i <= nano::thread_cached_allocator<nano::vote>::cache_capacity && !found; ++i)
+	{
+		votes.push_back (nano::make_pooled<nano::vote> ());
+		found = votes.back ().get () == address;
+	}
+	ASSERT_TRUE (found);
+}
+
+TEST (memory_pool, pooled_bytes)
+{
+	if (!nano::get_use_memory_pools ())
+	{
+		return;
+	}
+	auto & stats (nano::pooled_bytes_stats ());
+	{
+		auto bytes (nano::make_pooled_bytes ());
+		bytes->resize (100);
+	}
+	auto const hits (stats.hits.load ());
+	auto bytes (nano::make_pooled_bytes ());
+	ASSERT_EQ (hits + 1, stats.hits);
+	// Vectors come back empty with their capacity kept
+	ASSERT_TRUE (bytes->empty ());
+	ASSERT_GE (bytes->capacity (), 100);
+}
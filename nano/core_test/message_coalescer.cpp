@@ -0,0 +1,87 @@
+#include <nano/node/message_coalescer.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::vector<std::pair<nano::block_hash, nano::root>> roots_hashes (size_t count_a)
+{
+	std::vector<std::pair<nano::block_hash, nano::root>> result;
+	for (size_t i (0); i < count_a; ++i)
+	{
+		result.emplace_back (nano::block_hash (i + 1), nano::root (i + 1));
+	}
+	return result;
+}
+}
+
+TEST (message_coalescer, sparse_immediate)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_udp = false;
+	auto & node1 = *system.add_node (node_flags);
+	auto & node2 = *system.add_node (node_flags);
+	auto channel (node2.network.udp_channels.create (node1.network.endpoint ()));
+	// Without recent traffic a partial message is not held back
+	node2.network.coalescer.add_confirm_req (channel, roots_hashes (3));
+	ASSERT_EQ (0, node2.network.coalescer.pending ());
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+	ASSERT_DOUBLE_EQ (3.0 / nano::network::confirm_req_hashes_max, node2.network.coalescer.fill_ratio (node1.network.endpoint (), nano::message_type::confirm_req));
+	ASSERT_EQ (0, node2.stats.count (nano::stat::type::coalescer, nano::stat::detail::coalescer_held));
+}
+
+TEST (message_coalescer, burst_coalesced)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_udp = false;
+	auto & node1 = *system.add_node (node_flags);
+	auto & node2 = *system.add_node (node_flags);
+	auto channel (node2.network.udp_channels.create (node1.network.endpoint ()));
+	auto & coalescer (node2.network.coalescer);
+	coalescer.add_confirm_req (channel, roots_hashes (1));
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+	// Requests arriving in quick succession are held back and packed into fewer messages
+	for (size_t i (0); i < nano::network::confirm_req_hashes_max; ++i)
+	{
+		coalescer.add_confirm_req (channel, roots_hashes (1));
+	}
+	ASSERT_LE (1, node2.stats.count (nano::stat::type::coalescer, nano::stat::detail::coalescer_held));
+	// Held hashes are sent once full or when the deadline passes
+	ASSERT_TIMELY (5s, coalescer.pending () == 0);
+	ASSERT_EQ (nano::network::confirm_req_hashes_max + 1, node2.stats.count (nano::stat::type::coalescer, nano::stat::detail::coalescer_req_hashes, nano::stat::dir::out));
+	ASSERT_LT (node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out), nano::network::confirm_req_hashes_max + 1);
+	ASSERT_LT (1.0 / nano::network::confirm_req_hashes_max, coalescer.fill_ratio (node1.network.endpoint (), nano::message_type::confirm_req));
+}
+
+TEST (message_coalescer, container_info)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_udp = false;
+	auto & node1 = *system.add_node (node_flags);
+	auto & node2 = *system.add_node (node_flags);
+	auto channel (node2.network.udp_channels.create (node1.network.endpoint ()));
+	node2.network.coalescer.add_confirm_req (channel, roots_hashes (3));
+	// Fill ratios are reported for each endpoint
+	auto info (nano::collect_container_info (node2.network.coalescer, "coalescer"));
+	auto const & children (static_cast<nano::container_info_composite &> (*info).get_children ());
+	auto const & channels (static_cast<nano::container_info_composite &> (*children.back ()));
+	ASSERT_EQ ("channels", channels.get_name ());
+	ASSERT_EQ (1, channels.get_children ().size ());
+	std::unordered_map<std::string, size_t> counts;
+	for (auto const & leaf : static_cast<nano::container_info_composite &> (*channels.get_children ().front ()).get_children ())
+	{
+		auto const & leaf_info (static_cast<nano::container_info_leaf &> (*leaf).get_info ());
+		counts[leaf_info.name] = leaf_info.count;
+	}
+	ASSERT_EQ (1, counts["confirm_req_messages"]);
+	ASSERT_EQ (std::lround (300.0 / nano::network::confirm_req_hashes_max), counts["confirm_req_fill_percent"]);
+	ASSERT_EQ (0, counts["confirm_ack_messages"]);
+	ASSERT_EQ (0, counts["confirm_ack_fill_percent"]);
+}
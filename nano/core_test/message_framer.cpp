@@ -0,0 +1,80 @@
+#include <nano/node/common.hpp>
+#include <nano/node/message_framer.hpp>
+#include <nano/secure/buffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+void append (std::vector<uint8_t> & bytes_a, nano::message const & message_a)
+{
+	auto bytes (message_a.to_bytes ());
+	bytes_a.insert (bytes_a.end (), bytes->begin (), bytes->end ());
+}
+
+void write (nano::message_framer & framer_a, uint8_t const * data_a, size_t size_a)
+{
+	auto free (framer_a.prepare ());
+	ASSERT_LE (size_a, free.second);
+	std::memcpy (framer_a.buffer->data () + free.first, data_a, size_a);
+	framer_a.commit (size_a);
+}
+}
+
+TEST (message_framer, multiple_messages)
+{
+	nano::keepalive keepalive;
+	keepalive.peers[0] = nano::endpoint (boost::asio::ip::address_v6::loopback (), 10000);
+	nano::publish publish (std::make_shared<nano::send_block> (0, 1, 2, nano::keypair ().prv, 4, 5));
+	nano::telemetry_req telemetry_req;
+	std::vector<uint8_t> bytes;
+	append (bytes, keepalive);
+	append (bytes, publish);
+	append (bytes, telemetry_req);
+
+	// All three messages arrive in one read, except for the last byte of the stream
+	nano::message_framer framer;
+	write (framer, bytes.data (), bytes.size () - 1);
+	nano::message_header header (nano::message_type::invalid);
+	uint8_t const * payload (nullptr);
+	ASSERT_EQ (nano::message_framer::status::complete, framer.next (header, payload));
+	ASSERT_EQ (nano::message_type::keepalive, header.type);
+	auto error (false);
+	nano::bufferstream keepalive_stream (payload, header.payload_length_bytes ());
+	nano::keepalive keepalive2 (error, keepalive_stream, header);
+	ASSERT_FALSE (error);
+	ASSERT_EQ (keepalive, keepalive2);
+	ASSERT_EQ (nano::message_framer::status::complete, framer.next (header, payload));
+	ASSERT_EQ (nano::message_type::publish, header.type);
+	nano::bufferstream publish_stream (payload, header.payload_length_bytes ());
+	nano::publish publish2 (error, publish_stream, header);
+	ASSERT_FALSE (error);
+	ASSERT_EQ (*publish.block, *publish2.block);
+	// The telemetry_req header is incomplete
+	ASSERT_EQ (nano::message_framer::status::incomplete, framer.next (header, payload));
+	ASSERT_EQ (nano::message_header::size - 1, framer.pending ());
+
+	// The remainder is moved to the start of the buffer before the next read
+	auto free (framer.prepare ());
+	ASSERT_EQ (nano::message_header::size - 1, free.first);
+	write (framer, bytes.data () + bytes.size () - 1, 1);
+	ASSERT_EQ (nano::message_framer::status::complete, framer.next (header, payload));
+	ASSERT_EQ (nano::message_type::telemetry_req, header.type);
+	ASSERT_EQ (0, framer.pending ());
+	ASSERT_EQ (nano::message_framer::status::incomplete, framer.next (header, payload));
+}
+
+TEST (message_framer, invalid)
+{
+	std::vector<uint8_t> bytes;
+	append (bytes, nano::keepalive ());
+	// Unknown message type
+	bytes[5] = 0x09;
+	nano::message_framer framer;
+	write (framer, bytes.data (), bytes.size ());
+	nano::message_header header (nano::message_type::invalid);
+	uint8_t const * payload (nullptr);
+	ASSERT_EQ (nano::message_framer::status::invalid, framer.next (header, payload));
+}
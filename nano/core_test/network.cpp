@@ -100,6 +100,24 @@ TEST (network, send_node_id_handshake)
 	node1->stop ();
 }
 
+TEST (network, udp_batched_io)
+{
+	nano::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_udp = false;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.udp_batched_io = true;
+	auto & node0 (*system.add_node (node_config, node_flags, nano::transport::transport_type::udp));
+	node_config.peering_port = nano::get_available_port ();
+	auto & node1 (*system.add_node (node_config, node_flags, nano::transport::transport_type::udp));
+	ASSERT_TIMELY (10s, node0.network.udp_channels.size () == 1 && node1.network.udp_channels.size () == 1);
+	if (node0.network.udp_channels.batched_io)
+	{
+		ASSERT_LT (0, node0.stats.count (nano::stat::type::udp, nano::stat::detail::batch_packets, nano::stat::dir::in));
+		ASSERT_LT (0, node0.stats.count (nano::stat::type::udp, nano::stat::detail::batch_packets, nano::stat::dir::out));
+	}
+}
+
 TEST (network, send_node_id_handshake_tcp)
 {
 	nano::system system (1);
@@ -1046,6 +1064,59 @@ TEST (network, bandwidth_limiter)
 	node.stop ();
 }
 
+TEST (network, broadcast_limiter)
+{
+	nano::system system;
+	nano::genesis genesis;
+	nano::publish message (genesis.open);
+	auto message_size = message.to_bytes ()->size ();
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.bandwidth_limit = 2 * message_size;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	auto & node = *system.add_node (node_config);
+	std::deque<std::shared_ptr<nano::transport::channel>> channels;
+	for (auto i = 0; i < 3; ++i)
+	{
+		channels.push_back (node.network.udp_channels.create (node.network.endpoint ()));
+	}
+	// The limiter only has room for two of the three copies
+	node.network.broadcast (message, channels);
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::out));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::out));
+
+	// Non-droppable broadcasts reach every channel
+	node.network.broadcast (message, channels, nano::buffer_drop_policy::no_limiter_drop);
+	ASSERT_EQ (5, node.stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::out));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::out));
+
+	node.stop ();
+}
+
+TEST (network, broadcast_no_limiter_drop_charged)
+{
+	nano::system system;
+	nano::genesis genesis;
+	nano::publish message (genesis.open);
+	auto message_size = message.to_bytes ()->size ();
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.bandwidth_limit = 2 * message_size;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	auto & node = *system.add_node (node_config);
+	std::deque<std::shared_ptr<nano::transport::channel>> channels;
+	for (auto i = 0; i < 2; ++i)
+	{
+		channels.push_back (node.network.udp_channels.create (node.network.endpoint ()));
+	}
+	// Non-droppable traffic is sent regardless but uses up the limiter budget
+	node.network.broadcast (message, channels, nano::buffer_drop_policy::no_limiter_drop);
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::out));
+	node.network.broadcast (message, { channels.front () });
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::message, nano::stat::detail::publish, nano::stat::dir::out));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::out));
+
+	node.stop ();
+}
+
 namespace nano
 {
 TEST (peer_exclusion, validate)
@@ -1152,7 +1223,10 @@ TEST (network, tcp_message_manager)
 	ASSERT_EQ (0, manager.entries.size ());
 
 	// Fill the queue
-	manager.entries = decltype (manager.entries) (manager.max_entries, item);
+	while (manager.entries.size () < manager.max_entries)
+	{
+		manager.entries.push (item.endpoint, item);
+	}
 	ASSERT_EQ (manager.entries.size (), manager.max_entries);
 
 	// This task will wait until a message is consumed
@@ -1270,3 +1344,22 @@ TEST (network, filter)
 	node1.network.inbound (keepalive, std::make_shared<nano::transport::channel_loopback> (node1));
 	ASSERT_EQ (1, node1.stats.count (nano::stat::type::message, nano::stat::detail::invalid_network));
 }
+
+// Messages over a peer's rate are dropped by the TCP server before they are queued for processing
+TEST (network, tcp_ingress_policing)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.peer_message_rate = 1;
+	auto & node1 = *system.add_node (node_config);
+	auto & node2 = *system.add_node ();
+	ASSERT_TIMELY (5s, node2.network.find_node_id (node1.node_id.pub) != nullptr);
+	auto channel (node2.network.find_node_id (node1.node_id.pub));
+	nano::keepalive keepalive;
+	for (auto i (0); i < 20; ++i)
+	{
+		channel->send (keepalive);
+	}
+	// The burst is five times the rate
+	ASSERT_TIMELY (5s, node1.stats.count (nano::stat::type::drop, nano::stat::detail::keepalive, nano::stat::dir::in) >= 14);
+}
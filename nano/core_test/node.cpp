@@ -4687,6 +4687,32 @@ TEST (rep_crawler, local)
 	node.rep_crawler.validate ();
 	ASSERT_EQ (0, node.rep_crawler.representative_count ());
 }
+
+TEST (rep_crawler, snapshot)
+{
+	nano::system system;
+	nano::node_flags flags;
+	flags.disable_rep_crawler = true;
+	auto & node = *system.add_node (flags);
+	auto loopback = std::make_shared<nano::transport::channel_loopback> (node);
+	auto snapshot1 = node.rep_crawler.snapshot ();
+	ASSERT_TRUE (snapshot1->representatives.empty ());
+	{
+		nano::lock_guard<nano::mutex> guard (node.rep_crawler.probable_reps_mutex);
+		node.rep_crawler.probable_reps.emplace (nano::dev_genesis_key.pub, nano::genesis_amount, loopback);
+		node.rep_crawler.update_snapshot ();
+	}
+	auto snapshot2 = node.rep_crawler.snapshot ();
+	ASSERT_GT (snapshot2->epoch, snapshot1->epoch);
+	// Published snapshots are immutable
+	ASSERT_TRUE (snapshot1->representatives.empty ());
+	ASSERT_EQ (1, snapshot2->representatives.size ());
+	ASSERT_EQ (nano::genesis_amount, node.rep_crawler.total_weight ());
+	ASSERT_EQ (1, node.rep_crawler.principal_representatives ().size ());
+	// Unchanged weights don't publish a new snapshot
+	node.rep_crawler.update_weights ();
+	ASSERT_EQ (snapshot2, node.rep_crawler.snapshot ());
+}
 }
 
 TEST (node, pruning_automatic)
@@ -4853,6 +4879,72 @@ TEST (node, pruning_depth)
 	ASSERT_TRUE (node1.ledger.block_or_pruned_exists (send2->hash ()));
 }
 
+TEST (node, read_transaction_pool)
+{
+	nano::system system (1);
+	auto & node = *system.nodes[0];
+	nano::stat stats;
+	nano::read_transaction_pool pool (node.store, stats, std::chrono::hours (1));
+	nano::genesis genesis;
+	nano::keypair key1;
+	auto send1 = nano::send_block_builder ()
+				 .previous (genesis.hash ())
+				 .destination (key1.pub)
+				 .balance (nano::genesis_amount - nano::Gxrb_ratio)
+				 .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+				 .work (*system.work.generate (genesis.hash ()))
+				 .build_shared ();
+	nano::read_transaction const * first (nullptr);
+	{
+		auto transaction (pool.borrow ());
+		first = &transaction.get ();
+		ASSERT_TRUE (node.store.block.exists (transaction, genesis.hash ()));
+		// Nested borrows share the transaction
+		auto nested (pool.borrow ());
+		ASSERT_EQ (first, &nested.get ());
+	}
+	ASSERT_EQ (1, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_open));
+	ASSERT_EQ (1, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_reuse));
+	ASSERT_EQ (nano::process_result::progress, node.process (*send1).code);
+	{
+		// The snapshot is younger than max_age so it is reused and does not see the new block
+		auto transaction (pool.borrow ());
+		ASSERT_EQ (first, &transaction.get ());
+		ASSERT_FALSE (node.store.block.exists (transaction, send1->hash ()));
+	}
+	ASSERT_EQ (2, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_reuse));
+	{
+		// Unless a fresh snapshot is requested
+		auto transaction (pool.borrow (true));
+		ASSERT_EQ (first, &transaction.get ());
+		ASSERT_TRUE (node.store.block.exists (transaction, send1->hash ()));
+	}
+	ASSERT_EQ (1, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_refresh));
+	ASSERT_EQ (1, pool.size ());
+	// Borrowing on another thread uses a separate transaction
+	nano::read_transaction const * other (nullptr);
+	std::thread thread ([&pool, &other] () {
+		auto transaction (pool.borrow ());
+		other = &transaction.get ();
+	});
+	thread.join ();
+	ASSERT_NE (first, other);
+	ASSERT_EQ (2, pool.size ());
+	ASSERT_EQ (2, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_open));
+	// Without a max age every borrow sees a fresh snapshot, which is reset when returned
+	nano::read_transaction_pool fresh (node.store, stats, std::chrono::milliseconds (0));
+	{
+		auto transaction (fresh.borrow ());
+		ASSERT_TRUE (node.store.block.exists (transaction, send1->hash ()));
+	}
+	ASSERT_EQ (1, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_reset));
+	{
+		auto transaction (fresh.borrow ());
+		ASSERT_TRUE (node.store.block.exists (transaction, send1->hash ()));
+	}
+	ASSERT_EQ (1, stats.count (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_renew));
+}
+
 namespace
 {
 void add_required_children_node_config_tree (nano::jsonconfig & tree)
@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+using namespace std::chrono_literals;
+
 TEST (peer_container, empty_peers)
 {
 	nano::system system (1);
@@ -186,3 +188,80 @@ TEST (peer_container, depeer)
 	system.nodes[0]->network.udp_channels.receive_action (&buffer);
 	ASSERT_EQ (1, system.nodes[0]->stats.count (nano::stat::type::udp, nano::stat::detail::outdated_version));
 }
+
+TEST (channels, tcp_snapshot_range)
+{
+	nano::system system (1);
+	auto & node (*system.nodes[0]);
+	nano::transport::channels_snapshot snapshot;
+	for (uint8_t version (18); version <= 20; ++version)
+	{
+		auto channel (std::make_shared<nano::transport::channel_tcp> (node, std::weak_ptr<nano::socket> ()));
+		snapshot.all.push_back ({ version, channel });
+		if (version != 19)
+		{
+			snapshot.permanent.push_back ({ version, channel });
+		}
+	}
+	auto range1 (snapshot.range (19, true));
+	ASSERT_EQ (2, std::distance (range1.first, range1.second));
+	ASSERT_EQ (19, range1.first->network_version);
+	auto range2 (snapshot.range (19, false));
+	ASSERT_EQ (1, std::distance (range2.first, range2.second));
+	ASSERT_EQ (20, range2.first->network_version);
+	auto range3 (snapshot.range (21, true));
+	ASSERT_EQ (range3.first, range3.second);
+}
+
+TEST (channels, tcp_random_set)
+{
+	nano::system system (3);
+	auto & node (*system.nodes[0]);
+	ASSERT_TIMELY (5s, node.network.tcp_channels.snapshot ()->permanent.size () == 2);
+	for (auto i (0); i < 100; ++i)
+	{
+		ASSERT_EQ (1, node.network.tcp_channels.random_set (1).size ());
+	}
+	ASSERT_EQ (2, node.network.tcp_channels.random_set (10).size ());
+	ASSERT_TRUE (node.network.tcp_channels.random_set (10, node.network_params.protocol.protocol_version + 1).empty ());
+}
+
+TEST (channels, tcp_modify_snapshot)
+{
+	nano::system system (2);
+	auto & node (*system.nodes[0]);
+	ASSERT_TIMELY (5s, node.network.tcp_channels.snapshot ()->permanent.size () == 1);
+	auto channel (node.network.tcp_channels.find_node_id (system.nodes[1]->node_id.pub));
+	ASSERT_NE (nullptr, channel);
+	node.network.tcp_channels.modify (channel, [] (std::shared_ptr<nano::transport::channel_tcp> const & channel_a) {
+		channel_a->temporary = true;
+	});
+	ASSERT_TRUE (node.network.tcp_channels.snapshot ()->permanent.empty ());
+	ASSERT_EQ (1, node.network.tcp_channels.snapshot ()->all.size ());
+	node.network.tcp_channels.modify (channel, [] (std::shared_ptr<nano::transport::channel_tcp> const & channel_a) {
+		channel_a->temporary = false;
+	});
+	ASSERT_EQ (1, node.network.tcp_channels.snapshot ()->permanent.size ());
+}
+
+TEST (channels, tcp_bootstrap_peers)
+{
+	nano::node_flags node_flags;
+	node_flags.disable_ongoing_bootstrap = true;
+	nano::system system (3, nano::transport::transport_type::tcp, node_flags);
+	auto & node (*system.nodes[0]);
+	ASSERT_TIMELY (5s, node.network.tcp_channels.size () == 2);
+	auto const version_min (node.network_params.protocol.protocol_version_min ());
+	auto all = [] (nano::tcp_endpoint const &) { return true; };
+	auto peers1 (node.network.tcp_channels.bootstrap_peers (version_min, 4, all));
+	ASSERT_EQ (2, peers1.size ());
+	// Listing does not rotate peers
+	ASSERT_EQ (peers1, node.network.tcp_channels.bootstrap_peers (version_min, 4, all));
+	node.network.tcp_channels.bootstrap_attempted (peers1[0]);
+	auto peers2 (node.network.tcp_channels.bootstrap_peers (version_min, 1, all));
+	ASSERT_EQ (1, peers2.size ());
+	ASSERT_EQ (peers1[1], peers2[0]);
+	auto peers3 (node.network.tcp_channels.bootstrap_peers (version_min, 4, [&peers1] (nano::tcp_endpoint const & endpoint_a) { return endpoint_a != peers1[1]; }));
+	ASSERT_EQ (1, peers3.size ());
+	ASSERT_EQ (peers1[0], peers3[0]);
+}
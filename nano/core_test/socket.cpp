@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+
 using namespace std::chrono_literals;
 
 TEST (socket, max_connections)
@@ -169,6 +171,49 @@ TEST (socket, drop_policy)
 	runner.join ();
 }
 
+TEST (socket, write_priority)
+{
+	auto node_flags = nano::inactive_node_flag_defaults ();
+	node_flags.read_only = false;
+	nano::inactive_node inactivenode (nano::unique_path (), node_flags);
+	auto node = inactivenode.node;
+
+	nano::thread_runner runner (node->io_ctx, 1);
+
+	auto server_port (nano::get_available_port ());
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::address_v6::any (), server_port);
+	auto server_socket = std::make_shared<nano::server_socket> (*node, endpoint, 1);
+	boost::system::error_code ec;
+	server_socket->start (ec);
+	ASSERT_FALSE (ec);
+
+	std::promise<std::string> received;
+	std::vector<std::shared_ptr<nano::socket>> connections;
+	server_socket->on_connection ([&connections, &received] (std::shared_ptr<nano::socket> const & new_connection, boost::system::error_code const & ec_a) {
+		connections.push_back (new_connection);
+		auto buffer (std::make_shared<std::vector<uint8_t>> (3));
+		new_connection->async_read (buffer, 3, [buffer, &received] (boost::system::error_code const & ec, size_t size_a) {
+			received.set_value (std::string (buffer->begin (), buffer->begin () + size_a));
+		});
+		return true;
+	});
+
+	auto client = std::make_shared<nano::socket> (*node, boost::none);
+	client->async_connect (boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), server_port), [client] (boost::system::error_code const & ec_a) {
+		// Queued from the strand, so all three buffers are waiting when the first write starts
+		client->async_write (nano::shared_const_buffer (std::string ("L")), nullptr, nano::write_priority::low);
+		client->async_write (nano::shared_const_buffer (std::string ("N")), nullptr, nano::write_priority::normal);
+		client->async_write (nano::shared_const_buffer (std::string ("H")), nullptr, nano::write_priority::high);
+	});
+	auto future (received.get_future ());
+	ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	ASSERT_EQ ("HNL", future.get ());
+
+	node->stop ();
+	runner.stop_event_processing ();
+	runner.join ();
+}
+
 TEST (socket, concurrent_writes)
 {
 	auto node_flags = nano::inactive_node_flag_defaults ();
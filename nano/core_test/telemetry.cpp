@@ -181,6 +181,126 @@ TEST (telemetry, consolidate_data_remove_outliers)
 	ASSERT_EQ (data, consolidated_telemetry_data);
 }
 
+TEST (telemetry, quantile_sketch)
+{
+	nano::quantile_sketch sketch (0.01);
+	ASSERT_EQ (0, sketch.quantile (0.5));
+	for (uint64_t i (1); i <= 1000; ++i)
+	{
+		sketch.insert (i);
+	}
+	ASSERT_EQ (1000, sketch.size ());
+	auto within = [] (uint64_t expected, uint64_t actual) {
+		return actual >= expected * 0.98 && actual <= expected * 1.02;
+	};
+	ASSERT_PRED2 (within, 500, sketch.quantile (0.5));
+	ASSERT_PRED2 (within, 990, sketch.quantile (0.99));
+	ASSERT_PRED2 (within, 1000, sketch.quantile (1.0));
+	ASSERT_LT (sketch.bucket_count (), 1000);
+	for (uint64_t i (501); i <= 1000; ++i)
+	{
+		sketch.erase (i);
+	}
+	ASSERT_EQ (500, sketch.size ());
+	ASSERT_PRED2 (within, 500, sketch.quantile (1.0));
+	sketch.insert (0);
+	ASSERT_EQ (0, sketch.quantile (0.0));
+}
+
+TEST (telemetry, trimmed_sum)
+{
+	nano::trimmed_sum sum;
+	for (uint64_t i (1); i <= 10; ++i)
+	{
+		sum.insert (i);
+	}
+	ASSERT_EQ (55, sum.sum ());
+	sum.trim (2);
+	ASSERT_EQ (6, sum.size ());
+	ASSERT_EQ (3 + 4 + 5 + 6 + 7 + 8, sum.sum ());
+	// Values below the trimmed lowest move into the kept range
+	sum.insert (0);
+	ASSERT_EQ (2 + 3 + 4 + 5 + 6 + 7 + 8, sum.sum ());
+	sum.erase (5);
+	sum.erase (10);
+	ASSERT_EQ (2 + 3 + 4 + 6 + 7, sum.sum ());
+	sum.trim (10);
+	ASSERT_EQ (0, sum.size ());
+	ASSERT_EQ (0, sum.sum ());
+}
+
+TEST (telemetry, aggregator)
+{
+	auto now = std::chrono::steady_clock::now ();
+	nano::telemetry_aggregator aggregator (10s, 2);
+	std::vector<nano::telemetry_data> all_data;
+	for (auto i (0); i < 10; ++i)
+	{
+		nano::telemetry_data data;
+		data.account_count = i;
+		data.block_count = 10 + i;
+		data.cemented_count = 5 + i;
+		data.bandwidth_cap = i % 3 == 0 ? 0 : 1000;
+		data.uptime = 100 * i;
+		data.timestamp = std::chrono::system_clock::time_point (std::chrono::milliseconds (i));
+		aggregator.add (nano::endpoint (boost::asio::ip::address_v6::loopback (), 1000 + i), data, now);
+		all_data.push_back (data);
+	}
+	ASSERT_EQ (10, aggregator.size ());
+	ASSERT_EQ (nano::consolidate_telemetry_data (all_data), aggregator.consolidated (now));
+
+	// Only the latest sample of a peer contributes, older ones are kept as history
+	nano::endpoint endpoint (boost::asio::ip::address_v6::loopback (), 1000);
+	auto updated (all_data[0]);
+	updated.block_count = 1000;
+	aggregator.add (endpoint, updated, now);
+	all_data[0] = updated;
+	ASSERT_EQ (nano::consolidate_telemetry_data (all_data), aggregator.consolidated (now));
+
+	// Trimming follows the number of peers
+	for (auto i (10); i < 25; ++i)
+	{
+		nano::telemetry_data data;
+		data.account_count = 1000 - i;
+		data.block_count = i * i;
+		data.peer_count = i % 7;
+		data.bandwidth_cap = 1000;
+		data.active_difficulty = 1000 + i;
+		aggregator.add (nano::endpoint (boost::asio::ip::address_v6::loopback (), 1000 + i), data, now);
+		all_data.push_back (data);
+		ASSERT_EQ (nano::consolidate_telemetry_data (all_data), aggregator.consolidated (now));
+	}
+	for (auto i (24); i >= 10; --i)
+	{
+		aggregator.erase (nano::endpoint (boost::asio::ip::address_v6::loopback (), 1000 + i));
+		all_data.pop_back ();
+		ASSERT_EQ (nano::consolidate_telemetry_data (all_data), aggregator.consolidated (now));
+	}
+	updated.block_count = 2000;
+	aggregator.add (endpoint, updated, now);
+	auto history (aggregator.history (endpoint));
+	ASSERT_EQ (2, history.size ());
+	ASSERT_EQ (1000, history[0].block_count);
+	ASSERT_EQ (2000, history[1].block_count);
+
+	auto summaries (aggregator.summaries (now));
+	auto block_count = std::find_if (summaries.begin (), summaries.end (), [] (auto const & summary_a) { return summary_a.first == "block_count"; });
+	ASSERT_NE (summaries.end (), block_count);
+	ASSERT_EQ (10, block_count->second.samples);
+	auto bandwidth_cap = std::find_if (summaries.begin (), summaries.end (), [] (auto const & summary_a) { return summary_a.first == "bandwidth_cap"; });
+	ASSERT_NE (summaries.end (), bandwidth_cap);
+	// Unlimited (0) bandwidth caps are not sampled
+	ASSERT_EQ (6, bandwidth_cap->second.samples);
+
+	aggregator.erase (endpoint);
+	ASSERT_EQ (9, aggregator.size ());
+	ASSERT_TRUE (aggregator.history (endpoint).empty ());
+
+	// Everything expires once no new samples arrive
+	ASSERT_EQ (nano::telemetry_data{}, aggregator.consolidated (now + 11s));
+	ASSERT_EQ (0, aggregator.size ());
+}
+
 TEST (telemetry, signatures)
 {
 	nano::keypair node_id;
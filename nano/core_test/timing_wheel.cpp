@@ -0,0 +1,80 @@
+#include <nano/lib/threading.hpp>
+#include <nano/lib/timing_wheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace std::chrono_literals;
+
+TEST (timing_wheel, expiry)
+{
+	auto const start (std::chrono::steady_clock::now ());
+	nano::timing_wheel wheel (10ms, start);
+	std::vector<int> fired;
+	wheel.add (start, start + 25ms, [&fired] () { fired.push_back (1); });
+	wheel.add (start, start + 5ms, [&fired] () { fired.push_back (0); });
+	ASSERT_EQ (2, wheel.size ());
+	ASSERT_EQ (start + 10ms, wheel.next_wakeup ());
+	std::vector<nano::timing_wheel::callback_t> expired;
+	wheel.advance (start + 9ms, expired);
+	ASSERT_TRUE (expired.empty ());
+	wheel.advance (start + 10ms, expired);
+	ASSERT_EQ (1, expired.size ());
+	// Timers never expire early, only at the first tick after their deadline
+	wheel.advance (start + 29ms, expired);
+	ASSERT_EQ (1, expired.size ());
+	wheel.advance (start + 30ms, expired);
+	ASSERT_EQ (2, expired.size ());
+	for (auto & callback : expired)
+	{
+		callback ();
+	}
+	ASSERT_EQ ((std::vector<int>{ 0, 1 }), fired);
+	ASSERT_TRUE (wheel.empty ());
+	ASSERT_EQ (std::chrono::steady_clock::time_point::max (), wheel.next_wakeup ());
+}
+
+TEST (timing_wheel, cascade)
+{
+	auto const start (std::chrono::steady_clock::now ());
+	nano::timing_wheel wheel (1ms, start);
+	// Deadlines beyond one revolution of each wheel and beyond the coarsest wheel
+	std::vector<std::chrono::milliseconds> deadlines{ 300ms, 70000ms, 20000000ms, 5000ms };
+	std::vector<std::chrono::milliseconds> fired;
+	for (auto deadline : deadlines)
+	{
+		wheel.add (start, start + deadline, [&fired, deadline] () { fired.push_back (deadline); });
+	}
+	auto now (start);
+	std::vector<nano::timing_wheel::callback_t> expired;
+	while (!wheel.empty ())
+	{
+		auto const wakeup (wheel.next_wakeup ());
+		ASSERT_GT (wakeup, now);
+		now = wakeup;
+		wheel.advance (now, expired);
+		for (auto & callback : expired)
+		{
+			callback ();
+			ASSERT_EQ (start + fired.back (), now);
+		}
+		expired.clear ();
+	}
+	ASSERT_EQ ((std::vector<std::chrono::milliseconds>{ 300ms, 5000ms, 70000ms, 20000000ms }), fired);
+}
+
+TEST (thread_pool_alarm, delayed)
+{
+	nano::thread_pool workers (1u, nano::thread_role::name::unknown);
+	std::promise<std::chrono::steady_clock::time_point> promise;
+	auto const deadline (std::chrono::steady_clock::now () + 50ms);
+	workers.add_timed_task (deadline, [&promise] () {
+		promise.set_value (std::chrono::steady_clock::now ());
+	});
+	ASSERT_EQ (1, workers.num_timed_tasks ());
+	auto future (promise.get_future ());
+	ASSERT_EQ (std::future_status::ready, future.wait_for (5s));
+	ASSERT_GE (future.get (), deadline);
+	ASSERT_EQ (0, workers.num_timed_tasks ());
+}
@@ -104,8 +104,14 @@ TEST (toml, rpc_config_deserialize_defaults)
 	ASSERT_EQ (conf.rpc_process.ipc_address, defaults.rpc_process.ipc_address);
 	ASSERT_EQ (conf.rpc_process.ipc_port, defaults.rpc_process.ipc_port);
 	ASSERT_EQ (conf.rpc_process.num_ipc_connections, defaults.rpc_process.num_ipc_connections);
+	ASSERT_EQ (conf.rpc_process.io_timeout, defaults.rpc_process.io_timeout);
 
 	ASSERT_EQ (conf.rpc_logging.log_rpc, defaults.rpc_logging.log_rpc);
+
+	ASSERT_EQ (conf.http.keep_alive, defaults.http.keep_alive);
+	ASSERT_EQ (conf.http.keep_alive_timeout, defaults.http.keep_alive_timeout);
+	ASSERT_EQ (conf.http.max_requests_per_connection, defaults.http.max_requests_per_connection);
+	ASSERT_EQ (conf.http.max_concurrent_requests, defaults.http.max_concurrent_requests);
 }
 
 /** Empty config file should match a default config object */
@@ -124,6 +130,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	[node.websocket]
 	[node.lmdb]
 	[node.rocksdb]
+	[node.rpc_cache]
 	[opencl]
 	[rpc]
 	[rpc.child_process]
@@ -176,11 +183,15 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.receive_minimum, defaults.node.receive_minimum);
 	ASSERT_EQ (conf.node.signature_checker_threads, defaults.node.signature_checker_threads);
 	ASSERT_EQ (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
+	ASSERT_EQ (conf.node.peer_message_rate, defaults.node.peer_message_rate);
 	ASSERT_EQ (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
 	ASSERT_EQ (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
 	ASSERT_EQ (conf.node.use_memory_pools, defaults.node.use_memory_pools);
+	ASSERT_EQ (conf.node.udp_batched_io, defaults.node.udp_batched_io);
+	ASSERT_EQ (conf.node.read_transaction_max_age, defaults.node.read_transaction_max_age);
 	ASSERT_EQ (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_EQ (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
+	ASSERT_EQ (conf.node.vote_signing_threads, defaults.node.vote_signing_threads);
 	ASSERT_EQ (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_EQ (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
@@ -254,6 +265,11 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
 
+	ASSERT_EQ (conf.node.rpc_cache_config.enable, defaults.node.rpc_cache_config.enable);
+	ASSERT_EQ (conf.node.rpc_cache_config.max_size, defaults.node.rpc_cache_config.max_size);
+	ASSERT_EQ (conf.node.rpc_cache_config.ledger_ttl, defaults.node.rpc_cache_config.ledger_ttl);
+	ASSERT_EQ (conf.node.rpc_cache_config.network_ttl, defaults.node.rpc_cache_config.network_ttl);
+
 	ASSERT_EQ (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_EQ (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
 	ASSERT_EQ (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
@@ -413,11 +429,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	receive_minimum = "999"
 	signature_checker_threads = 999
 	tcp_incoming_connections_max = 999
+	peer_message_rate = 999
 	tcp_io_timeout = 999
 	unchecked_cutoff_time = 999
 	use_memory_pools = false
+	udp_batched_io = true
+	read_transaction_max_age = 999
 	vote_generator_delay = 999
 	vote_generator_threshold = 9
+	vote_signing_threads = 999
 	vote_minimum = "999"
 	work_peers = ["dev.org:999"]
 	work_threads = 999
@@ -509,6 +529,12 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	memory_multiplier = 3
 	io_threads = 99
 
+	[node.rpc_cache]
+	enable = true
+	max_size = 999
+	ledger_ttl = 999
+	network_ttl = 999
+
 	[node.experimental]
 	secondary_work_peers = ["dev.org:998"]
 	max_pruning_age = 999
@@ -579,11 +605,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.receive_minimum, defaults.node.receive_minimum);
 	ASSERT_NE (conf.node.signature_checker_threads, defaults.node.signature_checker_threads);
 	ASSERT_NE (conf.node.tcp_incoming_connections_max, defaults.node.tcp_incoming_connections_max);
+	ASSERT_NE (conf.node.peer_message_rate, defaults.node.peer_message_rate);
 	ASSERT_NE (conf.node.tcp_io_timeout, defaults.node.tcp_io_timeout);
 	ASSERT_NE (conf.node.unchecked_cutoff_time, defaults.node.unchecked_cutoff_time);
 	ASSERT_NE (conf.node.use_memory_pools, defaults.node.use_memory_pools);
+	ASSERT_NE (conf.node.udp_batched_io, defaults.node.udp_batched_io);
+	ASSERT_NE (conf.node.read_transaction_max_age, defaults.node.read_transaction_max_age);
 	ASSERT_NE (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_NE (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
+	ASSERT_NE (conf.node.vote_signing_threads, defaults.node.vote_signing_threads);
 	ASSERT_NE (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_NE (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
@@ -657,6 +687,11 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
 
+	ASSERT_NE (conf.node.rpc_cache_config.enable, defaults.node.rpc_cache_config.enable);
+	ASSERT_NE (conf.node.rpc_cache_config.max_size, defaults.node.rpc_cache_config.max_size);
+	ASSERT_NE (conf.node.rpc_cache_config.ledger_ttl, defaults.node.rpc_cache_config.ledger_ttl);
+	ASSERT_NE (conf.node.rpc_cache_config.network_ttl, defaults.node.rpc_cache_config.network_ttl);
+
 	ASSERT_TRUE (conf.node.rocksdb_config.enable);
 	ASSERT_EQ (nano::rocksdb_config::using_rocksdb_in_tests (), defaults.node.rocksdb_config.enable);
 	ASSERT_NE (conf.node.rocksdb_config.memory_multiplier, defaults.node.rocksdb_config.memory_multiplier);
@@ -711,8 +746,14 @@ TEST (toml, rpc_config_deserialize_no_defaults)
 	ipc_address = "0:0:0:0:0:ffff:7f01:101"
 	ipc_port = 999
 	num_ipc_connections = 999
+	io_timeout = 999
 	[logging]
 	log_rpc = false
+	[http]
+	keep_alive = true
+	keep_alive_timeout = 999
+	max_requests_per_connection = 999
+	max_concurrent_requests = 999
 	)toml";
 
 	nano::tomlconfig toml;
@@ -733,8 +774,14 @@ TEST (toml, rpc_config_deserialize_no_defaults)
 	ASSERT_NE (conf.rpc_process.ipc_address, defaults.rpc_process.ipc_address);
 	ASSERT_NE (conf.rpc_process.ipc_port, defaults.rpc_process.ipc_port);
 	ASSERT_NE (conf.rpc_process.num_ipc_connections, defaults.rpc_process.num_ipc_connections);
+	ASSERT_NE (conf.rpc_process.io_timeout, defaults.rpc_process.io_timeout);
 
 	ASSERT_NE (conf.rpc_logging.log_rpc, defaults.rpc_logging.log_rpc);
+
+	ASSERT_NE (conf.http.keep_alive, defaults.http.keep_alive);
+	ASSERT_NE (conf.http.keep_alive_timeout, defaults.http.keep_alive_timeout);
+	ASSERT_NE (conf.http.max_requests_per_connection, defaults.http.max_requests_per_connection);
+	ASSERT_NE (conf.http.max_concurrent_requests, defaults.http.max_concurrent_requests);
 }
 
 /** There should be no required values **/
@@ -748,6 +795,7 @@ TEST (toml, rpc_config_no_required)
 	[process]
 	[logging]
 	[secure]
+	[http]
 	)toml";
 
 	nano::tomlconfig toml;
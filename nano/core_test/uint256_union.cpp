@@ -157,6 +157,27 @@ TEST (uint128_union, decode_decimal)
 	ASSERT_EQ (1230 * nano::Gxrb_ratio, amount.number ());
 }
 
+TEST (uint128_union, decode_decimal_leading_zero_fraction)
+{
+	// Fractions starting with zeros are decimal, not octal
+	nano::amount amount;
+	ASSERT_FALSE (amount.decode_dec ("1.08", nano::Mxrb_ratio));
+	ASSERT_EQ (nano::Mxrb_ratio + 8 * nano::Mxrb_ratio / 100, amount.number ());
+	ASSERT_FALSE (amount.decode_dec ("1.010", nano::Mxrb_ratio));
+	ASSERT_EQ (nano::Mxrb_ratio + nano::Mxrb_ratio / 100, amount.number ());
+}
+
+TEST (uint128_union, encode_dec_buffer)
+{
+	std::array<char, nano::uint128_union::dec_size_max> buffer;
+	nano::amount max (std::numeric_limits<nano::uint128_t>::max ());
+	ASSERT_EQ ("340282366920938463463374607431768211455", std::string (buffer.data (), max.encode_dec (buffer.data ())));
+	ASSERT_EQ ("0", std::string (buffer.data (), nano::amount (0).encode_dec (buffer.data ())));
+	// Chunks below the most significant one keep their zeros
+	ASSERT_EQ ("1000000000000000000", std::string (buffer.data (), nano::amount (1000000000000000000ULL).encode_dec (buffer.data ())));
+	ASSERT_EQ ("1000000000000000000000000000000", nano::amount (nano::Mxrb_ratio).to_string_dec ());
+}
+
 TEST (unions, identity)
 {
 	ASSERT_EQ (1, nano::uint128_union (1).number ().convert_to<uint8_t> ());
@@ -426,6 +447,24 @@ TEST (uint256_union, account_encode_lex)
 	}
 }
 
+TEST (uint256_union, encode_buffers)
+{
+	nano::account account (1);
+	std::array<char, nano::account::hex_size> hex;
+	account.encode_hex (hex.data ());
+	ASSERT_EQ (std::string (63, '0') + "1", std::string (hex.data (), hex.size ()));
+	std::array<char, nano::account::account_size> address;
+	account.encode_account (address.data ());
+	ASSERT_EQ (account.to_account (), std::string (address.data (), address.size ()));
+	ASSERT_EQ ("nano_1111111111111111111111111111111111111111111111111113b8661hfk", account.to_account ());
+	nano::signature signature;
+	signature.qwords.fill (~0ULL);
+	ASSERT_EQ (std::string (128, 'F'), signature.to_string ());
+	nano::signature decoded;
+	ASSERT_FALSE (decoded.decode_hex (std::string (128, 'f')));
+	ASSERT_EQ (signature, decoded);
+}
+
 TEST (uint256_union, bounds)
 {
 	nano::account key;
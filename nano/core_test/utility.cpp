@@ -98,6 +98,21 @@ TEST (rate, unlimited)
 	ASSERT_EQ (bucket.largest_burst (), static_cast<size_t> (1e9));
 }
 
+TEST (rate, consume_many)
+{
+	nano::rate::token_bucket bucket (10, 1);
+
+	// Only whole operations are granted
+	ASSERT_EQ (3, bucket.try_consume_many (3, 5));
+	ASSERT_EQ (0, bucket.try_consume_many (3, 5));
+	ASSERT_TRUE (bucket.try_consume (1));
+	ASSERT_FALSE (bucket.try_consume (1));
+
+	// Unlimited buckets grant everything
+	bucket.reset (0, 0);
+	ASSERT_EQ (100, bucket.try_consume_many (1000000, 100));
+}
+
 TEST (optional_ptr, basic)
 {
 	struct valtype
@@ -104,6 +104,39 @@ TEST (vote_generator, multiple_representatives)
 	}
 }
 
+// Votes for several representatives are signed on the signing pool
+TEST (vote_generator, parallel_signing)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.vote_signing_threads = 2;
+	auto & node (*system.add_node (node_config));
+	nano::keypair key1, key2;
+	auto & wallet (*system.wallet (0));
+	wallet.insert_adhoc (nano::dev_genesis_key.prv);
+	wallet.insert_adhoc (key1.prv);
+	wallet.insert_adhoc (key2.prv);
+	auto const amount = 100 * nano::Gxrb_ratio;
+	wallet.send_sync (nano::dev_genesis_key.pub, key1.pub, amount);
+	wallet.send_sync (nano::dev_genesis_key.pub, key2.pub, amount);
+	ASSERT_TIMELY (3s, node.balance (key1.pub) == amount && node.balance (key2.pub) == amount);
+	wallet.change_sync (key1.pub, key1.pub);
+	wallet.change_sync (key2.pub, key2.pub);
+	node.wallets.compute_reps ();
+	ASSERT_EQ (3, node.wallets.reps ().voting);
+	auto const signed_before (node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_votes_signed));
+	auto hash = wallet.send_sync (nano::dev_genesis_key.pub, nano::dev_genesis_key.pub, 1);
+	auto send = node.block (hash);
+	ASSERT_NE (nullptr, send);
+	ASSERT_TIMELY (5s, node.history.votes (send->root (), send->hash ()).size () == 3);
+	for (auto const & vote : node.history.votes (send->root (), send->hash ()))
+	{
+		ASSERT_FALSE (vote->validate ());
+		ASSERT_EQ (1, vote->blocks.size ());
+	}
+	ASSERT_LE (signed_before + 3, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_votes_signed));
+}
+
 TEST (vote_generator, session)
 {
 	nano::system system (1);
@@ -0,0 +1,139 @@
+#include <nano/crypto/blake2/blake2.h>
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+/** The multiprecision and stream based codecs the table driven ones replaced */
+namespace reference
+{
+	template <typename Number>
+	std::string encode_hex (Number const & number_a, int width_a)
+	{
+		std::stringstream stream;
+		stream << std::hex << std::uppercase << std::noshowbase << std::setw (width_a) << std::setfill ('0');
+		stream << number_a;
+		return stream.str ();
+	}
+
+	template <typename Number>
+	bool decode_hex (std::string const & text_a, Number & number_a)
+	{
+		auto error (false);
+		std::stringstream stream (text_a);
+		stream << std::hex << std::noshowbase;
+		try
+		{
+			stream >> number_a;
+			error = !stream.eof ();
+		}
+		catch (std::runtime_error &)
+		{
+			error = true;
+		}
+		return error;
+	}
+
+	bool decode_dec (std::string const & text_a, nano::uint128_t & number_a)
+	{
+		auto error (false);
+		std::stringstream stream (text_a);
+		stream << std::dec << std::noshowbase;
+		boost::multiprecision::checked_uint128_t number_l;
+		try
+		{
+			stream >> number_l;
+			number_a = number_l;
+			error = !stream.eof ();
+		}
+		catch (std::runtime_error &)
+		{
+			error = true;
+		}
+		return error;
+	}
+
+	std::string encode_account (nano::public_key const & key_a)
+	{
+		std::string result;
+		uint64_t check (0);
+		blake2b_state hash;
+		blake2b_init (&hash, 5);
+		blake2b_update (&hash, key_a.bytes.data (), key_a.bytes.size ());
+		blake2b_final (&hash, reinterpret_cast<uint8_t *> (&check), 5);
+		nano::uint512_t number_l (key_a.number ());
+		number_l <<= 40;
+		number_l |= nano::uint512_t (check);
+		for (auto i (0); i < 60; ++i)
+		{
+			result.push_back ("13456789abcdefghijkmnopqrstuwxyz"[static_cast<uint8_t> (number_l & 0x1f)]);
+			number_l >>= 5;
+		}
+		result.append ("_onan");
+		std::reverse (result.begin (), result.end ());
+		return result;
+	}
+}
+
+bool is_digits (std::string const & text_a, bool hex_a)
+{
+	return !text_a.empty () && std::all_of (text_a.begin (), text_a.end (), [hex_a] (char c) { return hex_a ? std::isxdigit (static_cast<unsigned char> (c)) : std::isdigit (static_cast<unsigned char> (c)); });
+}
+
+/** Compare the table driven codecs with the reference ones */
+void fuzz_codecs (const uint8_t * Data, size_t Size)
+{
+	auto data (std::string (reinterpret_cast<char const *> (Data), Size));
+	// Encoders, on the bytes of the input
+	if (Size >= 32)
+	{
+		nano::public_key key;
+		std::copy (Data, Data + 32, key.bytes.begin ());
+		release_assert (key.to_string () == reference::encode_hex (key.number (), 64));
+		auto const account (key.to_account ());
+		release_assert (account == reference::encode_account (key));
+		nano::public_key decoded;
+		release_assert (!decoded.decode_account (account) && decoded == key);
+	}
+	if (Size >= 16)
+	{
+		nano::uint128_union value;
+		std::copy (Data, Data + 16, value.bytes.begin ());
+		release_assert (value.to_string () == reference::encode_hex (value.number (), 32));
+		release_assert (value.to_string_dec () == value.number ().convert_to<std::string> ());
+	}
+	// Decoders, on the input as text. Digit strings take the fast paths, anything else the reference parsers themselves
+	if (is_digits (data, true) && data.size () <= 64)
+	{
+		nano::uint256_union value;
+		nano::uint256_t expected;
+		release_assert (!value.decode_hex (data) && !reference::decode_hex (data, expected) && value.number () == expected);
+	}
+	if (is_digits (data, false) && data.size () <= 39 && (data.size () == 1 || data.front () != '0'))
+	{
+		nano::uint128_union value;
+		nano::uint128_t expected;
+		auto const error (value.decode_dec (data));
+		release_assert (error == reference::decode_dec (data, expected));
+		release_assert (error || value.number () == expected);
+	}
+	nano::public_key key;
+	if (!key.decode_account (data))
+	{
+		// Node ids are the only addresses accepted with lengths other than 64 and 65 characters
+		release_assert (data.size () != 65 || reference::encode_account (key).substr (5) == data.substr (5));
+	}
+}
+}
+
+/** Fuzzer entry point */
+extern "C" int LLVMFuzzerTestOneInput (const uint8_t * Data, size_t Size)
+{
+	fuzz_codecs (Data, Size);
+	return 0;
+}
@@ -33,3 +33,10 @@ std::shared_ptr<flatbuffers::FlatBufferBuilder> nano::ipc::flatbuffer_producer::
 {
 	return fbb;
 }
+
+std::shared_ptr<flatbuffers::FlatBufferBuilder> nano::ipc::flatbuffer_producer::take_shared_flatbuffer ()
+{
+	auto result (fbb);
+	fbb = std::make_shared<flatbuffers::FlatBufferBuilder> ();
+	return result;
+}
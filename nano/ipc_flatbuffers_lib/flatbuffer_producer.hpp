@@ -78,6 +78,8 @@ namespace ipc
 		void set_credentials (std::string const & credentials_a);
 		/** Returns the flatbuffer */
 		std::shared_ptr<flatbuffers::FlatBufferBuilder> get_shared_flatbuffer () const;
+		/** Returns the flatbuffer and continues with an empty one. This is used to produce a response in several chunks. */
+		std::shared_ptr<flatbuffers::FlatBufferBuilder> take_shared_flatbuffer ();
 
 	private:
 		/** The builder managed by this instance */
@@ -0,0 +1,515 @@
+#include <nano/lib/config.hpp>
+#include <nano/lib/threading.hpp>
+#include <nano/node/active_transactions.hpp>
+#include <nano/node/confirmation_height_processor.hpp>
+#include <nano/node/node.hpp>
+#include <nano/secure/buffer.hpp>
+#include <nano/secure/utility.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+/** Role of a block inside a generated workload */
+enum class workload_entry_type : uint8_t
+{
+	/** Expected to be confirmed and cemented */
+	normal = 0,
+	/** Competes with an already published block for the same root and is expected to lose */
+	fork = 1
+};
+
+class workload_entry final
+{
+public:
+	workload_entry_type type;
+	std::shared_ptr<nano::block> block;
+};
+
+/**
+ * A ledger-shaped workload in delivery order. Block hashes only depend on the generation parameters and seed, the proof of
+ * work is generated anew with each generation. Saved workloads keep their proof of work and replay it when loaded.
+ */
+class workload final
+{
+public:
+	std::vector<workload_entry> entries;
+	uint64_t accounts{ 0 };
+	uint64_t chain_length{ 0 };
+	uint64_t forks{ 0 };
+	uint64_t gaps{ 0 };
+	uint64_t seed{ 0 };
+
+	uint64_t expected_cemented () const
+	{
+		return entries.size () - forks;
+	}
+
+	/** Serialized size of all blocks, used as the denominator of the write amplification */
+	uint64_t logical_bytes () const
+	{
+		uint64_t result (0);
+		for (auto const & entry : entries)
+		{
+			result += nano::block::size (entry.block->type ());
+		}
+		return result;
+	}
+
+	void save (boost::filesystem::path const & path_a) const
+	{
+		std::vector<uint8_t> bytes;
+		{
+			nano::vectorstream stream (bytes);
+			nano::write (stream, accounts);
+			nano::write (stream, chain_length);
+			nano::write (stream, forks);
+			nano::write (stream, gaps);
+			nano::write (stream, seed);
+			nano::write (stream, static_cast<uint64_t> (entries.size ()));
+			for (auto const & entry : entries)
+			{
+				nano::write (stream, entry.type);
+				nano::serialize_block (stream, *entry.block);
+			}
+		}
+		std::ofstream file (path_a.string (), std::ios::binary | std::ios::trunc);
+		file.write (reinterpret_cast<char const *> (bytes.data ()), bytes.size ());
+	}
+
+	/** Returns true on error */
+	bool load (boost::filesystem::path const & path_a)
+	{
+		std::ifstream file (path_a.string (), std::ios::binary);
+		std::vector<uint8_t> bytes ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char> ());
+		nano::bufferstream stream (bytes.data (), bytes.size ());
+		uint64_t count (0);
+		auto error (nano::try_read (stream, accounts) || nano::try_read (stream, chain_length) || nano::try_read (stream, forks) || nano::try_read (stream, gaps) || nano::try_read (stream, seed) || nano::try_read (stream, count));
+		for (uint64_t i (0); !error && i < count; ++i)
+		{
+			workload_entry entry;
+			error = nano::try_read (stream, entry.type);
+			if (!error)
+			{
+				entry.block = nano::deserialize_block (stream);
+				error = entry.block == nullptr;
+			}
+			if (!error)
+			{
+				entries.push_back (std::move (entry));
+			}
+		}
+		return error;
+	}
+};
+
+/**
+ * Builds \p accounts_a accounts funded by the dev genesis, then \p chain_length_a rounds of send/receive pairs between them.
+ * \p forks_a sends get a competing send published right after them and \p gaps_a dependent blocks are delivered before their dependency.
+ */
+workload generate_workload (nano::work_pool & pool_a, uint64_t accounts_a, uint64_t chain_length_a, uint64_t forks_a, uint64_t gaps_a, uint64_t seed_a)
+{
+	nano::network_params network_params;
+	auto const & genesis_key (network_params.ledger.dev_genesis_key);
+	auto const difficulty (network_params.network.publish_thresholds.epoch_1);
+	nano::block_builder builder;
+	std::mt19937_64 rng (seed_a);
+	nano::raw_key seed (seed_a);
+
+	workload result;
+	result.accounts = accounts_a;
+	result.chain_length = chain_length_a;
+	result.seed = seed_a;
+
+	std::vector<nano::keypair> keys;
+	std::unordered_map<nano::account, size_t> key_index;
+	keys.reserve (accounts_a);
+	for (uint64_t i (0); i < accounts_a; ++i)
+	{
+		keys.emplace_back (nano::deterministic_key (seed, static_cast<uint32_t> (i)));
+		key_index.emplace (keys.back ().pub, i);
+	}
+	std::vector<nano::block_hash> frontiers (accounts_a);
+	std::vector<nano::uint128_t> balances (accounts_a, nano::Gxrb_ratio);
+	std::vector<std::shared_ptr<nano::block>> sends;
+
+	nano::block_hash genesis_latest (network_params.ledger.genesis_hash);
+	nano::uint128_t genesis_balance (network_params.ledger.genesis_amount);
+	for (uint64_t i (0); i < accounts_a; ++i)
+	{
+		genesis_balance -= nano::Gxrb_ratio;
+		auto send = builder.state ()
+					.account (genesis_key.pub)
+					.previous (genesis_latest)
+					.representative (genesis_key.pub)
+					.balance (genesis_balance)
+					.link (keys[i].pub)
+					.sign (genesis_key.prv, genesis_key.pub)
+					.work (*pool_a.generate (nano::work_version::work_1, genesis_latest, difficulty))
+					.build_shared ();
+		genesis_latest = send->hash ();
+		result.entries.push_back ({ workload_entry_type::normal, send });
+		auto open = builder.state ()
+					.account (keys[i].pub)
+					.previous (0)
+					.representative (genesis_key.pub)
+					.balance (balances[i])
+					.link (genesis_latest)
+					.sign (keys[i].prv, keys[i].pub)
+					.work (*pool_a.generate (nano::work_version::work_1, keys[i].pub, difficulty))
+					.build_shared ();
+		frontiers[i] = open->hash ();
+		result.entries.push_back ({ workload_entry_type::normal, open });
+	}
+	for (uint64_t round (0); round < chain_length_a; ++round)
+	{
+		for (uint64_t j (0); j < accounts_a; ++j)
+		{
+			auto other ((j + 1 + rng () % std::max<uint64_t> (accounts_a - 1, 1)) % accounts_a);
+			balances[j] -= 1;
+			auto send = builder.state ()
+						.account (keys[j].pub)
+						.previous (frontiers[j])
+						.representative (genesis_key.pub)
+						.balance (balances[j])
+						.link (keys[other].pub)
+						.sign (keys[j].prv, keys[j].pub)
+						.work (*pool_a.generate (nano::work_version::work_1, frontiers[j], difficulty))
+						.build_shared ();
+			frontiers[j] = send->hash ();
+			result.entries.push_back ({ workload_entry_type::normal, send });
+			sends.push_back (send);
+			balances[other] += 1;
+			auto receive = builder.state ()
+						   .account (keys[other].pub)
+						   .previous (frontiers[other])
+						   .representative (genesis_key.pub)
+						   .balance (balances[other])
+						   .link (send->hash ())
+						   .sign (keys[other].prv, keys[other].pub)
+						   .work (*pool_a.generate (nano::work_version::work_1, frontiers[other], difficulty))
+						   .build_shared ();
+			frontiers[other] = receive->hash ();
+			result.entries.push_back ({ workload_entry_type::normal, receive });
+		}
+	}
+	// Delay a dependency behind the block depending on it so the dependent goes through the unchecked table
+	for (uint64_t i (0); i < gaps_a && result.entries.size () > 1; ++i)
+	{
+		auto index (rng () % (result.entries.size () - 1));
+		std::swap (result.entries[index], result.entries[index + 1]);
+		++result.gaps;
+	}
+	// Competing sends to a burn destination, inserted after the block they fork so the original wins
+	std::shuffle (sends.begin (), sends.end (), rng);
+	std::unordered_map<nano::block_hash, std::shared_ptr<nano::block>> fork_of;
+	for (uint64_t i (0); i < forks_a && i < sends.size (); ++i)
+	{
+		auto const & original (*sends[i]);
+		auto fork = builder.state ()
+					.account (original.account ())
+					.previous (original.previous ())
+					.representative (genesis_key.pub)
+					.balance (original.balance ().number () - 1)
+					.link (nano::account (0))
+					.sign (keys[key_index[original.account ()]].prv, original.account ())
+					.work (*pool_a.generate (nano::work_version::work_1, original.previous (), difficulty))
+					.build_shared ();
+		fork_of.emplace (original.hash (), fork);
+	}
+	std::vector<workload_entry> ordered;
+	ordered.reserve (result.entries.size () + fork_of.size ());
+	for (auto & entry : result.entries)
+	{
+		ordered.push_back (entry);
+		auto existing (fork_of.find (entry.block->hash ()));
+		if (existing != fork_of.end ())
+		{
+			ordered.push_back ({ workload_entry_type::fork, existing->second });
+			++result.forks;
+		}
+	}
+	result.entries.swap (ordered);
+	return result;
+}
+
+/** Bytes the process caused to be sent to the storage layer, 0 where unsupported */
+uint64_t storage_write_bytes ()
+{
+	uint64_t result (0);
+	std::ifstream io ("/proc/self/io");
+	std::string key;
+	uint64_t value;
+	while (io >> key >> value)
+	{
+		if (key == "write_bytes:")
+		{
+			result = value;
+		}
+	}
+	return result;
+}
+
+uint64_t directory_size (boost::filesystem::path const & path_a)
+{
+	uint64_t result (0);
+	boost::system::error_code ec;
+	for (boost::filesystem::recursive_directory_iterator i (path_a, ec), n; !ec && i != n; i.increment (ec))
+	{
+		if (boost::filesystem::is_regular_file (i->path ()))
+		{
+			result += boost::filesystem::file_size (i->path (), ec);
+		}
+	}
+	return result;
+}
+
+uint64_t percentile (std::vector<uint64_t> const & sorted_a, double percentile_a)
+{
+	uint64_t result (0);
+	if (!sorted_a.empty ())
+	{
+		auto index (static_cast<size_t> (percentile_a * (sorted_a.size () - 1)));
+		result = sorted_a[index];
+	}
+	return result;
+}
+
+/** Replays \p workload_a through a fresh node using the given backend and returns the measurements */
+boost::property_tree::ptree run (workload const & workload_a, nano::work_pool & pool_a, bool rocksdb_a, std::chrono::seconds timeout_a)
+{
+	nano::network_params network_params;
+	auto path (nano::unique_path ());
+	boost::asio::io_context io_ctx;
+	nano::logging logging;
+	logging.init (path);
+	nano::node_config config (24000, logging);
+	config.enable_voting = true;
+	config.frontiers_confirmation = nano::frontiers_confirmation_mode::disabled;
+	config.rocksdb_config.enable = rocksdb_a;
+	nano::node_flags flags;
+	flags.disable_bootstrap_listener = true;
+	flags.disable_tcp_realtime = true;
+	flags.disable_rep_crawler = true;
+	flags.disable_ongoing_bootstrap = true;
+	flags.disable_legacy_bootstrap = true;
+	flags.disable_lazy_bootstrap = true;
+	flags.disable_wallet_bootstrap = true;
+	flags.disable_ongoing_telemetry_requests = true;
+	flags.disable_initial_telemetry_requests = true;
+	auto node (std::make_shared<nano::node> (io_ctx, path, config, pool_a, flags));
+	boost::property_tree::ptree result;
+	result.put ("backend", rocksdb_a ? "rocksdb" : "lmdb");
+	if (node->init_error ())
+	{
+		result.put ("error", "node initialization failed");
+		return result;
+	}
+	node->start ();
+	nano::thread_runner runner (io_ctx, config.io_threads);
+	node->wallets.create (nano::random_wallet_id ())->insert_adhoc (network_params.ledger.dev_genesis_key.prv);
+
+	nano::mutex mutex;
+	std::unordered_map<nano::block_hash, std::chrono::steady_clock::time_point> inserted;
+	std::vector<uint64_t> latencies;
+	latencies.reserve (workload_a.expected_cemented ());
+	node->confirmation_height_processor.add_cemented_observer ([&mutex, &inserted, &latencies] (std::shared_ptr<nano::block> const & block_a) {
+		auto now (std::chrono::steady_clock::now ());
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto existing (inserted.find (block_a->hash ()));
+		if (existing != inserted.end ())
+		{
+			latencies.push_back (std::chrono::duration_cast<std::chrono::microseconds> (now - existing->second).count ());
+			inserted.erase (existing);
+		}
+	});
+
+	auto const initial_blocks (node->ledger.cache.block_count.load ());
+	auto const initial_cemented (node->ledger.cache.cemented_count.load ());
+	auto const write_bytes_begin (storage_write_bytes ());
+	auto const begin (std::chrono::steady_clock::now ());
+	auto const deadline (begin + timeout_a);
+	uint64_t submitted (0);
+	for (auto i (workload_a.entries.begin ()), n (workload_a.entries.end ()); i != n && std::chrono::steady_clock::now () < deadline; ++i)
+	{
+		// Back off instead of dropping blocks when the processor queue is full
+		while (node->block_processor.full () && std::chrono::steady_clock::now () < deadline)
+		{
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+		}
+		if (!node->block_processor.full ())
+		{
+			if (i->type == workload_entry_type::normal)
+			{
+				nano::lock_guard<nano::mutex> guard (mutex);
+				inserted.emplace (i->block->hash (), std::chrono::steady_clock::now ());
+			}
+			node->process_active (i->block);
+			++submitted;
+		}
+	}
+	auto processed_end (begin);
+	auto done = [&node, &workload_a, initial_blocks] () { return node->ledger.cache.block_count - initial_blocks >= workload_a.expected_cemented (); };
+	while (!done () && std::chrono::steady_clock::now () < deadline)
+	{
+		std::this_thread::sleep_for (std::chrono::milliseconds (1));
+	}
+	processed_end = std::chrono::steady_clock::now ();
+	while (node->ledger.cache.cemented_count - initial_cemented < workload_a.expected_cemented () && std::chrono::steady_clock::now () < deadline)
+	{
+		std::this_thread::sleep_for (std::chrono::milliseconds (1));
+	}
+	auto const cemented_end (std::chrono::steady_clock::now ());
+	auto const processed (node->ledger.cache.block_count - initial_blocks);
+	auto const cemented (node->ledger.cache.cemented_count - initial_cemented);
+	node->stop ();
+	runner.stop_event_processing ();
+	runner.join ();
+	auto const write_bytes (storage_write_bytes () - write_bytes_begin);
+	auto const logical_bytes (workload_a.logical_bytes ());
+
+	auto seconds = [begin] (std::chrono::steady_clock::time_point end_a) {
+		return std::max (std::chrono::duration<double> (end_a - begin).count (), std::numeric_limits<double>::epsilon ());
+	};
+	result.put ("timed_out", cemented < workload_a.expected_cemented ());
+	result.put ("blocks_submitted", submitted);
+	result.put ("blocks_processed", processed);
+	result.put ("blocks_cemented", cemented);
+	result.put ("processing_seconds", seconds (processed_end));
+	result.put ("cementing_seconds", seconds (cemented_end));
+	result.put ("blocks_per_second", processed / seconds (processed_end));
+	result.put ("cemented_per_second", cemented / seconds (cemented_end));
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		std::sort (latencies.begin (), latencies.end ());
+		boost::property_tree::ptree latency;
+		latency.put ("samples", latencies.size ());
+		latency.put ("p50", percentile (latencies, 0.50));
+		latency.put ("p99", percentile (latencies, 0.99));
+		latency.put ("max", latencies.empty () ? 0 : latencies.back ());
+		result.add_child ("insertion_to_cementing_latency_us", latency);
+	}
+	result.put ("logical_bytes", logical_bytes);
+	result.put ("storage_write_bytes", write_bytes);
+	result.put ("write_amplification", logical_bytes == 0 ? 0.0 : static_cast<double> (write_bytes) / logical_bytes);
+	result.put ("database_bytes", directory_size (path));
+	node.reset ();
+	boost::system::error_code ec;
+	boost::filesystem::remove_all (path, ec);
+	return result;
+}
+}
+
+/** Replays a deterministic ledger workload through the block processor, active elections and confirmation height processor of an in-process node and reports the results as JSON */
+int main (int argc, char * const * argv)
+{
+	nano::force_nano_dev_network ();
+
+	boost::program_options::options_description description ("Command line options");
+
+	// clang-format off
+	description.add_options ()
+		("help", "Print out options")
+		("accounts", boost::program_options::value<uint64_t> ()->default_value (1000), "Number of accounts opened from the genesis account")
+		("chain_length", boost::program_options::value<uint64_t> ()->default_value (10), "Number of send/receive rounds between accounts")
+		("forks", boost::program_options::value<uint64_t> ()->default_value (100), "Number of sends which get a competing fork published after them")
+		("gaps", boost::program_options::value<uint64_t> ()->default_value (100), "Number of blocks delivered before the block they depend on")
+		("seed", boost::program_options::value<uint64_t> ()->default_value (0), "Seed for the account keys and workload shape")
+		("backend", boost::program_options::value<std::string> ()->default_value ("both"), "Ledger backend to replay against: lmdb, rocksdb or both")
+		("timeout", boost::program_options::value<uint64_t> ()->default_value (600), "Seconds to wait for the workload to be submitted and cemented")
+		("load_workload", boost::program_options::value<std::string> (), "Replay a workload previously written with --save_workload instead of generating one")
+		("save_workload", boost::program_options::value<std::string> (), "Write the generated workload to this file")
+		("output", boost::program_options::value<std::string> (), "Write the JSON report to this file instead of stdout");
+	// clang-format on
+
+	boost::program_options::variables_map vm;
+	try
+	{
+		boost::program_options::store (boost::program_options::parse_command_line (argc, argv, description), vm);
+	}
+	catch (boost::program_options::error const & err)
+	{
+		std::cerr << err.what () << std::endl;
+		return 1;
+	}
+	boost::program_options::notify (vm);
+	if (vm.count ("help"))
+	{
+		std::cout << description << std::endl;
+		return 0;
+	}
+
+	auto backend (vm["backend"].as<std::string> ());
+	if (backend != "lmdb" && backend != "rocksdb" && backend != "both")
+	{
+		std::cerr << "Invalid backend: " << backend << std::endl;
+		return 1;
+	}
+
+	nano::work_pool pool (std::numeric_limits<unsigned>::max ());
+	workload workload_l;
+	auto load_it (vm.find ("load_workload"));
+	if (load_it != vm.end ())
+	{
+		if (workload_l.load (load_it->second.as<std::string> ()))
+		{
+			std::cerr << "Could not load workload from " << load_it->second.as<std::string> () << std::endl;
+			return 1;
+		}
+	}
+	else
+	{
+		std::cerr << "Generating workload..." << std::endl;
+		workload_l = generate_workload (pool, vm["accounts"].as<uint64_t> (), vm["chain_length"].as<uint64_t> (), vm["forks"].as<uint64_t> (), vm["gaps"].as<uint64_t> (), vm["seed"].as<uint64_t> ());
+	}
+	auto save_it (vm.find ("save_workload"));
+	if (save_it != vm.end ())
+	{
+		workload_l.save (save_it->second.as<std::string> ());
+	}
+
+	boost::property_tree::ptree report;
+	boost::property_tree::ptree workload_tree;
+	workload_tree.put ("accounts", workload_l.accounts);
+	workload_tree.put ("chain_length", workload_l.chain_length);
+	workload_tree.put ("forks", workload_l.forks);
+	workload_tree.put ("gaps", workload_l.gaps);
+	workload_tree.put ("seed", workload_l.seed);
+	workload_tree.put ("blocks", workload_l.entries.size ());
+	report.add_child ("workload", workload_tree);
+	report.put ("version", NANO_VERSION_STRING);
+
+	std::chrono::seconds timeout (vm["timeout"].as<uint64_t> ());
+	boost::property_tree::ptree results;
+	if (backend != "rocksdb")
+	{
+		std::cerr << "Replaying against LMDB..." << std::endl;
+		results.push_back (std::make_pair ("", run (workload_l, pool, false, timeout)));
+	}
+	if (backend != "lmdb")
+	{
+		std::cerr << "Replaying against RocksDB..." << std::endl;
+		results.push_back (std::make_pair ("", run (workload_l, pool, true, timeout)));
+	}
+	report.add_child ("results", results);
+
+	auto output_it (vm.find ("output"));
+	if (output_it != vm.end ())
+	{
+		std::ofstream output (output_it->second.as<std::string> ());
+		boost::property_tree::write_json (output, report);
+	}
+	else
+	{
+		boost::property_tree::write_json (std::cout, report);
+	}
+	return 0;
+}
@@ -43,3 +43,18 @@ size_t nano::shared_const_buffer::size () const
 {
 	return m_buffer.size ();
 }
+
+char const * nano::io_backend ()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+	return "io_uring";
+#elif defined(BOOST_ASIO_HAS_IOCP)
+	return "iocp";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+	return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+	return "kqueue";
+#else
+	return "select";
+#endif
+}
@@ -28,6 +28,9 @@ private:
 
 static_assert (boost::asio::is_const_buffer_sequence<shared_const_buffer>::value, "Not ConstBufferSequence compliant");
 
+/** Name of the reactor asio performs socket I/O with, selected at build time (NANO_IO_URING for io_uring) */
+char const * io_backend ();
+
 template <typename AsyncWriteStream, typename WriteHandler>
 BOOST_ASIO_INITFN_RESULT_TYPE (WriteHandler, void (boost::system::error_code, std::size_t))
 async_write (AsyncWriteStream & s, nano::shared_const_buffer const & buffer, WriteHandler && handler)
@@ -25,7 +25,16 @@ template <typename block>
 std::shared_ptr<block> deserialize_block (nano::stream & stream_a)
 {
 	auto error (false);
-	auto result = nano::make_shared<block> (error, stream_a);
+	// State blocks make up nearly all realtime traffic, allocate them from the thread cached pool
+	std::shared_ptr<block> result;
+	if constexpr (std::is_same<block, nano::state_block>::value)
+	{
+		result = nano::make_pooled<block> (error, stream_a);
+	}
+	else
+	{
+		result = nano::make_shared<block> (error, stream_a);
+	}
 	if (error)
 	{
 		result = nullptr;
@@ -2,16 +2,23 @@
 #include <nano/lib/utility.hpp>
 
 nano::ipc::socket_base::socket_base (boost::asio::io_context & io_ctx_a) :
-	io_timer (io_ctx_a)
+	read_timer (io_ctx_a),
+	write_timer (io_ctx_a)
 {
 }
 
-void nano::ipc::socket_base::timer_start (std::chrono::seconds timeout_a)
+boost::asio::deadline_timer & nano::ipc::socket_base::io_timer (io_direction direction_a)
+{
+	return direction_a == io_direction::read ? read_timer : write_timer;
+}
+
+void nano::ipc::socket_base::timer_start (std::chrono::seconds timeout_a, io_direction direction_a)
 {
 	if (timeout_a < std::chrono::seconds::max ())
 	{
-		io_timer.expires_from_now (boost::posix_time::seconds (static_cast<long> (timeout_a.count ())));
-		io_timer.async_wait ([this] (const boost::system::error_code & ec) {
+		auto & timer (io_timer (direction_a));
+		timer.expires_from_now (boost::posix_time::seconds (static_cast<long> (timeout_a.count ())));
+		timer.async_wait ([this] (const boost::system::error_code & ec) {
 			if (!ec)
 			{
 				this->timer_expired ();
@@ -25,10 +32,10 @@ void nano::ipc::socket_base::timer_expired ()
 	close ();
 }
 
-void nano::ipc::socket_base::timer_cancel ()
+void nano::ipc::socket_base::timer_cancel (io_direction direction_a)
 {
 	boost::system::error_code ec;
-	io_timer.cancel (ec);
+	io_timer (direction_a).cancel (ec);
 	debug_assert (!ec);
 }
 
@@ -35,17 +35,26 @@ namespace ipc
 		/** Close socket */
 		virtual void close () = 0;
 
+		/** Reads and writes may be in progress at the same time, each direction has its own deadline */
+		enum class io_direction
+		{
+			read,
+			write
+		};
+
 		/**
-		 * Start IO timer.
+		 * Start the IO timer of \p direction_a.
 		 * @param timeout_a Seconds to wait. To wait indefinitely, use std::chrono::seconds::max ()
 		 */
-		void timer_start (std::chrono::seconds timeout_a);
+		void timer_start (std::chrono::seconds timeout_a, io_direction direction_a);
 		void timer_expired ();
-		void timer_cancel ();
+		void timer_cancel (io_direction direction_a);
 
 	private:
-		/** IO operation timer */
-		boost::asio::deadline_timer io_timer;
+		boost::asio::deadline_timer & io_timer (io_direction direction_a);
+		/** IO operation timers */
+		boost::asio::deadline_timer read_timer;
+		boost::asio::deadline_timer write_timer;
 	};
 
 	/**
@@ -70,7 +79,15 @@ namespace ipc
 		flatbuffers = 0x3,
 
 		/** JSON -> Flatbuffers -> JSON  */
-		flatbuffers_json = 0x4
+		flatbuffers_json = 0x4,
+
+		/**
+		 * Request is preamble followed by a 32-bit BE request id and a complete json_v1, json_v1_unsafe or flatbuffers_json request.
+		 * Any number of requests may be in flight on a connection. They are executed concurrently and each response is written
+		 * as soon as it is ready, so responses may arrive out of order.
+		 * Response is 32-bit BE length, followed by the 32-bit BE request id and the payload bytes. The length includes the request id.
+		 */
+		multiplexed = 0x5
 	};
 
 	/** IPC transport interface */
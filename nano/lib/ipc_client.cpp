@@ -31,6 +31,7 @@ public:
 	 * @param callback_a If called without errors, the payload buffer is successfully populated
 	 */
 	virtual void async_read_message (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, std::chrono::seconds timeout_a, std::function<void (boost::system::error_code const &, size_t)> callback_a) = 0;
+	virtual void close () = 0;
 };
 
 /* Boost v1.70 introduced breaking changes; the conditional compilation allows 1.6x to be supported as well. */
@@ -53,9 +54,9 @@ public:
 	void async_resolve (std::string const & host_a, uint16_t port_a, std::function<void (boost::system::error_code const &, boost::asio::ip::tcp::endpoint)> callback_a)
 	{
 		auto this_l (this->shared_from_this ());
-		this_l->timer_start (io_timeout);
+		this_l->timer_start (io_timeout, io_direction::write);
 		resolver.async_resolve (boost::asio::ip::tcp::resolver::query (host_a, std::to_string (port_a)), [this_l, callback_a] (boost::system::error_code const & ec, boost::asio::ip::tcp::resolver::iterator endpoint_iterator_a) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (io_direction::write);
 			boost::asio::ip::tcp::resolver::iterator end;
 			if (!ec && endpoint_iterator_a != end)
 			{
@@ -72,9 +73,9 @@ public:
 	void async_connect (std::function<void (boost::system::error_code const &)> callback_a)
 	{
 		auto this_l (this->shared_from_this ());
-		this_l->timer_start (io_timeout);
+		this_l->timer_start (io_timeout, io_direction::write);
 		socket.async_connect (endpoint, boost::asio::bind_executor (strand, [this_l, callback_a] (boost::system::error_code const & ec) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (io_direction::write);
 			callback_a (ec);
 		}));
 	}
@@ -82,10 +83,10 @@ public:
 	void async_read (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, size_t size_a, std::function<void (boost::system::error_code const &, size_t)> callback_a) override
 	{
 		auto this_l (this->shared_from_this ());
-		this_l->timer_start (io_timeout);
+		this_l->timer_start (io_timeout, io_direction::read);
 		buffer_a->resize (size_a);
 		boost::asio::async_read (socket, boost::asio::buffer (buffer_a->data (), size_a), boost::asio::bind_executor (this_l->strand, [this_l, buffer_a, callback_a] (boost::system::error_code const & ec, size_t size_a) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (io_direction::read);
 			callback_a (ec, size_a);
 		}));
 	}
@@ -111,11 +112,11 @@ public:
 	{
 		auto this_l (this->shared_from_this ());
 		auto msg (send_queue.front ());
-		this_l->timer_start (io_timeout);
+		this_l->timer_start (io_timeout, io_direction::write);
 		nano::async_write (socket, msg.buffer,
 		boost::asio::bind_executor (strand,
 		[msg, this_l] (boost::system::error_code ec, std::size_t size_a) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (io_direction::write);
 
 			if (msg.callback)
 			{
@@ -133,19 +134,19 @@ public:
 	void async_read_message (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, std::chrono::seconds timeout_a, std::function<void (boost::system::error_code const &, size_t)> callback_a) override
 	{
 		auto this_l (this->shared_from_this ());
-		this_l->timer_start (timeout_a);
+		this_l->timer_start (timeout_a, io_direction::read);
 		buffer_a->resize (4);
 		// Read 32 bit big-endian length
 		boost::asio::async_read (socket, boost::asio::buffer (buffer_a->data (), 4), boost::asio::bind_executor (this_l->strand, [this_l, timeout_a, buffer_a, callback_a] (boost::system::error_code const & ec, size_t size_a) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (io_direction::read);
 			if (!ec)
 			{
 				uint32_t payload_size_l = boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (buffer_a->data ()));
 				buffer_a->resize (payload_size_l);
 				// Read payload
-				this_l->timer_start (timeout_a);
+				this_l->timer_start (timeout_a, io_direction::read);
 				this_l->async_read (buffer_a, payload_size_l, [this_l, buffer_a, callback_a] (boost::system::error_code const & ec_a, size_t size_a) {
-					this_l->timer_cancel ();
+					this_l->timer_cancel (io_direction::read);
 					callback_a (ec_a, size_a);
 				});
 			}
@@ -161,8 +162,10 @@ public:
 	{
 		auto this_l (this->shared_from_this ());
 		boost::asio::post (strand, boost::asio::bind_executor (strand, [this_l] () {
-			this_l->socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both);
-			this_l->socket.close ();
+			// The peer may have closed the socket already
+			boost::system::error_code ec_ignored;
+			this_l->socket.shutdown (boost::asio::ip::tcp::socket::shutdown_both, ec_ignored);
+			this_l->socket.close (ec_ignored);
 		}));
 	}
 
@@ -300,6 +303,15 @@ void nano::ipc::ipc_client::async_read_message (std::shared_ptr<std::vector<uint
 	});
 }
 
+void nano::ipc::ipc_client::close ()
+{
+	if (impl != nullptr)
+	{
+		auto client (boost::polymorphic_downcast<client_impl *> (impl.get ()));
+		client->get_channel ().close ();
+	}
+}
+
 std::vector<uint8_t> nano::ipc::get_preamble (nano::ipc::payload_encoding encoding_a)
 {
 	std::vector<uint8_t> buffer_l;
@@ -336,6 +348,22 @@ nano::shared_const_buffer nano::ipc::prepare_request (nano::ipc::payload_encodin
 	return nano::shared_const_buffer{ std::move (buffer_l) };
 }
 
+nano::shared_const_buffer nano::ipc::prepare_multiplexed_request (nano::ipc::payload_encoding encoding_a, uint32_t request_id_a, std::string const & payload_a)
+{
+	debug_assert (encoding_a == nano::ipc::payload_encoding::json_v1 || encoding_a == nano::ipc::payload_encoding::json_v1_unsafe || encoding_a == nano::ipc::payload_encoding::flatbuffers_json);
+	auto buffer_l (get_preamble (nano::ipc::payload_encoding::multiplexed));
+	uint32_t be_id = boost::endian::native_to_big (request_id_a);
+	char * id_chars = reinterpret_cast<char *> (&be_id);
+	buffer_l.insert (buffer_l.end (), id_chars, id_chars + sizeof (uint32_t));
+	auto preamble_l (get_preamble (encoding_a));
+	buffer_l.insert (buffer_l.end (), preamble_l.begin (), preamble_l.end ());
+	uint32_t be_length = boost::endian::native_to_big (static_cast<uint32_t> (payload_a.size ()));
+	char * length_chars = reinterpret_cast<char *> (&be_length);
+	buffer_l.insert (buffer_l.end (), length_chars, length_chars + sizeof (uint32_t));
+	buffer_l.insert (buffer_l.end (), payload_a.begin (), payload_a.end ());
+	return nano::shared_const_buffer{ std::move (buffer_l) };
+}
+
 std::string nano::ipc::request (nano::ipc::payload_encoding encoding_a, nano::ipc::ipc_client & ipc_client, std::string const & rpc_action_a)
 {
 	auto req (prepare_request (encoding_a, rpc_action_a));
@@ -56,6 +56,9 @@ namespace ipc
 		 */
 		void async_read_message (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, std::chrono::seconds timeout_a, std::function<void (nano::error, size_t)> callback_a);
 
+		/** Close the connection, pending operations complete with an error */
+		void close ();
+
 	private:
 		boost::asio::io_context & io_ctx;
 
@@ -88,5 +91,11 @@ namespace ipc
 	 * the buffer may contain a payload length or end sentinel.
 	 */
 	nano::shared_const_buffer prepare_request (nano::ipc::payload_encoding encoding_a, std::string const & payload_a);
+
+	/**
+	 * Returns a buffer with a payload_encoding::multiplexed request, enclosing a request of the given \p encoding_a and \p payload_a.
+	 * The response carries \p request_id_a so it can be matched with the request.
+	 */
+	nano::shared_const_buffer prepare_multiplexed_request (nano::ipc::payload_encoding encoding_a, uint32_t request_id_a, std::string const & payload_a);
 }
 }
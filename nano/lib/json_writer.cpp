@@ -0,0 +1,244 @@
+#include <nano/lib/json_writer.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+
+nano::json_writer::json_writer () :
+	buffer ("{"),
+	stack{ { false, 0 } }
+{
+}
+
+void nano::json_writer::next (std::string_view const * key_a)
+{
+	debug_assert (!stack.empty ());
+	auto & top (stack.back ());
+	debug_assert (top.array == (key_a == nullptr));
+	// Openers are deferred to the first child because empty containers are written as ""
+	if (top.children == 0)
+	{
+		if (stack.size () > 1)
+		{
+			buffer += top.array ? '[' : '{';
+		}
+		buffer += '\n';
+	}
+	else
+	{
+		buffer += ",\n";
+	}
+	++top.children;
+	buffer.append (4 * stack.size (), ' ');
+	if (key_a != nullptr)
+	{
+		buffer += '"';
+		escape (*key_a);
+		buffer += "\": ";
+	}
+}
+
+void nano::json_writer::close ()
+{
+	debug_assert (!stack.empty ());
+	auto const top (stack.back ());
+	stack.pop_back ();
+	if (top.children > 0)
+	{
+		buffer += '\n';
+		buffer.append (4 * stack.size (), ' ');
+		buffer += top.array ? ']' : '}';
+	}
+	else if (!stack.empty ())
+	{
+		buffer += "\"\"";
+	}
+	else
+	{
+		buffer += "\n}";
+	}
+}
+
+void nano::json_writer::escape (std::string_view const & text_a)
+{
+	// Whether bytes outside ASCII are escaped depends on the Boost version, those strings are left to Boost itself
+	if (std::any_of (text_a.begin (), text_a.end (), [] (char c) { return static_cast<unsigned char> (c) >= 0x80; }))
+	{
+		buffer += boost::property_tree::json_parser::create_escapes (std::string (text_a));
+		return;
+	}
+	for (auto c : text_a)
+	{
+		auto const u (static_cast<unsigned char> (c));
+		// Same escaping of ASCII as boost::property_tree::json_parser::create_escapes
+		if (u >= 0x20 && c != '"' && c != '/' && c != '\\')
+		{
+			buffer += c;
+		}
+		else
+		{
+			buffer += '\\';
+			switch (c)
+			{
+				case '\b':
+					buffer += 'b';
+					break;
+				case '\f':
+					buffer += 'f';
+					break;
+				case '\n':
+					buffer += 'n';
+					break;
+				case '\r':
+					buffer += 'r';
+					break;
+				case '\t':
+					buffer += 't';
+					break;
+				case '"':
+				case '/':
+				case '\\':
+					buffer += c;
+					break;
+				default:
+				{
+					char const * hex_digits = "0123456789ABCDEF";
+					buffer += "u00";
+					buffer += hex_digits[u >> 4];
+					buffer += hex_digits[u & 0xf];
+					break;
+				}
+			}
+		}
+	}
+}
+
+void nano::json_writer::begin_object (std::string_view const & key_a)
+{
+	next (&key_a);
+	stack.push_back ({ false, 0 });
+}
+
+void nano::json_writer::begin_object ()
+{
+	next (nullptr);
+	stack.push_back ({ false, 0 });
+}
+
+void nano::json_writer::end_object ()
+{
+	debug_assert (stack.size () > 1 && !stack.back ().array);
+	close ();
+}
+
+void nano::json_writer::begin_array (std::string_view const & key_a)
+{
+	next (&key_a);
+	stack.push_back ({ true, 0 });
+}
+
+void nano::json_writer::end_array ()
+{
+	debug_assert (stack.size () > 1 && stack.back ().array);
+	close ();
+}
+
+void nano::json_writer::put (std::string_view const & key_a, std::string_view const & value_a)
+{
+	next (&key_a);
+	buffer += '"';
+	escape (value_a);
+	buffer += '"';
+}
+
+void nano::json_writer::put (std::string_view const & key_a, uint64_t value_a)
+{
+	put (key_a, std::to_string (value_a));
+}
+
+void nano::json_writer::push_back (std::string_view const & value_a)
+{
+	next (nullptr);
+	buffer += '"';
+	escape (value_a);
+	buffer += '"';
+}
+
+void nano::json_writer::put_child (std::string_view const & key_a, boost::property_tree::ptree const & tree_a)
+{
+	next (&key_a);
+	write (tree_a);
+}
+
+void nano::json_writer::push_back (boost::property_tree::ptree const & tree_a)
+{
+	next (nullptr);
+	write (tree_a);
+}
+
+void nano::json_writer::write (boost::property_tree::ptree const & tree_a)
+{
+	if (tree_a.empty ())
+	{
+		buffer += '"';
+		escape (tree_a.data ());
+		buffer += '"';
+	}
+	else
+	{
+		// Like write_json, a tree is an array when none of its children have a key
+		auto const array (tree_a.count ("") == tree_a.size ());
+		stack.push_back ({ array, 0 });
+		for (auto const & [key, child] : tree_a)
+		{
+			if (array)
+			{
+				next (nullptr);
+			}
+			else
+			{
+				std::string_view const key_l (key);
+				next (&key_l);
+			}
+			write (child);
+		}
+		close ();
+	}
+}
+
+bool nano::json_writer::empty () const
+{
+	return stack.size () == 1 && stack.front ().children == 0;
+}
+
+std::string const & nano::json_writer::finish (boost::property_tree::ptree const & leading_a)
+{
+	if (!leading_a.empty ())
+	{
+		nano::json_writer result;
+		for (auto const & [key, child] : leading_a)
+		{
+			result.put_child (key, child);
+		}
+		if (!empty ())
+		{
+			// Members written so far follow the opening brace and the newline of the root object
+			result.buffer += ',';
+			result.buffer.append (buffer, 1, std::string::npos);
+			result.stack.front ().children += stack.front ().children;
+		}
+		buffer.swap (result.buffer);
+		stack.swap (result.stack);
+	}
+	return finish ();
+}
+
+std::string const & nano::json_writer::finish ()
+{
+	debug_assert (stack.size () == 1);
+	close ();
+	buffer += '\n';
+	return buffer;
+}
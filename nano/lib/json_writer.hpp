@@ -0,0 +1,58 @@
+#pragma once
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Writes JSON straight into a string buffer instead of building a boost::property_tree::ptree first.
+ * The output is byte for byte what boost::property_tree::write_json produces for the equivalent tree, including
+ * its quirks: every value is a string and an empty object or array below the root is written as "".
+ */
+class json_writer final
+{
+public:
+	json_writer ();
+	/** Starts an object as a member of the current object */
+	void begin_object (std::string_view const & key_a);
+	/** Starts an object as an element of the current array */
+	void begin_object ();
+	void end_object ();
+	/** Starts an array as a member of the current object */
+	void begin_array (std::string_view const & key_a);
+	void end_array ();
+	/** Adds a member to the current object */
+	void put (std::string_view const & key_a, std::string_view const & value_a);
+	void put (std::string_view const & key_a, uint64_t value_a);
+	/** Adds a small tree as a member of the current object, written the way write_json writes it */
+	void put_child (std::string_view const & key_a, boost::property_tree::ptree const & tree_a);
+	/** Adds an element to the current array */
+	void push_back (std::string_view const & value_a);
+	void push_back (boost::property_tree::ptree const & tree_a);
+	/** True if nothing was added to the root object */
+	bool empty () const;
+	/** Closes the root object and returns the document, no other calls are allowed afterwards */
+	std::string const & finish ();
+	/** Like finish, with the members of \p leading_a written before everything added to the writer */
+	std::string const & finish (boost::property_tree::ptree const & leading_a);
+
+private:
+	class frame final
+	{
+	public:
+		bool array;
+		size_t children;
+	};
+	void next (std::string_view const * key_a);
+	void close ();
+	void write (boost::property_tree::ptree const & tree_a);
+	void escape (std::string_view const & text_a);
+	std::string buffer;
+	std::vector<frame> stack;
+};
+}
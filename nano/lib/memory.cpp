@@ -2,6 +2,46 @@
 
 namespace
 {
+/** Vectors that grew beyond this are released instead of being cached so one large message does not pin its memory */
+size_t constexpr pooled_bytes_max_capacity = 4096;
+size_t constexpr pooled_bytes_cache_size = 64;
+
+class byte_vector_tag
+{
+};
+
+class pooled_vector final : public nano::thread_free_list::node
+{
+public:
+	std::vector<uint8_t> vector;
+};
+
+/** Returns nullptr while thread local objects are destroyed at thread exit */
+nano::thread_free_list * bytes_free_list ()
+{
+	thread_local auto list (new nano::thread_free_list (pooled_bytes_cache_size));
+	thread_local nano::thread_free_list::close_guard guard (list, [] (nano::thread_free_list::node * node_a) {
+		delete static_cast<pooled_vector *> (node_a);
+	});
+	return list;
+}
+
+class byte_vector_release final
+{
+public:
+	void operator() (std::vector<uint8_t> *) const
+	{
+		auto & stats (nano::pooled_bytes_stats ());
+		--stats.outstanding;
+		vector->vector.clear ();
+		if (vector->vector.capacity () > pooled_bytes_max_capacity || !nano::thread_free_list::recycle (vector, bytes_free_list (), stats))
+		{
+			delete vector;
+		}
+	}
+	pooled_vector * vector;
+};
+
 #ifdef MEMORY_POOL_DISABLED
 /** TSAN on mac is generating some warnings. They need further investigating before memory pools can be used, so disable them for now */
 bool use_memory_pools{ false };
@@ -35,3 +75,176 @@ nano::cleanup_guard::~cleanup_guard ()
 		func ();
 	}
 }
+
+std::shared_ptr<std::vector<uint8_t>> nano::make_pooled_bytes ()
+{
+	if (!nano::get_use_memory_pools ())
+	{
+		return std::make_shared<std::vector<uint8_t>> ();
+	}
+	auto & stats (nano::pooled_bytes_stats ());
+	++stats.outstanding;
+	auto list (bytes_free_list ());
+	auto vector (list != nullptr ? static_cast<pooled_vector *> (list->pop ()) : nullptr);
+	if (vector != nullptr)
+	{
+		++stats.hits;
+	}
+	else
+	{
+		vector = new pooled_vector;
+		nano::thread_free_list::attach (vector, list);
+		++stats.misses;
+	}
+	return std::shared_ptr<std::vector<uint8_t>> (&vector->vector, byte_vector_release{ vector }, nano::thread_cached_allocator<std::vector<uint8_t>, byte_vector_tag> ());
+}
+
+nano::object_pool_stats & nano::pooled_bytes_stats ()
+{
+	static nano::object_pool_stats stats;
+	return stats;
+}
+
+nano::thread_free_list::thread_free_list (size_t capacity_a) :
+	capacity (capacity_a)
+{
+}
+
+nano::thread_free_list::node * nano::thread_free_list::closed_marker ()
+{
+	static node marker{};
+	return &marker;
+}
+
+nano::thread_free_list::node * nano::thread_free_list::pop ()
+{
+	if (local == nullptr && returned.load (std::memory_order_relaxed) != nullptr)
+	{
+		// Take over everything other threads gave back so far with a single exchange
+		local = returned.exchange (nullptr, std::memory_order_acquire);
+		size_t count (0);
+		for (auto i (local); i != nullptr; i = i->next)
+		{
+			++count;
+		}
+		local_count = count;
+		returned_count.fetch_sub (count, std::memory_order_relaxed);
+	}
+	auto result (local);
+	if (result != nullptr)
+	{
+		local = result->next;
+		--local_count;
+	}
+	return result;
+}
+
+bool nano::thread_free_list::push (node * node_a)
+{
+	auto result (local_count < capacity);
+	if (result)
+	{
+		node_a->next = local;
+		local = node_a;
+		++local_count;
+	}
+	return result;
+}
+
+bool nano::thread_free_list::give_back (node * node_a)
+{
+	if (returned_count.fetch_add (1, std::memory_order_relaxed) >= capacity)
+	{
+		returned_count.fetch_sub (1, std::memory_order_relaxed);
+		return false;
+	}
+	auto head (returned.load (std::memory_order_relaxed));
+	do
+	{
+		if (head == closed_marker ())
+		{
+			returned_count.fetch_sub (1, std::memory_order_relaxed);
+			return false;
+		}
+		node_a->next = head;
+	} while (!returned.compare_exchange_weak (head, node_a, std::memory_order_release, std::memory_order_relaxed));
+	return true;
+}
+
+void nano::thread_free_list::attach (node * node_a, nano::thread_free_list * local_a)
+{
+	node_a->owner = local_a;
+	if (local_a != nullptr)
+	{
+		local_a->references.fetch_add (1, std::memory_order_relaxed);
+	}
+}
+
+void nano::thread_free_list::detach (node * node_a)
+{
+	if (node_a->owner != nullptr)
+	{
+		unreference (node_a->owner);
+		node_a->owner = nullptr;
+	}
+}
+
+void nano::thread_free_list::unreference (nano::thread_free_list * list_a)
+{
+	if (list_a->references.fetch_sub (1, std::memory_order_acq_rel) == 1)
+	{
+		delete list_a;
+	}
+}
+
+bool nano::thread_free_list::recycle (node * node_a, nano::thread_free_list * local_a, nano::object_pool_stats & stats_a)
+{
+	auto result (false);
+	if (node_a->owner == nullptr)
+	{
+		// Allocated while its thread was exiting
+	}
+	else if (node_a->owner == local_a)
+	{
+		result = local_a->push (node_a);
+	}
+	else if (node_a->owner->give_back (node_a))
+	{
+		++stats_a.returned;
+		result = true;
+	}
+	if (!result)
+	{
+		detach (node_a);
+	}
+	return result;
+}
+
+nano::thread_free_list::close_guard::close_guard (nano::thread_free_list *& list_a, void (*release_a) (node *)) :
+	list (list_a),
+	release (release_a)
+{
+}
+
+nano::thread_free_list::close_guard::~close_guard ()
+{
+	auto list_l (list);
+	// Allocations made by thread local objects destroyed after this one bypass the cache
+	list = nullptr;
+	auto release_all = [this] (node * head_a) {
+		while (head_a != nullptr)
+		{
+			auto next (head_a->next);
+			detach (head_a);
+			release (head_a);
+			head_a = next;
+		}
+	};
+	release_all (list_l->local);
+	list_l->local = nullptr;
+	list_l->local_count = 0;
+	// Other threads see the marker and release what they would have given back themselves
+	release_all (list_l->returned.exchange (closed_marker (), std::memory_order_acquire));
+	// Deleted here unless items it handed out are still in use elsewhere
+	unreference (list_l);
+}
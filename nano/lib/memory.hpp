@@ -2,8 +2,12 @@
 
 #include <boost/pool/pool_alloc.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <new>
 #include <vector>
 
 namespace nano
@@ -60,4 +64,200 @@ std::shared_ptr<T> make_shared (Args &&... args)
 		return std::make_shared<T> (std::forward<Args> (args)...);
 	}
 }
+
+/** Counters of an object pool, shared by every thread */
+class object_pool_stats final
+{
+public:
+	/** Allocations served from a thread cache */
+	std::atomic<uint64_t> hits{ 0 };
+	/** Allocations that had to go to the global allocator */
+	std::atomic<uint64_t> misses{ 0 };
+	/** Deallocations on another thread which were handed back to the allocating thread */
+	std::atomic<uint64_t> returned{ 0 };
+	/** Allocations not yet deallocated */
+	std::atomic<int64_t> outstanding{ 0 };
+
+	template <typename Tag>
+	static object_pool_stats & get ()
+	{
+		static object_pool_stats stats;
+		return stats;
+	}
+};
+
+/**
+ * Bounded intrusive free list owned by a single thread. The owner pushes and pops without synchronization, other threads
+ * give items back through a lock-free list which the owner takes over with a single exchange once its own list runs dry.
+ * A list lives until its thread exited and every item it handed out has been released.
+ */
+class thread_free_list final
+{
+public:
+	class node
+	{
+	public:
+		nano::thread_free_list * owner;
+		node * next;
+	};
+
+	/** Closes the list when the owning thread exits, releasing every cached item */
+	class close_guard final
+	{
+	public:
+		close_guard (nano::thread_free_list *& list_a, void (*release_a) (node *));
+		~close_guard ();
+
+	private:
+		nano::thread_free_list *& list;
+		void (*release) (node *);
+	};
+
+	explicit thread_free_list (size_t capacity_a);
+	/** Owner thread only, returns nullptr if no item is cached */
+	node * pop ();
+	/** Records \p local_a, the free list of the calling thread or nullptr once it exited, as the owner of a new item */
+	static void attach (node *, nano::thread_free_list * local_a);
+	/**
+	 * Caches an item in its owner list, directly if that is \p local_a otherwise by giving it back.
+	 * Returns false if the item was not kept, it is then detached from its owner and the caller releases it.
+	 */
+	static bool recycle (node *, nano::thread_free_list * local_a, nano::object_pool_stats &);
+	size_t const capacity;
+
+private:
+	bool push (node *);
+	bool give_back (node *);
+	static void detach (node *);
+	static void unreference (nano::thread_free_list *);
+	static node * closed_marker ();
+	node * local{ nullptr };
+	size_t local_count{ 0 };
+	std::atomic<node *> returned{ nullptr };
+	std::atomic<size_t> returned_count{ 0 };
+	/** Items attached to this list plus one for the owning thread */
+	std::atomic<size_t> references{ 1 };
+};
+
+/**
+ * Allocator caching freed single object allocations in a bounded free list for each thread, so allocating on the realtime
+ * path neither contends on a process wide pool nor goes to the global allocator in steady state. Each allocation records
+ * the thread that made it, memory freed on another thread is handed back to that thread rather than cached by the freeing
+ * one, since realtime objects are typically allocated on io threads and released by processing threads. \p Tag selects the
+ * counters, allocators rebound by std::allocate_shared keep the tag of the object they were created for.
+ */
+template <typename T, typename Tag = T>
+class thread_cached_allocator final
+{
+	/** Precedes each single object allocation */
+	class alignas (std::max_align_t) header final : public nano::thread_free_list::node
+	{
+	};
+	static_assert (alignof (T) <= alignof (header), "Over aligned types are not supported");
+
+public:
+	using value_type = T;
+	static size_t constexpr cache_capacity = 128;
+
+	thread_cached_allocator () = default;
+	template <typename U>
+	thread_cached_allocator (thread_cached_allocator<U, Tag> const &)
+	{
+	}
+
+	T * allocate (size_t count_a)
+	{
+		auto & stats_l (stats ());
+		++stats_l.outstanding;
+		void * result (nullptr);
+		if (count_a == 1)
+		{
+			auto list (free_list ());
+			auto node (list != nullptr ? static_cast<header *> (list->pop ()) : nullptr);
+			if (node != nullptr)
+			{
+				++stats_l.hits;
+			}
+			else
+			{
+				node = new (::operator new (sizeof (header) + sizeof (T))) header;
+				nano::thread_free_list::attach (node, list);
+				++stats_l.misses;
+			}
+			result = node + 1;
+		}
+		else
+		{
+			result = ::operator new (count_a * sizeof (T));
+			++stats_l.misses;
+		}
+		return static_cast<T *> (result);
+	}
+
+	void deallocate (T * pointer_a, size_t count_a)
+	{
+		auto & stats_l (stats ());
+		--stats_l.outstanding;
+		if (count_a == 1)
+		{
+			auto node (reinterpret_cast<header *> (pointer_a) - 1);
+			if (!nano::thread_free_list::recycle (node, free_list (), stats_l))
+			{
+				::operator delete (node);
+			}
+		}
+		else
+		{
+			::operator delete (pointer_a);
+		}
+	}
+
+	/** Counters of the pool, shared by every allocator with the same tag */
+	static nano::object_pool_stats & stats ()
+	{
+		return nano::object_pool_stats::get<Tag> ();
+	}
+
+	template <typename U>
+	bool operator== (thread_cached_allocator<U, Tag> const &) const
+	{
+		return true;
+	}
+
+	template <typename U>
+	bool operator!= (thread_cached_allocator<U, Tag> const &) const
+	{
+		return false;
+	}
+
+private:
+	/** Returns nullptr while thread local objects are destroyed at thread exit */
+	static nano::thread_free_list * free_list ()
+	{
+		thread_local auto list_l (new nano::thread_free_list (cache_capacity));
+		thread_local nano::thread_free_list::close_guard guard (list_l, [] (nano::thread_free_list::node * node_a) {
+			::operator delete (static_cast<header *> (node_a));
+		});
+		return list_l;
+	}
+};
+
+/** Like nano::make_shared but allocates from a cache local to the calling thread, for objects created at a high rate on the realtime path */
+template <typename T, typename... Args>
+std::shared_ptr<T> make_pooled (Args &&... args)
+{
+	if (nano::get_use_memory_pools ())
+	{
+		return std::allocate_shared<T> (nano::thread_cached_allocator<T> (), std::forward<Args> (args)...);
+	}
+	else
+	{
+		return std::make_shared<T> (std::forward<Args> (args)...);
+	}
+}
+
+/** Byte vector whose capacity is returned to the cache of the allocating thread when the last reference goes away */
+std::shared_ptr<std::vector<uint8_t>> make_pooled_bytes ();
+/** Counters of the byte vectors handed out by nano::make_pooled_bytes */
+nano::object_pool_stats & pooled_bytes_stats ();
 }
@@ -4,6 +4,8 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <boost/endian/conversion.hpp>
+
 #include <crypto/cryptopp/aes.h>
 #include <crypto/cryptopp/modes.h>
 
@@ -30,28 +32,218 @@ uint8_t account_decode (char value)
 	}
 	return result;
 }
+
+/** Value of each account alphabet character, 0xff for characters outside of it */
+std::array<uint8_t, 256> const account_values = [] () {
+	std::array<uint8_t, 256> result;
+	result.fill (0xff);
+	for (uint8_t i (0); i < 32; ++i)
+	{
+		result[static_cast<uint8_t> (account_lookup[i])] = i;
+	}
+	return result;
+} ();
+
+char const * hex_digits ("0123456789ABCDEF");
+
+/** Two uppercase hex digits for each byte value */
+std::array<std::array<char, 2>, 256> const hex_pairs = [] () {
+	std::array<std::array<char, 2>, 256> result;
+	for (auto i (0); i < 256; ++i)
+	{
+		result[i] = { hex_digits[i >> 4], hex_digits[i & 0xf] };
+	}
+	return result;
+} ();
+
+/** Value of each hex digit in either case, 0xff for other characters */
+std::array<uint8_t, 256> const hex_values = [] () {
+	std::array<uint8_t, 256> result;
+	result.fill (0xff);
+	for (uint8_t i (0); i < 16; ++i)
+	{
+		result[static_cast<uint8_t> (hex_digits[i])] = i;
+		result[static_cast<uint8_t> (std::tolower (hex_digits[i]))] = i;
+	}
+	return result;
+} ();
+
+/** Two decimal digits for each value up to 99 */
+std::array<std::array<char, 2>, 100> const decimal_pairs = [] () {
+	std::array<std::array<char, 2>, 100> result;
+	for (auto i (0); i < 100; ++i)
+	{
+		result[i] = { static_cast<char> ('0' + i / 10), static_cast<char> ('0' + i % 10) };
+	}
+	return result;
+} ();
+
+void encode_hex_bytes (uint8_t const * bytes_a, size_t size_a, char * destination_a)
+{
+	for (size_t i (0); i < size_a; ++i)
+	{
+		std::memcpy (destination_a + 2 * i, hex_pairs[bytes_a[i]].data (), 2);
+	}
+}
+
+/**
+ * Decodes 1 to 2 * \p size_a hex digits into the big endian \p bytes_a, with implied leading zeros.
+ * Invalid characters are collected into a single check at the end instead of branching on each digit.
+ */
+bool decode_hex_bytes (std::string const & text_a, uint8_t * bytes_a, size_t size_a)
+{
+	auto error (text_a.empty () || text_a.size () > 2 * size_a);
+	if (!error)
+	{
+		std::fill (bytes_a, bytes_a + size_a, 0);
+		auto destination (bytes_a + size_a - (text_a.size () + 1) / 2);
+		auto source (reinterpret_cast<uint8_t const *> (text_a.data ()));
+		auto const end (source + text_a.size ());
+		uint8_t invalid (0);
+		if (text_a.size () % 2 != 0)
+		{
+			auto const value (hex_values[*source++]);
+			invalid |= value;
+			*destination++ = value;
+		}
+		for (; source != end; source += 2)
+		{
+			auto const high (hex_values[source[0]]);
+			auto const low (hex_values[source[1]]);
+			invalid |= high | low;
+			*destination++ = static_cast<uint8_t> ((high << 4) | low);
+		}
+		error = (invalid & 0xf0) != 0;
+	}
+	return error;
+}
+
+/** Checksum of an account in the order its bytes are encoded in an address */
+std::array<uint8_t, 5> account_checksum (nano::public_key const & key_a)
+{
+	std::array<uint8_t, 5> check;
+	blake2b_state hash;
+	blake2b_init (&hash, check.size ());
+	blake2b_update (&hash, key_a.bytes.data (), key_a.bytes.size ());
+	blake2b_final (&hash, check.data (), check.size ());
+	std::reverse (check.begin (), check.end ());
+	return check;
+}
+
+/** Decodes the 60 characters following the prefix of an address, returns true on error */
+bool decode_account_fast (char const * source_a, nano::public_key & key_a)
+{
+	// 4 zero bits, the 256 bit key and the 40 bit checksum, so only the lowest bit of the first character is used
+	std::array<uint8_t, 37> decoded;
+	auto source (reinterpret_cast<uint8_t const *> (source_a));
+	uint8_t invalid (account_values[source[0]] & 0xfe);
+	uint32_t accumulator (account_values[source[0]] & 1);
+	unsigned bits (1);
+	auto destination (decoded.begin ());
+	for (auto i (1); i < 60; ++i)
+	{
+		auto const value (account_values[source[i]]);
+		invalid |= value & 0xe0;
+		accumulator = (accumulator << 5) | (value & 0x1f);
+		bits += 5;
+		if (bits >= 8)
+		{
+			bits -= 8;
+			*destination++ = static_cast<uint8_t> (accumulator >> bits);
+			accumulator &= (1u << bits) - 1;
+		}
+	}
+	debug_assert (destination == decoded.end () && bits == 0);
+	auto error (invalid != 0);
+	if (!error)
+	{
+		nano::public_key key;
+		std::copy (decoded.begin (), decoded.begin () + 32, key.bytes.begin ());
+		auto const check (account_checksum (key));
+		error = !std::equal (check.begin (), check.end (), decoded.begin () + 32);
+		if (!error)
+		{
+			key_a = key;
+		}
+	}
+	return error;
+}
+
+/**
+ * Decodes \p text_a as a 128 bit decimal number in 9 digit chunks on 32 bit limbs, so no multiprecision arithmetic is involved.
+ * Only plain digit strings are accepted, returns true on error or overflow.
+ */
+bool decode_dec_fast (std::string const & text_a, nano::uint128_union & value_a)
+{
+	auto error (text_a.empty () || text_a.size () > nano::uint128_union::dec_size_max);
+	std::array<uint32_t, 4> limbs{};
+	for (size_t i (0); !error && i < text_a.size ();)
+	{
+		auto const chunk_size (std::min<size_t> (9, text_a.size () - i));
+		uint64_t chunk (0);
+		uint64_t multiplier (1);
+		for (auto const end (i + chunk_size); i < end; ++i)
+		{
+			auto const digit (static_cast<uint8_t> (text_a[i] - '0'));
+			error |= digit > 9;
+			chunk = chunk * 10 + digit;
+			multiplier *= 10;
+		}
+		// Least significant limb last
+		uint64_t carry (chunk);
+		for (auto limb (limbs.rbegin ()), n (limbs.rend ()); limb != n; ++limb)
+		{
+			auto const product (*limb * multiplier + carry);
+			*limb = static_cast<uint32_t> (product);
+			carry = product >> 32;
+		}
+		error |= carry != 0;
+	}
+	if (!error)
+	{
+		for (auto i (0); i < 4; ++i)
+		{
+			boost::endian::store_big_u32 (value_a.bytes.data () + 4 * i, limbs[i]);
+		}
+	}
+	return error;
+}
 }
 
 void nano::public_key::encode_account (std::string & destination_a) const
 {
 	debug_assert (destination_a.empty ());
-	destination_a.reserve (65);
-	uint64_t check (0);
-	blake2b_state hash;
-	blake2b_init (&hash, 5);
-	blake2b_update (&hash, bytes.data (), bytes.size ());
-	blake2b_final (&hash, reinterpret_cast<uint8_t *> (&check), 5);
-	nano::uint512_t number_l (number ());
-	number_l <<= 40;
-	number_l |= nano::uint512_t (check);
-	for (auto i (0); i < 60; ++i)
+	destination_a.resize (account_size);
+	encode_account (destination_a.data ());
+}
+
+void nano::public_key::encode_account (char * destination_a) const
+{
+	std::memcpy (destination_a, "nano_", 5);
+	auto destination (destination_a + 5);
+	// The key followed by its checksum make 296 bits, 4 leading zero bits pad them to 60 characters of 5 bits
+	auto const check (account_checksum (*this));
+	uint32_t accumulator (0);
+	unsigned bits (4);
+	auto encode_byte = [&accumulator, &bits, &destination] (uint8_t byte_a) {
+		accumulator = (accumulator << 8) | byte_a;
+		bits += 8;
+		while (bits >= 5)
+		{
+			bits -= 5;
+			*destination++ = account_encode ((accumulator >> bits) & 0x1f);
+		}
+		accumulator &= (1u << bits) - 1;
+	};
+	for (auto byte : bytes)
+	{
+		encode_byte (byte);
+	}
+	for (auto byte : check)
 	{
-		uint8_t r (number_l & static_cast<uint8_t> (0x1f));
-		number_l >>= 5;
-		destination_a.push_back (account_encode (r));
+		encode_byte (byte);
 	}
-	destination_a.append ("_onan"); // nano_
-	std::reverse (destination_a.begin (), destination_a.end ());
+	debug_assert (destination == destination_a + account_size && bits == 0);
 }
 
 std::string nano::public_key::to_account () const
@@ -85,8 +277,13 @@ bool nano::public_key::decode_account (std::string const & source_a)
 			if (xrb_prefix || nano_prefix || node_id_prefix)
 			{
 				auto i (source_a.begin () + (xrb_prefix ? 4 : 5));
-				if (*i == '1' || *i == '3')
+				if ((*i == '1' || *i == '3') && source_a.end () - i == 60)
 				{
+					error = decode_account_fast (&*i, *this);
+				}
+				else if (*i == '1' || *i == '3')
+				{
+					// Node ids are not length checked, decode them the general way
 					nano::uint512_t number_l;
 					for (auto j (source_a.end ()); !error && i != j; ++i)
 					{
@@ -208,17 +405,27 @@ nano::uint256_t nano::uint256_union::number () const
 void nano::uint256_union::encode_hex (std::string & text) const
 {
 	debug_assert (text.empty ());
-	std::stringstream stream;
-	stream << std::hex << std::uppercase << std::noshowbase << std::setw (64) << std::setfill ('0');
-	stream << number ();
-	text = stream.str ();
+	text.resize (hex_size);
+	encode_hex (text.data ());
+}
+
+void nano::uint256_union::encode_hex (char * destination_a) const
+{
+	encode_hex_bytes (bytes.data (), bytes.size (), destination_a);
 }
 
 bool nano::uint256_union::decode_hex (std::string const & text)
 {
-	auto error (false);
-	if (!text.empty () && text.size () <= 64)
+	nano::uint256_union value;
+	auto error (decode_hex_bytes (text, value.bytes.data (), value.bytes.size ()));
+	if (!error)
+	{
+		*this = value;
+	}
+	// Anything other than plain hex digits takes the stream based parser, which accepts a few more forms such as a 0x prefix
+	else if (!text.empty () && text.size () <= 64)
 	{
+		error = false;
 		std::stringstream stream (text);
 		stream << std::hex << std::noshowbase;
 		nano::uint256_t number_l;
@@ -325,17 +532,26 @@ nano::uint512_t nano::uint512_union::number () const
 void nano::uint512_union::encode_hex (std::string & text) const
 {
 	debug_assert (text.empty ());
-	std::stringstream stream;
-	stream << std::hex << std::uppercase << std::noshowbase << std::setw (128) << std::setfill ('0');
-	stream << number ();
-	text = stream.str ();
+	text.resize (hex_size);
+	encode_hex (text.data ());
+}
+
+void nano::uint512_union::encode_hex (char * destination_a) const
+{
+	encode_hex_bytes (bytes.data (), bytes.size (), destination_a);
 }
 
 bool nano::uint512_union::decode_hex (std::string const & text)
 {
-	auto error (text.size () > 128);
+	nano::uint512_union value;
+	auto error (decode_hex_bytes (text, value.bytes.data (), value.bytes.size ()));
 	if (!error)
 	{
+		*this = value;
+	}
+	else if (text.size () <= 128)
+	{
+		error = false;
 		std::stringstream stream (text);
 		stream << std::hex << std::noshowbase;
 		nano::uint512_t number_l;
@@ -486,17 +702,26 @@ nano::uint128_t nano::uint128_union::number () const
 void nano::uint128_union::encode_hex (std::string & text) const
 {
 	debug_assert (text.empty ());
-	std::stringstream stream;
-	stream << std::hex << std::uppercase << std::noshowbase << std::setw (32) << std::setfill ('0');
-	stream << number ();
-	text = stream.str ();
+	text.resize (hex_size);
+	encode_hex (text.data ());
+}
+
+void nano::uint128_union::encode_hex (char * destination_a) const
+{
+	encode_hex_bytes (bytes.data (), bytes.size (), destination_a);
 }
 
 bool nano::uint128_union::decode_hex (std::string const & text)
 {
-	auto error (text.size () > 32);
+	nano::uint128_union value;
+	auto error (decode_hex_bytes (text, value.bytes.data (), value.bytes.size ()));
 	if (!error)
 	{
+		*this = value;
+	}
+	else if (text.size () <= 32)
+	{
+		error = false;
 		std::stringstream stream (text);
 		stream << std::hex << std::noshowbase;
 		nano::uint128_t number_l;
@@ -520,16 +745,57 @@ bool nano::uint128_union::decode_hex (std::string const & text)
 void nano::uint128_union::encode_dec (std::string & text) const
 {
 	debug_assert (text.empty ());
-	std::stringstream stream;
-	stream << std::dec << std::noshowbase;
-	stream << number ();
-	text = stream.str ();
+	std::array<char, dec_size_max> buffer;
+	text.assign (buffer.data (), encode_dec (buffer.data ()));
+}
+
+size_t nano::uint128_union::encode_dec (char * destination_a) const
+{
+	// Divide by 10^9 on 32 bit limbs, each remainder gives 9 digits written from the end of the buffer
+	std::array<uint32_t, 4> limbs;
+	for (auto i (0); i < 4; ++i)
+	{
+		limbs[i] = boost::endian::load_big_u32 (bytes.data () + 4 * i);
+	}
+	std::array<char, dec_size_max> buffer;
+	auto position (buffer.end ());
+	auto remaining (true);
+	while (remaining)
+	{
+		uint64_t remainder (0);
+		remaining = false;
+		for (auto & limb : limbs)
+		{
+			auto const current ((remainder << 32) | limb);
+			limb = static_cast<uint32_t> (current / 1000000000);
+			remainder = current % 1000000000;
+			remaining |= limb != 0;
+		}
+		// Leading zeros are only written for chunks below the most significant one
+		auto const digits_min (remaining ? 9 : 1);
+		auto digits (0);
+		while (remainder >= 10 || digits + 2 <= digits_min)
+		{
+			position -= 2;
+			std::memcpy (&*position, decimal_pairs[remainder % 100].data (), 2);
+			remainder /= 100;
+			digits += 2;
+		}
+		if (remainder != 0 || digits < digits_min)
+		{
+			*--position = static_cast<char> ('0' + remainder);
+		}
+	}
+	auto const size (static_cast<size_t> (buffer.end () - position));
+	std::memcpy (destination_a, position, size);
+	return size;
 }
 
 bool nano::uint128_union::decode_dec (std::string const & text, bool decimal)
 {
 	auto error (text.size () > 39 || (text.size () > 1 && text.front () == '0' && !decimal) || (!text.empty () && text.front () == '-'));
-	if (!error)
+	// Anything other than plain digits is left to the stream based parser
+	if (!error && decode_dec_fast (text, *this))
 	{
 		std::stringstream stream (text);
 		stream << std::dec << std::noshowbase;
@@ -30,8 +30,12 @@ public:
 	bool operator< (nano::uint128_union const &) const;
 	bool operator> (nano::uint128_union const &) const;
 	void encode_hex (std::string &) const;
+	/** Writes hex_size uppercase hex digits to \p destination_a */
+	void encode_hex (char * destination_a) const;
 	bool decode_hex (std::string const &);
 	void encode_dec (std::string &) const;
+	/** Writes the decimal digits to \p destination_a, which must have room for dec_size_max characters, and returns their count */
+	size_t encode_dec (char * destination_a) const;
 	bool decode_dec (std::string const &, bool = false);
 	bool decode_dec (std::string const &, nano::uint128_t);
 	std::string format_balance (nano::uint128_t scale, int precision, bool group_digits) const;
@@ -41,6 +45,8 @@ public:
 	bool is_zero () const;
 	std::string to_string () const;
 	std::string to_string_dec () const;
+	static size_t constexpr hex_size = 32;
+	static size_t constexpr dec_size_max = 39;
 	union
 	{
 		std::array<uint8_t, 16> bytes;
@@ -76,6 +82,8 @@ public:
 	bool operator!= (nano::uint256_union const &) const;
 	bool operator< (nano::uint256_union const &) const;
 	void encode_hex (std::string &) const;
+	/** Writes hex_size uppercase hex digits to \p destination_a */
+	void encode_hex (char * destination_a) const;
 	bool decode_hex (std::string const &);
 	void encode_dec (std::string &) const;
 	bool decode_dec (std::string const &);
@@ -84,6 +92,7 @@ public:
 	bool is_zero () const;
 	std::string to_string () const;
 	nano::uint256_t number () const;
+	static size_t constexpr hex_size = 64;
 
 	union
 	{
@@ -118,12 +127,16 @@ public:
 	std::string to_node_id () const;
 	bool decode_node_id (std::string const & source_a);
 	void encode_account (std::string &) const;
+	/** Writes the account_size characters of the nano_ address to \p destination_a */
+	void encode_account (char * destination_a) const;
 	std::string to_account () const;
 	bool decode_account (std::string const &);
 
 	operator nano::link const & () const;
 	operator nano::root const & () const;
 	operator nano::hash_or_account const & () const;
+
+	static size_t constexpr account_size = 65;
 };
 
 class wallet_id : public uint256_union
@@ -198,11 +211,14 @@ public:
 	bool operator!= (nano::uint512_union const &) const;
 	nano::uint512_union & operator^= (nano::uint512_union const &);
 	void encode_hex (std::string &) const;
+	/** Writes hex_size uppercase hex digits to \p destination_a */
+	void encode_hex (char * destination_a) const;
 	bool decode_hex (std::string const &);
 	void clear ();
 	bool is_zero () const;
 	nano::uint512_t number () const;
 	std::string to_string () const;
+	static size_t constexpr hex_size = 128;
 
 	union
 	{
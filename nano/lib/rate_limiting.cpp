@@ -30,6 +30,17 @@ bool nano::rate::token_bucket::try_consume (unsigned tokens_required_a)
 	return possible || refill_rate == 1e9;
 }
 
+size_t nano::rate::token_bucket::try_consume_many (unsigned tokens_required_a, size_t count_a)
+{
+	debug_assert (tokens_required_a <= 1e9);
+	nano::lock_guard<nano::mutex> lk (bucket_mutex);
+	refill ();
+	auto result (tokens_required_a == 0 ? count_a : std::min<size_t> (count_a, current_size / tokens_required_a));
+	current_size -= result * tokens_required_a;
+	smallest_size = std::min (smallest_size, current_size);
+	return refill_rate == 1e9 ? count_a : result;
+}
+
 void nano::rate::token_bucket::refill ()
 {
 	auto now (std::chrono::steady_clock::now ());
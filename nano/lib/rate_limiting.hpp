@@ -38,6 +38,12 @@ namespace rate
 		 */
 		bool try_consume (unsigned tokens_required_a = 1);
 
+		/**
+		 * Deduct \p tokens_required_a for up to \p count_a operations at once
+		 * @return The number of operations the bucket had room for
+		 */
+		size_t try_consume_many (unsigned tokens_required_a, size_t count_a);
+
 		/** Returns the largest burst observed */
 		size_t largest_burst () const;
 
@@ -136,11 +136,19 @@ nano::error nano::rpc_config::serialize_toml (nano::tomlconfig & toml) const
 	rpc_process_l.put ("ipc_address", rpc_process.ipc_address, "Address of IPC server.\ntype:string,ip");
 	rpc_process_l.put ("ipc_port", rpc_process.ipc_port, "Listening port of IPC server.\ntype:uint16");
 	rpc_process_l.put ("num_ipc_connections", rpc_process.num_ipc_connections, "Number of IPC connections to establish.\ntype:uint32");
+	rpc_process_l.put ("io_timeout", rpc_process.io_timeout.count (), "Fail requests to the node which are not answered within this time.\ntype:seconds");
 	toml.put_child ("process", rpc_process_l);
 
 	nano::tomlconfig rpc_logging_l;
 	rpc_logging_l.put ("log_rpc", rpc_logging.log_rpc, "Whether to log RPC calls.\ntype:bool");
 	toml.put_child ("logging", rpc_logging_l);
+
+	nano::tomlconfig rpc_http_l;
+	rpc_http_l.put ("keep_alive", http.keep_alive, "Keep connections open between requests, allowing clients to reuse and pipeline requests on a connection.\ntype:bool");
+	rpc_http_l.put ("keep_alive_timeout", http.keep_alive_timeout.count (), "Close persistent connections which have been idle this long.\ntype:seconds");
+	rpc_http_l.put ("max_requests_per_connection", http.max_requests_per_connection, "Close persistent connections after serving this many requests, 0 for no limit.\ntype:uint32");
+	rpc_http_l.put ("max_concurrent_requests", http.max_concurrent_requests, "Maximum number of pipelined requests processed at once on a connection.\ntype:uint32");
+	toml.put_child ("http", rpc_http_l);
 	return toml.get_error ();
 }
 
@@ -168,6 +176,21 @@ nano::error nano::rpc_config::deserialize_toml (nano::tomlconfig & toml)
 			rpc_logging_l->get_optional<bool> ("log_rpc", rpc_logging.log_rpc);
 		}
 
+		auto rpc_http_l (toml.get_optional_child ("http"));
+		if (rpc_http_l)
+		{
+			rpc_http_l->get_optional<bool> ("keep_alive", http.keep_alive);
+			auto keep_alive_timeout_l (http.keep_alive_timeout.count ());
+			rpc_http_l->get_optional ("keep_alive_timeout", keep_alive_timeout_l);
+			http.keep_alive_timeout = std::chrono::seconds (keep_alive_timeout_l);
+			rpc_http_l->get_optional<unsigned> ("max_requests_per_connection", http.max_requests_per_connection);
+			rpc_http_l->get_optional<unsigned> ("max_concurrent_requests", http.max_concurrent_requests);
+			if (http.max_concurrent_requests == 0)
+			{
+				toml.get_error ().set ("http.max_concurrent_requests must be at least 1");
+			}
+		}
+
 		auto rpc_process_l (toml.get_optional_child ("process"));
 		if (rpc_process_l)
 		{
@@ -177,6 +200,9 @@ nano::error nano::rpc_config::deserialize_toml (nano::tomlconfig & toml)
 			rpc_process_l->get_optional<boost::asio::ip::address_v6> ("ipc_address", ipc_address_l, boost::asio::ip::address_v6::loopback ());
 			rpc_process.ipc_address = address_l.to_string ();
 			rpc_process_l->get_optional<unsigned> ("num_ipc_connections", rpc_process.num_ipc_connections);
+			auto io_timeout_l (rpc_process.io_timeout.count ());
+			rpc_process_l->get_optional ("io_timeout", io_timeout_l);
+			rpc_process.io_timeout = std::chrono::seconds (io_timeout_l);
 		}
 	}
 
@@ -3,6 +3,7 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/errors.hpp>
 
+#include <chrono>
 #include <string>
 #include <thread>
 #include <vector>
@@ -54,6 +55,8 @@ public:
 	std::string ipc_address;
 	uint16_t ipc_port{ network_constants.default_ipc_port };
 	unsigned num_ipc_connections{ (network_constants.is_live_network () || network_constants.is_test_network ()) ? 8u : network_constants.is_beta_network () ? 4u : 1u };
+	/** Requests forwarded to the node fail if no response arrives within this time */
+	std::chrono::seconds io_timeout{ 60 };
 	static unsigned json_version ()
 	{
 		return 1;
@@ -66,6 +69,20 @@ public:
 	bool log_rpc{ true };
 };
 
+/** Configuration options for persistent HTTP connections */
+class rpc_http_config final
+{
+public:
+	/** If true, connections are kept open between requests unless the client asks to close them */
+	bool keep_alive{ false };
+	/** Connections without a request in progress are closed after this time */
+	std::chrono::seconds keep_alive_timeout{ 30 };
+	/** Connections are closed after serving this many requests, 0 for no limit */
+	unsigned max_requests_per_connection{ 1000 };
+	/** Maximum number of pipelined requests processed at once per connection, further requests are not read until a response is written */
+	unsigned max_concurrent_requests{ 8 };
+};
+
 class rpc_config final
 {
 public:
@@ -84,6 +101,7 @@ public:
 	uint8_t max_json_depth{ 20 };
 	uint64_t max_request_size{ 32 * 1024 * 1024 };
 	nano::rpc_logging_config rpc_logging;
+	nano::rpc_http_config http;
 	static unsigned json_version ()
 	{
 		return 1;
@@ -564,6 +564,15 @@ std::string nano::stat::type_to_string (uint32_t key)
 		case nano::stat::type::vote_generator:
 			res = "vote_generator";
 			break;
+		case nano::stat::type::coalescer:
+			res = "coalescer";
+			break;
+		case nano::stat::type::read_transaction_pool:
+			res = "read_transaction_pool";
+			break;
+		case nano::stat::type::rpc_cache:
+			res = "rpc_cache";
+			break;
 	}
 	return res;
 }
@@ -673,6 +682,9 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::invocations:
 			res = "invocations";
 			break;
+		case nano::stat::detail::chunk_write_failed:
+			res = "chunk_write_failed";
+			break;
 		case nano::stat::detail::keepalive:
 			res = "keepalive";
 			break;
@@ -757,6 +769,12 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::overflow:
 			res = "overflow";
 			break;
+		case nano::stat::detail::batch_syscall:
+			res = "batch_syscall";
+			break;
+		case nano::stat::detail::batch_packets:
+			res = "batch_packets";
+			break;
 		case nano::stat::detail::tcp_accept_success:
 			res = "accept_success";
 			break;
@@ -880,9 +898,63 @@ std::string nano::stat::detail_to_string (uint32_t key)
 		case nano::stat::detail::generator_replies_discarded:
 			res = "generator_replies_discarded";
 			break;
+		case nano::stat::detail::generator_replies_coalesced:
+			res = "generator_replies_coalesced";
+			break;
 		case nano::stat::detail::generator_spacing:
 			res = "generator_spacing";
 			break;
+		case nano::stat::detail::generator_votes_signed:
+			res = "generator_votes_signed";
+			break;
+		case nano::stat::detail::coalescer_held:
+			res = "coalescer_held";
+			break;
+		case nano::stat::detail::coalescer_expired:
+			res = "coalescer_expired";
+			break;
+		case nano::stat::detail::coalescer_req_hashes:
+			res = "coalescer_req_hashes";
+			break;
+		case nano::stat::detail::coalescer_ack_hashes:
+			res = "coalescer_ack_hashes";
+			break;
+		case nano::stat::detail::txn_open:
+			res = "txn_open";
+			break;
+		case nano::stat::detail::txn_renew:
+			res = "txn_renew";
+			break;
+		case nano::stat::detail::txn_refresh:
+			res = "txn_refresh";
+			break;
+		case nano::stat::detail::txn_reuse:
+			res = "txn_reuse";
+			break;
+		case nano::stat::detail::txn_reset:
+			res = "txn_reset";
+			break;
+		case nano::stat::detail::txn_evict:
+			res = "txn_evict";
+			break;
+		case nano::stat::detail::txn_age_ms:
+			res = "txn_age_ms";
+			break;
+		case nano::stat::detail::rpc_cache_hit:
+			res = "rpc_cache_hit";
+			break;
+		case nano::stat::detail::rpc_cache_miss:
+			res = "rpc_cache_miss";
+			break;
+		case nano::stat::detail::rpc_cache_expired:
+			res = "rpc_cache_expired";
+			break;
+		case nano::stat::detail::rpc_cache_evicted:
+			res = "rpc_cache_evicted";
+			break;
+		case nano::stat::detail::rpc_cache_invalidated:
+			res = "rpc_cache_invalidated";
+			break;
 		case nano::stat::detail::invalid_network:
 			res = "invalid_network";
 			break;
@@ -242,7 +242,10 @@ public:
 		requests,
 		filter,
 		telemetry,
-		vote_generator
+		vote_generator,
+		coalescer,
+		read_transaction_pool,
+		rpc_cache
 	};
 
 	/** Optional detail type */
@@ -327,6 +330,8 @@ public:
 		// udp
 		blocking,
 		overflow,
+		batch_syscall,
+		batch_packets,
 		invalid_header,
 		invalid_message_type,
 		invalid_keepalive_message,
@@ -348,6 +353,7 @@ public:
 
 		// ipc
 		invocations,
+		chunk_write_failed,
 
 		// peering
 		handshake,
@@ -387,7 +393,31 @@ public:
 		generator_broadcasts,
 		generator_replies,
 		generator_replies_discarded,
-		generator_spacing
+		generator_replies_coalesced,
+		generator_spacing,
+		generator_votes_signed,
+
+		// message coalescer
+		coalescer_held,
+		coalescer_expired,
+		coalescer_req_hashes,
+		coalescer_ack_hashes,
+
+		// read transaction pool
+		txn_open,
+		txn_renew,
+		txn_refresh,
+		txn_reuse,
+		txn_reset,
+		txn_evict,
+		txn_age_ms,
+
+		// rpc cache
+		rpc_cache_hit,
+		rpc_cache_miss,
+		rpc_cache_expired,
+		rpc_cache_evicted,
+		rpc_cache_invalidated
 	};
 
 	/** Direction of the stat. If the direction is irrelevant, use in */
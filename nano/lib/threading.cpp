@@ -86,6 +86,18 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 			break;
 		case nano::thread_role::name::election_scheduler:
 			thread_role_name_string = "Election Sched";
+			break;
+		case nano::thread_role::name::message_coalescer:
+			thread_role_name_string = "Msg coalescer";
+			break;
+		case nano::thread_role::name::vote_signing:
+			thread_role_name_string = "Vote signing";
+			break;
+		case nano::thread_role::name::udp_reader:
+			thread_role_name_string = "UDP reader";
+			break;
+		case nano::thread_role::name::ipc_request_processing:
+			thread_role_name_string = "IPC requests";
 	}
 
 	/*
@@ -195,9 +207,13 @@ void nano::thread_runner::stop_event_processing ()
 	io_guard.get_executor ().context ().stop ();
 }
 
+std::chrono::milliseconds constexpr nano::thread_pool::timer_tick;
+
 nano::thread_pool::thread_pool (unsigned num_threads, nano::thread_role::name thread_name) :
 	num_threads (num_threads),
-	thread_pool_m (std::make_unique<boost::asio::thread_pool> (num_threads))
+	thread_pool_m (std::make_unique<boost::asio::thread_pool> (num_threads)),
+	timers (timer_tick),
+	timer (std::make_unique<boost::asio::steady_timer> (thread_pool_m->get_executor ()))
 {
 	set_thread_names (num_threads, thread_name);
 }
@@ -221,6 +237,7 @@ void nano::thread_pool::stop ()
 		thread_pool_m->stop ();
 		thread_pool_m->join ();
 		lk.lock ();
+		timer = nullptr;
 		thread_pool_m = nullptr;
 	}
 }
@@ -240,19 +257,63 @@ void nano::thread_pool::push_task (std::function<void ()> task)
 
 void nano::thread_pool::add_timed_task (std::chrono::steady_clock::time_point const & expiry_time, std::function<void ()> task)
 {
-	nano::lock_guard<nano::mutex> guard (mutex);
-	if (!stopped && thread_pool_m)
+	auto const now (std::chrono::steady_clock::now ());
+	if (expiry_time <= now)
+	{
+		push_task (std::move (task));
+	}
+	else
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		if (!stopped && thread_pool_m)
+		{
+			timers.add (now, expiry_time, std::move (task));
+			schedule_timers ();
+		}
+	}
+}
+
+void nano::thread_pool::schedule_timers ()
+{
+	auto const wakeup (timers.next_wakeup ());
+	if (wakeup < timer_deadline)
 	{
-		auto timer = std::make_shared<boost::asio::steady_timer> (thread_pool_m->get_executor (), expiry_time);
-		timer->async_wait ([this, task, timer] (const boost::system::error_code & ec) {
+		// Rearming cancels the pending wait, so there is only ever one wait outstanding
+		timer_deadline = wakeup;
+		timer->expires_at (wakeup);
+		timer->async_wait ([this] (boost::system::error_code const & ec) {
 			if (!ec)
 			{
-				push_task (task);
+				process_timers ();
 			}
 		});
 	}
 }
 
+void nano::thread_pool::process_timers ()
+{
+	std::vector<nano::timing_wheel::callback_t> expired;
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		if (!stopped)
+		{
+			timer_deadline = std::chrono::steady_clock::time_point::max ();
+			timers.advance (std::chrono::steady_clock::now (), expired);
+			schedule_timers ();
+		}
+	}
+	for (auto & task : expired)
+	{
+		push_task (std::move (task));
+	}
+}
+
+size_t nano::thread_pool::num_timed_tasks ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return timers.size ();
+}
+
 unsigned nano::thread_pool::get_num_threads () const
 {
 	return num_threads;
@@ -292,5 +353,6 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (th
 {
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "count", thread_pool.num_queued_tasks (), sizeof (std::function<void ()>) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "timed", thread_pool.num_timed_tasks (), sizeof (std::function<void ()>) + sizeof (uint64_t) }));
 	return composite;
 }
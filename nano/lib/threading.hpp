@@ -5,6 +5,7 @@
 #include <nano/boost/asio/io_context.hpp>
 #include <nano/boost/asio/steady_timer.hpp>
 #include <nano/boost/asio/thread_pool.hpp>
+#include <nano/lib/timing_wheel.hpp>
 #include <nano/lib/utility.hpp>
 
 #include <boost/thread/thread.hpp>
@@ -38,7 +39,11 @@ namespace thread_role
 		state_block_signature_verification,
 		epoch_upgrader,
 		db_parallel_traversal,
-		election_scheduler
+		election_scheduler,
+		message_coalescer,
+		vote_signing,
+		udp_reader,
+		ipc_request_processing
 	};
 	/*
 	 * Get/Set the identifier for the current thread
@@ -171,7 +176,7 @@ public:
 	/** This will run when there is an available thread for execution */
 	void push_task (std::function<void ()>);
 
-	/** Run a task at a certain point in time */
+	/** Run a task at a certain point in time, with a resolution of timer_tick */
 	void add_timed_task (std::chrono::steady_clock::time_point const & expiry_time, std::function<void ()> task);
 
 	/** Stops any further pushed tasks from executing */
@@ -183,14 +188,26 @@ public:
 	/** Returns the number of tasks which are awaiting execution by the thread pool **/
 	uint64_t num_queued_tasks () const;
 
+	/** Number of timed tasks waiting for their expiry time */
+	size_t num_timed_tasks ();
+
+	static std::chrono::milliseconds constexpr timer_tick{ 10 };
+
 private:
 	nano::mutex mutex;
 	std::atomic<bool> stopped{ false };
 	unsigned num_threads;
 	std::unique_ptr<boost::asio::thread_pool> thread_pool_m;
 	relaxed_atomic_integral<uint64_t> num_tasks{ 0 };
+	/** Timed tasks share a single asio timer which is armed for the next wakeup of the wheel, mutex must be held to access either */
+	nano::timing_wheel timers;
+	std::unique_ptr<boost::asio::steady_timer> timer;
+	std::chrono::steady_clock::time_point timer_deadline{ std::chrono::steady_clock::time_point::max () };
 
 	void set_thread_names (unsigned num_threads, nano::thread_role::name thread_name);
+	/** Arms the timer if the wheel needs to be advanced earlier than it is armed for, mutex must be held */
+	void schedule_timers ();
+	void process_timers ();
 };
 
 std::unique_ptr<nano::container_info_component> collect_container_info (thread_pool & thread_pool, std::string const & name);
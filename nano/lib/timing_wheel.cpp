@@ -0,0 +1,134 @@
+#include <nano/lib/timing_wheel.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <algorithm>
+
+nano::timing_wheel::timing_wheel (std::chrono::milliseconds tick_a, std::chrono::steady_clock::time_point const & start_a) :
+	tick (tick_a),
+	start (start_a)
+{
+	debug_assert (tick.count () > 0);
+}
+
+uint64_t nano::timing_wheel::ticks (std::chrono::steady_clock::time_point const & time_a) const
+{
+	return time_a > start ? static_cast<uint64_t> ((time_a - start) / tick) : 0;
+}
+
+void nano::timing_wheel::add (std::chrono::steady_clock::time_point const & deadline_a, callback_t callback_a)
+{
+	add (std::chrono::steady_clock::now (), deadline_a, std::move (callback_a));
+}
+
+void nano::timing_wheel::add (std::chrono::steady_clock::time_point const & now_a, std::chrono::steady_clock::time_point const & deadline_a, callback_t callback_a)
+{
+	if (count == 0)
+	{
+		// Nothing is pending, skip straight to the present instead of walking the idle ticks later
+		current = std::max (current, ticks (now_a));
+	}
+	// Round up so timers never expire early
+	auto expiry (ticks (deadline_a));
+	if (start + tick * static_cast<int64_t> (expiry) < deadline_a)
+	{
+		++expiry;
+	}
+	insert ({ std::max (expiry, current + 1), std::move (callback_a) });
+	++count;
+}
+
+void nano::timing_wheel::insert (timer timer_a)
+{
+	auto const expiry (timer_a.expiry);
+	debug_assert (expiry >= current);
+	auto inserted (false);
+	for (size_t level (0); level < level_count && !inserted; ++level)
+	{
+		// A wheel holds the timers expiring within the current revolution of the wheel above it
+		auto const shift ((level + 1) * slot_bits);
+		if ((expiry >> shift) == (current >> shift))
+		{
+			wheels[level][(expiry >> (level * slot_bits)) & slot_mask].push_back (std::move (timer_a));
+			inserted = true;
+		}
+	}
+	if (!inserted)
+	{
+		overflow.push_back (std::move (timer_a));
+	}
+}
+
+void nano::timing_wheel::cascade (std::vector<timer> & timers_a)
+{
+	std::vector<timer> timers_l;
+	timers_l.swap (timers_a);
+	for (auto & timer_l : timers_l)
+	{
+		insert (std::move (timer_l));
+	}
+}
+
+void nano::timing_wheel::advance (std::chrono::steady_clock::time_point const & now_a, std::vector<callback_t> & expired_a)
+{
+	auto const target (ticks (now_a));
+	while (current < target)
+	{
+		if (count == 0)
+		{
+			current = target;
+		}
+		else
+		{
+			++current;
+			// Cascade the coarser wheels whose slot starts at this tick, coarsest first so timers can move down several levels
+			size_t aligned (0);
+			while (aligned < level_count && (current & ((uint64_t{ 1 } << ((aligned + 1) * slot_bits)) - 1)) == 0)
+			{
+				++aligned;
+			}
+			if (aligned == level_count)
+			{
+				cascade (overflow);
+			}
+			for (auto level (std::min (aligned, level_count - 1)); level > 0; --level)
+			{
+				cascade (wheels[level][(current >> (level * slot_bits)) & slot_mask]);
+			}
+			auto & slot (wheels[0][current & slot_mask]);
+			for (auto & timer_l : slot)
+			{
+				debug_assert (timer_l.expiry == current);
+				expired_a.push_back (std::move (timer_l.callback));
+			}
+			count -= slot.size ();
+			slot.clear ();
+		}
+	}
+}
+
+std::chrono::steady_clock::time_point nano::timing_wheel::next_wakeup () const
+{
+	auto result (std::chrono::steady_clock::time_point::max ());
+	if (count > 0)
+	{
+		// First pending slot of the finest wheel, otherwise the start of its next revolution where timers get cascaded
+		auto const block_end ((current | slot_mask) + 1);
+		auto next (current + 1);
+		while (next < block_end && wheels[0][next & slot_mask].empty ())
+		{
+			++next;
+		}
+		result = start + tick * static_cast<int64_t> (next);
+	}
+	return result;
+}
+
+size_t nano::timing_wheel::size () const
+{
+	return count;
+}
+
+bool nano::timing_wheel::empty () const
+{
+	return count == 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Hierarchical hashed timing wheel. Adding and expiring a timer are O(1) no matter how many timers are pending, timers
+ * beyond one revolution of the finest wheel wait in a coarser wheel and are cascaded down as time advances.
+ * Timers never expire early and expire at most one tick late.
+ * This class is not thread safe, the owner is expected to serialize access.
+ */
+class timing_wheel final
+{
+public:
+	using callback_t = std::function<void ()>;
+
+	explicit timing_wheel (std::chrono::milliseconds tick_a, std::chrono::steady_clock::time_point const & start_a = std::chrono::steady_clock::now ());
+	void add (std::chrono::steady_clock::time_point const & deadline_a, callback_t callback_a);
+	/** Same as add but with the current time supplied by the caller */
+	void add (std::chrono::steady_clock::time_point const & now_a, std::chrono::steady_clock::time_point const & deadline_a, callback_t callback_a);
+	/** Moves time forward to \p now_a, appending the callbacks of expired timers to \p expired_a in deadline order */
+	void advance (std::chrono::steady_clock::time_point const & now_a, std::vector<callback_t> & expired_a);
+	/** Earliest time advance needs to be called at to expire or cascade timers, time_point::max () when empty */
+	std::chrono::steady_clock::time_point next_wakeup () const;
+	size_t size () const;
+	bool empty () const;
+
+	std::chrono::milliseconds const tick;
+	static unsigned constexpr slot_bits = 8;
+	static uint64_t constexpr slot_count = 1 << slot_bits;
+	static uint64_t constexpr slot_mask = slot_count - 1;
+	static size_t constexpr level_count = 3;
+
+private:
+	class timer final
+	{
+	public:
+		uint64_t expiry;
+		callback_t callback;
+	};
+
+	void insert (timer);
+	void cascade (std::vector<timer> &);
+	/** Ticks elapsed since start at \p time_a, rounded down */
+	uint64_t ticks (std::chrono::steady_clock::time_point const & time_a) const;
+
+	std::chrono::steady_clock::time_point const start;
+	/** Last tick that has been processed */
+	uint64_t current{ 0 };
+	size_t count{ 0 };
+	std::array<std::array<std::vector<timer>, slot_count>, level_count> wheels;
+	/** Timers further away than the coarsest wheel covers */
+	std::vector<timer> overflow;
+};
+}
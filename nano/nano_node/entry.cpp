@@ -8,15 +8,18 @@
 #include <nano/node/json_handler.hpp>
 #include <nano/node/node.hpp>
 
+#include <boost/asio/read.hpp>
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
+#include <boost/property_tree/json_parser.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <iomanip>
 #include <numeric>
 #include <sstream>
 
@@ -40,9 +43,30 @@
 #undef _GNU_SOURCE
 #endif
 #endif
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 namespace
 {
+/** Peak resident set size of the process in kilobytes, 0 where it is not available */
+uint64_t peak_memory_kb ()
+{
+	uint64_t result (0);
+#ifndef _WIN32
+	rusage usage;
+	if (getrusage (RUSAGE_SELF, &usage) == 0)
+	{
+#ifdef __APPLE__
+		result = usage.ru_maxrss / 1024;
+#else
+		result = usage.ru_maxrss;
+#endif
+	}
+#endif
+	return result;
+}
+
 class uint64_from_hex // For use with boost::lexical_cast to read hexadecimal strings
 {
 public:
@@ -94,6 +118,10 @@ int main (int argc, char * const * argv)
 		("debug_profile_process", "Profile active blocks processing (only for nano_dev_network)")
 		("debug_profile_votes", "Profile votes processing (only for nano_dev_network)")
 		("debug_profile_frontiers_confirmation", "Profile frontiers confirmation speed (only for nano_dev_network)")
+		("debug_profile_message_pool", "Profile deserialization of replayed realtime messages with and without the thread cached pools")
+		("debug_profile_codecs", "Profile account, hex and decimal encoding and decoding of <count> random numbers against boost::multiprecision stream formatting")
+		("debug_profile_json", "Profile serializing a ledger RPC response of <count> accounts with the streaming JSON writer and with boost::property_tree")
+		("debug_profile_sockets", "Profile message round trips over <count> loopback TCP connections with the network I/O backend of this build")
 		("debug_random_feed", "Generates output to RNG test suites")
 		("debug_rpc", "Read an RPC command from stdin and invoke it. Network operations will have no effect.")
 		("debug_peers", "Display peer IPv6:port connections")
@@ -1110,6 +1138,342 @@ int main (int argc, char * const * argv)
 			node->stop ();
 			std::cerr << boost::str (boost::format ("%|1$ 12d| us \n%2% votes per second\n") % time % (max_votes * 1000000 / time));
 		}
+		else if (vm.count ("debug_profile_message_pool"))
+		{
+			nano::force_nano_dev_network ();
+			size_t count (1000000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			unsigned threads_count (std::max (1u, std::thread::hardware_concurrency ()));
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count))
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			threads_count = std::max (1u, threads_count);
+			// Recorded realtime traffic, alternating publish and confirm_ack messages
+			std::cerr << boost::str (boost::format ("Generating %1% messages\n") % count);
+			std::vector<std::shared_ptr<std::vector<uint8_t>>> capture;
+			capture.reserve (count);
+			nano::keypair key;
+			nano::block_builder builder;
+			for (size_t i (0); i < count; ++i)
+			{
+				auto block = builder.state ()
+							.account (key.pub)
+							.previous (i)
+							.representative (key.pub)
+							.balance (i)
+							.link (i)
+							.sign (key.prv, key.pub)
+							.work (0)
+							.build_shared ();
+				if (i % 2 == 0)
+				{
+					capture.push_back (nano::publish (block).to_bytes ());
+				}
+				else
+				{
+					auto vote (std::make_shared<nano::vote> (key.pub, key.prv, i, std::vector<nano::block_hash>{ block->hash () }));
+					capture.push_back (nano::confirm_ack (vote).to_bytes ());
+				}
+			}
+			// Deserializes and reserializes every message of the capture, as the realtime path does for flooding
+			auto replay = [&capture, threads_count] () {
+				std::vector<std::thread> threads;
+				auto begin (std::chrono::steady_clock::now ());
+				for (unsigned thread (0); thread < threads_count; ++thread)
+				{
+					threads.emplace_back ([&capture, thread, threads_count] () {
+						for (size_t i (thread); i < capture.size (); i += threads_count)
+						{
+							auto error (false);
+							nano::bufferstream stream (capture[i]->data (), capture[i]->size ());
+							nano::message_header header (error, stream);
+							std::shared_ptr<nano::message> message;
+							if (header.type == nano::message_type::publish)
+							{
+								message = nano::make_pooled<nano::publish> (error, stream, header);
+							}
+							else
+							{
+								message = nano::make_pooled<nano::confirm_ack> (error, stream, header);
+							}
+							release_assert (!error);
+							auto bytes (message->to_bytes ());
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
+				}
+				return std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - begin);
+			};
+			nano::set_use_memory_pools (false);
+			auto unpooled (replay ());
+			nano::set_use_memory_pools (true);
+			auto pooled (replay ());
+			std::cout << boost::str (boost::format ("%1% messages on %2% threads: %3% ms without pools, %4% ms with thread cached pools\n") % count % threads_count % unpooled.count () % pooled.count ());
+			auto print_pool = [] (std::string const & name_a, nano::object_pool_stats const & stats_a) {
+				std::cout << boost::str (boost::format ("%1%: %2% hits, %3% misses, %4% returned, %5% outstanding\n") % name_a % stats_a.hits.load () % stats_a.misses.load () % stats_a.returned.load () % stats_a.outstanding.load ());
+			};
+			print_pool ("state_block", nano::thread_cached_allocator<nano::state_block>::stats ());
+			print_pool ("vote", nano::thread_cached_allocator<nano::vote>::stats ());
+			print_pool ("publish", nano::thread_cached_allocator<nano::publish>::stats ());
+			print_pool ("confirm_ack", nano::thread_cached_allocator<nano::confirm_ack>::stats ());
+			print_pool ("bytes", nano::pooled_bytes_stats ());
+		}
+		else if (vm.count ("debug_profile_codecs"))
+		{
+			size_t count (1000000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			std::vector<nano::account> accounts (count);
+			std::vector<nano::amount> amounts (count);
+			for (size_t i (0); i < count; ++i)
+			{
+				nano::random_pool::generate_block (accounts[i].bytes.data (), accounts[i].bytes.size ());
+				nano::random_pool::generate_block (amounts[i].bytes.data (), amounts[i].bytes.size ());
+			}
+			auto profile = [count] (std::string const & name_a, auto const & action_a) {
+				auto const begin (std::chrono::steady_clock::now ());
+				size_t checksum (0);
+				for (size_t i (0); i < count; ++i)
+				{
+					checksum += action_a (i);
+				}
+				auto const time (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - begin));
+				std::cout << boost::str (boost::format ("%1%: %2% ns per call (%3%)\n") % name_a % (time.count () / std::max<size_t> (count, 1)) % checksum);
+			};
+			std::vector<std::string> encoded (count);
+			profile ("account encode", [&] (size_t i) { encoded[i] = accounts[i].to_account (); return encoded[i].size (); });
+			profile ("account decode", [&] (size_t i) { nano::account account; return static_cast<size_t> (account.decode_account (encoded[i])); });
+			profile ("hex encode", [&] (size_t i) { encoded[i] = accounts[i].to_string (); return encoded[i].size (); });
+			profile ("hex decode", [&] (size_t i) { nano::account account; return static_cast<size_t> (account.decode_hex (encoded[i])); });
+			profile ("hex encode (stream)", [&] (size_t i) {
+				std::stringstream stream;
+				stream << std::hex << std::uppercase << std::noshowbase << std::setw (64) << std::setfill ('0') << accounts[i].number ();
+				return stream.str ().size ();
+			});
+			profile ("decimal encode", [&] (size_t i) { encoded[i] = amounts[i].to_string_dec (); return encoded[i].size (); });
+			profile ("decimal decode", [&] (size_t i) { nano::amount amount; return static_cast<size_t> (amount.decode_dec (encoded[i])); });
+			profile ("decimal encode (stream)", [&] (size_t i) {
+				std::stringstream stream;
+				stream << std::dec << std::noshowbase << amounts[i].number ();
+				return stream.str ().size ();
+			});
+			profile ("decimal decode (stream)", [&] (size_t i) {
+				nano::uint128_t number;
+				std::stringstream stream (encoded[i]);
+				stream >> number;
+				return static_cast<size_t> (number == amounts[i].number ());
+			});
+		}
+		else if (vm.count ("debug_profile_json"))
+		{
+			size_t count (500000);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			std::vector<std::pair<nano::account, nano::account_info>> accounts;
+			accounts.reserve (count);
+			for (size_t i (0); i < count; ++i)
+			{
+				nano::account account;
+				nano::random_pool::generate_block (account.bytes.data (), account.bytes.size ());
+				nano::account_info info;
+				nano::random_pool::generate_block (info.head.bytes.data (), info.head.bytes.size ());
+				nano::random_pool::generate_block (info.open_block.bytes.data (), info.open_block.bytes.size ());
+				nano::random_pool::generate_block (info.balance.bytes.data (), info.balance.bytes.size ());
+				info.modified = nano::seconds_since_epoch ();
+				info.block_count = i;
+				accounts.emplace_back (account, info);
+			}
+			// Same members as the "ledger" action, the streaming writer runs first since the peak memory of the process only grows
+			auto const memory_start (peak_memory_kb ());
+			auto begin (std::chrono::steady_clock::now ());
+			nano::json_writer writer;
+			writer.begin_object ("accounts");
+			for (auto const & [account, info] : accounts)
+			{
+				writer.begin_object (account.to_account ());
+				writer.put ("frontier", info.head.to_string ());
+				writer.put ("open_block", info.open_block.to_string ());
+				writer.put ("representative_block", info.head.to_string ());
+				writer.put ("balance", info.balance.to_string_dec ());
+				writer.put ("modified_timestamp", std::to_string (info.modified));
+				writer.put ("block_count", std::to_string (info.block_count));
+				writer.end_object ();
+			}
+			writer.end_object ();
+			auto const & streamed (writer.finish ());
+			auto const writer_time (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - begin));
+			auto const writer_memory (peak_memory_kb ());
+			begin = std::chrono::steady_clock::now ();
+			std::string tree_output;
+			{
+				boost::property_tree::ptree response_l;
+				boost::property_tree::ptree accounts_l;
+				for (auto const & [account, info] : accounts)
+				{
+					boost::property_tree::ptree response_a;
+					response_a.put ("frontier", info.head.to_string ());
+					response_a.put ("open_block", info.open_block.to_string ());
+					response_a.put ("representative_block", info.head.to_string ());
+					response_a.put ("balance", info.balance.to_string_dec ());
+					response_a.put ("modified_timestamp", std::to_string (info.modified));
+					response_a.put ("block_count", std::to_string (info.block_count));
+					accounts_l.push_back (std::make_pair (account.to_account (), response_a));
+				}
+				response_l.add_child ("accounts", accounts_l);
+				std::stringstream ostream;
+				boost::property_tree::write_json (ostream, response_l);
+				tree_output = ostream.str ();
+			}
+			auto const tree_time (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - begin));
+			auto const tree_memory (peak_memory_kb ());
+			std::cout << boost::str (boost::format ("%1% accounts, %2% bytes, outputs %3%\n") % count % streamed.size () % (streamed == tree_output ? "identical" : "differ"));
+			std::cout << boost::str (boost::format ("json_writer: %1% ms, peak memory growth %2% KB\n") % writer_time.count () % (writer_memory - memory_start));
+			std::cout << boost::str (boost::format ("ptree: %1% ms, peak memory growth %2% KB\n") % tree_time.count () % (tree_memory - writer_memory));
+		}
+		else if (vm.count ("debug_profile_sockets"))
+		{
+			// Each connection uses two descriptors, the default leaves headroom under the common limit of 1024
+			size_t count (400);
+			auto count_it = vm.find ("count");
+			if (count_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (count_it->second.as<std::string> (), count))
+				{
+					std::cerr << "Invalid count\n";
+					return -1;
+				}
+			}
+			unsigned threads_count (std::max (1u, std::thread::hardware_concurrency ()));
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count))
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			threads_count = std::max (1u, threads_count);
+			size_t const descriptors_reserved (64);
+			nano::set_file_descriptor_limit (2 * count + descriptors_reserved);
+			auto const file_descriptor_limit (nano::get_file_descriptor_limit ());
+			if (file_descriptor_limit < 2 * count + descriptors_reserved)
+			{
+				std::cerr << boost::str (boost::format ("Open file descriptors limit is %1%, which is too low for %2% connections\n") % file_descriptor_limit % count);
+				return -1;
+			}
+			std::cout << boost::str (boost::format ("Opening %1% loopback connections using %2%\n") % count % nano::io_backend ());
+			boost::asio::io_context io_ctx;
+			boost::system::error_code ec;
+			boost::asio::ip::tcp::acceptor acceptor (io_ctx);
+			boost::asio::ip::tcp::endpoint const endpoint (boost::asio::ip::address_v6::loopback (), 0);
+			acceptor.open (endpoint.protocol (), ec);
+			if (!ec)
+			{
+				acceptor.bind (endpoint, ec);
+			}
+			if (!ec)
+			{
+				acceptor.listen (boost::asio::socket_base::max_listen_connections, ec);
+			}
+			if (ec)
+			{
+				std::cerr << boost::str (boost::format ("Unable to listen on loopback: %1%\n") % ec.message ());
+				return -1;
+			}
+			std::vector<std::shared_ptr<boost::asio::ip::tcp::socket>> sockets;
+			for (size_t i (0); i < count; ++i)
+			{
+				auto client (std::make_shared<boost::asio::ip::tcp::socket> (io_ctx));
+				client->connect (acceptor.local_endpoint (), ec);
+				auto server (std::make_shared<boost::asio::ip::tcp::socket> (io_ctx));
+				if (!ec)
+				{
+					acceptor.accept (*server, ec);
+				}
+				if (ec)
+				{
+					std::cerr << boost::str (boost::format ("Unable to open connection %1% of %2%: %3%\n") % (i + 1) % count % ec.message ());
+					return -1;
+				}
+				sockets.push_back (client);
+				sockets.push_back (server);
+			}
+			// Every connection bounces a message the size of a confirm_ack with a single hash back and forth
+			std::atomic<uint64_t> round_trips (0);
+			std::function<void (std::shared_ptr<boost::asio::ip::tcp::socket> const &, std::shared_ptr<std::vector<uint8_t>> const &)> echo;
+			echo = [&echo, &round_trips] (std::shared_ptr<boost::asio::ip::tcp::socket> const & socket_a, std::shared_ptr<std::vector<uint8_t>> const & buffer_a) {
+				boost::asio::async_read (*socket_a, boost::asio::buffer (*buffer_a), [&echo, &round_trips, socket_a, buffer_a] (boost::system::error_code const & ec, size_t) {
+					if (!ec)
+					{
+						++round_trips;
+						boost::asio::async_write (*socket_a, boost::asio::buffer (*buffer_a), [&echo, socket_a, buffer_a] (boost::system::error_code const & ec, size_t) {
+							if (!ec)
+							{
+								echo (socket_a, buffer_a);
+							}
+						});
+					}
+				});
+			};
+			auto const message_size (nano::message_header::size + sizeof (nano::account) + sizeof (nano::signature) + sizeof (uint64_t) + sizeof (nano::block_hash));
+			for (size_t i (0); i < sockets.size (); i += 2)
+			{
+				auto client_buffer (std::make_shared<std::vector<uint8_t>> (message_size));
+				boost::asio::async_write (*sockets[i], boost::asio::buffer (*client_buffer), [&echo, client = sockets[i], client_buffer] (boost::system::error_code const & ec, size_t) {
+					if (!ec)
+					{
+						echo (client, client_buffer);
+					}
+				});
+				echo (sockets[i + 1], std::make_shared<std::vector<uint8_t>> (message_size));
+			}
+			std::vector<std::thread> threads;
+			auto const begin (std::chrono::steady_clock::now ());
+			for (unsigned i (0); i < threads_count; ++i)
+			{
+				threads.emplace_back ([&io_ctx] () { io_ctx.run (); });
+			}
+			std::this_thread::sleep_for (std::chrono::seconds (10));
+			io_ctx.stop ();
+			for (auto & thread : threads)
+			{
+				thread.join ();
+			}
+			auto const elapsed (std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - begin));
+			std::cout << boost::str (boost::format ("%1% messages received in %2% ms on %3% threads, %4% messages per second\n") % round_trips.load () % elapsed.count () % threads_count % (round_trips.load () * 1000 / std::max<int64_t> (elapsed.count (), 1)));
+		}
 		else if (vm.count ("debug_profile_frontiers_confirmation"))
 		{
 			nano::force_nano_dev_network ();
@@ -2021,7 +2385,8 @@ int main (int argc, char * const * argv)
 		else if (vm.count ("version"))
 		{
 			std::cout << "Version " << NANO_VERSION_STRING << "\n"
-					  << "Build Info " << BUILD_INFO << std::endl;
+					  << "Build Info " << BUILD_INFO << "\n"
+					  << "Network I/O backend " << nano::io_backend () << std::endl;
 		}
 		else
 		{
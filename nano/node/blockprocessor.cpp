@@ -231,7 +231,7 @@ void nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 {
 	auto scoped_write_guard = write_database_queue.wait (nano::writer::process_batch);
 	block_post_events post_events ([&store = node.store] { return store.tx_begin_read (); });
-	auto transaction (node.store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::unchecked }));
+	auto transaction (node.store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::frontiers, tables::pending, tables::unchecked }));
 	nano::timer<std::chrono::milliseconds> timer_l;
 	lock_a.lock ();
 	timer_l.start ();
@@ -283,6 +283,12 @@ void nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 				{
 					node.logger.always_log (boost::str (boost::format ("%1% blocks rolled back") % rollback_list.size ()));
 				}
+				post_events.events.emplace_back ([this, rollback_list] (nano::transaction const &) {
+					for (auto const & block : rollback_list)
+					{
+						node.observers.block_rolled_back.notify (block);
+					}
+				});
 				// Deleting from votes cache, stop active transaction
 				for (auto & i : rollback_list)
 				{
@@ -354,6 +360,7 @@ nano::process_return nano::block_processor::process_one (nano::write_transaction
 			{
 				events_a.events.emplace_back ([this, hash, block = info_a.block, result, origin_a] (nano::transaction const & post_event_transaction_a) { process_live (post_event_transaction_a, hash, block, result, origin_a); });
 			}
+			events_a.events.emplace_back ([this, block] (nano::transaction const &) { node.observers.block_processed.notify (block); });
 			queue_unchecked (transaction_a, hash);
 			/* For send blocks check epoch open unchecked (gap pending).
 			For state blocks check only send subtype and only if block epoch is not last epoch.
@@ -303,6 +303,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (bo
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "observers", count, sizeof_element }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pulls_cache", cache_count, sizeof_cache_element }));
+	composite->add_component (collect_container_info (bootstrap_initiator.connections->scores, "peer_scores"));
 	return composite;
 }
 
@@ -263,6 +263,7 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 				connection->node->logger.try_log ("Error deserializing block received from pull request");
 			}
 			connection->node->stats.inc (nano::stat::type::bootstrap, nano::stat::detail::bulk_pull_deserialize_receive_block, nano::stat::dir::in);
+			connection->connections->scores.invalid_block (connection->channel->get_tcp_endpoint ());
 		}
 		else // Work invalid
 		{
@@ -271,6 +272,7 @@ void nano::bulk_pull_client::received_block (boost::system::error_code const & e
 				connection->node->logger.try_log (boost::str (boost::format ("Insufficient work for bulk pull block: %1%") % block->hash ().to_string ()));
 			}
 			connection->node->stats.inc_detail_only (nano::stat::type::error, nano::stat::detail::insufficient_work);
+			connection->connections->scores.invalid_block (connection->channel->get_tcp_endpoint ());
 		}
 	}
 	else
@@ -418,7 +420,7 @@ void nano::bulk_pull_server::set_current_end ()
 {
 	include_start = false;
 	debug_assert (request != nullptr);
-	auto transaction (connection->node->store.tx_begin_read ());
+	auto transaction (connection->node->read_transactions.borrow ());
 	if (!connection->node->store.block.exists (transaction, request->end))
 	{
 		if (connection->node->config.logging.bulk_pull_logging ())
@@ -545,7 +547,8 @@ std::shared_ptr<nano::block> nano::bulk_pull_server::get_next ()
 
 	if (send_current)
 	{
-		result = connection->node->block (current);
+		auto transaction (connection->node->read_transactions.borrow ());
+		result = connection->node->store.block.get (transaction, current);
 		if (result != nullptr && set_current_to_end == false)
 		{
 			auto previous (result->previous ());
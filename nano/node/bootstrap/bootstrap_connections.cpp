@@ -12,6 +12,7 @@ constexpr double nano::bootstrap_limits::bootstrap_minimum_blocks_per_sec;
 constexpr double nano::bootstrap_limits::bootstrap_minimum_termination_time_sec;
 constexpr unsigned nano::bootstrap_limits::bootstrap_max_new_connections;
 constexpr unsigned nano::bootstrap_limits::requeued_pulls_processed_blocks_factor;
+constexpr size_t nano::bootstrap_connections::peer_candidates;
 
 nano::bootstrap_client::bootstrap_client (std::shared_ptr<nano::node> const & node_a, std::shared_ptr<nano::bootstrap_connections> const & connections_a, std::shared_ptr<nano::transport::channel_tcp> const & channel_a, std::shared_ptr<nano::socket> const & socket_a) :
 	node (node_a),
@@ -28,6 +29,10 @@ nano::bootstrap_client::bootstrap_client (std::shared_ptr<nano::node> const & no
 
 nano::bootstrap_client::~bootstrap_client ()
 {
+	if (block_count > 0)
+	{
+		connections->scores.session (channel->get_tcp_endpoint (), sample_block_rate ());
+	}
 	--connections->connections_count;
 }
 
@@ -146,10 +151,12 @@ void nano::bootstrap_connections::connect_client (nano::tcp_endpoint const & end
 	++connections_count;
 	auto socket (std::make_shared<nano::socket> (node));
 	auto this_l (shared_from_this ());
+	auto const start (std::chrono::steady_clock::now ());
 	socket->async_connect (endpoint_a,
-	[this_l, socket, endpoint_a, push_front] (boost::system::error_code const & ec) {
+	[this_l, socket, endpoint_a, push_front, start] (boost::system::error_code const & ec) {
 		if (!ec)
 		{
+			this_l->scores.connected (endpoint_a, std::chrono::steady_clock::now () - start);
 			if (this_l->node.config.logging.bulk_pull_logging ())
 			{
 				this_l->node.logger.try_log (boost::str (boost::format ("Connection established to %1%") % endpoint_a));
@@ -159,6 +166,7 @@ void nano::bootstrap_connections::connect_client (nano::tcp_endpoint const & end
 		}
 		else
 		{
+			this_l->scores.failed (endpoint_a);
 			if (this_l->node.config.logging.network_logging ())
 			{
 				switch (ec.value ())
@@ -234,6 +242,7 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 						node.logger.try_log (boost::str (boost::format ("Stopping slow peer %1% (elapsed sec %2%s > %3%s and %4% blocks per second < %5%)") % client->channel->to_string () % elapsed_sec % nano::bootstrap_limits::bootstrap_minimum_termination_time_sec % blocks_per_sec % nano::bootstrap_limits::bootstrap_minimum_blocks_per_sec));
 					}
 
+					scores.failed (client->channel->get_tcp_endpoint ());
 					client->stop (true);
 					new_clients.pop_back ();
 				}
@@ -283,8 +292,8 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 		// Not many peers respond, need to try to make more connections than we need.
 		for (auto i = 0u; i < delta; i++)
 		{
-			auto endpoint (node.network.bootstrap_peer (true));
-			if (endpoint != nano::tcp_endpoint (boost::asio::ip::address_v6::any (), 0) && (node.flags.allow_bootstrap_peers_duplicates || endpoints.find (endpoint) == endpoints.end ()) && !node.network.excluded_peers.check (endpoint))
+			auto endpoint (select_peer (endpoints));
+			if (endpoint != nano::tcp_endpoint (boost::asio::ip::address_v6::any (), 0))
 			{
 				connect_client (endpoint);
 				endpoints.insert (endpoint);
@@ -313,6 +322,21 @@ void nano::bootstrap_connections::populate_connections (bool repeat)
 	}
 }
 
+nano::tcp_endpoint nano::bootstrap_connections::select_peer (std::unordered_set<nano::tcp_endpoint> const & endpoints_a)
+{
+	nano::tcp_endpoint result (boost::asio::ip::address_v6::any (), 0);
+	auto candidates (node.network.bootstrap_peers (peer_candidates, [this, &endpoints_a] (nano::tcp_endpoint const & endpoint_a) {
+		return (node.flags.allow_bootstrap_peers_duplicates || endpoints_a.find (endpoint_a) == endpoints_a.end ()) && !node.network.excluded_peers.check (endpoint_a);
+	}));
+	if (!candidates.empty ())
+	{
+		result = scores.select (candidates);
+		// Candidates which lost the comparison keep their place in the rotation
+		node.network.bootstrap_attempted (result);
+	}
+	return result;
+}
+
 void nano::bootstrap_connections::start_populate_connections ()
 {
 	if (!populate_connections_started.exchange (true))
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/node/bootstrap/bootstrap_bulk_pull.hpp>
+#include <nano/node/bootstrap/bootstrap_peer_scores.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/socket.hpp>
 
@@ -55,6 +56,8 @@ public:
 	void connect_client (nano::tcp_endpoint const & endpoint_a, bool push_front = false);
 	unsigned target_connections (size_t pulls_remaining, size_t attempts_count);
 	void populate_connections (bool repeat = true);
+	/** Picks the peer to connect to among a few candidates, weighted by their bootstrap history */
+	nano::tcp_endpoint select_peer (std::unordered_set<nano::tcp_endpoint> const & endpoints_a);
 	void start_populate_connections ();
 	void add_pull (nano::pull_info const & pull_a);
 	void request_pull (nano::unique_lock<nano::mutex> & lock_a);
@@ -65,6 +68,7 @@ public:
 	std::deque<std::weak_ptr<nano::bootstrap_client>> clients;
 	std::atomic<unsigned> connections_count{ 0 };
 	nano::node & node;
+	nano::bootstrap_peer_scores scores;
 	std::deque<std::shared_ptr<nano::bootstrap_client>> idle;
 	std::deque<nano::pull_info> pulls;
 	std::atomic<bool> populate_connections_started{ false };
@@ -72,5 +76,7 @@ public:
 	std::atomic<bool> stopped{ false };
 	nano::mutex mutex;
 	nano::condition_variable condition;
+	/** Number of peers considered for each new connection */
+	static size_t constexpr peer_candidates = 4;
 };
 }
@@ -334,7 +334,7 @@ void nano::frontier_req_server::next ()
 		auto now (nano::seconds_since_epoch ());
 		bool disable_age_filter (request->age == std::numeric_limits<decltype (request->age)>::max ());
 		size_t max_size (128);
-		auto transaction (connection->node->store.tx_begin_read ());
+		auto transaction (connection->node->read_transactions.borrow ());
 		if (!send_confirmed ())
 		{
 			for (auto i (connection->node->store.account.begin (transaction, current.number () + 1)), n (connection->node->store.account.end ()); i != n && accounts.size () != max_size; ++i)
@@ -0,0 +1,127 @@
+#include <nano/crypto_lib/random_pool.hpp>
+#include <nano/node/bootstrap/bootstrap_peer_scores.hpp>
+
+#include <numeric>
+
+constexpr double nano::bootstrap_peer_scores::reference_block_rate;
+constexpr double nano::bootstrap_peer_scores::reference_latency_ms;
+constexpr double nano::bootstrap_peer_scores::smoothing;
+constexpr double nano::bootstrap_peer_scores::score_min;
+constexpr size_t nano::bootstrap_peer_scores::max_peers;
+
+template <typename F>
+void nano::bootstrap_peer_scores::update (nano::tcp_endpoint const & endpoint_a, F const & modify_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto & peers_by_endpoint (peers.get<tag_endpoint> ());
+	auto existing (peers_by_endpoint.find (endpoint_a));
+	if (existing == peers_by_endpoint.end ())
+	{
+		nano::bootstrap_peer_score peer;
+		peer.endpoint = endpoint_a;
+		existing = peers_by_endpoint.insert (peer).first;
+	}
+	peers_by_endpoint.modify (existing, [&modify_a] (nano::bootstrap_peer_score & peer_a) {
+		modify_a (peer_a);
+		peer_a.last_update = std::chrono::steady_clock::now ();
+	});
+	// Forget the peers not heard of for the longest time
+	while (peers.size () > max_peers)
+	{
+		peers.get<tag_last_update> ().erase (peers.get<tag_last_update> ().begin ());
+	}
+}
+
+void nano::bootstrap_peer_scores::connected (nano::tcp_endpoint const & endpoint_a, std::chrono::steady_clock::duration const & latency_a)
+{
+	auto const latency_ms (std::chrono::duration<double, std::milli> (latency_a).count ());
+	update (endpoint_a, [latency_ms] (nano::bootstrap_peer_score & peer_a) {
+		peer_a.latency_ms = peer_a.latency_ms == 0.0 ? latency_ms : peer_a.latency_ms + smoothing * (latency_ms - peer_a.latency_ms);
+		peer_a.failure_rate -= smoothing * peer_a.failure_rate;
+	});
+}
+
+void nano::bootstrap_peer_scores::failed (nano::tcp_endpoint const & endpoint_a)
+{
+	update (endpoint_a, [] (nano::bootstrap_peer_score & peer_a) {
+		peer_a.failure_rate += smoothing * (1.0 - peer_a.failure_rate);
+	});
+}
+
+void nano::bootstrap_peer_scores::session (nano::tcp_endpoint const & endpoint_a, double block_rate_a)
+{
+	update (endpoint_a, [block_rate_a] (nano::bootstrap_peer_score & peer_a) {
+		peer_a.block_rate = peer_a.sessions == 0 ? block_rate_a : peer_a.block_rate + smoothing * (block_rate_a - peer_a.block_rate);
+		++peer_a.sessions;
+	});
+}
+
+void nano::bootstrap_peer_scores::invalid_block (nano::tcp_endpoint const & endpoint_a)
+{
+	update (endpoint_a, [] (nano::bootstrap_peer_score & peer_a) {
+		++peer_a.invalid_blocks;
+	});
+}
+
+double nano::bootstrap_peer_scores::score (nano::bootstrap_peer_score const & peer_a) const
+{
+	auto const throughput (peer_a.sessions == 0 ? 1.0 : peer_a.block_rate / reference_block_rate);
+	auto const latency (reference_latency_ms / (reference_latency_ms + peer_a.latency_ms));
+	auto const result (throughput * latency * (1.0 - peer_a.failure_rate) / (1.0 + peer_a.invalid_blocks));
+	return std::max (result, score_min);
+}
+
+double nano::bootstrap_peer_scores::score (nano::tcp_endpoint const & endpoint_a)
+{
+	auto result (1.0);
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto existing (peers.get<tag_endpoint> ().find (endpoint_a));
+	if (existing != peers.get<tag_endpoint> ().end ())
+	{
+		result = score (*existing);
+	}
+	return result;
+}
+
+nano::tcp_endpoint nano::bootstrap_peer_scores::select (std::vector<nano::tcp_endpoint> const & candidates_a)
+{
+	debug_assert (!candidates_a.empty ());
+	std::vector<double> weights;
+	weights.reserve (candidates_a.size ());
+	for (auto const & candidate : candidates_a)
+	{
+		weights.push_back (score (candidate));
+	}
+	auto const total (std::accumulate (weights.begin (), weights.end (), 0.0));
+	// Resolution of one millionth of the total score is plenty to pick between a handful of candidates
+	auto target (total * nano::random_pool::generate_word32 (0, 999999) / 1000000.0);
+	auto result (candidates_a.back ());
+	for (size_t i (0); i < candidates_a.size (); ++i)
+	{
+		if (target < weights[i])
+		{
+			result = candidates_a[i];
+			break;
+		}
+		target -= weights[i];
+	}
+	return result;
+}
+
+size_t nano::bootstrap_peer_scores::size ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return peers.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (bootstrap_peer_scores & scores, std::string const & name)
+{
+	size_t count;
+	{
+		nano::lock_guard<nano::mutex> guard (scores.mutex);
+		count = scores.peers.size ();
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", count, sizeof (decltype (scores.peers)::value_type) }));
+	return composite;
+}
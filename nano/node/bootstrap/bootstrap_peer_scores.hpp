@@ -0,0 +1,93 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/common.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace mi = boost::multi_index;
+
+namespace nano
+{
+/**
+ * Bootstrap history of a single peer. Rates are exponential moving averages so recent sessions weigh the most.
+ */
+class bootstrap_peer_score final
+{
+public:
+	nano::tcp_endpoint endpoint;
+	/** Blocks per second served over pull sessions */
+	double block_rate{ 0.0 };
+	/** Time taken to establish a connection */
+	double latency_ms{ 0.0 };
+	/** Share of connections and sessions that failed, between 0 and 1 */
+	double failure_rate{ 0.0 };
+	uint64_t sessions{ 0 };
+	uint64_t invalid_blocks{ 0 };
+	std::chrono::steady_clock::time_point last_update;
+};
+
+/**
+ * Scores bootstrap peers by throughput, connection latency, failure rate and the validity of the blocks they served.
+ * The history outlives bootstrap attempts so both legacy and lazy bootstrap stop reconnecting to peers that performed poorly.
+ */
+class bootstrap_peer_scores final
+{
+public:
+	/** A connection to \p endpoint_a was established after \p latency_a */
+	void connected (nano::tcp_endpoint const & endpoint_a, std::chrono::steady_clock::duration const & latency_a);
+	/** A connection to \p endpoint_a could not be established or was stopped for being too slow */
+	void failed (nano::tcp_endpoint const & endpoint_a);
+	/** A connection served pulls at \p block_rate_a blocks per second */
+	void session (nano::tcp_endpoint const & endpoint_a, double block_rate_a);
+	/** \p endpoint_a served a block that could not be deserialized or had insufficient work */
+	void invalid_block (nano::tcp_endpoint const & endpoint_a);
+	/** Relative score, peers without history score 1 so they keep being explored */
+	double score (nano::tcp_endpoint const & endpoint_a);
+	/** Randomly chooses one of \p candidates_a with a probability proportional to its score */
+	nano::tcp_endpoint select (std::vector<nano::tcp_endpoint> const & candidates_a);
+	size_t size ();
+
+	/** Block rate scoring the same as a peer without history */
+	static double constexpr reference_block_rate = 1000.0;
+	/** Connection latency halving the score of a peer */
+	static double constexpr reference_latency_ms = 250.0;
+	/** Weight of the newest sample in the moving averages */
+	static double constexpr smoothing = 0.25;
+	/** Lowest score so peers with a bad history are eventually retried */
+	static double constexpr score_min = 0.01;
+	static size_t constexpr max_peers = 4096;
+
+private:
+	template <typename F>
+	void update (nano::tcp_endpoint const & endpoint_a, F const & modify_a);
+	double score (nano::bootstrap_peer_score const &) const;
+	class tag_endpoint
+	{
+	};
+	class tag_last_update
+	{
+	};
+	nano::mutex mutex;
+	// clang-format off
+	boost::multi_index_container<nano::bootstrap_peer_score,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_endpoint>,
+			mi::member<nano::bootstrap_peer_score, nano::tcp_endpoint, &nano::bootstrap_peer_score::endpoint>>,
+		mi::ordered_non_unique<mi::tag<tag_last_update>,
+			mi::member<nano::bootstrap_peer_score, std::chrono::steady_clock::time_point, &nano::bootstrap_peer_score::last_update>>>>
+	peers;
+	// clang-format on
+
+	friend std::unique_ptr<container_info_component> collect_container_info (bootstrap_peer_scores &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (bootstrap_peer_scores & scores, std::string const & name);
+}
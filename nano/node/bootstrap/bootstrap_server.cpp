@@ -123,7 +123,9 @@ nano::bootstrap_server::~bootstrap_server ()
 		auto exisiting_response_channel (node->network.tcp_channels.find_channel (remote_endpoint));
 		if (exisiting_response_channel != nullptr)
 		{
-			exisiting_response_channel->temporary = false;
+			node->network.tcp_channels.modify (exisiting_response_channel, [] (std::shared_ptr<nano::transport::channel_tcp> const & channel_a) {
+				channel_a->temporary = false;
+			});
 			node->network.tcp_channels.erase (remote_endpoint);
 		}
 	}
@@ -145,6 +147,11 @@ void nano::bootstrap_server::stop ()
 
 void nano::bootstrap_server::receive ()
 {
+	if (is_realtime_connection ())
+	{
+		receive_buffered ();
+		return;
+	}
 	// Increase timeout to receive TCP header (idle server socket)
 	socket->set_timeout (node->network_params.node.idle_timeout);
 	auto this_l (shared_from_this ());
@@ -244,19 +251,9 @@ void nano::bootstrap_server::receive_header_action (boost::system::error_code co
 				}
 				case nano::message_type::telemetry_req:
 				{
-					if (is_realtime_connection ())
+					if (is_realtime_connection () && telemetry_req_allowed ())
 					{
-						// Only handle telemetry requests if they are outside of the cutoff time
-						auto cache_exceeded = std::chrono::steady_clock::now () >= last_telemetry_req + nano::telemetry_cache_cutoffs::network_to_time (node->network_params.network);
-						if (cache_exceeded)
-						{
-							last_telemetry_req = std::chrono::steady_clock::now ();
-							add_request (std::make_unique<nano::telemetry_req> (header));
-						}
-						else
-						{
-							node->stats.inc (nano::stat::type::telemetry, nano::stat::detail::request_within_protection_cache_zone);
-						}
+						add_request (std::make_unique<nano::telemetry_req> (header));
 					}
 					receive ();
 					break;
@@ -486,23 +483,7 @@ void nano::bootstrap_server::receive_confirm_ack_action (boost::system::error_co
 		{
 			if (is_realtime_connection ())
 			{
-				bool process_vote (true);
-				if (header_a.block_type () != nano::block_type::not_a_block)
-				{
-					for (auto & vote_block : request->vote->blocks)
-					{
-						if (!vote_block.which ())
-						{
-							auto const & block (boost::get<std::shared_ptr<nano::block>> (vote_block));
-							if (nano::work_validate_entry (*block))
-							{
-								process_vote = false;
-								node->stats.inc_detail_only (nano::stat::type::error, nano::stat::detail::insufficient_work);
-							}
-						}
-					}
-				}
-				if (process_vote)
+				if (!insufficient_work (*request))
 				{
 					add_request (std::unique_ptr<nano::message> (request.release ()));
 				}
@@ -538,6 +519,194 @@ void nano::bootstrap_server::receive_node_id_handshake_action (boost::system::er
 	}
 }
 
+void nano::bootstrap_server::receive_buffered ()
+{
+	if (framer == nullptr)
+	{
+		framer = std::make_unique<nano::message_framer> ();
+	}
+	// Idle timeout while waiting for the start of a message, default timeout while a message is partially received
+	socket->set_timeout (framer->pending () == 0 ? node->network_params.node.idle_timeout : node->config.tcp_io_timeout);
+	auto const free (framer->prepare ());
+	auto this_l (shared_from_this ());
+	socket->async_read_some (framer->buffer, free.first, free.second, [this_l] (boost::system::error_code const & ec, size_t size_a) {
+		if (this_l->remote_endpoint.port () == 0)
+		{
+			this_l->remote_endpoint = this_l->socket->remote_endpoint ();
+		}
+		this_l->receive_buffered_action (ec, size_a);
+	});
+}
+
+void nano::bootstrap_server::receive_buffered_action (boost::system::error_code const & ec, size_t size_a)
+{
+	if (!ec)
+	{
+		framer->commit (size_a);
+		std::vector<nano::tcp_message_item> batch;
+		nano::message_header header (nano::message_type::invalid);
+		uint8_t const * payload (nullptr);
+		auto error (false);
+		auto status (nano::message_framer::status::incomplete);
+		while (!error && (status = framer->next (header, payload)) == nano::message_framer::status::complete)
+		{
+			// Policed before deserializing, so a flooding peer costs neither the deserialization nor a queue slot
+			if (node->network.ingress.drop (nano::transport::map_tcp_to_endpoint (remote_endpoint), header.type))
+			{
+				node->stats.inc (nano::stat::type::drop, nano::transport::message_detail (header.type), nano::stat::dir::in);
+				continue;
+			}
+			auto message (deserialize_realtime (error, header, payload));
+			if (message != nullptr)
+			{
+				batch.push_back (nano::tcp_message_item{ message, remote_endpoint, remote_node_id, socket });
+			}
+		}
+		if (!batch.empty ())
+		{
+			node->network.tcp_message_manager.put_messages (batch);
+			std::weak_ptr<nano::bootstrap_server> this_w (shared_from_this ());
+			node->workers.add_timed_task (std::chrono::steady_clock::now () + (node->config.tcp_io_timeout * 2) + std::chrono::seconds (1), [this_w] () {
+				if (auto this_l = this_w.lock ())
+				{
+					this_l->timeout ();
+				}
+			});
+		}
+		if (!error && status == nano::message_framer::status::incomplete)
+		{
+			receive_buffered ();
+		}
+		else if (node->config.logging.network_logging ())
+		{
+			node->logger.try_log (boost::str (boost::format ("Received invalid message from realtime connection %1%") % remote_endpoint));
+		}
+	}
+	else if (node->config.logging.network_message_logging ())
+	{
+		node->logger.try_log (boost::str (boost::format ("Error receiving from realtime connection: %1%") % ec.message ()));
+	}
+}
+
+std::shared_ptr<nano::message> nano::bootstrap_server::deserialize_realtime (bool & error_a, nano::message_header const & header_a, uint8_t const * payload_a)
+{
+	std::shared_ptr<nano::message> result;
+	auto const size (header_a.payload_length_bytes ());
+	nano::bufferstream stream (payload_a, size);
+	switch (header_a.type)
+	{
+		case nano::message_type::keepalive:
+		{
+			result = nano::make_pooled<nano::keepalive> (error_a, stream, header_a);
+			break;
+		}
+		case nano::message_type::publish:
+		{
+			nano::uint128_t digest;
+			if (!node->network.publish_filter.apply (payload_a, size, &digest))
+			{
+				auto publish (nano::make_pooled<nano::publish> (error_a, stream, header_a, digest));
+				if (!error_a)
+				{
+					if (!nano::work_validate_entry (*publish->block))
+					{
+						result = publish;
+					}
+					else
+					{
+						node->stats.inc_detail_only (nano::stat::type::error, nano::stat::detail::insufficient_work);
+					}
+				}
+			}
+			else
+			{
+				node->stats.inc (nano::stat::type::filter, nano::stat::detail::duplicate_publish);
+			}
+			break;
+		}
+		case nano::message_type::confirm_req:
+		{
+			result = nano::make_pooled<nano::confirm_req> (error_a, stream, header_a);
+			break;
+		}
+		case nano::message_type::confirm_ack:
+		{
+			auto confirm_ack (nano::make_pooled<nano::confirm_ack> (error_a, stream, header_a));
+			if (!error_a && !insufficient_work (*confirm_ack))
+			{
+				result = confirm_ack;
+			}
+			break;
+		}
+		case nano::message_type::telemetry_req:
+		{
+			if (telemetry_req_allowed ())
+			{
+				result = std::make_shared<nano::telemetry_req> (header_a);
+			}
+			break;
+		}
+		case nano::message_type::telemetry_ack:
+		{
+			result = std::make_shared<nano::telemetry_ack> (error_a, stream, header_a);
+			break;
+		}
+		case nano::message_type::node_id_handshake:
+		{
+			// The handshake is already complete, only check that the message is well formed
+			nano::node_id_handshake handshake (error_a, stream, header_a);
+			break;
+		}
+		default:
+		{
+			// Bootstrap requests are not served over realtime connections
+			break;
+		}
+	}
+	if (error_a)
+	{
+		result = nullptr;
+	}
+	return result;
+}
+
+bool nano::bootstrap_server::insufficient_work (nano::confirm_ack const & message_a)
+{
+	bool result (false);
+	if (message_a.header.block_type () != nano::block_type::not_a_block)
+	{
+		for (auto & vote_block : message_a.vote->blocks)
+		{
+			if (!vote_block.which ())
+			{
+				auto const & block (boost::get<std::shared_ptr<nano::block>> (vote_block));
+				if (nano::work_validate_entry (*block))
+				{
+					result = true;
+					node->stats.inc_detail_only (nano::stat::type::error, nano::stat::detail::insufficient_work);
+				}
+			}
+		}
+	}
+	return result;
+}
+
+/** Only handle telemetry requests if they are outside of the cutoff time */
+bool nano::bootstrap_server::telemetry_req_allowed ()
+{
+	auto const now (std::chrono::steady_clock::now ());
+	auto const result (now >= last_telemetry_req + nano::telemetry_cache_cutoffs::network_to_time (node->network_params.network));
+	if (result)
+	{
+		last_telemetry_req = now;
+	}
+	else
+	{
+		node->stats.inc (nano::stat::type::telemetry, nano::stat::detail::request_within_protection_cache_zone);
+	}
+	return result;
+}
+
 void nano::bootstrap_server::add_request (std::unique_ptr<nano::message> message_a)
 {
 	debug_assert (message_a != nullptr);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/node/common.hpp>
+#include <nano/node/message_framer.hpp>
 #include <nano/node/socket.hpp>
 
 #include <atomic>
@@ -51,6 +52,13 @@ public:
 	void receive_confirm_ack_action (boost::system::error_code const &, size_t, nano::message_header const &);
 	void receive_node_id_handshake_action (boost::system::error_code const &, size_t, nano::message_header const &);
 	void receive_telemetry_ack_action (boost::system::error_code const & ec, size_t size_a, nano::message_header const & header_a);
+	/** Realtime connections read as much as is available and dispatch every complete message as one batch */
+	void receive_buffered ();
+	void receive_buffered_action (boost::system::error_code const &, size_t);
+	/** Returns nullptr if the message is dropped, sets \p error_a if it could not be deserialized */
+	std::shared_ptr<nano::message> deserialize_realtime (bool & error_a, nano::message_header const &, uint8_t const * payload_a);
+	bool insufficient_work (nano::confirm_ack const &);
+	bool telemetry_req_allowed ();
 	void add_request (std::unique_ptr<nano::message>);
 	void finish_request ();
 	void finish_request_async ();
@@ -59,6 +67,8 @@ public:
 	bool is_bootstrap_connection ();
 	bool is_realtime_connection ();
 	std::shared_ptr<std::vector<uint8_t>> receive_buffer;
+	/** Created once the connection is realtime, bootstrap connections read messages exactly as bootstrap servers consume the socket directly */
+	std::unique_ptr<nano::message_framer> framer;
 	std::shared_ptr<nano::socket> socket;
 	std::shared_ptr<nano::node> node;
 	nano::mutex mutex;
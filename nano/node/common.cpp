@@ -119,7 +119,7 @@ nano::message::message (nano::message_header const & header_a) :
 
 std::shared_ptr<std::vector<uint8_t>> nano::message::to_bytes () const
 {
-	auto bytes = std::make_shared<std::vector<uint8_t>> ();
+	auto bytes = nano::make_pooled_bytes ();
 	nano::vectorstream stream (*bytes);
 	serialize (stream);
 	return bytes;
@@ -799,7 +799,7 @@ size_t nano::confirm_req::size (nano::block_type type_a, size_t count)
 
 nano::confirm_ack::confirm_ack (bool & error_a, nano::stream & stream_a, nano::message_header const & header_a, nano::vote_uniquer * uniquer_a) :
 	message (header_a),
-	vote (nano::make_shared<nano::vote> (error_a, stream_a, header.block_type ()))
+	vote (nano::make_pooled<nano::vote> (error_a, stream_a, header.block_type ()))
 {
 	if (!error_a && uniquer_a)
 	{
@@ -1558,3 +1558,30 @@ nano::node_singleton_memory_pool_purge_guard::node_singleton_memory_pool_purge_g
 	cleanup_guard ({ nano::block_memory_pool_purge, nano::purge_shared_ptr_singleton_pool_memory<nano::vote>, nano::purge_shared_ptr_singleton_pool_memory<nano::election>, nano::purge_singleton_inactive_votes_cache_pool_memory })
 {
 }
+
+namespace
+{
+template <typename T>
+std::unique_ptr<nano::container_info_component> collect_pool_info (nano::object_pool_stats const & stats_a, std::string const & name)
+{
+	auto composite = std::make_unique<nano::container_info_composite> (name);
+	composite->add_component (std::make_unique<nano::container_info_leaf> (nano::container_info{ "outstanding", static_cast<size_t> (std::max<int64_t> (stats_a.outstanding.load (), 0)), sizeof (T) }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (nano::container_info{ "hits", static_cast<size_t> (stats_a.hits.load ()), 0 }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (nano::container_info{ "misses", static_cast<size_t> (stats_a.misses.load ()), 0 }));
+	composite->add_component (std::make_unique<nano::container_info_leaf> (nano::container_info{ "returned", static_cast<size_t> (stats_a.returned.load ()), 0 }));
+	return composite;
+}
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_object_pool_info (std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (collect_pool_info<nano::state_block> (nano::thread_cached_allocator<nano::state_block>::stats (), "state_block"));
+	composite->add_component (collect_pool_info<nano::vote> (nano::thread_cached_allocator<nano::vote>::stats (), "vote"));
+	composite->add_component (collect_pool_info<nano::keepalive> (nano::thread_cached_allocator<nano::keepalive>::stats (), "keepalive"));
+	composite->add_component (collect_pool_info<nano::publish> (nano::thread_cached_allocator<nano::publish>::stats (), "publish"));
+	composite->add_component (collect_pool_info<nano::confirm_req> (nano::thread_cached_allocator<nano::confirm_req>::stats (), "confirm_req"));
+	composite->add_component (collect_pool_info<nano::confirm_ack> (nano::thread_cached_allocator<nano::confirm_ack>::stats (), "confirm_ack"));
+	composite->add_component (collect_pool_info<std::vector<uint8_t>> (nano::pooled_bytes_stats (), "bytes"));
+	return composite;
+}
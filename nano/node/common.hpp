@@ -501,4 +501,7 @@ public:
 private:
 	nano::cleanup_guard cleanup_guard;
 };
+
+/** Hit, miss and outstanding counts of the thread cached pools used on the realtime path */
+std::unique_ptr<container_info_component> collect_object_pool_info (std::string const & name);
 }
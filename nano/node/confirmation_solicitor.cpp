@@ -91,23 +91,8 @@ void nano::confirmation_solicitor::flush ()
 	debug_assert (prepared);
 	for (auto const & request_queue : requests)
 	{
-		auto const & channel (request_queue.first);
-		std::vector<std::pair<nano::block_hash, nano::root>> roots_hashes_l;
-		for (auto const & root_hash : request_queue.second)
-		{
-			roots_hashes_l.push_back (root_hash);
-			if (roots_hashes_l.size () == nano::network::confirm_req_hashes_max)
-			{
-				nano::confirm_req req (roots_hashes_l);
-				channel->send (req);
-				roots_hashes_l.clear ();
-			}
-		}
-		if (!roots_hashes_l.empty ())
-		{
-			nano::confirm_req req (roots_hashes_l);
-			channel->send (req);
-		}
+		std::vector<std::pair<nano::block_hash, nano::root>> roots_hashes_l (request_queue.second.begin (), request_queue.second.end ());
+		network.coalescer.add_confirm_req (request_queue.first, roots_hashes_l);
 	}
 	prepared = false;
 }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <nano/lib/utility.hpp>
+
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+namespace nano
+{
+/**
+ * Queue holding a separate FIFO for each source that is dequeued in weighted round robin order, so that a single source
+ * cannot starve the others no matter how much it queues. Each time a source comes up it may dequeue as many items as
+ * its weight before the next source gets its turn. Weights are looked up when a source's turn starts.
+ * This class is not thread safe.
+ */
+template <typename Source, typename T>
+class fair_queue final
+{
+public:
+	/** Sources have a weight of 1 without a \p weight_a function */
+	explicit fair_queue (std::function<size_t (Source const &)> weight_a = nullptr) :
+		weight (std::move (weight_a))
+	{
+	}
+
+	void push (Source const & source_a, T item_a)
+	{
+		auto existing (queues.find (source_a));
+		if (existing == queues.end ())
+		{
+			existing = queues.emplace (source_a, source_queue{}).first;
+			order.push_back (source_a);
+		}
+		existing->second.items.push_back (std::move (item_a));
+		++total;
+	}
+
+	/** Removes the next item, the queue must not be empty */
+	T pop ()
+	{
+		debug_assert (!empty ());
+		auto const source (order.front ());
+		auto & queue (queues.at (source));
+		if (queue.credit == 0)
+		{
+			queue.credit = std::max<size_t> (weight ? weight (source) : 1, 1);
+		}
+		T result (std::move (queue.items.front ()));
+		queue.items.pop_front ();
+		--queue.credit;
+		--total;
+		if (queue.items.empty ())
+		{
+			queues.erase (source);
+			order.pop_front ();
+		}
+		else if (queue.credit == 0)
+		{
+			order.pop_front ();
+			order.push_back (source);
+		}
+		return result;
+	}
+
+	size_t size () const
+	{
+		return total;
+	}
+
+	bool empty () const
+	{
+		return total == 0;
+	}
+
+	/** Number of items queued by \p source_a */
+	size_t size (Source const & source_a) const
+	{
+		auto existing (queues.find (source_a));
+		return existing != queues.end () ? existing->second.items.size () : 0;
+	}
+
+	/** Number of sources with queued items */
+	size_t sources () const
+	{
+		return queues.size ();
+	}
+
+	void clear ()
+	{
+		queues.clear ();
+		order.clear ();
+		total = 0;
+	}
+
+private:
+	class source_queue final
+	{
+	public:
+		std::deque<T> items;
+		/** Items left to dequeue in the current turn of the source */
+		size_t credit{ 0 };
+	};
+
+	std::function<size_t (Source const &)> weight;
+	std::unordered_map<Source, source_queue> queues;
+	/** Sources with queued items in round robin order, the front source has the current turn */
+	std::deque<Source> order;
+	size_t total{ 0 };
+};
+}
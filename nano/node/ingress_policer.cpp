@@ -0,0 +1,77 @@
+#include <nano/node/ingress_policer.hpp>
+#include <nano/node/transport/transport.hpp>
+
+nano::ingress_policer::ingress_policer (size_t rate_a, size_t burst_a) :
+	rate (rate_a),
+	burst (std::max (rate_a, burst_a))
+{
+}
+
+bool nano::ingress_policer::drop (nano::endpoint const & endpoint_a, nano::message_type type_a)
+{
+	auto result (false);
+	if (rate != 0)
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto & peer_l (peers[nano::transport::map_endpoint_to_v6 (endpoint_a)]);
+		peer_l.last_message = std::chrono::steady_clock::now ();
+		auto existing (peer_l.buckets.find (type_a));
+		if (existing == peer_l.buckets.end ())
+		{
+			existing = peer_l.buckets.emplace (std::piecewise_construct, std::forward_as_tuple (type_a), std::forward_as_tuple (burst, rate)).first;
+		}
+		result = !existing->second.try_consume ();
+		if (result)
+		{
+			++peer_l.drops;
+		}
+	}
+	return result;
+}
+
+uint64_t nano::ingress_policer::drops (nano::endpoint const & endpoint_a) const
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto existing (peers.find (nano::transport::map_endpoint_to_v6 (endpoint_a)));
+	return existing != peers.end () ? existing->second.drops : 0;
+}
+
+void nano::ingress_policer::purge (std::chrono::steady_clock::time_point const & cutoff_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	for (auto i (peers.begin ()), n (peers.end ()); i != n;)
+	{
+		if (i->second.last_message < cutoff_a)
+		{
+			i = peers.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+size_t nano::ingress_policer::size () const
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return peers.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (ingress_policer & policer, std::string const & name)
+{
+	size_t peers_count;
+	size_t buckets_count (0);
+	{
+		nano::lock_guard<nano::mutex> guard (policer.mutex);
+		peers_count = policer.peers.size ();
+		for (auto const & peer : policer.peers)
+		{
+			buckets_count += peer.second.buckets.size ();
+		}
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", peers_count, sizeof (decltype (policer.peers)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "buckets", buckets_count, sizeof (nano::rate::token_bucket) }));
+	return composite;
+}
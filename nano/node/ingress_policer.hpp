@@ -0,0 +1,51 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/rate_limiting.hpp>
+#include <nano/node/common.hpp>
+
+#include <chrono>
+#include <unordered_map>
+
+namespace nano
+{
+/**
+ * Polices inbound messages with a token bucket for each peer and message type, so a single peer flooding one kind of
+ * message cannot fill the processing queues. Messages above the rate are dropped and counted for the peer.
+ */
+class ingress_policer final
+{
+public:
+	/**
+	 * @param rate_a Messages of each type accepted from a peer per second, 0 disables policing
+	 * @param burst_a Messages of each type a peer can send in a burst
+	 */
+	ingress_policer (size_t rate_a, size_t burst_a);
+	/** Returns true if a message of type \p type_a from \p endpoint_a exceeds the rate and should be dropped */
+	bool drop (nano::endpoint const & endpoint_a, nano::message_type type_a);
+	/** Number of messages dropped from \p endpoint_a */
+	uint64_t drops (nano::endpoint const & endpoint_a) const;
+	/** Forget peers that sent nothing since \p cutoff_a */
+	void purge (std::chrono::steady_clock::time_point const & cutoff_a);
+	size_t size () const;
+
+	size_t const rate;
+	size_t const burst;
+
+private:
+	class peer final
+	{
+	public:
+		std::unordered_map<nano::message_type, nano::rate::token_bucket> buckets;
+		uint64_t drops{ 0 };
+		std::chrono::steady_clock::time_point last_message;
+	};
+
+	mutable nano::mutex mutex;
+	std::unordered_map<nano::endpoint, peer> peers;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (ingress_policer &, std::string const &);
+};
+
+std::unique_ptr<container_info_component> collect_container_info (ingress_policer &, std::string const &);
+}
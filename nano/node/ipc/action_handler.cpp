@@ -2,10 +2,12 @@
 #include <nano/lib/errors.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/node/ipc/action_handler.hpp>
+#include <nano/node/ipc/flatbuffers_util.hpp>
 #include <nano/node/ipc/ipc_server.hpp>
 #include <nano/node/node.hpp>
 
 #include <iostream>
+#include <limits>
 
 namespace
 {
@@ -27,6 +29,37 @@ nano::account parse_account (std::string const & account, bool & out_is_deprecat
 
 	return result;
 }
+/** Returns the error as a Flatbuffers ObjectAPI type, used for errors concerning single entries of bulk requests */
+std::unique_ptr<nanoapi::ErrorT> to_error (std::error_code const & code_a)
+{
+	auto result (std::make_unique<nanoapi::ErrorT> ());
+	result->code = code_a.value ();
+	result->message = code_a.message ();
+	return result;
+}
+
+std::unique_ptr<nanoapi::BlockInfoT> to_block_info (nano::node & node_a, nano::transaction const & transaction_a, nano::block const & block_a)
+{
+	auto const hash (block_a.hash ());
+	auto const & sideband (block_a.sideband ());
+	auto result (std::make_unique<nanoapi::BlockInfoT> ());
+	result->hash = hash.to_string ();
+	result->account = (block_a.account ().is_zero () ? sideband.account : block_a.account ()).to_account ();
+	bool error_or_pruned (false);
+	auto const amount (node_a.ledger.amount_safe (transaction_a, hash, error_or_pruned));
+	if (!error_or_pruned)
+	{
+		result->amount = amount.convert_to<std::string> ();
+	}
+	result->balance = node_a.ledger.balance (transaction_a, hash).convert_to<std::string> ();
+	result->height = sideband.height;
+	result->local_timestamp = sideband.timestamp;
+	result->successor = sideband.successor.to_string ();
+	result->confirmed = node_a.ledger.block_confirmed (transaction_a, hash);
+	result->block = nano::ipc::flatbuffers_builder::block_to_union (block_a, amount, sideband.details.is_send);
+	return result;
+}
+
 /** Returns the message as a Flatbuffers ObjectAPI type, managed by a unique_ptr */
 template <typename T>
 auto get_message (nanoapi::Envelope const & envelope)
@@ -51,6 +84,12 @@ auto nano::ipc::action_handler::handler_map () -> std::unordered_map<nanoapi::Me
 		handlers.emplace (nanoapi::Message::Message_ServiceRegister, &nano::ipc::action_handler::on_service_register);
 		handlers.emplace (nanoapi::Message::Message_ServiceStop, &nano::ipc::action_handler::on_service_stop);
 		handlers.emplace (nanoapi::Message::Message_TopicServiceStop, &nano::ipc::action_handler::on_topic_service_stop);
+		handlers.emplace (nanoapi::Message::Message_AccountsInfo, &nano::ipc::action_handler::on_accounts_info);
+		handlers.emplace (nanoapi::Message::Message_AccountsBalances, &nano::ipc::action_handler::on_accounts_balances);
+		handlers.emplace (nanoapi::Message::Message_BlocksInfo, &nano::ipc::action_handler::on_blocks_info);
+		handlers.emplace (nanoapi::Message::Message_AccountsPending, &nano::ipc::action_handler::on_accounts_pending);
+		handlers.emplace (nanoapi::Message::Message_Frontiers, &nano::ipc::action_handler::on_frontiers);
+		handlers.emplace (nanoapi::Message::Message_AccountHistory, &nano::ipc::action_handler::on_account_history);
 	}
 	return handlers;
 }
@@ -116,6 +155,286 @@ void nano::ipc::action_handler::on_account_weight (nanoapi::Envelope const & env
 	create_response (response);
 }
 
+void nano::ipc::action_handler::set_chunk_handler (std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & chunk_handler_a)
+{
+	chunk_handler = chunk_handler_a;
+}
+
+size_t nano::ipc::action_handler::chunk_size (uint32_t chunk_size_a) const
+{
+	size_t result (std::numeric_limits<size_t>::max ());
+	if (chunk_handler)
+	{
+		result = chunk_size_a == 0 ? chunk_size_default : chunk_size_a;
+	}
+	return result;
+}
+
+template <typename T, typename U>
+void nano::ipc::action_handler::send_chunk (T & response_a, std::vector<U> & entries_a, nano::read_transaction const & transaction_a)
+{
+	debug_assert (chunk_handler);
+	response_a.more = true;
+	create_response (response_a);
+	// Writing the chunk may wait on the client, don't pin a ledger snapshot meanwhile
+	transaction_a.reset ();
+	try
+	{
+		chunk_handler (take_shared_flatbuffer ());
+	}
+	catch (...)
+	{
+		transaction_a.renew ();
+		throw;
+	}
+	transaction_a.renew ();
+	response_a.more = false;
+	entries_a.clear ();
+}
+
+void nano::ipc::action_handler::on_accounts_info (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_accounts_info, nano::ipc::access_permission::account_query });
+	auto query (get_message<nanoapi::AccountsInfo> (envelope_a));
+	auto const chunk_size_l (chunk_size (query->chunk_size));
+	nanoapi::AccountsInfoResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & account_text : query->accounts)
+	{
+		if (response.accounts.size () == chunk_size_l)
+		{
+			send_chunk (response, response.accounts, transaction);
+		}
+		auto entry (std::make_unique<nanoapi::AccountInfoT> ());
+		entry->account = account_text;
+		nano::account account;
+		nano::account_info info;
+		if (account.decode_account (account_text))
+		{
+			entry->error = to_error (nano::error_common::bad_account_number);
+		}
+		else if (node.store.account.get (transaction, account, info))
+		{
+			entry->error = to_error (nano::error_common::account_not_found);
+		}
+		else
+		{
+			nano::confirmation_height_info confirmation_height_info;
+			node.store.confirmation_height.get (transaction, account, confirmation_height_info);
+			entry->frontier = info.head.to_string ();
+			entry->open_block = info.open_block.to_string ();
+			entry->representative_block = node.ledger.representative (transaction, info.head).to_string ();
+			entry->representative = info.representative.to_account ();
+			entry->balance = info.balance.to_string_dec ();
+			entry->modified_timestamp = info.modified;
+			entry->block_count = info.block_count;
+			entry->confirmation_height = confirmation_height_info.height;
+			entry->confirmation_height_frontier = confirmation_height_info.frontier.to_string ();
+			if (query->include_weight)
+			{
+				entry->weight = node.ledger.weight (account).convert_to<std::string> ();
+			}
+			if (query->include_receivable)
+			{
+				entry->receivable = node.ledger.account_pending (transaction, account).convert_to<std::string> ();
+			}
+		}
+		response.accounts.push_back (std::move (entry));
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_accounts_balances (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_accounts_balances, nano::ipc::access_permission::account_query });
+	auto query (get_message<nanoapi::AccountsBalances> (envelope_a));
+	auto const chunk_size_l (chunk_size (query->chunk_size));
+	nanoapi::AccountsBalancesResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & account_text : query->accounts)
+	{
+		if (response.balances.size () == chunk_size_l)
+		{
+			send_chunk (response, response.balances, transaction);
+		}
+		auto entry (std::make_unique<nanoapi::AccountBalanceT> ());
+		entry->account = account_text;
+		nano::account account;
+		if (account.decode_account (account_text))
+		{
+			entry->error = to_error (nano::error_common::bad_account_number);
+		}
+		else
+		{
+			entry->balance = node.ledger.account_balance (transaction, account).convert_to<std::string> ();
+			entry->receivable = node.ledger.account_pending (transaction, account).convert_to<std::string> ();
+		}
+		response.balances.push_back (std::move (entry));
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_blocks_info (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_blocks_info, nano::ipc::access_permission::account_query });
+	auto query (get_message<nanoapi::BlocksInfo> (envelope_a));
+	auto const chunk_size_l (chunk_size (query->chunk_size));
+	nanoapi::BlocksInfoResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & hash_text : query->hashes)
+	{
+		if (response.blocks.size () == chunk_size_l)
+		{
+			send_chunk (response, response.blocks, transaction);
+		}
+		nano::block_hash hash;
+		std::shared_ptr<nano::block> block;
+		if (hash.decode_hex (hash_text))
+		{
+			response.blocks.push_back (std::make_unique<nanoapi::BlockInfoT> ());
+			response.blocks.back ()->error = to_error (nano::error_blocks::bad_hash_number);
+		}
+		else if ((block = node.store.block.get (transaction, hash)) == nullptr)
+		{
+			response.blocks.push_back (std::make_unique<nanoapi::BlockInfoT> ());
+			response.blocks.back ()->error = to_error (nano::error_blocks::not_found);
+		}
+		else
+		{
+			response.blocks.push_back (to_block_info (node, transaction, *block));
+		}
+		response.blocks.back ()->hash = hash_text;
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_accounts_pending (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_accounts_pending, nano::ipc::access_permission::account_query });
+	auto query (get_message<nanoapi::AccountsPending> (envelope_a));
+	nano::amount threshold (0);
+	if (!query->threshold.empty () && threshold.decode_dec (query->threshold))
+	{
+		throw nano::error (nano::error_common::bad_threshold);
+	}
+	auto const chunk_size_l (chunk_size (query->chunk_size));
+	nanoapi::AccountsPendingResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	for (auto const & account_text : query->accounts)
+	{
+		if (response.accounts.size () == chunk_size_l)
+		{
+			send_chunk (response, response.accounts, transaction);
+		}
+		auto entry (std::make_unique<nanoapi::AccountPendingT> ());
+		entry->account = account_text;
+		nano::account account;
+		if (account.decode_account (account_text))
+		{
+			entry->error = to_error (nano::error_common::bad_account_number);
+		}
+		else
+		{
+			for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && entry->blocks.size () < query->count; ++i)
+			{
+				nano::pending_info const & info (i->second);
+				if (info.amount.number () >= threshold.number ())
+				{
+					auto pending (std::make_unique<nanoapi::PendingBlockT> ());
+					pending->hash = nano::pending_key (i->first).hash.to_string ();
+					pending->amount = info.amount.to_string_dec ();
+					pending->source = info.source.to_account ();
+					entry->blocks.push_back (std::move (pending));
+				}
+			}
+		}
+		response.accounts.push_back (std::move (entry));
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_frontiers (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_frontiers, nano::ipc::access_permission::account_query });
+	auto query (get_message<nanoapi::Frontiers> (envelope_a));
+	nano::account start (0);
+	if (!query->start.empty ())
+	{
+		bool is_deprecated_format{ false };
+		start = parse_account (query->start, is_deprecated_format);
+	}
+	auto const chunk_size_l (chunk_size (query->chunk_size));
+	nanoapi::FrontiersResponseT response;
+	auto transaction (node.store.tx_begin_read ());
+	uint64_t count (0);
+	for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && count < query->count; ++i, ++count)
+	{
+		if (response.frontiers.size () == chunk_size_l)
+		{
+			// The iterator doesn't outlive the transaction being released, resume from the current account
+			nano::account const next (i->first);
+			i = node.store.account.end ();
+			send_chunk (response, response.frontiers, transaction);
+			i = node.store.account.begin (transaction, next);
+			if (i == n)
+			{
+				break;
+			}
+		}
+		auto entry (std::make_unique<nanoapi::FrontierT> ());
+		entry->account = i->first.to_account ();
+		entry->hash = i->second.head.to_string ();
+		response.frontiers.push_back (std::move (entry));
+	}
+	create_response (response);
+}
+
+void nano::ipc::action_handler::on_account_history (nanoapi::Envelope const & envelope_a)
+{
+	require_oneof (envelope_a, { nano::ipc::access_permission::api_account_history, nano::ipc::access_permission::account_query });
+	auto query (get_message<nanoapi::AccountHistory> (envelope_a));
+	bool is_deprecated_format{ false };
+	auto const account (parse_account (query->account, is_deprecated_format));
+	auto transaction (node.store.tx_begin_read ());
+	nano::block_hash hash (0);
+	if (query->head.empty ())
+	{
+		hash = node.ledger.latest (transaction, account);
+	}
+	else if (hash.decode_hex (query->head))
+	{
+		throw nano::error (nano::error_blocks::bad_hash_number);
+	}
+	else if (!node.store.block.exists (transaction, hash) || node.ledger.account (transaction, hash) != account)
+	{
+		throw nano::error (nano::error_blocks::not_found);
+	}
+	auto const chunk_size_l (chunk_size (query->chunk_size));
+	nanoapi::AccountHistoryResponseT response;
+	response.account = account.to_account ();
+	for (uint64_t count (0); !hash.is_zero () && count < query->count; ++count)
+	{
+		auto block (node.store.block.get (transaction, hash));
+		if (block == nullptr)
+		{
+			// The rest of the chain is pruned
+			hash.clear ();
+			break;
+		}
+		if (response.history.size () == chunk_size_l)
+		{
+			send_chunk (response, response.history, transaction);
+		}
+		response.history.push_back (to_block_info (node, transaction, *block));
+		hash = block->previous ();
+	}
+	if (!hash.is_zero ())
+	{
+		response.previous = hash.to_string ();
+	}
+	create_response (response);
+}
+
 void nano::ipc::action_handler::on_is_alive (nanoapi::Envelope const & envelope)
 {
 	nanoapi::IsAliveT alive;
@@ -13,6 +13,7 @@
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <flatbuffers/flatbuffers.h>
 #include <flatbuffers/idl.h>
@@ -24,6 +25,7 @@ namespace nano
 {
 class error;
 class node;
+class read_transaction;
 namespace ipc
 {
 	class ipc_server;
@@ -52,6 +54,25 @@ namespace ipc
 		/** Subscribe to the ServiceStop event. The service must first have registered itself on the same session. */
 		void on_topic_service_stop (nanoapi::Envelope const & envelope);
 
+		/** Bulk ledger reads. These may produce the response in several chunks if a chunk handler is set. */
+		void on_accounts_info (nanoapi::Envelope const & envelope);
+		void on_accounts_balances (nanoapi::Envelope const & envelope);
+		void on_blocks_info (nanoapi::Envelope const & envelope);
+		void on_accounts_pending (nanoapi::Envelope const & envelope);
+		void on_frontiers (nanoapi::Envelope const & envelope);
+		void on_account_history (nanoapi::Envelope const & envelope);
+
+		/**
+		 * Set a handler receiving every response chunk except the last, which is left in the flatbuffer as usual.
+		 * Without a chunk handler, responses are never split. The handler is called synchronously, so blocking in it
+		 * throttles production of the response, and a nano::error it throws aborts the request. No read transaction
+		 * is held while it runs.
+		 */
+		void set_chunk_handler (std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & chunk_handler_a);
+
+		/** Number of entries per response chunk if the request doesn't specify one */
+		static uint32_t constexpr chunk_size_default = 1000;
+
 		/** Returns a mapping from api message types to handler functions */
 		static auto handler_map () -> std::unordered_map<nanoapi::Message, std::function<void (action_handler *, nanoapi::Envelope const &)>, nano::ipc::enum_hash>;
 
@@ -63,9 +84,19 @@ namespace ipc
 		void require_all (nanoapi::Envelope const & envelope_a, std::initializer_list<nano::ipc::access_permission> permissions_a) const;
 		void require_oneof (nanoapi::Envelope const & envelope_a, std::initializer_list<nano::ipc::access_permission> alternative_permissions_a) const;
 
+		/** Returns the number of entries per chunk given the \p chunk_size_a requested */
+		size_t chunk_size (uint32_t chunk_size_a) const;
+		/**
+		 * Sends \p response_a as a chunk and clears its \p entries_a, so the remaining entries can be added.
+		 * \p transaction_a is reset while the chunk handler runs and renewed afterwards, so iterators must be re-seeked.
+		 */
+		template <typename T, typename U>
+		void send_chunk (T & response_a, std::vector<U> & entries_a, nano::read_transaction const & transaction_a);
+
 		nano::node & node;
 		nano::ipc::ipc_server & ipc_server;
 		std::weak_ptr<nano::ipc::subscriber> subscriber;
+		std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> chunk_handler;
 	};
 }
 }
@@ -145,10 +145,14 @@ std::function<void (std::shared_ptr<std::string> const &)> const & response_hand
 }
 
 void nano::ipc::flatbuffers_handler::process (const uint8_t * message_buffer_a, size_t buffer_size_a,
-std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler)
+std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler, std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & chunk_handler)
 {
 	auto buffer_l (std::make_shared<flatbuffers::FlatBufferBuilder> ());
 	auto actionhandler (std::make_shared<action_handler> (node, ipc_server, subscriber, buffer_l));
+	if (chunk_handler)
+	{
+		actionhandler->set_chunk_handler (chunk_handler);
+	}
 	std::string correlationId = "";
 
 	// Find and call the action handler
@@ -170,7 +174,7 @@ std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> co
 		{
 			nano::error err ("Invalid message");
 			actionhandler->make_error (err.error_code_as_int (), err.get_message ());
-			response_handler (buffer_l);
+			response_handler (actionhandler->get_shared_flatbuffer ());
 			return;
 		}
 
@@ -194,5 +198,6 @@ std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> co
 		actionhandler->make_error (err.error_code_as_int (), err.get_message ());
 	}
 
-	response_handler (buffer_l);
+	// Chunked responses replace the flatbuffer, so the last chunk is not necessarily in buffer_l
+	response_handler (actionhandler->get_shared_flatbuffer ());
 }
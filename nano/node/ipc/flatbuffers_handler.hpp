@@ -40,9 +40,12 @@ namespace ipc
 		 * Deserialize flatbuffer message, look up and call the action handler, then call the response handler with a
 		 * FlatBufferBuilder to allow for zero-copy transfers of data.
 		 * @param response_handler Receives a shared pointer to the flatbuffer builder, from which the buffer and size can be queried
+		 * @param chunk_handler If set, large responses are split. This receives every chunk but the last, which goes to \p response_handler.
+		 * It may block until the chunk is written, so process() must then run on a thread allowed to wait, and throw nano::error
+		 * to fail the request with an error response.
 		 * @throw Throws std:runtime_error on deserialization or processing errors
 		 */
-		void process (const uint8_t * message_buffer_a, size_t buffer_size_a, std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler);
+		void process (const uint8_t * message_buffer_a, size_t buffer_size_a, std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & response_handler, std::function<void (std::shared_ptr<flatbuffers::FlatBufferBuilder> const &)> const & chunk_handler = nullptr);
 
 		/**
 		 * Parses a JSON encoded requests into Flatbuffer format, calls process(), yields the result as a JSON string
@@ -20,6 +20,18 @@ nano::ipc::access_permission from_string (std::string permission)
 		return nano::ipc::access_permission::api_topic_service_stop;
 	if (permission == "api_topic_confirmation")
 		return nano::ipc::access_permission::api_topic_confirmation;
+	if (permission == "api_accounts_info")
+		return nano::ipc::access_permission::api_accounts_info;
+	if (permission == "api_accounts_balances")
+		return nano::ipc::access_permission::api_accounts_balances;
+	if (permission == "api_blocks_info")
+		return nano::ipc::access_permission::api_blocks_info;
+	if (permission == "api_accounts_pending")
+		return nano::ipc::access_permission::api_accounts_pending;
+	if (permission == "api_frontiers")
+		return nano::ipc::access_permission::api_frontiers;
+	if (permission == "api_account_history")
+		return nano::ipc::access_permission::api_account_history;
 	if (permission == "account_query")
 		return nano::ipc::access_permission::account_query;
 	if (permission == "epoch_upgrade")
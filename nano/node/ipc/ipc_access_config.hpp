@@ -54,6 +54,12 @@ namespace ipc
 		api_service_stop,
 		api_topic_service_stop,
 		api_topic_confirmation,
+		api_accounts_info,
+		api_accounts_balances,
+		api_blocks_info,
+		api_accounts_pending,
+		api_frontiers,
+		api_account_history,
 		/** Query account information */
 		account_query,
 		/** Epoch upgrade */
@@ -21,6 +21,8 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstring>
+#include <future>
 #include <list>
 
 #include <flatbuffers/flatbuffers.h>
@@ -138,7 +140,10 @@ public:
 		return subscriber;
 	}
 
-	/** Write a fixed array of buffers through the queue. Once the last item is completed, the callback is invoked */
+	/**
+	 * Write a fixed array of buffers through the queue. Once the last item is completed, the callback is invoked.
+	 * If the queue is full, nothing is written and the callback is invoked with boost::asio::error::no_buffer_space.
+	 */
 	template <std::size_t N>
 	void queued_write (boost::array<boost::asio::const_buffer, N> & buffers, std::function<void (boost::system::error_code const &, size_t)> callback_a)
 	{
@@ -146,14 +151,17 @@ public:
 		boost::asio::post (strand, boost::asio::bind_executor (strand, [buffers, callback_a, this_l] () {
 			bool write_in_progress = !this_l->send_queue.empty ();
 			auto queue_size = this_l->send_queue.size ();
-			if (queue_size < this_l->queue_size_max)
+			if (queue_size + N > this_l->queue_size_max)
 			{
-				for (size_t i = 0; i < N - 1; i++)
-				{
-					this_l->send_queue.emplace_back (queue_item{ buffers[i], nullptr });
-				}
-				this_l->send_queue.emplace_back (queue_item{ buffers[N - 1], callback_a });
+				// Never drop part of a message silently, the writer decides how to fail
+				callback_a (boost::asio::error::no_buffer_space, 0);
+				return;
 			}
+			for (size_t i = 0; i < N - 1; i++)
+			{
+				this_l->send_queue.emplace_back (queue_item{ buffers[i], nullptr });
+			}
+			this_l->send_queue.emplace_back (queue_item{ buffers[N - 1], callback_a });
 			if (!write_in_progress)
 			{
 				this_l->write_queued_messages ();
@@ -163,7 +171,7 @@ public:
 
 	/**
 	 * Write to underlying socket. Writes goes through a queue protected by the strand. Thus, this function
-	 * can be called concurrently with other writes.
+	 * can be called concurrently with other writes. If the queue is full, the callback is invoked with boost::asio::error::no_buffer_space.
 	 * @note This function explicitely doesn't use nano::shared_const_buffer, as buffers usually originate from Flatbuffers
 	 * and copying into the shared_const_buffer vector would impose a significant overhead for large requests and responses.
 	 */
@@ -173,10 +181,12 @@ public:
 		boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback_a, this_l] () {
 			bool write_in_progress = !this_l->send_queue.empty ();
 			auto queue_size = this_l->send_queue.size ();
-			if (queue_size < this_l->queue_size_max)
+			if (queue_size >= this_l->queue_size_max)
 			{
-				this_l->send_queue.emplace_back (queue_item{ buffer_a, callback_a });
+				callback_a (boost::asio::error::no_buffer_space, 0);
+				return;
 			}
+			this_l->send_queue.emplace_back (queue_item{ buffer_a, callback_a });
 			if (!write_in_progress)
 			{
 				this_l->write_queued_messages ();
@@ -188,13 +198,13 @@ public:
 	{
 		std::weak_ptr<session> this_w (this->shared_from_this ());
 		auto msg (send_queue.front ());
-		timer_start (std::chrono::seconds (config_transport.io_timeout));
+		timer_start (std::chrono::seconds (config_transport.io_timeout), io_direction::write);
 		nano::unsafe_async_write (socket, msg.buffer,
 		boost::asio::bind_executor (strand,
 		[msg, this_w] (boost::system::error_code ec, std::size_t size_a) {
 			if (auto this_l = this_w.lock ())
 			{
-				this_l->timer_cancel ();
+				this_l->timer_cancel (io_direction::write);
 
 				if (msg.callback)
 				{
@@ -226,14 +236,14 @@ public:
 	 */
 	void async_read_exactly (void * buff_a, size_t size_a, std::chrono::seconds timeout_a, std::function<void ()> const & callback_a)
 	{
-		timer_start (timeout_a);
+		timer_start (timeout_a, io_direction::read);
 		auto this_l (this->shared_from_this ());
 		boost::asio::async_read (socket,
 		boost::asio::buffer (buff_a, size_a),
 		boost::asio::transfer_exactly (size_a),
 		boost::asio::bind_executor (strand,
 		[this_l, callback_a] (boost::system::error_code const & ec, size_t bytes_transferred_a) {
-			this_l->timer_cancel ();
+			this_l->timer_cancel (io_direction::read);
 			if (ec == boost::asio::error::broken_pipe || ec == boost::asio::error::connection_aborted || ec == boost::asio::error::connection_reset || ec == boost::asio::error::connection_refused)
 			{
 				if (this_l->node.config.logging.log_ipc ())
@@ -267,9 +277,9 @@ public:
 				this_l->node.logger.always_log (boost::str (boost::format ("IPC/RPC request %1% completed in: %2% %3%") % request_id_l % this_l->session_timer.stop ().count () % this_l->session_timer.unit ()));
 			}
 
-			this_l->timer_start (std::chrono::seconds (this_l->config_transport.io_timeout));
+			this_l->timer_start (std::chrono::seconds (this_l->config_transport.io_timeout), io_direction::write);
 			this_l->queued_write (boost::asio::buffer (buffer->data (), buffer->size ()), [this_l, buffer] (boost::system::error_code const & error_a, size_t size_a) {
-				this_l->timer_cancel ();
+				this_l->timer_cancel (io_direction::write);
 				if (!error_a)
 				{
 					this_l->read_next_request ();
@@ -287,14 +297,169 @@ public:
 		auto body (std::string (reinterpret_cast<char *> (buffer.data ()), buffer.size ()));
 
 		// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
-		auto handler (std::make_shared<nano::json_handler> (node, server.node_rpc_config, body, response_handler_l, [&server = server] () {
+		auto handler (std::make_shared<nano::json_handler> (node, server.node_rpc_config, body, response_handler_l, stop_callback ()));
+		// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
+		handler->process_request (allow_unsafe && config_transport.allow_unsafe);
+	}
+
+	/** Invoked by the stop action */
+	std::function<void ()> stop_callback ()
+	{
+		return [&server = server] () {
 			server.stop ();
 			server.node.workers.add_timed_task (std::chrono::steady_clock::now () + std::chrono::seconds (3), [&io_ctx = server.node.io_ctx] () {
 				io_ctx.stop ();
 			});
-		}));
-		// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
-		handler->process_request (allow_unsafe && config_transport.allow_unsafe);
+		};
+	}
+
+	/**
+	 * Reads the remainder of a payload_encoding::multiplexed request, hands it off and reads the next request without awaiting
+	 * the response. Reading pauses while multiplexed_requests_max requests are in flight.
+	 */
+	void read_multiplexed_request ()
+	{
+		auto this_l = this->shared_from_this ();
+		// Request id followed by the preamble of the enclosed request
+		buffer.resize (sizeof (uint32_t) + sizeof (buffer_size));
+		async_read_exactly (buffer.data (), buffer.size (), [this_l] () {
+			uint32_t request_id (0);
+			std::memcpy (&request_id, this_l->buffer.data (), sizeof (request_id));
+			boost::endian::big_to_native_inplace (request_id);
+			auto const preamble (this_l->buffer.data () + sizeof (request_id));
+			auto const encoding (static_cast<nano::ipc::payload_encoding> (preamble[nano::ipc::preamble_offset::encoding]));
+			auto const supported (encoding == nano::ipc::payload_encoding::json_v1 || encoding == nano::ipc::payload_encoding::json_v1_unsafe || encoding == nano::ipc::payload_encoding::flatbuffers_json);
+			if (preamble[nano::ipc::preamble_offset::lead] != 'N' || preamble[nano::ipc::preamble_offset::reserved_1] != 0 || preamble[nano::ipc::preamble_offset::reserved_2] != 0 || !supported)
+			{
+				if (this_l->node.config.logging.log_ipc ())
+				{
+					this_l->node.logger.always_log ("IPC: Invalid multiplexed request");
+				}
+			}
+			else
+			{
+				// Length of payload
+				this_l->async_read_exactly (&this_l->buffer_size, sizeof (this_l->buffer_size), [this_l, request_id, encoding] () {
+					boost::endian::big_to_native_inplace (this_l->buffer_size);
+					// Each request gets its own buffer as the session buffer is reused by the next read
+					auto payload (std::make_shared<std::vector<uint8_t>> (this_l->buffer_size));
+					this_l->async_read_exactly (payload->data (), payload->size (), [this_l, request_id, encoding, payload] () {
+						++this_l->multiplexed_requests;
+						this_l->handle_multiplexed_request (request_id, encoding, payload);
+						if (this_l->multiplexed_requests < this_l->multiplexed_requests_max)
+						{
+							this_l->read_next_request ();
+						}
+					});
+				});
+			}
+		});
+	}
+
+	/** Handler for requests enclosed in payload_encoding::multiplexed */
+	void handle_multiplexed_request (uint32_t request_id_a, nano::ipc::payload_encoding encoding_a, std::shared_ptr<std::vector<uint8_t>> const & payload_a)
+	{
+		auto this_l (this->shared_from_this ());
+		auto const start (std::chrono::steady_clock::now ());
+		auto response_handler_l ([this_l, request_id_a, start] (std::string const & body_a) {
+			this_l->write_multiplexed_response (request_id_a, start, body_a);
+		});
+
+		node.stats.inc (nano::stat::type::ipc, nano::stat::detail::invocations);
+		if (encoding_a == nano::ipc::payload_encoding::flatbuffers_json)
+		{
+			// The Flatbuffers handler holds a parser which is not thread safe, so these requests are processed on the strand
+			if (!flatbuffers_handler)
+			{
+				flatbuffers_handler = std::make_shared<nano::ipc::flatbuffers_handler> (node, server, get_subscriber (), node.config.ipc_config);
+			}
+			flatbuffers_handler->process_json (payload_a->data (), payload_a->size (), [response_handler_l] (std::shared_ptr<std::string> const & body_a) {
+				response_handler_l (*body_a);
+			});
+		}
+		else
+		{
+			// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
+			auto const allow_unsafe (encoding_a == nano::ipc::payload_encoding::json_v1_unsafe && config_transport.allow_unsafe);
+			node.workers.push_task ([this_l, payload_a, allow_unsafe, response_handler_l] () {
+				auto body (std::string (reinterpret_cast<char *> (payload_a->data ()), payload_a->size ()));
+				auto handler (std::make_shared<nano::json_handler> (this_l->node, this_l->server.node_rpc_config, body, response_handler_l, this_l->stop_callback ()));
+				handler->process_request (allow_unsafe);
+			});
+		}
+	}
+
+	/** Writes a response tagged with its request id. Responses are written in completion order, which may differ from the request order. */
+	void write_multiplexed_response (uint32_t request_id_a, std::chrono::steady_clock::time_point const & start_a, std::string const & body_a)
+	{
+		if (node.config.logging.log_ipc ())
+		{
+			auto const elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - start_a));
+			node.logger.always_log (boost::str (boost::format ("IPC multiplexed request %1% completed in: %2% microseconds") % request_id_a % elapsed.count ()));
+		}
+
+		auto big_length (boost::endian::native_to_big (static_cast<uint32_t> (sizeof (request_id_a) + body_a.size ())));
+		auto big_request_id (boost::endian::native_to_big (request_id_a));
+		auto buffer (std::make_shared<std::vector<uint8_t>> ());
+		buffer->reserve (sizeof (big_length) + sizeof (big_request_id) + body_a.size ());
+		buffer->insert (buffer->end (), reinterpret_cast<std::uint8_t *> (&big_length), reinterpret_cast<std::uint8_t *> (&big_length) + sizeof (big_length));
+		buffer->insert (buffer->end (), reinterpret_cast<std::uint8_t *> (&big_request_id), reinterpret_cast<std::uint8_t *> (&big_request_id) + sizeof (big_request_id));
+		buffer->insert (buffer->end (), body_a.begin (), body_a.end ());
+
+		auto this_l (this->shared_from_this ());
+		queued_write (boost::asio::buffer (buffer->data (), buffer->size ()), [this_l, buffer] (boost::system::error_code const & error_a, size_t size_a) {
+			// Write completions run on the strand, same as reads, so the in-flight count needs no further synchronization
+			auto const paused (this_l->multiplexed_requests == this_l->multiplexed_requests_max);
+			--this_l->multiplexed_requests;
+			if (error_a)
+			{
+				if (this_l->node.config.logging.log_ipc ())
+				{
+					this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+				}
+			}
+			else if (paused)
+			{
+				this_l->read_next_request ();
+			}
+		});
+	}
+
+	/**
+	 * Writes a chunk preceding the final response and waits for the write to complete, so a response is never produced
+	 * faster than the client reads it. Called from the request pool thread processing the request.
+	 * @throws nano::error if the chunk could not be written in time, which fails the request
+	 */
+	void write_chunk (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb_a)
+	{
+		auto big_endian_length = std::make_shared<uint32_t> (boost::endian::native_to_big (static_cast<uint32_t> (fbb_a->GetSize ())));
+		boost::array<boost::asio::const_buffer, 2> buffers = {
+			boost::asio::buffer (big_endian_length.get (), sizeof (std::uint32_t)),
+			boost::asio::buffer (fbb_a->GetBufferPointer (), fbb_a->GetSize ())
+		};
+		auto written (std::make_shared<std::promise<boost::system::error_code>> ());
+		auto result (written->get_future ());
+		queued_write (buffers, [fbb_a, big_endian_length, written] (boost::system::error_code const & error_a, size_t size_a) {
+			written->set_value (error_a);
+		});
+		boost::system::error_code error;
+		if (result.wait_for (std::chrono::seconds (config_transport.io_timeout)) != std::future_status::ready)
+		{
+			error = boost::asio::error::timed_out;
+		}
+		else
+		{
+			error = result.get ();
+		}
+		if (error)
+		{
+			node.stats.inc (nano::stat::type::ipc, nano::stat::detail::chunk_write_failed);
+			if (node.config.logging.log_ipc ())
+			{
+				node.logger.always_log ("IPC: Write failed: ", error.message ());
+			}
+			throw nano::error ("Response chunk could not be written: " + error.message ());
+		}
 	}
 
 	/** Async request reader */
@@ -327,6 +492,10 @@ public:
 					});
 				});
 			}
+			else if (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::multiplexed))
+			{
+				this_l->read_multiplexed_request ();
+			}
 			else if (encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::flatbuffers) || encoding == static_cast<uint8_t> (nano::ipc::payload_encoding::flatbuffers_json))
 			{
 				// Length of payload
@@ -371,27 +540,33 @@ public:
 						}
 						else
 						{
-							this_l->flatbuffers_handler->process (this_l->buffer.data (), this_l->buffer_size, [this_l] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) {
-								if (this_l->node.config.logging.log_ipc ())
-								{
-									this_l->node.logger.always_log (boost::str (boost::format ("IPC/Flatbuffer request completed in: %1% %2%") % this_l->session_timer.stop ().count () % this_l->session_timer.unit ()));
-								}
-
-								auto big_endian_length = std::make_shared<uint32_t> (boost::endian::native_to_big (static_cast<uint32_t> (fbb->GetSize ())));
-								boost::array<boost::asio::const_buffer, 2> buffers = {
-									boost::asio::buffer (big_endian_length.get (), sizeof (std::uint32_t)),
-									boost::asio::buffer (fbb->GetBufferPointer (), fbb->GetSize ())
-								};
-
-								this_l->queued_write (buffers, [this_l, fbb, big_endian_length] (boost::system::error_code const & error_a, size_t size_a) {
-									if (!error_a)
-									{
-										this_l->read_next_request ();
-									}
-									else if (this_l->node.config.logging.log_ipc ())
+							// Processed off the strand, so chunks of a large response are written while the following ones are produced
+							this_l->server.request_pool.push_task ([this_l] () {
+								this_l->flatbuffers_handler->process (this_l->buffer.data (), this_l->buffer_size, [this_l] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) {
+									if (this_l->node.config.logging.log_ipc ())
 									{
-										this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+										this_l->node.logger.always_log (boost::str (boost::format ("IPC/Flatbuffer request completed in: %1% %2%") % this_l->session_timer.stop ().count () % this_l->session_timer.unit ()));
 									}
+
+									auto big_endian_length = std::make_shared<uint32_t> (boost::endian::native_to_big (static_cast<uint32_t> (fbb->GetSize ())));
+									boost::array<boost::asio::const_buffer, 2> buffers = {
+										boost::asio::buffer (big_endian_length.get (), sizeof (std::uint32_t)),
+										boost::asio::buffer (fbb->GetBufferPointer (), fbb->GetSize ())
+									};
+
+									this_l->queued_write (buffers, [this_l, fbb, big_endian_length] (boost::system::error_code const & error_a, size_t size_a) {
+										if (!error_a)
+										{
+											this_l->read_next_request ();
+										}
+										else if (this_l->node.config.logging.log_ipc ())
+										{
+											this_l->node.logger.always_log ("IPC: Write failed: ", error_a.message ());
+										}
+									});
+								},
+								[this_l] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) {
+									this_l->write_chunk (fbb);
 								});
 							});
 						}
@@ -422,6 +597,8 @@ private:
 		std::function<void (boost::system::error_code const &, size_t)> callback;
 	};
 	size_t const queue_size_max = 64 * 1024;
+	/** Upper bound on multiplexed requests being processed or awaiting their response write */
+	size_t const multiplexed_requests_max = 1024;
 
 	nano::ipc::ipc_server & server;
 	nano::node & node;
@@ -456,6 +633,9 @@ private:
 	/** A socket of the given asio type */
 	SOCKET_TYPE socket;
 
+	/** Multiplexed requests in flight, only accessed through the strand */
+	size_t multiplexed_requests{ 0 };
+
 	/** Buffer sizes are read into this */
 	uint32_t buffer_size{ 0 };
 
@@ -578,6 +758,7 @@ void await_hup_signal (std::shared_ptr<boost::asio::signal_set> const & signals,
 nano::ipc::ipc_server::ipc_server (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a) :
 	node (node_a),
 	node_rpc_config (node_rpc_config_a),
+	request_pool (request_threads, nano::thread_role::name::ipc_request_processing),
 	broker (std::make_shared<nano::ipc::broker> (node_a))
 {
 	try
@@ -634,6 +815,7 @@ void nano::ipc::ipc_server::stop ()
 	{
 		transport->stop ();
 	}
+	request_pool.stop ();
 }
 
 std::shared_ptr<nano::ipc::broker> nano::ipc::ipc_server::get_broker ()
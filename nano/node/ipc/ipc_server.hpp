@@ -3,6 +3,7 @@
 #include <nano/ipc_flatbuffers_lib/generated/flatbuffers/nanoapi_generated.h>
 #include <nano/lib/errors.hpp>
 #include <nano/lib/ipc.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/node/ipc/ipc_access_config.hpp>
 #include <nano/node/ipc/ipc_broker.hpp>
 #include <nano/node/node_rpc_config.hpp>
@@ -33,6 +34,13 @@ namespace ipc
 		nano::node & node;
 		nano::node_rpc_config const & node_rpc_config;
 
+		/**
+		 * Processes flatbuffers requests, which may wait on slow clients while writing response chunks.
+		 * Bounded and separate from the node's worker threads, so such clients can't starve other node tasks.
+		 */
+		nano::thread_pool request_pool;
+		static unsigned constexpr request_threads = 4;
+
 		/** Unique counter/id shared across sessions */
 		std::atomic<uint64_t> id_dispenser{ 1 };
 		std::shared_ptr<nano::ipc::broker> get_broker ();
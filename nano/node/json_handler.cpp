@@ -14,6 +14,8 @@
 
 #include <algorithm>
 #include <chrono>
+#include <map>
+#include <numeric>
 
 namespace
 {
@@ -21,10 +23,14 @@ void construct_json (nano::container_info_component * component, boost::property
 using ipc_json_handler_no_arg_func_map = std::unordered_map<std::string, std::function<void (nano::json_handler *)>>;
 ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ();
 auto ipc_json_handler_no_arg_funcs = create_ipc_json_handler_no_arg_func_map ();
-bool block_confirmed (nano::node & node, nano::transaction & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed);
+bool block_confirmed (nano::node & node, nano::transaction const & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed);
 const char * epoch_as_string (nano::epoch);
 }
 
+unsigned constexpr nano::json_handler::scan_ranges;
+uint64_t constexpr nano::json_handler::parallel_scan_count;
+unsigned constexpr nano::json_handler::scan_helpers;
+
 nano::json_handler::json_handler (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a, std::string const & body_a, std::function<void (std::string const &)> const & response_a, std::function<void ()> stop_callback_a) :
 	body (body_a),
 	node (node_a),
@@ -64,6 +70,19 @@ void nano::json_handler::process_request (bool unsafe_a)
 			node_rpc_config.request_callback (request);
 		}
 		action = request.get<std::string> ("action");
+		if (node.rpc_cache.config.enable)
+		{
+			cache_key = node.rpc_cache.key (action, request);
+			if (!cache_key.empty ())
+			{
+				if (auto cached = node.rpc_cache.get (cache_key))
+				{
+					response (*cached);
+					return;
+				}
+				cache_generation = node.rpc_cache.generation ();
+			}
+		}
 		auto no_arg_func_iter = ipc_json_handler_no_arg_funcs.find (action);
 		if (no_arg_func_iter != ipc_json_handler_no_arg_funcs.cend ())
 		{
@@ -147,7 +166,7 @@ void nano::json_handler::process_request (bool unsafe_a)
 
 void nano::json_handler::response_errors ()
 {
-	if (!ec && response_l.empty ())
+	if (!ec && response_l.empty () && response_writer.empty ())
 	{
 		// Return an error code if no response data was given
 		ec = nano::error_rpc::empty_response;
@@ -160,14 +179,49 @@ void nano::json_handler::response_errors ()
 		boost::property_tree::write_json (ostream, response_error);
 		response (ostream.str ());
 	}
+	else if (!response_writer.empty ())
+	{
+		// Members such as deprecated_account_format are put in response_l before the writer is used
+		response (response_writer.finish (response_l));
+	}
 	else
 	{
 		std::stringstream ostream;
 		boost::property_tree::write_json (ostream, response_l);
-		response (ostream.str ());
+		auto body_l (ostream.str ());
+		cache_response (body_l);
+		response (body_l);
 	}
 }
 
+void nano::json_handler::cache_response (std::string const & body_a)
+{
+	if (!cache_key.empty ())
+	{
+		// Responses about an account or block are invalidated when the account changes
+		nano::account account (0);
+		bool error (false);
+		if (action == "block_info")
+		{
+			error = account.decode_account (response_l.get<std::string> ("block_account", ""));
+		}
+		else if (action == "account_info" || action == "account_balance")
+		{
+			error = account.decode_account (request.get<std::string> ("account", ""));
+		}
+		if (!error)
+		{
+			node.rpc_cache.put (cache_key, cache_generation, account, body_a);
+		}
+	}
+}
+
+nano::pooled_read_transaction nano::json_handler::borrow_read_transaction ()
+{
+	// A pooled snapshot may predate invalidations made before cache_generation was taken
+	return node.read_transactions.borrow (!cache_key.empty ());
+}
+
 std::shared_ptr<nano::wallet> nano::json_handler::wallet_impl ()
 {
 	if (!ec)
@@ -246,6 +300,31 @@ nano::account nano::json_handler::account_impl (std::string account_text, std::e
 	return result;
 }
 
+std::vector<nano::account> nano::json_handler::accounts_impl ()
+{
+	std::vector<nano::account> result;
+	for (auto & accounts : request.get_child ("accounts"))
+	{
+		auto account (account_impl (accounts.second.data ()));
+		if (ec)
+		{
+			break;
+		}
+		result.push_back (account);
+	}
+	return result;
+}
+
+std::vector<nano::account> nano::json_handler::wallet_accounts_impl (nano::transaction const & transaction_a, std::shared_ptr<nano::wallet> const & wallet_a)
+{
+	std::vector<nano::account> result;
+	for (auto i (wallet_a->store.begin (transaction_a)), n (wallet_a->store.end ()); i != n; ++i)
+	{
+		result.push_back (i->first);
+	}
+	return result;
+}
+
 nano::account_info nano::json_handler::account_info_impl (nano::transaction const & transaction_a, nano::account const & account_a)
 {
 	nano::account_info result;
@@ -527,7 +606,7 @@ void nano::json_handler::account_block_count ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (borrow_read_transaction ());
 		auto info (account_info_impl (transaction, account));
 		if (!ec)
 		{
@@ -603,7 +682,7 @@ void nano::json_handler::account_info ()
 		const bool weight = request.get<bool> ("weight", false);
 		const bool pending = request.get<bool> ("pending", false);
 		const bool include_confirmed = request.get<bool> ("include_confirmed", false);
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (borrow_read_transaction ());
 		auto info (account_info_impl (transaction, account));
 		nano::confirmation_height_info confirmation_height_info;
 		node.store.confirmation_height.get (transaction, account, confirmation_height_info);
@@ -788,7 +867,7 @@ void nano::json_handler::account_representative ()
 	auto account (account_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (borrow_read_transaction ());
 		auto info (account_info_impl (transaction, account));
 		if (!ec)
 		{
@@ -877,20 +956,20 @@ void nano::json_handler::account_weight ()
 
 void nano::json_handler::accounts_balances ()
 {
-	boost::property_tree::ptree balances;
-	for (auto & accounts : request.get_child ("accounts"))
+	auto accounts (accounts_impl ());
+	auto transaction (borrow_read_transaction ());
+	auto infos (node.store.account.get_many (transaction, accounts));
+	response_writer.begin_object ("balances");
+	for (size_t i (0), n (accounts.size ()); i < n; ++i)
 	{
-		auto account (account_impl (accounts.second.data ()));
-		if (!ec)
-		{
-			boost::property_tree::ptree entry;
-			auto balance (node.balance_pending (account, false));
-			entry.put ("balance", balance.first.convert_to<std::string> ());
-			entry.put ("pending", balance.second.convert_to<std::string> ());
-			balances.push_back (std::make_pair (account.to_account (), entry));
-		}
+		auto balance (infos[i] ? infos[i]->balance.number () : nano::uint128_t (0));
+		auto pending (node.ledger.account_pending (transaction, accounts[i]));
+		response_writer.begin_object (accounts[i].to_account ());
+		response_writer.put ("balance", balance.convert_to<std::string> ());
+		response_writer.put ("pending", pending.convert_to<std::string> ());
+		response_writer.end_object ();
 	}
-	response_l.add_child ("balances", balances);
+	response_writer.end_object ();
 	response_errors ();
 }
 
@@ -922,17 +1001,14 @@ void nano::json_handler::accounts_create ()
 void nano::json_handler::accounts_frontiers ()
 {
 	boost::property_tree::ptree frontiers;
-	auto transaction (node.store.tx_begin_read ());
-	for (auto & accounts : request.get_child ("accounts"))
+	auto accounts (accounts_impl ());
+	auto transaction (borrow_read_transaction ());
+	auto infos (node.store.account.get_many (transaction, accounts));
+	for (size_t i (0), n (accounts.size ()); i < n; ++i)
 	{
-		auto account (account_impl (accounts.second.data ()));
-		if (!ec)
+		if (infos[i])
 		{
-			auto latest (node.ledger.latest (transaction, account));
-			if (!latest.is_zero ())
-			{
-				frontiers.put (account.to_account (), latest.to_string ());
-			}
+			frontiers.put (accounts[i].to_account (), infos[i]->head.to_string ());
 		}
 	}
 	response_l.add_child ("frontiers", frontiers);
@@ -948,63 +1024,71 @@ void nano::json_handler::accounts_pending ()
 	const bool include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
 	const bool sorting = request.get<bool> ("sorting", false);
 	auto simple (threshold.is_zero () && !source && !sorting); // if simple, response is a list of hashes for each account
-	boost::property_tree::ptree pending;
-	auto transaction (node.store.tx_begin_read ());
-	for (auto & accounts : request.get_child ("accounts"))
+	auto accounts (accounts_impl ());
+	// Pending entries are keyed by account, seeking in ascending account order keeps the cursor on nearby pages
+	std::vector<size_t> order (accounts.size ());
+	std::iota (order.begin (), order.end (), 0);
+	std::sort (order.begin (), order.end (), [&accounts] (size_t const lhs, size_t const rhs) {
+		return accounts[lhs] < accounts[rhs];
+	});
+	std::vector<boost::property_tree::ptree> results (accounts.size ());
+	auto transaction (borrow_read_transaction ());
+	for (auto index : order)
 	{
-		auto account (account_impl (accounts.second.data ()));
-		if (!ec)
+		auto const & account (accounts[index]);
+		auto & peers_l (results[index]);
+		for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
 		{
-			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end ()); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			nano::pending_key const & key (i->first);
+			if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
 			{
-				nano::pending_key const & key (i->first);
-				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+				if (simple)
 				{
-					if (simple)
-					{
-						boost::property_tree::ptree entry;
-						entry.put ("", key.hash.to_string ());
-						peers_l.push_back (std::make_pair ("", entry));
-					}
-					else
+					boost::property_tree::ptree entry;
+					entry.put ("", key.hash.to_string ());
+					peers_l.push_back (std::make_pair ("", entry));
+				}
+				else
+				{
+					nano::pending_info const & info (i->second);
+					if (info.amount.number () >= threshold.number ())
 					{
-						nano::pending_info const & info (i->second);
-						if (info.amount.number () >= threshold.number ())
+						if (source)
 						{
-							if (source)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								pending_tree.put ("source", info.source.to_account ());
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
+							boost::property_tree::ptree pending_tree;
+							pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+							pending_tree.put ("source", info.source.to_account ());
+							peers_l.add_child (key.hash.to_string (), pending_tree);
+						}
+						else
+						{
+							peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 						}
 					}
 				}
 			}
-			if (sorting && !simple)
+		}
+		if (sorting && !simple)
+		{
+			if (source)
 			{
-				if (source)
-				{
-					peers_l.sort ([] (const auto & child1, const auto & child2) -> bool {
-						return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
-					});
-				}
-				else
-				{
-					peers_l.sort ([] (const auto & child1, const auto & child2) -> bool {
-						return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
-					});
-				}
+				peers_l.sort ([] (const auto & child1, const auto & child2) -> bool {
+					return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
+				});
+			}
+			else
+			{
+				peers_l.sort ([] (const auto & child1, const auto & child2) -> bool {
+					return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
+				});
 			}
-			pending.add_child (account.to_account (), peers_l);
 		}
 	}
+	boost::property_tree::ptree pending;
+	for (size_t i (0), n (accounts.size ()); i < n; ++i)
+	{
+		pending.add_child (accounts[i].to_account (), results[i]);
+	}
 	response_l.add_child ("blocks", pending);
 	response_errors ();
 }
@@ -1052,7 +1136,7 @@ void nano::json_handler::block_info ()
 	auto hash (hash_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (borrow_read_transaction ());
 		auto block (node.store.block.get (transaction, hash));
 		if (block != nullptr)
 		{
@@ -1150,7 +1234,7 @@ void nano::json_handler::blocks ()
 {
 	const bool json_block_l = request.get<bool> ("json_block", false);
 	boost::property_tree::ptree blocks;
-	auto transaction (node.store.tx_begin_read ());
+	auto transaction (borrow_read_transaction ());
 	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
 	{
 		if (!ec)
@@ -1197,104 +1281,113 @@ void nano::json_handler::blocks_info ()
 	const bool json_block_l = request.get<bool> ("json_block", false);
 	const bool include_not_found = request.get<bool> ("include_not_found", false);
 
-	boost::property_tree::ptree blocks;
-	boost::property_tree::ptree blocks_not_found;
-	auto transaction (node.store.tx_begin_read ());
-	for (boost::property_tree::ptree::value_type & hashes : request.get_child ("hashes"))
+	std::vector<std::string> blocks_not_found;
+	std::vector<std::string> hash_texts;
+	std::vector<nano::block_hash> hashes;
+	bool bad_hash (false);
+	for (boost::property_tree::ptree::value_type & hashes_l : request.get_child ("hashes"))
 	{
-		if (!ec)
+		nano::block_hash hash;
+		bad_hash = hash.decode_hex (hashes_l.second.data ());
+		if (bad_hash)
 		{
-			std::string hash_text = hashes.second.data ();
-			nano::block_hash hash;
-			if (!hash.decode_hex (hash_text))
+			break;
+		}
+		hash_texts.push_back (hashes_l.second.data ());
+		hashes.push_back (hash);
+	}
+	auto transaction (borrow_read_transaction ());
+	auto blocks (node.store.block.get_many (transaction, hashes));
+	response_writer.begin_object ("blocks");
+	for (size_t i (0), n (hashes.size ()); i < n && !ec; ++i)
+	{
+		auto const & hash_text (hash_texts[i]);
+		auto const & hash (hashes[i]);
+		auto const & block (blocks[i]);
+		if (block != nullptr)
+		{
+			response_writer.begin_object (hash_text);
+			nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
+			response_writer.put ("block_account", account.to_account ());
+			bool error_or_pruned (false);
+			auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
+			if (!error_or_pruned)
 			{
-				auto block (node.store.block.get (transaction, hash));
-				if (block != nullptr)
-				{
-					boost::property_tree::ptree entry;
-					nano::account account (block->account ().is_zero () ? block->sideband ().account : block->account ());
-					entry.put ("block_account", account.to_account ());
-					bool error_or_pruned (false);
-					auto amount (node.ledger.amount_safe (transaction, hash, error_or_pruned));
-					if (!error_or_pruned)
-					{
-						entry.put ("amount", amount.convert_to<std::string> ());
-					}
-					auto balance (node.ledger.balance (transaction, hash));
-					entry.put ("balance", balance.convert_to<std::string> ());
-					entry.put ("height", std::to_string (block->sideband ().height));
-					entry.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
-					entry.put ("successor", block->sideband ().successor.to_string ());
-					auto confirmed (node.ledger.block_confirmed (transaction, hash));
-					entry.put ("confirmed", confirmed);
+				response_writer.put ("amount", amount.convert_to<std::string> ());
+			}
+			auto balance (node.ledger.balance (transaction, hash));
+			response_writer.put ("balance", balance.convert_to<std::string> ());
+			response_writer.put ("height", std::to_string (block->sideband ().height));
+			response_writer.put ("local_timestamp", std::to_string (block->sideband ().timestamp));
+			response_writer.put ("successor", block->sideband ().successor.to_string ());
+			auto confirmed (node.ledger.block_confirmed (transaction, hash));
+			response_writer.put ("confirmed", confirmed ? "true" : "false");
 
-					if (json_block_l)
-					{
-						boost::property_tree::ptree block_node_l;
-						block->serialize_json (block_node_l);
-						entry.add_child ("contents", block_node_l);
-					}
-					else
-					{
-						std::string contents;
-						block->serialize_json (contents);
-						entry.put ("contents", contents);
-					}
-					if (block->type () == nano::block_type::state)
-					{
-						auto subtype (nano::state_subtype (block->sideband ().details));
-						entry.put ("subtype", subtype);
-					}
-					if (pending)
-					{
-						bool exists (false);
-						auto destination (node.ledger.block_destination (transaction, *block));
-						if (!destination.is_zero ())
-						{
-							exists = node.store.pending.exists (transaction, nano::pending_key (destination, hash));
-						}
-						entry.put ("pending", exists ? "1" : "0");
-					}
-					if (source)
-					{
-						nano::block_hash source_hash (node.ledger.block_source (transaction, *block));
-						auto block_a (node.store.block.get (transaction, source_hash));
-						if (block_a != nullptr)
-						{
-							auto source_account (node.ledger.account (transaction, source_hash));
-							entry.put ("source_account", source_account.to_account ());
-						}
-						else
-						{
-							entry.put ("source_account", "0");
-						}
-					}
-					blocks.push_back (std::make_pair (hash_text, entry));
+			if (json_block_l)
+			{
+				boost::property_tree::ptree block_node_l;
+				block->serialize_json (block_node_l);
+				response_writer.put_child ("contents", block_node_l);
+			}
+			else
+			{
+				std::string contents;
+				block->serialize_json (contents);
+				response_writer.put ("contents", contents);
+			}
+			if (block->type () == nano::block_type::state)
+			{
+				auto subtype (nano::state_subtype (block->sideband ().details));
+				response_writer.put ("subtype", subtype);
+			}
+			if (pending)
+			{
+				bool exists (false);
+				auto destination (node.ledger.block_destination (transaction, *block));
+				if (!destination.is_zero ())
+				{
+					exists = node.store.pending.exists (transaction, nano::pending_key (destination, hash));
 				}
-				else if (include_not_found)
+				response_writer.put ("pending", exists ? "1" : "0");
+			}
+			if (source)
+			{
+				nano::block_hash source_hash (node.ledger.block_source (transaction, *block));
+				auto block_a (node.store.block.get (transaction, source_hash));
+				if (block_a != nullptr)
 				{
-					boost::property_tree::ptree entry;
-					entry.put ("", hash_text);
-					blocks_not_found.push_back (std::make_pair ("", entry));
+					auto source_account (node.ledger.account (transaction, source_hash));
+					response_writer.put ("source_account", source_account.to_account ());
 				}
 				else
 				{
-					ec = nano::error_blocks::not_found;
+					response_writer.put ("source_account", "0");
 				}
 			}
-			else
-			{
-				ec = nano::error_blocks::bad_hash_number;
-			}
+			response_writer.end_object ();
+		}
+		else if (include_not_found)
+		{
+			blocks_not_found.push_back (hash_text);
+		}
+		else
+		{
+			ec = nano::error_blocks::not_found;
 		}
 	}
-	if (!ec)
+	if (!ec && bad_hash)
 	{
-		response_l.add_child ("blocks", blocks);
-		if (include_not_found)
+		ec = nano::error_blocks::bad_hash_number;
+	}
+	response_writer.end_object ();
+	if (!ec && include_not_found)
+	{
+		response_writer.begin_array ("blocks_not_found");
+		for (auto const & hash_text : blocks_not_found)
 		{
-			response_l.add_child ("blocks_not_found", blocks_not_found);
+			response_writer.push_back (hash_text);
 		}
+		response_writer.end_array ();
 	}
 	response_errors ();
 }
@@ -1304,7 +1397,7 @@ void nano::json_handler::block_account ()
 	auto hash (hash_impl ());
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (borrow_read_transaction ());
 		if (node.store.block.exists (transaction, hash))
 		{
 			auto account (node.ledger.account (transaction, hash));
@@ -1816,6 +1909,19 @@ void nano::json_handler::chain (bool successors)
 	{
 		boost::property_tree::ptree blocks;
 		auto transaction (node.store.tx_begin_read ());
+		if (offset > 0)
+		{
+			auto block_l (node.store.block.get (transaction, hash));
+			if (block_l != nullptr)
+			{
+				// Jump over the offset instead of walking the chain when the account height index is available
+				if (auto target = node.ledger.hash_at_offset (transaction, node.ledger.account (transaction, hash), block_l->sideband ().height, offset, !successors))
+				{
+					hash = *target;
+					offset = 0;
+				}
+			}
+		}
 		while (!hash.is_zero () && blocks.size () < count)
 		{
 			auto block_l (node.store.block.get (transaction, hash));
@@ -2220,6 +2326,215 @@ void nano::json_handler::epoch_upgrade ()
 	response_errors ();
 }
 
+namespace
+{
+/**
+ * Collects the results of a table scan split into key ranges, merging them back in key order.
+ * A range stops early once the ranges before it have produced count results, or when the node is stopping.
+ * Long scans log their progress.
+ */
+template <typename Key, typename Result>
+class ordered_scan final
+{
+public:
+	using results_t = std::vector<std::pair<Key, Result>>;
+
+	ordered_scan (nano::node & node_a, std::string const & name_a, uint64_t count_a) :
+		node (node_a),
+		name (name_a),
+		count (count_a),
+		next_log (std::chrono::steady_clock::now () + log_interval)
+	{
+	}
+
+	/** Called for each entry visited by the range starting at first_a, returns true if the range should stop */
+	bool visit (Key const & first_a)
+	{
+		auto visited_l (++visited);
+		bool result (node.stopped);
+		if (!result && visited_l % check_interval == 0)
+		{
+			nano::lock_guard<nano::mutex> guard (mutex);
+			uint64_t preceding (0);
+			for (auto i (finished.begin ()), n (finished.lower_bound (first_a)); i != n; ++i)
+			{
+				preceding += i->second.second;
+			}
+			result = preceding >= count;
+			auto now (std::chrono::steady_clock::now ());
+			if (now >= next_log)
+			{
+				next_log = now + log_interval;
+				node.logger.try_log (boost::str (boost::format ("RPC %1% visited %2% entries, %3% of %4% ranges finished") % name % visited_l % finished.size () % started));
+			}
+		}
+		return result;
+	}
+
+	void start ()
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		++started;
+	}
+
+	/** Records the results of the range starting at first_a, of which definite_a are certain to be in the merged results */
+	void finish (Key const & first_a, results_t && results_a, uint64_t definite_a)
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		finished.emplace (first_a, std::make_pair (std::move (results_a), definite_a));
+	}
+
+	/** Results of all ranges in key order */
+	results_t results ()
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		results_t result;
+		for (auto & [first, range] : finished)
+		{
+			result.insert (result.end (), std::make_move_iterator (range.first.begin ()), std::make_move_iterator (range.first.end ()));
+		}
+		return result;
+	}
+
+private:
+	static uint64_t constexpr check_interval{ 1024 };
+	static std::chrono::seconds constexpr log_interval{ 5 };
+	nano::node & node;
+	std::string const name;
+	uint64_t const count;
+	std::atomic<uint64_t> visited{ 0 };
+	nano::mutex mutex;
+	std::map<Key, std::pair<results_t, uint64_t>> finished;
+	unsigned started{ 0 };
+	std::chrono::steady_clock::time_point next_log;
+};
+
+template <typename Key, typename Result>
+std::chrono::seconds constexpr ordered_scan<Key, Result>::log_interval;
+
+/** Positions i_a at the first account at or after start_a, returns false if that is at or past n_a */
+bool seek (nano::store & store_a, nano::transaction const & transaction_a, nano::store_iterator<nano::account, nano::account_info> & i_a, nano::store_iterator<nano::account, nano::account_info> & n_a, nano::account const & start_a)
+{
+	auto result (n_a == store_a.account.end () || start_a < n_a->first);
+	if (result)
+	{
+		i_a = store_a.account.begin (transaction_a, start_a);
+	}
+	return result;
+}
+
+bool pending_less (nano::pending_key const & lhs, nano::pending_key const & rhs)
+{
+	return lhs.account < rhs.account || (lhs.account == rhs.account && lhs.hash < rhs.hash);
+}
+
+/** Positions i_a at the first pending entry at or after start_a, returns false if that is at or past n_a */
+bool seek (nano::store & store_a, nano::transaction const & transaction_a, nano::store_iterator<nano::pending_key, nano::pending_info> & i_a, nano::store_iterator<nano::pending_key, nano::pending_info> & n_a, nano::pending_key const & start_a)
+{
+	auto result (n_a == store_a.pending.end () || pending_less (start_a, n_a->first));
+	if (result)
+	{
+		i_a = store_a.pending.begin (transaction_a, start_a);
+	}
+	return result;
+}
+
+/**
+ * Runs an action for each of a number of key ranges. The calling thread scans ranges itself, helped by a fixed number of
+ * tasks on the node workers, so a request never holds more than 1 + json_handler::scan_helpers read transactions. Helpers
+ * take one range at a time and give their worker back in between. Ranges left by helpers which never run, for instance
+ * because the workers are stopping, are scanned by the caller.
+ */
+class range_scan final : public std::enable_shared_from_this<range_scan>
+{
+public:
+	range_scan (unsigned ranges_a, std::function<void (unsigned)> const & action_a) :
+		ranges (ranges_a),
+		action (action_a)
+	{
+	}
+
+	/** Returns once every range has been scanned */
+	void run (nano::thread_pool & workers_a)
+	{
+		for (auto i (0u); i < nano::json_handler::scan_helpers; ++i)
+		{
+			help (workers_a);
+		}
+		while (scan_next ())
+		{
+		}
+		nano::unique_lock<nano::mutex> lock (mutex);
+		condition.wait (lock, [this] () { return finished == ranges; });
+	}
+
+private:
+	void help (nano::thread_pool & workers_a)
+	{
+		workers_a.push_task ([this_l = shared_from_this (), &workers_a] () {
+			if (this_l->scan_next ())
+			{
+				this_l->help (workers_a);
+			}
+		});
+	}
+
+	/** Scans the next range not yet taken, returns false if there was none */
+	bool scan_next ()
+	{
+		auto range (next++);
+		auto result (range < ranges);
+		if (result)
+		{
+			action (range);
+			{
+				nano::lock_guard<nano::mutex> guard (mutex);
+				++finished;
+			}
+			condition.notify_all ();
+		}
+		return result;
+	}
+
+	unsigned const ranges;
+	std::function<void (unsigned)> const action;
+	std::atomic<unsigned> next{ 0 };
+	nano::mutex mutex;
+	nano::condition_variable condition;
+	unsigned finished{ 0 };
+};
+
+/** Splits the key space of T into json_handler::scan_ranges ranges, calling action_a with the bounds of each */
+template <typename T>
+void scan_ranges (nano::node & node_a, std::function<void (T const &, T const &, bool const)> const & action_a)
+{
+	T const split = std::numeric_limits<T>::max () / nano::json_handler::scan_ranges;
+	std::make_shared<range_scan> (nano::json_handler::scan_ranges, [&action_a, &split] (unsigned range_a) {
+		action_a (range_a * split, (range_a + 1) * split, range_a == nano::json_handler::scan_ranges - 1);
+	})->run (node_a.workers);
+}
+
+void scan_accounts (nano::node & node_a, std::function<void (nano::read_transaction const &, nano::store_iterator<nano::account, nano::account_info>, nano::store_iterator<nano::account, nano::account_info>)> const & action_a)
+{
+	scan_ranges<nano::uint256_t> (node_a, [&node_a, &action_a] (nano::uint256_t const & start, nano::uint256_t const & end, bool const is_last) {
+		auto transaction (node_a.store.tx_begin_read ());
+		action_a (transaction, node_a.store.account.begin (transaction, start), !is_last ? node_a.store.account.begin (transaction, end) : node_a.store.account.end ());
+	});
+}
+
+void scan_pending (nano::node & node_a, std::function<void (nano::read_transaction const &, nano::store_iterator<nano::pending_key, nano::pending_info>, nano::store_iterator<nano::pending_key, nano::pending_info>)> const & action_a)
+{
+	scan_ranges<nano::uint512_t> (node_a, [&node_a, &action_a] (nano::uint512_t const & start, nano::uint512_t const & end, bool const is_last) {
+		nano::uint512_union union_start (start);
+		nano::uint512_union union_end (end);
+		nano::pending_key key_start (union_start.uint256s[0].number (), union_start.uint256s[1].number ());
+		nano::pending_key key_end (union_end.uint256s[0].number (), union_end.uint256s[1].number ());
+		auto transaction (node_a.store.tx_begin_read ());
+		action_a (transaction, node_a.store.pending.begin (transaction, key_start), !is_last ? node_a.store.pending.begin (transaction, key_end) : node_a.store.pending.end ());
+	});
+}
+}
+
 void nano::json_handler::frontiers ()
 {
 	auto start (account_impl ());
@@ -2514,10 +2829,20 @@ void nano::json_handler::account_history ()
 	}
 	if (!ec)
 	{
-		boost::property_tree::ptree history;
 		bool output_raw (request.get_optional<bool> ("raw") == true);
-		response_l.put ("account", account.to_account ());
+		response_writer.put ("account", account.to_account ());
+		response_writer.begin_array ("history");
 		auto block (node.store.block.get (transaction, hash));
+		if (block != nullptr && offset > 0)
+		{
+			// Jump over the offset instead of walking the chain when the account height index is available
+			if (auto target = node.ledger.hash_at_offset (transaction, account, block->sideband ().height, offset, !reverse))
+			{
+				hash = *target;
+				block = node.store.block.get (transaction, hash);
+				offset = 0;
+			}
+		}
 		while (block != nullptr && count > 0)
 		{
 			if (offset > 0)
@@ -2539,17 +2864,17 @@ void nano::json_handler::account_history ()
 						entry.put ("work", nano::to_string_hex (block->block_work ()));
 						entry.put ("signature", block->block_signature ().to_string ());
 					}
-					history.push_back (std::make_pair ("", entry));
+					response_writer.push_back (entry);
 					--count;
 				}
 			}
 			hash = reverse ? node.store.block.successor (transaction, hash) : block->previous ();
 			block = node.store.block.get (transaction, hash);
 		}
-		response_l.add_child ("history", history);
+		response_writer.end_array ();
 		if (!hash.is_zero ())
 		{
-			response_l.put (reverse ? "next" : "previous", hash.to_string ());
+			response_writer.put (reverse ? "next" : "previous", hash.to_string ());
 		}
 	}
 	response_errors ();
@@ -2627,100 +2952,160 @@ void nano::json_handler::ledger ()
 		const bool representative = request.get<bool> ("representative", false);
 		const bool weight = request.get<bool> ("weight", false);
 		const bool pending = request.get<bool> ("pending", false);
-		boost::property_tree::ptree accounts;
+		uint64_t accounts_count (0);
 		auto transaction (node.store.tx_begin_read ());
+		response_writer.begin_object ("accounts");
 		if (!ec && !sorting) // Simple
 		{
-			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n && accounts_count < count; ++i)
 			{
 				nano::account_info const & info (i->second);
 				if (info.modified >= modified_since && (pending || info.balance.number () >= threshold.number ()))
 				{
 					nano::account const & account (i->first);
-					boost::property_tree::ptree response_a;
+					boost::optional<nano::uint128_t> account_pending;
 					if (pending)
 					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
+						account_pending = node.ledger.account_pending (transaction, account);
+						if (info.balance.number () + *account_pending < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					response_writer.begin_object (account.to_account ());
+					if (account_pending)
+					{
+						response_writer.put ("pending", account_pending->convert_to<std::string> ());
+					}
+					response_writer.put ("frontier", info.head.to_string ());
+					response_writer.put ("open_block", info.open_block.to_string ());
+					response_writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					nano::uint128_union (info.balance).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					response_writer.put ("balance", balance);
+					response_writer.put ("modified_timestamp", std::to_string (info.modified));
+					response_writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						response_writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						response_writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					response_writer.end_object ();
+					++accounts_count;
 				}
 			}
 		}
 		else if (!ec) // Sorting
 		{
 			std::vector<std::pair<nano::uint128_union, nano::account>> ledger_l;
-			for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n; ++i)
+			if (count < parallel_scan_count)
 			{
-				nano::account_info const & info (i->second);
-				nano::uint128_union balance (info.balance);
-				if (info.modified >= modified_since)
+				for (auto i (node.store.account.begin (transaction, start)), n (node.store.account.end ()); i != n; ++i)
 				{
-					ledger_l.emplace_back (balance, i->first);
+					nano::account_info const & info (i->second);
+					nano::uint128_union balance (info.balance);
+					if (info.modified >= modified_since)
+					{
+						ledger_l.emplace_back (balance, i->first);
+					}
 				}
 			}
+			else
+			{
+				// Without pending every account below the threshold sorts after those above it, so each range only needs its largest count balances
+				auto const bounded (!pending && count < std::numeric_limits<uint64_t>::max () / 2);
+				auto const greater ([] (std::pair<nano::account, nano::uint128_union> const & lhs, std::pair<nano::account, nano::uint128_union> const & rhs) {
+					return std::make_pair (rhs.second, rhs.first) < std::make_pair (lhs.second, lhs.first);
+				});
+				auto const trim ([count, &greater] (std::vector<std::pair<nano::account, nano::uint128_union>> & results_a) {
+					std::nth_element (results_a.begin (), results_a.begin () + count, results_a.end (), greater);
+					results_a.resize (count);
+				});
+				ordered_scan<nano::account, nano::uint128_union> scan (node, "ledger", std::numeric_limits<uint64_t>::max ());
+				scan_accounts (node, [this, &scan, &start, modified_since, bounded, count, &trim] (nano::read_transaction const & transaction_a, nano::store_iterator<nano::account, nano::account_info> i, nano::store_iterator<nano::account, nano::account_info> n) {
+					scan.start ();
+					auto in_range (i == n || !(i->first < start) || seek (node.store, transaction_a, i, n, start));
+					if (in_range && i != n)
+					{
+						nano::account first (i->first);
+						decltype (scan)::results_t results;
+						for (; i != n && !scan.visit (first); ++i)
+						{
+							nano::account_info const & info (i->second);
+							if (info.modified >= modified_since)
+							{
+								results.emplace_back (i->first, info.balance);
+								if (bounded && results.size () >= 2 * count + 1)
+								{
+									trim (results);
+								}
+							}
+						}
+						if (bounded && results.size () > count)
+						{
+							trim (results);
+						}
+						auto size (results.size ());
+						scan.finish (first, std::move (results), size);
+					}
+				});
+				for (auto const & [account, balance] : scan.results ())
+				{
+					ledger_l.emplace_back (balance, account);
+				}
+				// The ranges were scanned with their own transactions, which may be newer than this one
+				transaction.refresh ();
+			}
 			std::sort (ledger_l.begin (), ledger_l.end ());
 			std::reverse (ledger_l.begin (), ledger_l.end ());
 			nano::account_info info;
-			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts.size () < count; ++i)
+			for (auto i (ledger_l.begin ()), n (ledger_l.end ()); i != n && accounts_count < count; ++i)
 			{
-				node.store.account.get (transaction, i->second, info);
-				if (pending || info.balance.number () >= threshold.number ())
+				auto error (node.store.account.get (transaction, i->second, info));
+				if (!error && (pending || info.balance.number () >= threshold.number ()))
 				{
 					nano::account const & account (i->second);
-					boost::property_tree::ptree response_a;
+					boost::optional<nano::uint128_t> account_pending;
 					if (pending)
 					{
-						auto account_pending (node.ledger.account_pending (transaction, account));
-						if (info.balance.number () + account_pending < threshold.number ())
+						account_pending = node.ledger.account_pending (transaction, account);
+						if (info.balance.number () + *account_pending < threshold.number ())
 						{
 							continue;
 						}
-						response_a.put ("pending", account_pending.convert_to<std::string> ());
 					}
-					response_a.put ("frontier", info.head.to_string ());
-					response_a.put ("open_block", info.open_block.to_string ());
-					response_a.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
+					response_writer.begin_object (account.to_account ());
+					if (account_pending)
+					{
+						response_writer.put ("pending", account_pending->convert_to<std::string> ());
+					}
+					response_writer.put ("frontier", info.head.to_string ());
+					response_writer.put ("open_block", info.open_block.to_string ());
+					response_writer.put ("representative_block", node.ledger.representative (transaction, info.head).to_string ());
 					std::string balance;
 					(i->first).encode_dec (balance);
-					response_a.put ("balance", balance);
-					response_a.put ("modified_timestamp", std::to_string (info.modified));
-					response_a.put ("block_count", std::to_string (info.block_count));
+					response_writer.put ("balance", balance);
+					response_writer.put ("modified_timestamp", std::to_string (info.modified));
+					response_writer.put ("block_count", std::to_string (info.block_count));
 					if (representative)
 					{
-						response_a.put ("representative", info.representative.to_account ());
+						response_writer.put ("representative", info.representative.to_account ());
 					}
 					if (weight)
 					{
 						auto account_weight (node.ledger.weight (account));
-						response_a.put ("weight", account_weight.convert_to<std::string> ());
+						response_writer.put ("weight", account_weight.convert_to<std::string> ());
 					}
-					accounts.push_back (std::make_pair (account.to_account (), response_a));
+					response_writer.end_object ();
+					++accounts_count;
 				}
 			}
 		}
-		response_l.add_child ("accounts", accounts);
+		response_writer.end_object ();
 	}
 	response_errors ();
 }
@@ -2862,6 +3247,7 @@ void nano::json_handler::peers ()
 				pending_tree.put ("node_id", "");
 			}
 			pending_tree.put ("type", channel->get_type () == nano::transport::transport_type::tcp ? "tcp" : "udp");
+			pending_tree.put ("ingress_drops", std::to_string (node.network.ingress.drops (channel->get_endpoint ())));
 			peers_l.push_back (boost::property_tree::ptree::value_type (text.str (), pending_tree));
 		}
 		else
@@ -2983,7 +3369,7 @@ void nano::json_handler::pending_exists ()
 	const bool include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
+		auto transaction (borrow_read_transaction ());
 		auto block (node.store.block.get (transaction, hash));
 		if (block != nullptr)
 		{
@@ -3896,9 +4282,9 @@ void nano::json_handler::telemetry ()
 		auto output_raw = raw.value_or (false);
 		if (node.telemetry)
 		{
-			auto telemetry_responses = node.telemetry->get_metrics ();
 			if (output_raw)
 			{
+				auto telemetry_responses = node.telemetry->get_metrics ();
 				boost::property_tree::ptree metrics;
 				for (auto & telemetry_metrics : telemetry_responses)
 				{
@@ -3922,13 +4308,8 @@ void nano::json_handler::telemetry ()
 			else
 			{
 				nano::jsonconfig config_l;
-				std::vector<nano::telemetry_data> telemetry_datas;
-				telemetry_datas.reserve (telemetry_responses.size ());
-				std::transform (telemetry_responses.begin (), telemetry_responses.end (), std::back_inserter (telemetry_datas), [] (auto const & endpoint_telemetry_data) {
-					return endpoint_telemetry_data.second;
-				});
-
-				auto average_telemetry_metrics = nano::consolidate_telemetry_data (telemetry_datas);
+				// Maintained incrementally as telemetry arrives, so this does not depend on the number of peers
+				auto average_telemetry_metrics = node.telemetry->get_consolidated_metrics ();
 				// Don't add node_id/signature in consolidated metrics
 				auto const should_ignore_identification_metrics = true;
 				auto err = average_telemetry_metrics.serialize_json (config_l, should_ignore_identification_metrics);
@@ -3937,6 +4318,21 @@ void nano::json_handler::telemetry ()
 				if (!err)
 				{
 					response_l.insert (response_l.begin (), ptree.begin (), ptree.end ());
+					if (request.get<bool> ("percentiles", false))
+					{
+						boost::property_tree::ptree percentiles;
+						for (auto const & [metric, summary] : node.telemetry->get_metric_summaries ())
+						{
+							boost::property_tree::ptree entry;
+							entry.put ("p10", summary.p10);
+							entry.put ("p50", summary.p50);
+							entry.put ("p90", summary.p90);
+							entry.put ("p99", summary.p99);
+							entry.put ("samples", summary.samples);
+							percentiles.add_child (metric, entry);
+						}
+						response_l.add_child ("percentiles", percentiles);
+					}
 				}
 				else
 				{
@@ -3955,25 +4351,31 @@ void nano::json_handler::unchecked ()
 	auto count (count_optional_impl ());
 	if (!ec)
 	{
-		boost::property_tree::ptree unchecked;
+		uint64_t listed_count (0);
+		// Without json_block a block depending on several others is listed once, matching the former ptree::put
+		std::unordered_set<nano::block_hash> listed;
 		auto transaction (node.store.tx_begin_read ());
-		for (auto i (node.store.unchecked.begin (transaction)), n (node.store.unchecked.end ()); i != n && unchecked.size () < count; ++i)
+		response_writer.begin_object ("blocks");
+		for (auto i (node.store.unchecked.begin (transaction)), n (node.store.unchecked.end ()); i != n && listed_count < count; ++i)
 		{
 			nano::unchecked_info const & info (i->second);
+			auto const hash (info.block->hash ());
 			if (json_block_l)
 			{
 				boost::property_tree::ptree block_node_l;
 				info.block->serialize_json (block_node_l);
-				unchecked.add_child (info.block->hash ().to_string (), block_node_l);
+				response_writer.put_child (hash.to_string (), block_node_l);
+				++listed_count;
 			}
-			else
+			else if (listed.insert (hash).second)
 			{
 				std::string contents;
 				info.block->serialize_json (contents);
-				unchecked.put (info.block->hash ().to_string (), contents);
+				response_writer.put (hash.to_string (), contents);
+				++listed_count;
 			}
 		}
-		response_l.add_child ("blocks", unchecked);
+		response_writer.end_object ();
 	}
 	response_errors ();
 }
@@ -4081,48 +4483,110 @@ void nano::json_handler::unopened ()
 	}
 	if (!ec)
 	{
-		auto transaction (node.store.tx_begin_read ());
-		auto iterator (node.store.pending.begin (transaction, nano::pending_key (start, 0)));
-		auto end (node.store.pending.end ());
-		nano::account current_account (start);
-		nano::uint128_t current_account_sum{ 0 };
 		boost::property_tree::ptree accounts;
-		while (iterator != end && accounts.size () < count)
-		{
-			nano::pending_key key (iterator->first);
-			nano::account account (key.account);
-			nano::pending_info info (iterator->second);
-			if (node.store.account.exists (transaction, account))
-			{
-				if (account.number () == std::numeric_limits<nano::uint256_t>::max ())
+		if (count < parallel_scan_count)
+		{
+			auto transaction (node.store.tx_begin_read ());
+			auto iterator (node.store.pending.begin (transaction, nano::pending_key (start, 0)));
+			auto end (node.store.pending.end ());
+			nano::account current_account (start);
+			nano::uint128_t current_account_sum{ 0 };
+			while (iterator != end && accounts.size () < count)
+			{
+				nano::pending_key key (iterator->first);
+				nano::account account (key.account);
+				nano::pending_info info (iterator->second);
+				if (node.store.account.exists (transaction, account))
 				{
-					break;
+					if (account.number () == std::numeric_limits<nano::uint256_t>::max ())
+					{
+						break;
+					}
+					// Skip existing accounts
+					iterator = node.store.pending.begin (transaction, nano::pending_key (account.number () + 1, 0));
 				}
-				// Skip existing accounts
-				iterator = node.store.pending.begin (transaction, nano::pending_key (account.number () + 1, 0));
-			}
-			else
-			{
-				if (account != current_account)
+				else
 				{
-					if (current_account_sum > 0)
+					if (account != current_account)
 					{
-						if (current_account_sum >= threshold.number ())
+						if (current_account_sum > 0)
 						{
-							accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+							if (current_account_sum >= threshold.number ())
+							{
+								accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+							}
+							current_account_sum = 0;
 						}
-						current_account_sum = 0;
+						current_account = account;
 					}
-					current_account = account;
+					current_account_sum += info.amount.number ();
+					++iterator;
 				}
-				current_account_sum += info.amount.number ();
-				++iterator;
+			}
+			// last one after iterator reaches end
+			if (accounts.size () < count && current_account_sum > 0 && current_account_sum >= threshold.number ())
+			{
+				accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
 			}
 		}
-		// last one after iterator reaches end
-		if (accounts.size () < count && current_account_sum > 0 && current_account_sum >= threshold.number ())
+		else
 		{
-			accounts.put (current_account.to_account (), current_account_sum.convert_to<std::string> ());
+			ordered_scan<nano::account, nano::uint128_t> scan (node, "unopened", count);
+			scan_pending (node, [this, &scan, &start, &threshold, count] (nano::read_transaction const & transaction_a, nano::store_iterator<nano::pending_key, nano::pending_info> i, nano::store_iterator<nano::pending_key, nano::pending_info> n) {
+				scan.start ();
+				auto const end (node.store.pending.end ());
+				auto in_range (i == n || !pending_less (i->first, nano::pending_key (start, 0)) || seek (node.store, transaction_a, i, n, nano::pending_key (start, 0)));
+				if (in_range && i != n)
+				{
+					nano::account first (i->first.account);
+					decltype (scan)::results_t results;
+					uint64_t definite (0);
+					// One more than count as the first account may only be a part of one from the previous range
+					while (in_range && i != n && results.size () <= count && !scan.visit (first))
+					{
+						nano::account account (i->first.account);
+						if (node.store.account.exists (transaction_a, account))
+						{
+							if (account.number () == std::numeric_limits<nano::uint256_t>::max ())
+							{
+								break;
+							}
+							// Skip existing accounts
+							in_range = seek (node.store, transaction_a, i, n, nano::pending_key (account.number () + 1, 0));
+						}
+						else
+						{
+							nano::uint128_t sum (0);
+							for (; i != n && i->first.account == account; ++i)
+							{
+								sum += i->second.amount.number ();
+							}
+							// Accounts at either end of the range may continue in a neighbouring range, these are summed and filtered when merging
+							auto boundary (account == first || (i == n && n != end && n->first.account == account));
+							if (boundary || (sum > 0 && sum >= threshold.number ()))
+							{
+								results.emplace_back (account, sum);
+								definite += boundary ? 0 : 1;
+							}
+						}
+					}
+					scan.finish (first, std::move (results), definite);
+				}
+			});
+			auto results (scan.results ());
+			for (auto i (results.begin ()), n (results.end ()); i != n && accounts.size () < count;)
+			{
+				auto account (i->first);
+				nano::uint128_t sum (0);
+				for (; i != n && i->first == account; ++i)
+				{
+					sum += i->second;
+				}
+				if (sum > 0 && sum >= threshold.number ())
+				{
+					accounts.put (account.to_account (), sum.convert_to<std::string> ());
+				}
+			}
 		}
 		response_l.add_child ("accounts", accounts);
 	}
@@ -4291,10 +4755,12 @@ void nano::json_handler::wallet_balances ()
 		boost::property_tree::ptree balances;
 		auto transaction (node.wallets.tx_begin_read ());
 		auto block_transaction (node.store.tx_begin_read ());
-		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
+		auto accounts (wallet_accounts_impl (transaction, wallet));
+		auto infos (node.store.account.get_many (block_transaction, accounts));
+		for (size_t i (0), n (accounts.size ()); i < n; ++i)
 		{
-			nano::account const & account (i->first);
-			nano::uint128_t balance = node.ledger.account_balance (block_transaction, account);
+			nano::account const & account (accounts[i]);
+			nano::uint128_t balance = infos[i] ? infos[i]->balance.number () : nano::uint128_t (0);
 			if (balance >= threshold.number ())
 			{
 				boost::property_tree::ptree entry;
@@ -4545,12 +5011,14 @@ void nano::json_handler::wallet_ledger ()
 		boost::property_tree::ptree accounts;
 		auto transaction (node.wallets.tx_begin_read ());
 		auto block_transaction (node.store.tx_begin_read ());
-		for (auto i (wallet->store.begin (transaction)), n (wallet->store.end ()); i != n; ++i)
+		auto accounts_l (wallet_accounts_impl (transaction, wallet));
+		auto infos (node.store.account.get_many (block_transaction, accounts_l));
+		for (size_t i (0), n (accounts_l.size ()); i < n; ++i)
 		{
-			nano::account const & account (i->first);
-			nano::account_info info;
-			if (!node.store.account.get (block_transaction, account, info))
+			nano::account const & account (accounts_l[i]);
+			if (infos[i])
 			{
+				auto const & info (*infos[i]);
 				if (info.modified >= modified_since)
 				{
 					boost::property_tree::ptree entry;
@@ -5213,7 +5681,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 }
 
 /** Due to the asynchronous nature of updating confirmation heights, it can also be necessary to check active roots */
-bool block_confirmed (nano::node & node, nano::transaction & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed)
+bool block_confirmed (nano::node & node, nano::transaction const & transaction, nano::block_hash const & hash, bool include_active, bool include_only_confirmed)
 {
 	bool is_confirmed = false;
 	if (include_active && !include_only_confirmed)
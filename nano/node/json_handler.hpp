@@ -1,7 +1,9 @@
 #pragma once
 
+#include <nano/lib/json_writer.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/node/ipc/flatbuffers_handler.hpp>
+#include <nano/node/read_transaction_pool.hpp>
 #include <nano/node/wallet.hpp>
 #include <nano/rpc/rpc.hpp>
 
@@ -135,6 +137,11 @@ public:
 	void work_peers_clear ();
 	void work_set ();
 	void work_validate ();
+	/** ledger and unopened scan their table in this many key ranges when at least parallel_scan_count results are requested */
+	static unsigned constexpr scan_ranges{ 16 };
+	static uint64_t constexpr parallel_scan_count{ 1000 };
+	/** Node workers helping a request with its scan, each holds a read transaction while scanning a range */
+	static unsigned constexpr scan_helpers{ 2 };
 	std::string body;
 	nano::node & node;
 	boost::property_tree::ptree request;
@@ -143,10 +150,21 @@ public:
 	std::error_code ec;
 	std::string action;
 	boost::property_tree::ptree response_l;
+	/** Used instead of response_l by actions with large responses */
+	nano::json_writer response_writer;
+	/** Set when the response may be stored in the node's rpc_cache, empty otherwise */
+	std::string cache_key;
+	uint64_t cache_generation{ 0 };
+	void cache_response (std::string const &);
+	/** Borrows from the node's read transaction pool, with a fresh snapshot if the response may be cached */
+	nano::pooled_read_transaction borrow_read_transaction ();
 	std::shared_ptr<nano::wallet> wallet_impl ();
 	bool wallet_locked_impl (nano::transaction const &, std::shared_ptr<nano::wallet> const &);
 	bool wallet_account_impl (nano::transaction const &, std::shared_ptr<nano::wallet> const &, nano::account const &);
 	nano::account account_impl (std::string = "", std::error_code = nano::error_common::bad_account_number);
+	/** Parses the "accounts" list up to the first invalid account */
+	std::vector<nano::account> accounts_impl ();
+	std::vector<nano::account> wallet_accounts_impl (nano::transaction const &, std::shared_ptr<nano::wallet> const &);
 	nano::account_info account_info_impl (nano::transaction const &, nano::account const &);
 	nano::amount amount_impl ();
 	std::shared_ptr<nano::block> block_impl (bool = true);
@@ -53,6 +53,7 @@ nano::mdb_store::mdb_store (nano::logger_mt & logger_a, boost::filesystem::path
 		peer_store_partial,
 		confirmation_height_store_partial,
 		final_vote_store_partial,
+		account_height_store_partial,
 		version_store_partial
 	},
 	// clang-format on
@@ -65,6 +66,7 @@ nano::mdb_store::mdb_store (nano::logger_mt & logger_a, boost::filesystem::path
 	peer_store_partial{ *this },
 	confirmation_height_store_partial{ *this },
 	final_vote_store_partial{ *this },
+	account_height_store_partial{ *this },
 	unchecked_mdb_store{ *this },
 	version_store_partial{ *this },
 	logger (logger_a),
@@ -226,6 +228,7 @@ void nano::mdb_store::open_databases (bool & error_a, nano::transaction const &
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "pending", flags, &pending_v0_handle) != 0;
 	pending_handle = pending_v0_handle;
 	error_a |= mdb_dbi_open (env.tx (transaction_a), "final_votes", flags, &final_votes_handle) != 0;
+	error_a |= mdb_dbi_open (env.tx (transaction_a), "account_heights", flags, &account_heights_handle) != 0;
 
 	auto version_l = version.get (transaction_a);
 	if (version_l < 19)
@@ -310,6 +313,9 @@ bool nano::mdb_store::do_upgrades (nano::write_transaction & transaction_a, bool
 			upgrade_v20_to_v21 (transaction_a);
 			[[fallthrough]];
 		case 21:
+			upgrade_v21_to_v22 (transaction_a);
+			[[fallthrough]];
+		case 22:
 			break;
 		default:
 			logger.always_log (boost::str (boost::format ("The version of the ledger (%1%) is too high for this node") % version_l));
@@ -783,6 +789,15 @@ void nano::mdb_store::upgrade_v20_to_v21 (nano::write_transaction const & transa
 	logger.always_log ("Finished creating new final_vote table");
 }
 
+void nano::mdb_store::upgrade_v21_to_v22 (nano::write_transaction const & transaction_a)
+{
+	logger.always_log ("Preparing v21 to v22 database upgrade...");
+	// The table is filled in the background by nodes which enable the account height index
+	mdb_dbi_open (env.tx (transaction_a), "account_heights", MDB_CREATE, &account_heights_handle);
+	version.put (transaction_a, 22);
+	logger.always_log ("Finished creating new account_heights table");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void nano::mdb_store::create_backup_file (nano::mdb_env & env_a, boost::filesystem::path const & filepath_a, nano::logger_mt & logger_a)
 {
@@ -841,6 +856,24 @@ int nano::mdb_store::get (nano::transaction const & transaction_a, tables table_
 	return mdb_get (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a);
 }
 
+std::vector<int> nano::mdb_store::multi_get (nano::transaction const & transaction_a, tables table_a, std::vector<nano::mdb_val> const & keys_a, std::vector<nano::mdb_val> & values_a) const
+{
+	std::vector<int> result;
+	result.reserve (keys_a.size ());
+	values_a.resize (keys_a.size ());
+	MDB_cursor * cursor;
+	auto status (mdb_cursor_open (env.tx (transaction_a), table_to_dbi (table_a), &cursor));
+	release_assert (status == MDB_SUCCESS);
+	for (size_t i (0), n (keys_a.size ()); i < n; ++i)
+	{
+		// An initialized cursor first checks its current leaf page, so ascending keys avoid most descents from the root
+		MDB_val key (keys_a[i].value);
+		result.push_back (mdb_cursor_get (cursor, &key, &values_a[i].value, MDB_SET));
+	}
+	mdb_cursor_close (cursor);
+	return result;
+}
+
 int nano::mdb_store::put (nano::write_transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a, const nano::mdb_val & value_a) const
 {
 	return (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
@@ -900,6 +933,8 @@ MDB_dbi nano::mdb_store::table_to_dbi (tables table_a) const
 			return confirmation_height_handle;
 		case tables::final_votes:
 			return final_votes_handle;
+		case tables::account_heights:
+			return account_heights_handle;
 		default:
 			release_assert (false);
 			return peers_handle;
@@ -8,6 +8,7 @@
 #include <nano/node/lmdb/lmdb_iterator.hpp>
 #include <nano/node/lmdb/lmdb_txn.hpp>
 #include <nano/secure/common.hpp>
+#include <nano/secure/store/account_height_store_partial.hpp>
 #include <nano/secure/store/account_store_partial.hpp>
 #include <nano/secure/store/block_store_partial.hpp>
 #include <nano/secure/store/confirmation_height_store_partial.hpp>
@@ -64,6 +65,7 @@ private:
 	nano::peer_store_partial<MDB_val, mdb_store> peer_store_partial;
 	nano::confirmation_height_store_partial<MDB_val, mdb_store> confirmation_height_store_partial;
 	nano::final_vote_store_partial<MDB_val, mdb_store> final_vote_store_partial;
+	nano::account_height_store_partial<MDB_val, mdb_store> account_height_store_partial;
 	nano::version_store_partial<MDB_val, mdb_store> version_store_partial;
 
 	friend class nano::unchecked_mdb_store;
@@ -228,9 +230,17 @@ public:
 	 */
 	MDB_dbi final_votes_handle{ 0 };
 
+	/**
+	 * Hash of the block at each height of an account chain, maintained when the account height index is enabled
+	 * nano::account_height_key -> nano::block_hash
+	 */
+	MDB_dbi account_heights_handle{ 0 };
+
 	bool exists (nano::transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a) const;
 
 	int get (nano::transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a, nano::mdb_val & value_a) const;
+	/** Looks up sorted keys_a with one cursor, values_a and the returned statuses are in the order of keys_a */
+	std::vector<int> multi_get (nano::transaction const & transaction_a, tables table_a, std::vector<nano::mdb_val> const & keys_a, std::vector<nano::mdb_val> & values_a) const;
 	int put (nano::write_transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a, const nano::mdb_val & value_a) const;
 	int del (nano::write_transaction const & transaction_a, tables table_a, nano::mdb_val const & key_a) const;
 
@@ -270,6 +280,7 @@ private:
 	void upgrade_v18_to_v19 (nano::write_transaction const &);
 	void upgrade_v19_to_v20 (nano::write_transaction const &);
 	void upgrade_v20_to_v21 (nano::write_transaction const &);
+	void upgrade_v21_to_v22 (nano::write_transaction const &);
 
 	std::shared_ptr<nano::block> block_get_v18 (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const;
 	nano::mdb_val block_raw_get_v18 (nano::transaction const & transaction_a, nano::block_hash const & hash_a, nano::block_type & type_a) const;
@@ -0,0 +1,298 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/threading.hpp>
+#include <nano/node/message_coalescer.hpp>
+#include <nano/node/network.hpp>
+#include <nano/node/transport/transport.hpp>
+
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+size_t message_count (size_t hashes_a, size_t hashes_max_a)
+{
+	return (hashes_a + hashes_max_a - 1) / hashes_max_a;
+}
+}
+
+nano::message_coalescer::channel_entry::channel_entry (nano::endpoint const & endpoint_a) :
+	endpoint (endpoint_a)
+{
+}
+
+nano::message_coalescer::message_coalescer (nano::network_constants const & network_constants_a, nano::stat & stats_a) :
+	max_delay (network_constants_a.is_dev_network () ? 10 : 20),
+	idle_cutoff (network_constants_a.is_dev_network () ? 10 * 1000 : 5 * 60 * 1000),
+	stats (stats_a),
+	next_cleanup (std::chrono::steady_clock::now () + idle_cutoff),
+	thread ([this] () { run (); })
+{
+	nano::unique_lock<nano::mutex> lock (mutex);
+	condition.wait (lock, [&started = started] { return started; });
+}
+
+void nano::message_coalescer::add_confirm_req (std::shared_ptr<nano::transport::channel> const & channel_a, std::vector<std::pair<nano::block_hash, nano::root>> const & roots_hashes_a)
+{
+	auto const hashes_max (nano::network::confirm_req_hashes_max);
+	auto const endpoint (nano::transport::map_endpoint_to_v6 (channel_a->get_endpoint ()));
+	auto const now (std::chrono::steady_clock::now ());
+	std::vector<std::pair<nano::block_hash, nano::root>> to_send;
+	bool held (false);
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto & entries_by_endpoint (entries.get<tag_endpoint> ());
+		auto existing (entries_by_endpoint.find (endpoint));
+		if (existing == entries_by_endpoint.end ())
+		{
+			existing = entries_by_endpoint.emplace (endpoint).first;
+		}
+		entries_by_endpoint.modify (existing, [&] (channel_entry & entry_a) {
+			if (entry_a.last_arrival != std::chrono::steady_clock::time_point{})
+			{
+				auto const interval (now - entry_a.last_arrival);
+				entry_a.arrival_interval = entry_a.arrival_interval == std::chrono::steady_clock::duration::max () ? interval : (3 * entry_a.arrival_interval + interval) / 4;
+			}
+			entry_a.last_arrival = now;
+			entry_a.last_activity = now;
+			pending_count -= entry_a.pending.size ();
+			entry_a.pending.insert (entry_a.pending.end (), roots_hashes_a.begin (), roots_hashes_a.end ());
+			// Full messages always go out, the remainder is held back only if more requests are expected within max_delay
+			auto const full ((entry_a.pending.size () / hashes_max) * hashes_max);
+			auto const hold (entry_a.arrival_interval < max_delay && full < entry_a.pending.size ());
+			auto const send_count (hold ? full : entry_a.pending.size ());
+			to_send.assign (entry_a.pending.begin (), entry_a.pending.begin () + send_count);
+			entry_a.pending.erase (entry_a.pending.begin (), entry_a.pending.begin () + send_count);
+			entry_a.confirm_req_messages += message_count (send_count, hashes_max);
+			entry_a.confirm_req_hashes += send_count;
+			if (entry_a.pending.empty ())
+			{
+				entry_a.channel.reset ();
+				entry_a.deadline = std::chrono::steady_clock::time_point::max ();
+			}
+			else
+			{
+				entry_a.channel = channel_a;
+				if (entry_a.deadline == std::chrono::steady_clock::time_point::max ())
+				{
+					entry_a.deadline = now + max_delay;
+					held = true;
+				}
+			}
+			pending_count += entry_a.pending.size ();
+		});
+	}
+	if (held)
+	{
+		stats.inc (nano::stat::type::coalescer, nano::stat::detail::coalescer_held);
+		condition.notify_all ();
+	}
+	send (channel_a, to_send);
+}
+
+void nano::message_coalescer::confirm_ack_sent (nano::transport::channel const & channel_a, size_t hashes_a)
+{
+	auto const endpoint (nano::transport::map_endpoint_to_v6 (channel_a.get_endpoint ()));
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto & entries_by_endpoint (entries.get<tag_endpoint> ());
+		auto existing (entries_by_endpoint.find (endpoint));
+		if (existing == entries_by_endpoint.end ())
+		{
+			existing = entries_by_endpoint.emplace (endpoint).first;
+		}
+		entries_by_endpoint.modify (existing, [hashes_a] (channel_entry & entry_a) {
+			entry_a.last_activity = std::chrono::steady_clock::now ();
+			++entry_a.confirm_ack_messages;
+			entry_a.confirm_ack_hashes += hashes_a;
+		});
+	}
+	stats.inc (nano::stat::type::coalescer, nano::stat::detail::confirm_ack, nano::stat::dir::out);
+	stats.add (nano::stat::type::coalescer, nano::stat::detail::coalescer_ack_hashes, nano::stat::dir::out, hashes_a);
+}
+
+void nano::message_coalescer::send (std::shared_ptr<nano::transport::channel> const & channel_a, std::vector<std::pair<nano::block_hash, nano::root>> const & roots_hashes_a)
+{
+	auto const hashes_max (nano::network::confirm_req_hashes_max);
+	for (auto i (roots_hashes_a.begin ()), n (roots_hashes_a.end ()); i != n;)
+	{
+		auto const count (std::min<size_t> (hashes_max, std::distance (i, n)));
+		std::vector<std::pair<nano::block_hash, nano::root>> roots_hashes_l (i, i + count);
+		nano::confirm_req req (roots_hashes_l);
+		channel_a->send (req);
+		stats.inc (nano::stat::type::coalescer, nano::stat::detail::confirm_req, nano::stat::dir::out);
+		stats.add (nano::stat::type::coalescer, nano::stat::detail::coalescer_req_hashes, nano::stat::dir::out, count);
+		i += count;
+	}
+}
+
+void nano::message_coalescer::flush ()
+{
+	std::vector<std::pair<std::shared_ptr<nano::transport::channel>, std::vector<std::pair<nano::block_hash, nano::root>>>> to_send;
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto & entries_by_deadline (entries.get<tag_deadline> ());
+		while (!entries_by_deadline.empty () && entries_by_deadline.begin ()->deadline != std::chrono::steady_clock::time_point::max ())
+		{
+			decltype (to_send)::value_type item;
+			entries_by_deadline.modify (entries_by_deadline.begin (), [&item] (channel_entry & entry_a) {
+				entry_a.confirm_req_messages += message_count (entry_a.pending.size (), nano::network::confirm_req_hashes_max);
+				entry_a.confirm_req_hashes += entry_a.pending.size ();
+				entry_a.deadline = std::chrono::steady_clock::time_point::max ();
+				item.first.swap (entry_a.channel);
+				item.second.swap (entry_a.pending);
+			});
+			pending_count -= item.second.size ();
+			to_send.push_back (std::move (item));
+		}
+	}
+	for (auto const & [channel, roots_hashes] : to_send)
+	{
+		send (channel, roots_hashes);
+	}
+}
+
+void nano::message_coalescer::run ()
+{
+	nano::thread_role::set (nano::thread_role::name::message_coalescer);
+	nano::unique_lock<nano::mutex> lock (mutex);
+	started = true;
+	lock.unlock ();
+	condition.notify_all ();
+	lock.lock ();
+	while (!stopped)
+	{
+		auto const now (std::chrono::steady_clock::now ());
+		if (next_cleanup <= now)
+		{
+			cleanup (now);
+			next_cleanup = now + idle_cutoff;
+		}
+		auto & entries_by_deadline (entries.get<tag_deadline> ());
+		auto front (entries_by_deadline.begin ());
+		if (front != entries_by_deadline.end () && front->deadline <= now)
+		{
+			// Store the channel and hashes for sending after releasing the lock
+			decltype (front->channel) channel{};
+			decltype (front->pending) roots_hashes{};
+			entries_by_deadline.modify (front, [&channel, &roots_hashes] (channel_entry & entry_a) {
+				entry_a.confirm_req_messages += message_count (entry_a.pending.size (), nano::network::confirm_req_hashes_max);
+				entry_a.confirm_req_hashes += entry_a.pending.size ();
+				entry_a.deadline = std::chrono::steady_clock::time_point::max ();
+				channel.swap (entry_a.channel);
+				roots_hashes.swap (entry_a.pending);
+			});
+			pending_count -= roots_hashes.size ();
+			lock.unlock ();
+			stats.inc (nano::stat::type::coalescer, nano::stat::detail::coalescer_expired);
+			send (channel, roots_hashes);
+			lock.lock ();
+		}
+		else
+		{
+			auto wakeup (next_cleanup);
+			if (front != entries_by_deadline.end ())
+			{
+				wakeup = std::min (wakeup, front->deadline);
+			}
+			condition.wait_until (lock, wakeup, [this, &wakeup] () {
+				auto const & entries_by_deadline (this->entries.get<tag_deadline> ());
+				return this->stopped || wakeup <= std::chrono::steady_clock::now () || (!entries_by_deadline.empty () && entries_by_deadline.begin ()->deadline < wakeup);
+			});
+		}
+	}
+}
+
+/** Erase idle endpoints, mutex must be held */
+void nano::message_coalescer::cleanup (std::chrono::steady_clock::time_point const & now_a)
+{
+	for (auto i (entries.begin ()), n (entries.end ()); i != n;)
+	{
+		if (i->pending.empty () && i->last_activity + idle_cutoff < now_a)
+		{
+			i = entries.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void nano::message_coalescer::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+double nano::message_coalescer::fill_ratio (nano::endpoint const & endpoint_a, nano::message_type type_a)
+{
+	double result (0.0);
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto existing (entries.get<tag_endpoint> ().find (nano::transport::map_endpoint_to_v6 (endpoint_a)));
+	if (existing != entries.get<tag_endpoint> ().end ())
+	{
+		result = fill_ratio (*existing, type_a);
+	}
+	return result;
+}
+
+double nano::message_coalescer::fill_ratio (channel_entry const & entry_a, nano::message_type type_a)
+{
+	debug_assert (type_a == nano::message_type::confirm_req || type_a == nano::message_type::confirm_ack);
+	auto const is_req (type_a == nano::message_type::confirm_req);
+	auto const messages (is_req ? entry_a.confirm_req_messages : entry_a.confirm_ack_messages);
+	auto const hashes (is_req ? entry_a.confirm_req_hashes : entry_a.confirm_ack_hashes);
+	auto const hashes_max (is_req ? nano::network::confirm_req_hashes_max : nano::network::confirm_ack_hashes_max);
+	return messages > 0 ? static_cast<double> (hashes) / (messages * hashes_max) : 0.0;
+}
+
+size_t nano::message_coalescer::pending ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return pending_count;
+}
+
+size_t nano::message_coalescer::size ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return entries.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (nano::message_coalescer & coalescer, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	// Fill ratios of each endpoint, in percent of the capacity of the messages sent
+	auto channels = std::make_unique<container_info_composite> ("channels");
+	size_t entries_count;
+	size_t pending_count;
+	{
+		nano::lock_guard<nano::mutex> guard (coalescer.mutex);
+		entries_count = coalescer.entries.size ();
+		pending_count = coalescer.pending_count;
+		for (auto const & entry : coalescer.entries)
+		{
+			std::stringstream endpoint;
+			endpoint << entry.endpoint;
+			auto channel = std::make_unique<container_info_composite> (endpoint.str ());
+			auto percent = [&entry] (nano::message_type type_a) {
+				return static_cast<size_t> (std::lround (100 * nano::message_coalescer::fill_ratio (entry, type_a)));
+			};
+			channel->add_component (std::make_unique<container_info_leaf> (container_info{ "confirm_req_messages", entry.confirm_req_messages, 0 }));
+			channel->add_component (std::make_unique<container_info_leaf> (container_info{ "confirm_req_fill_percent", percent (nano::message_type::confirm_req), 0 }));
+			channel->add_component (std::make_unique<container_info_leaf> (container_info{ "confirm_ack_messages", entry.confirm_ack_messages, 0 }));
+			channel->add_component (std::make_unique<container_info_leaf> (container_info{ "confirm_ack_fill_percent", percent (nano::message_type::confirm_ack), 0 }));
+			channels->add_component (std::move (channel));
+		}
+	}
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", entries_count, sizeof (decltype (coalescer.entries)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "pending", pending_count, sizeof (std::pair<nano::block_hash, nano::root>) }));
+	composite->add_component (std::move (channels));
+	return composite;
+}
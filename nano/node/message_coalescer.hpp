@@ -0,0 +1,105 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/node/common.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <chrono>
+#include <thread>
+
+namespace mi = boost::multi_index;
+
+namespace nano
+{
+class stat;
+namespace transport
+{
+	class channel;
+}
+/**
+ * Coalesces outbound confirm_req hashes separately for each endpoint so that messages carry as many hashes as possible.
+ * Full messages are sent immediately. A partially filled message is only held back, for at most max_delay, when requests
+ * for the endpoint have recently been arriving faster than max_delay, otherwise it is sent immediately so that sparse
+ * traffic does not pay any extra latency.
+ * The fill ratio of confirm_req and confirm_ack messages is tracked for each endpoint and reported in the container info.
+ */
+class message_coalescer final
+{
+	class channel_entry final
+	{
+	public:
+		explicit channel_entry (nano::endpoint const &);
+		nano::endpoint endpoint;
+		/** Only held while hashes are pending, which extends the lifetime of the channel up to max_delay */
+		std::shared_ptr<nano::transport::channel> channel;
+		std::vector<std::pair<nano::block_hash, nano::root>> pending;
+		std::chrono::steady_clock::time_point deadline{ std::chrono::steady_clock::time_point::max () };
+		std::chrono::steady_clock::time_point last_arrival{};
+		std::chrono::steady_clock::time_point last_activity{ std::chrono::steady_clock::now () };
+		/** Moving average of the time between requests, starts out as slow traffic */
+		std::chrono::steady_clock::duration arrival_interval{ std::chrono::steady_clock::duration::max () };
+		uint64_t confirm_req_messages{ 0 };
+		uint64_t confirm_req_hashes{ 0 };
+		uint64_t confirm_ack_messages{ 0 };
+		uint64_t confirm_ack_hashes{ 0 };
+	};
+
+	// clang-format off
+	class tag_endpoint {};
+	class tag_deadline {};
+	// clang-format on
+
+public:
+	message_coalescer (nano::network_constants const &, nano::stat &);
+	/** Queue confirm_req \p roots_hashes_a for \p channel_a */
+	void add_confirm_req (std::shared_ptr<nano::transport::channel> const & channel_a, std::vector<std::pair<nano::block_hash, nano::root>> const & roots_hashes_a);
+	/** Record a confirm_ack containing \p hashes_a hashes sent to \p channel_a */
+	void confirm_ack_sent (nano::transport::channel const & channel_a, size_t hashes_a);
+	/** Send every pending message regardless of its deadline */
+	void flush ();
+	void stop ();
+	/** Ratio of hashes sent to \p endpoint_a to the capacity of the messages of type \p type_a that were sent, 0 if none were sent */
+	double fill_ratio (nano::endpoint const & endpoint_a, nano::message_type type_a);
+	/** Number of hashes waiting to be sent */
+	size_t pending ();
+	size_t size ();
+
+	std::chrono::milliseconds const max_delay;
+	/** Endpoints without traffic for this long are forgotten */
+	std::chrono::milliseconds const idle_cutoff;
+
+private:
+	void run ();
+	void cleanup (std::chrono::steady_clock::time_point const &);
+	void send (std::shared_ptr<nano::transport::channel> const &, std::vector<std::pair<nano::block_hash, nano::root>> const &);
+	static double fill_ratio (channel_entry const &, nano::message_type);
+
+	nano::stat & stats;
+
+	// clang-format off
+	boost::multi_index_container<channel_entry,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_endpoint>,
+			mi::member<channel_entry, nano::endpoint, &channel_entry::endpoint>>,
+		mi::ordered_non_unique<mi::tag<tag_deadline>,
+			mi::member<channel_entry, std::chrono::steady_clock::time_point, &channel_entry::deadline>>>>
+	entries;
+	// clang-format on
+
+	size_t pending_count{ 0 };
+	std::chrono::steady_clock::time_point next_cleanup;
+	bool stopped{ false };
+	bool started{ false };
+	nano::condition_variable condition;
+	nano::mutex mutex;
+	std::thread thread;
+
+	friend std::unique_ptr<container_info_component> collect_container_info (message_coalescer &, std::string const &);
+};
+std::unique_ptr<container_info_component> collect_container_info (message_coalescer &, std::string const &);
+}
@@ -0,0 +1,86 @@
+#include <nano/node/message_framer.hpp>
+#include <nano/secure/buffer.hpp>
+
+#include <cstring>
+
+namespace
+{
+/** Whether message_header::payload_length_bytes is defined for \p type_a */
+bool framed_type (nano::message_type type_a)
+{
+	switch (type_a)
+	{
+		case nano::message_type::keepalive:
+		case nano::message_type::publish:
+		case nano::message_type::confirm_req:
+		case nano::message_type::confirm_ack:
+		case nano::message_type::bulk_pull:
+		case nano::message_type::bulk_push:
+		case nano::message_type::frontier_req:
+		case nano::message_type::node_id_handshake:
+		case nano::message_type::bulk_pull_account:
+		case nano::message_type::telemetry_req:
+		case nano::message_type::telemetry_ack:
+			return true;
+		default:
+			return false;
+	}
+}
+}
+
+nano::message_framer::message_framer (size_t capacity_a) :
+	buffer (std::make_shared<std::vector<uint8_t>> (capacity_a))
+{
+	debug_assert (capacity_a > nano::message_header::size);
+}
+
+std::pair<size_t, size_t> nano::message_framer::prepare ()
+{
+	if (begin > 0)
+	{
+		// Only the start of a single message is left over, so this is cheap
+		std::memmove (buffer->data (), buffer->data () + begin, end - begin);
+		end -= begin;
+		begin = 0;
+	}
+	return { end, buffer->size () - end };
+}
+
+void nano::message_framer::commit (size_t size_a)
+{
+	debug_assert (end + size_a <= buffer->size ());
+	end += size_a;
+}
+
+nano::message_framer::status nano::message_framer::next (nano::message_header & header_a, uint8_t const *& payload_a)
+{
+	auto result (status::incomplete);
+	if (end - begin >= nano::message_header::size)
+	{
+		nano::bufferstream stream (buffer->data () + begin, nano::message_header::size);
+		if (!header_a.deserialize (stream) && framed_type (header_a.type))
+		{
+			auto const message_size (nano::message_header::size + header_a.payload_length_bytes ());
+			if (message_size > buffer->size ())
+			{
+				result = status::invalid;
+			}
+			else if (end - begin >= message_size)
+			{
+				payload_a = buffer->data () + begin + nano::message_header::size;
+				begin += message_size;
+				result = status::complete;
+			}
+		}
+		else
+		{
+			result = status::invalid;
+		}
+	}
+	return result;
+}
+
+size_t nano::message_framer::pending () const
+{
+	return end - begin;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <nano/node/common.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace nano
+{
+/**
+ * Frames messages out of a TCP byte stream. Socket data is read into the free space at the end of the buffer, as much as
+ * is available at once, after which every complete message the buffer holds can be extracted without further reads.
+ * The remainder of a partially received message is moved back to the start of the buffer before the next read.
+ */
+class message_framer final
+{
+public:
+	enum class status
+	{
+		complete,
+		incomplete,
+		invalid
+	};
+	explicit message_framer (size_t capacity_a = 16 * 1024);
+	/** Returns the offset and size of the free space to read into, moving unparsed bytes to the start of the buffer */
+	std::pair<size_t, size_t> prepare ();
+	/** Makes \p size_a bytes that were read into the free space available for parsing */
+	void commit (size_t size_a);
+	/**
+	 * Extracts the next complete message into \p header_a with \p payload_a pointing at its header_a.payload_length_bytes () payload bytes.
+	 * The payload stays valid until the next call to prepare ()
+	 */
+	status next (nano::message_header & header_a, uint8_t const *& payload_a);
+	/** Number of received bytes that have not been extracted yet */
+	size_t pending () const;
+
+	std::shared_ptr<std::vector<uint8_t>> const buffer;
+
+private:
+	size_t begin{ 0 };
+	size_t end{ 0 };
+};
+}
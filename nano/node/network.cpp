@@ -15,23 +15,32 @@ nano::network::network (nano::node & node_a, uint16_t port_a) :
 	id (nano::network_constants::active_network),
 	syn_cookies (node_a.network_params.node.max_peers_per_ip),
 	inbound{ [this] (nano::message const & message, std::shared_ptr<nano::transport::channel> const & channel) {
-		if (message.header.network == id)
+		if (message.header.network != id)
 		{
-			process_message (message, channel);
+			this->node.stats.inc (nano::stat::type::message, nano::stat::detail::invalid_network);
+		}
+		// TCP messages are policed by bootstrap_server before they are deserialized and queued
+		else if (channel->get_type () != nano::transport::transport_type::tcp && ingress.drop (channel->get_endpoint (), message.header.type))
+		{
+			this->node.stats.inc (nano::stat::type::drop, nano::transport::message_detail (message), nano::stat::dir::in);
 		}
 		else
 		{
-			this->node.stats.inc (nano::stat::type::message, nano::stat::detail::invalid_network);
+			process_message (message, channel);
 		}
 	} },
 	buffer_container (node_a.stats, nano::network::buffer_size, 4096), // 2Mb receive buffer
 	resolver (node_a.io_ctx),
 	limiter (node_a.config.bandwidth_limit_burst_ratio, node_a.config.bandwidth_limit),
-	tcp_message_manager (node_a.config.tcp_incoming_connections_max),
+	ingress (node_a.config.peer_message_rate, node_a.config.peer_message_rate * 5),
+	tcp_message_manager (node_a.config.tcp_incoming_connections_max, [this] (nano::tcp_endpoint const & endpoint_a) {
+		return this->node.rep_crawler.queue_weight (nano::transport::map_tcp_to_endpoint (endpoint_a));
+	}),
 	node (node_a),
 	publish_filter (256 * 1024),
 	udp_channels (node_a, port_a, inbound),
 	tcp_channels (node_a, inbound),
+	coalescer (node_a.network_params.network, node_a.stats),
 	port (port_a),
 	disconnect_observer ([] () {})
 {
@@ -142,6 +151,7 @@ void nano::network::stop ()
 		resolver.cancel ();
 		buffer_container.stop ();
 		tcp_message_manager.stop ();
+		coalescer.stop ();
 		port = 0;
 		for (auto & thread : packet_processing_threads)
 		{
@@ -182,9 +192,29 @@ void nano::network::send_node_id_handshake (std::shared_ptr<nano::transport::cha
 
 void nano::network::flood_message (nano::message const & message_a, nano::buffer_drop_policy const drop_policy_a, float const scale_a)
 {
-	for (auto & i : list (fanout (scale_a)))
-	{
-		i->send (message_a, nullptr, drop_policy_a);
+	broadcast (message_a, list (fanout (scale_a)), drop_policy_a);
+}
+
+void nano::network::broadcast (nano::message const & message_a, std::deque<std::shared_ptr<nano::transport::channel>> const & channels_a, nano::buffer_drop_policy const drop_policy_a)
+{
+	if (!channels_a.empty ())
+	{
+		auto const buffer (message_a.to_shared_const_buffer ());
+		auto const detail (nano::transport::message_detail (message_a));
+		auto const priority (nano::transport::write_priority (message_a.header.type));
+		// Every copy is charged so traffic which is never dropped still counts against the limit of the remaining traffic
+		auto const allowance (limiter.allowance (buffer.size (), channels_a.size ()));
+		// Channels are listed in random order, so skipping the ones past the allowance drops a random subset
+		auto const allowed (drop_policy_a == nano::buffer_drop_policy::limiter ? allowance : channels_a.size ());
+		for (size_t i (0); i < allowed; ++i)
+		{
+			channels_a[i]->send_buffer (buffer, nullptr, drop_policy_a, priority);
+		}
+		node.stats.add (nano::stat::type::message, detail, nano::stat::dir::out, allowed);
+		if (allowed < channels_a.size ())
+		{
+			node.stats.add (nano::stat::type::drop, detail, nano::stat::dir::out, channels_a.size () - allowed);
+		}
 	}
 }
 
@@ -197,32 +227,29 @@ void nano::network::flood_block (std::shared_ptr<nano::block> const & block_a, n
 void nano::network::flood_block_initial (std::shared_ptr<nano::block> const & block_a)
 {
 	nano::publish message (block_a);
+	auto channels (list_non_pr (fanout (1.0)));
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::buffer_drop_policy::no_limiter_drop);
-	}
-	for (auto & i : list_non_pr (fanout (1.0)))
-	{
-		i->send (message, nullptr, nano::buffer_drop_policy::no_limiter_drop);
+		channels.push_back (i.channel);
 	}
+	broadcast (message, channels, nano::buffer_drop_policy::no_limiter_drop);
 }
 
 void nano::network::flood_vote (std::shared_ptr<nano::vote> const & vote_a, float scale)
 {
 	nano::confirm_ack message (vote_a);
-	for (auto & i : list (fanout (scale)))
-	{
-		i->send (message, nullptr);
-	}
+	broadcast (message, list (fanout (scale)));
 }
 
 void nano::network::flood_vote_pr (std::shared_ptr<nano::vote> const & vote_a)
 {
 	nano::confirm_ack message (vote_a);
+	std::deque<std::shared_ptr<nano::transport::channel>> channels;
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::buffer_drop_policy::no_limiter_drop);
+		channels.push_back (i.channel);
 	}
+	broadcast (message, channels, nano::buffer_drop_policy::no_limiter_drop);
 }
 
 void nano::network::flood_block_many (std::deque<std::shared_ptr<nano::block>> blocks_a, std::function<void ()> callback_a, unsigned delay_a)
@@ -708,6 +735,26 @@ nano::tcp_endpoint nano::network::bootstrap_peer (bool lazy_bootstrap)
 	return result;
 }
 
+std::vector<nano::tcp_endpoint> nano::network::bootstrap_peers (size_t count_a, std::function<bool (nano::tcp_endpoint const &)> const & filter_a)
+{
+	auto result (tcp_channels.bootstrap_peers (node.network_params.protocol.protocol_version_min (), count_a, filter_a));
+	if (result.empty ())
+	{
+		// UDP peers are only offered one at a time, which marks them as attempted
+		auto endpoint (udp_channels.bootstrap_peer (node.network_params.protocol.protocol_version_min ()));
+		if (endpoint != nano::tcp_endpoint (boost::asio::ip::address_v6::any (), 0) && filter_a (endpoint))
+		{
+			result.push_back (endpoint);
+		}
+	}
+	return result;
+}
+
+void nano::network::bootstrap_attempted (nano::tcp_endpoint const & endpoint_a)
+{
+	tcp_channels.bootstrap_attempted (endpoint_a);
+}
+
 std::shared_ptr<nano::transport::channel> nano::network::find_channel (nano::endpoint const & endpoint_a)
 {
 	std::shared_ptr<nano::transport::channel> result (tcp_channels.find_channel (nano::transport::map_endpoint_to_tcp (endpoint_a)));
@@ -737,6 +784,7 @@ void nano::network::cleanup (std::chrono::steady_clock::time_point const & cutof
 {
 	tcp_channels.purge (cutoff_a);
 	udp_channels.purge (cutoff_a);
+	ingress.purge (cutoff_a);
 	if (node.network.empty ())
 	{
 		disconnect_observer ();
@@ -902,7 +950,8 @@ void nano::message_buffer_manager::stop ()
 	condition.notify_all ();
 }
 
-nano::tcp_message_manager::tcp_message_manager (unsigned incoming_connections_max_a) :
+nano::tcp_message_manager::tcp_message_manager (unsigned incoming_connections_max_a, std::function<size_t (nano::tcp_endpoint const &)> weight_a) :
+	entries (std::move (weight_a)),
 	max_entries (incoming_connections_max_a * nano::tcp_message_manager::max_entries_per_connection + 1)
 {
 	debug_assert (max_entries > 0);
@@ -916,11 +965,29 @@ void nano::tcp_message_manager::put_message (nano::tcp_message_item const & item
 		{
 			producer_condition.wait (lock);
 		}
-		entries.push_back (item_a);
+		entries.push (item_a.endpoint, item_a);
 	}
 	consumer_condition.notify_one ();
 }
 
+void nano::tcp_message_manager::put_messages (std::vector<nano::tcp_message_item> const & items_a)
+{
+	{
+		nano::unique_lock<nano::mutex> lock (mutex);
+		for (auto const & item : items_a)
+		{
+			while (entries.size () >= max_entries && !stopped)
+			{
+				// Wake consumers for the items already queued before waiting for room
+				consumer_condition.notify_all ();
+				producer_condition.wait (lock);
+			}
+			entries.push (item.endpoint, item);
+		}
+	}
+	consumer_condition.notify_all ();
+}
+
 nano::tcp_message_item nano::tcp_message_manager::get_message ()
 {
 	nano::tcp_message_item result;
@@ -931,8 +998,7 @@ nano::tcp_message_item nano::tcp_message_manager::get_message ()
 	}
 	if (!entries.empty ())
 	{
-		result = std::move (entries.front ());
-		entries.pop_front ();
+		result = entries.pop ();
 	}
 	else
 	{
@@ -1044,6 +1110,8 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (ne
 	composite->add_component (network.udp_channels.collect_container_info ("udp_channels"));
 	composite->add_component (network.syn_cookies.collect_container_info ("syn_cookies"));
 	composite->add_component (collect_container_info (network.excluded_peers, "excluded_peers"));
+	composite->add_component (collect_container_info (network.coalescer, "coalescer"));
+	composite->add_component (collect_container_info (network.ingress, "ingress"));
 	return composite;
 }
 
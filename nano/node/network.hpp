@@ -1,6 +1,9 @@
 #pragma once
 
 #include <nano/node/common.hpp>
+#include <nano/node/fair_queue.hpp>
+#include <nano/node/ingress_policer.hpp>
+#include <nano/node/message_coalescer.hpp>
 #include <nano/node/peer_exclusion.hpp>
 #include <nano/node/transport/tcp.hpp>
 #include <nano/node/transport/udp.hpp>
@@ -69,8 +72,11 @@ private:
 class tcp_message_manager final
 {
 public:
-	tcp_message_manager (unsigned incoming_connections_max_a);
+	/** Messages are dequeued in weighted round robin order across peers, with the weight of each peer given by \p weight_a */
+	tcp_message_manager (unsigned incoming_connections_max_a, std::function<size_t (nano::tcp_endpoint const &)> weight_a = nullptr);
 	void put_message (nano::tcp_message_item const & item_a);
+	/** Queues all \p items_a taking the lock once, waiting for consumers only while the queue is full */
+	void put_messages (std::vector<nano::tcp_message_item> const & items_a);
 	nano::tcp_message_item get_message ();
 	// Stop container and notify waiting threads
 	void stop ();
@@ -79,7 +85,7 @@ private:
 	nano::mutex mutex;
 	nano::condition_variable producer_condition;
 	nano::condition_variable consumer_condition;
-	std::deque<nano::tcp_message_item> entries;
+	nano::fair_queue<nano::tcp_endpoint, nano::tcp_message_item> entries;
 	unsigned max_entries;
 	static unsigned const max_entries_per_connection = 16;
 	bool stopped{ false };
@@ -124,6 +130,11 @@ public:
 	void start ();
 	void stop ();
 	void flood_message (nano::message const &, nano::buffer_drop_policy const = nano::buffer_drop_policy::limiter, float const = 1.0f);
+	/**
+	 * Serializes \p message_a once and sends the same buffer to each of \p channels_a. The bandwidth limiter is charged once
+	 * for the whole broadcast, with the limiter drop policy the channels past its allowance are skipped.
+	 */
+	void broadcast (nano::message const &, std::deque<std::shared_ptr<nano::transport::channel>> const &, nano::buffer_drop_policy const = nano::buffer_drop_policy::limiter);
 	void flood_keepalive (float const scale_a = 1.0f)
 	{
 		nano::keepalive message;
@@ -168,6 +179,9 @@ public:
 	std::unordered_set<std::shared_ptr<nano::transport::channel>> random_set (size_t, uint8_t = 0, bool = false) const;
 	// Get the next peer for attempting a tcp bootstrap connection
 	nano::tcp_endpoint bootstrap_peer (bool = false);
+	// Up to count_a bootstrap peers accepted by filter, only the one passed to bootstrap_attempted is marked as attempted
+	std::vector<nano::tcp_endpoint> bootstrap_peers (size_t count_a, std::function<bool (nano::tcp_endpoint const &)> const & filter_a);
+	void bootstrap_attempted (nano::tcp_endpoint const &);
 	nano::endpoint endpoint ();
 	void cleanup (std::chrono::steady_clock::time_point const &);
 	void ongoing_cleanup ();
@@ -190,12 +204,14 @@ public:
 	boost::asio::ip::udp::resolver resolver;
 	std::vector<boost::thread> packet_processing_threads;
 	nano::bandwidth_limiter limiter;
+	nano::ingress_policer ingress;
 	nano::peer_exclusion excluded_peers;
 	nano::tcp_message_manager tcp_message_manager;
 	nano::node & node;
 	nano::network_filter publish_filter;
 	nano::transport::udp_channels udp_channels;
 	nano::transport::tcp_channels tcp_channels;
+	nano::message_coalescer coalescer;
 	std::atomic<uint16_t> port{ 0 };
 	std::function<void ()> disconnect_observer;
 	// Called when a new channel is observed
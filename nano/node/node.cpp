@@ -101,6 +101,8 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 	wallets_store (*wallets_store_impl),
 	gap_cache (*this),
 	ledger (store, stats, flags_a.generate_cache),
+	// Pooled snapshots must be renewed before the transaction tracker would report them as held too long
+	read_transactions (store, stats, config.diagnostics_config.txn_tracking.enable ? std::min (config.read_transaction_max_age, config.diagnostics_config.txn_tracking.min_read_txn_time / 2) : config.read_transaction_max_age),
 	checker (config.signature_checker_threads),
 	network (*this, config.peering_port),
 	telemetry (std::make_shared<nano::telemetry> (network, workers, observers.telemetry, stats, network_params, flags.disable_ongoing_telemetry_requests)),
@@ -118,8 +120,9 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 	confirmation_height_processor (ledger, write_database_queue, config.conf_height_processor_batch_min_time, config.logging, logger, node_initialized_latch, flags.confirmation_height_processor_mode),
 	active (*this, confirmation_height_processor),
 	scheduler{ *this },
-	aggregator (network_params.network, config, stats, active.generator, active.final_generator, history, ledger, wallets, active),
+	aggregator (network_params.network, config, stats, active.generator, active.final_generator, history, ledger, read_transactions, wallets, active),
 	wallets (wallets_store.init_error (), *this),
+	rpc_cache (config.rpc_cache_config, stats),
 	startup_time (std::chrono::steady_clock::now ()),
 	node_seq (seq)
 {
@@ -310,6 +313,15 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 				}
 			});
 		}
+		if (config.rpc_cache_config.enable)
+		{
+			auto invalidate_rpc_cache ([this] (std::shared_ptr<nano::block> const & block_a) {
+				this->rpc_cache.invalidate (*block_a);
+			});
+			observers.block_processed.add (invalidate_rpc_cache);
+			observers.block_rolled_back.add (invalidate_rpc_cache);
+			confirmation_height_processor.add_cemented_observer (invalidate_rpc_cache);
+		}
 		// Cancelling local work generation
 		observers.work_cancel.add ([this] (nano::root const & root_a) {
 			this->work.cancel (root_a);
@@ -319,6 +331,7 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 		logger.always_log ("Node starting, version: ", NANO_VERSION_STRING);
 		logger.always_log ("Build information: ", BUILD_INFO);
 		logger.always_log ("Database backend: ", store.vendor_get ());
+		logger.always_log ("Network I/O backend: ", nano::io_backend ());
 
 		auto network_label = network_params.network.get_current_network_as_string ();
 		logger.always_log ("Active network: ", network_label);
@@ -430,6 +443,19 @@ nano::node::node (boost::asio::io_context & io_ctx_a, boost::filesystem::path co
 				std::exit (1);
 			}
 		}
+
+		if (flags.enable_account_height_index)
+		{
+			ledger.account_heights = true;
+			ledger.account_heights_complete = store.account_height.cursor (store.tx_begin_read ()) == nano::ledger::account_heights_complete_cursor;
+		}
+		else if (!flags.read_only && !flags.inactive_node && store.account_height.cursor (store.tx_begin_read ()) != nano::uint512_union (0))
+		{
+			// Blocks processed from now on would be missing from the index, it is built again over the existing entries if enabled later
+			auto transaction (store.tx_begin_write ({ tables::meta }));
+			store.account_height.cursor_put (transaction, nano::uint512_union (0));
+			logger.always_log ("Marking account height index as incomplete");
+		}
 	}
 	node_initialized_latch.count_down ();
 }
@@ -526,6 +552,8 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.work, "work"));
 	composite->add_component (collect_container_info (node.gap_cache, "gap_cache"));
 	composite->add_component (collect_container_info (node.ledger, "ledger"));
+	composite->add_component (collect_container_info (node.read_transactions, "read_transactions"));
+	composite->add_component (collect_container_info (node.rpc_cache, "rpc_cache"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (collect_container_info (node.bootstrap_initiator, "bootstrap_initiator"));
 	composite->add_component (collect_container_info (node.bootstrap, "bootstrap"));
@@ -548,6 +576,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.confirmation_height_processor, "confirmation_height_processor"));
 	composite->add_component (collect_container_info (node.distributed_work, "distributed_work"));
 	composite->add_component (collect_container_info (node.aggregator, "request_aggregator"));
+	composite->add_component (collect_object_pool_info ("object_pools"));
 	return composite;
 }
 
@@ -559,7 +588,7 @@ void nano::node::process_active (std::shared_ptr<nano::block> const & incoming)
 
 nano::process_return nano::node::process (nano::block & block_a)
 {
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto transaction (store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
 	auto result (ledger.process (transaction, block_a));
 	return result;
 }
@@ -574,7 +603,7 @@ nano::process_return nano::node::process_local (std::shared_ptr<nano::block> con
 	block_processor.wait_write ();
 	// Process block
 	block_post_events post_events ([&store = store] { return store.tx_begin_read (); });
-	auto transaction (store.tx_begin_write ({ tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
+	auto transaction (store.tx_begin_write ({ tables::account_heights, tables::accounts, tables::blocks, tables::frontiers, tables::pending }));
 	return block_processor.process_one (transaction, post_events, info, false, nano::block_origin::local);
 }
 
@@ -610,12 +639,21 @@ void nano::node::start ()
 			this_l->ongoing_ledger_pruning ();
 		});
 	}
+	if (flags.enable_account_height_index && !ledger.account_heights_complete && !flags.read_only)
+	{
+		logger.always_log ("Building account height index");
+		auto this_l (shared ());
+		workers.push_task ([this_l] () {
+			this_l->ongoing_account_heights_build ();
+		});
+	}
 	if (!flags.disable_rep_crawler)
 	{
 		rep_crawler.start ();
 	}
 	ongoing_rep_calculation ();
 	ongoing_peer_store ();
+	ongoing_read_transactions_cleanup ();
 	ongoing_online_weight_calculation_queue ();
 	bool tcp_enabled (false);
 	if (config.tcp_incoming_connections_max > 0 && !(flags.disable_bootstrap_listener && flags.disable_tcp_realtime))
@@ -856,6 +894,20 @@ void nano::node::ongoing_peer_store ()
 	});
 }
 
+void nano::node::ongoing_read_transactions_cleanup ()
+{
+	read_transactions.cleanup ();
+	// Idle snapshots are reset about once per max_age, with a 0 max_age nothing is held between borrows and only idle transactions need destroying
+	auto next_wakeup (read_transactions.max_age.count () > 0 ? std::max (read_transactions.max_age, std::chrono::milliseconds (100)) : std::chrono::duration_cast<std::chrono::milliseconds> (nano::read_transaction_pool::idle_cutoff));
+	std::weak_ptr<nano::node> node_w (shared_from_this ());
+	workers.add_timed_task (std::chrono::steady_clock::now () + next_wakeup, [node_w] () {
+		if (auto node_l = node_w.lock ())
+		{
+			node_l->ongoing_read_transactions_cleanup ();
+		}
+	});
+}
+
 void nano::node::backup_wallet ()
 {
 	auto transaction (wallets.tx_begin_read ());
@@ -1046,7 +1098,7 @@ void nano::node::ledger_pruning (uint64_t const batch_size_a, bool bootstrap_wei
 		if (!pruning_targets.empty () && !stopped)
 		{
 			auto scoped_write_guard = write_database_queue.wait (nano::writer::pruning);
-			auto write_transaction (store.tx_begin_write ({ tables::blocks, tables::pruned }));
+			auto write_transaction (store.tx_begin_write ({ tables::account_heights, tables::blocks, tables::pruned }));
 			while (!pruning_targets.empty () && transaction_write_count < batch_size_a && !stopped)
 			{
 				auto const & pruning_hash (pruning_targets.front ());
@@ -1090,6 +1142,27 @@ void nano::node::ongoing_ledger_pruning ()
 	});
 }
 
+void nano::node::ongoing_account_heights_build ()
+{
+	auto complete (false);
+	{
+		auto scoped_write_guard = write_database_queue.wait (nano::writer::account_heights);
+		auto transaction (store.tx_begin_write ({ tables::account_heights, tables::meta }));
+		complete = ledger.account_heights_build (transaction, flags.block_processor_batch_size != 0 ? flags.block_processor_batch_size : 16 * 1024);
+	}
+	if (complete)
+	{
+		logger.always_log ("Account height index built");
+	}
+	else if (!stopped)
+	{
+		auto this_l (shared ());
+		workers.push_task ([this_l] () {
+			this_l->ongoing_account_heights_build ();
+		});
+	}
+}
+
 int nano::node::price (nano::uint128_t const & balance_a, int amount_a)
 {
 	debug_assert (balance_a >= amount_a * nano::Gxrb_ratio);
@@ -18,8 +18,10 @@
 #include <nano/node/nodeconfig.hpp>
 #include <nano/node/online_reps.hpp>
 #include <nano/node/portmapping.hpp>
+#include <nano/node/read_transaction_pool.hpp>
 #include <nano/node/repcrawler.hpp>
 #include <nano/node/request_aggregator.hpp>
+#include <nano/node/rpc_cache.hpp>
 #include <nano/node/signatures.hpp>
 #include <nano/node/telemetry.hpp>
 #include <nano/node/vote_processor.hpp>
@@ -119,6 +121,7 @@ public:
 	void ongoing_bootstrap ();
 	void ongoing_peer_store ();
 	void ongoing_unchecked_cleanup ();
+	void ongoing_read_transactions_cleanup ();
 	void ongoing_backlog_population ();
 	void backup_wallet ();
 	void search_pending ();
@@ -127,6 +130,7 @@ public:
 	bool collect_ledger_pruning_targets (std::deque<nano::block_hash> &, nano::account &, uint64_t const, uint64_t const, uint64_t const);
 	void ledger_pruning (uint64_t const, bool, bool);
 	void ongoing_ledger_pruning ();
+	void ongoing_account_heights_build ();
 	int price (nano::uint128_t const &, int);
 	// The default difficulty updates to base only when the first epoch_2 block is processed
 	uint64_t default_difficulty (nano::work_version const) const;
@@ -169,6 +173,7 @@ public:
 	nano::wallets_store & wallets_store;
 	nano::gap_cache gap_cache;
 	nano::ledger ledger;
+	nano::read_transaction_pool read_transactions;
 	nano::signature_checker checker;
 	nano::network network;
 	std::shared_ptr<nano::telemetry> telemetry;
@@ -192,6 +197,7 @@ public:
 	nano::election_scheduler scheduler;
 	nano::request_aggregator aggregator;
 	nano::wallets wallets;
+	nano::rpc_cache rpc_cache;
 	const std::chrono::steady_clock::time_point startup_time;
 	std::chrono::seconds unchecked_cutoff = std::chrono::seconds (7 * 24 * 60 * 60); // Week
 	std::atomic<bool> unresponsive_work_peers{ false };
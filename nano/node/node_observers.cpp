@@ -8,6 +8,8 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (na
 	composite->add_component (collect_container_info (node_observers.vote, "vote"));
 	composite->add_component (collect_container_info (node_observers.active_stopped, "active_stopped"));
 	composite->add_component (collect_container_info (node_observers.account_balance, "account_balance"));
+	composite->add_component (collect_container_info (node_observers.block_processed, "block_processed"));
+	composite->add_component (collect_container_info (node_observers.block_rolled_back, "block_rolled_back"));
 	composite->add_component (collect_container_info (node_observers.endpoint, "endpoint"));
 	composite->add_component (collect_container_info (node_observers.disconnect, "disconnect"));
 	composite->add_component (collect_container_info (node_observers.work_cancel, "work_cancel"));
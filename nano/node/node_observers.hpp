@@ -17,6 +17,10 @@ public:
 	nano::observer_set<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>, nano::vote_code> vote;
 	nano::observer_set<nano::block_hash const &> active_stopped;
 	nano::observer_set<nano::account const &, bool> account_balance;
+	/** Blocks added to the ledger, notified after the write transaction is committed */
+	nano::observer_set<std::shared_ptr<nano::block> const &> block_processed;
+	/** Blocks rolled back from the ledger, notified after the write transaction is committed */
+	nano::observer_set<std::shared_ptr<nano::block> const &> block_rolled_back;
 	nano::observer_set<std::shared_ptr<nano::transport::channel>> endpoint;
 	nano::observer_set<> disconnect;
 	nano::observer_set<nano::root const &> work_cancel;
@@ -93,13 +93,17 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("vote_minimum", vote_minimum.to_string_dec (), "Local representatives do not vote if the delegated weight is under this threshold. Saves on system resources.\ntype:string,amount,raw");
 	toml.put ("vote_generator_delay", vote_generator_delay.count (), "Delay before votes are sent to allow for efficient bundling of hashes in votes.\ntype:milliseconds");
 	toml.put ("vote_generator_threshold", vote_generator_threshold, "Number of bundled hashes required for an additional generator delay.\ntype:uint64,[1..11]");
+	toml.put ("vote_signing_threads", vote_signing_threads, "Number of additional threads signing votes in parallel when generating many votes at once. 0 signs on the vote generator thread only. Defaults to number of CPU threads / 4, at most 4.\ntype:uint64");
 	toml.put ("unchecked_cutoff_time", unchecked_cutoff_time.count (), "Number of seconds before deleting an unchecked entry.\nWarning: lower values (e.g., 3600 seconds, or 1 hour) may result in unsuccessful bootstraps, especially a bootstrap from scratch.\ntype:seconds");
 	toml.put ("tcp_io_timeout", tcp_io_timeout.count (), "Timeout for TCP connect-, read- and write operations.\nWarning: a low value (e.g., below 5 seconds) may result in TCP connections failing.\ntype:seconds");
 	toml.put ("pow_sleep_interval", pow_sleep_interval.count (), "Time to sleep between batch work generation attempts. Reduces max CPU usage at the expense of a longer generation time.\ntype:nanoseconds");
 	toml.put ("external_address", external_address, "The external address of this node (NAT). If not set, the node will request this information via UPnP.\ntype:string,ip");
 	toml.put ("external_port", external_port, "The external port number of this node (NAT). Only used if external_address is set.\ntype:uint16");
 	toml.put ("tcp_incoming_connections_max", tcp_incoming_connections_max, "Maximum number of incoming TCP connections.\ntype:uint64");
+	toml.put ("peer_message_rate", peer_message_rate, "Maximum number of messages of each type accepted from a single peer per second. Bursts of up to five seconds worth of messages are allowed, messages above the limit are dropped. 0 disables the limit.\ntype:uint64");
 	toml.put ("use_memory_pools", use_memory_pools, "If true, allocate memory from memory pools. Enabling this may improve performance. Memory is never released to the OS.\ntype:bool");
+	toml.put ("udp_batched_io", udp_batched_io, "If true, UDP datagrams are received by a dedicated thread and sent in batches of many datagrams per system call. Only supported on Linux, other platforms ignore this setting.\ntype:bool");
+	toml.put ("read_transaction_max_age", read_transaction_max_age.count (), "Maximum age of the ledger snapshot seen by RPC and bootstrap read requests served from the per-thread read transaction pool. Higher values avoid reopening transactions at the cost of responses being up to this stale. 0 always uses a fresh snapshot.\nWhen diagnostics.txn_tracking is enabled, this is capped at half of min_read_txn_time.\ntype:milliseconds");
 	toml.put ("confirmation_history_size", confirmation_history_size, "Maximum confirmation history size. If tracking the rate of block confirmations, the websocket feature is recommended instead.\ntype:uint64");
 	toml.put ("active_elections_size", active_elections_size, "Number of active elections. Elections beyond this limit have limited survival time.\nWarning: modifying this value may result in a lower confirmation rate.\ntype:uint64,[250..]");
 	toml.put ("bandwidth_limit", bandwidth_limit, "Outbound traffic limit in bytes/sec after which messages will be dropped.\nNote: changing to unlimited bandwidth (0) is not recommended for limited connections.\ntype:uint64");
@@ -174,6 +178,10 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	lmdb_config.serialize_toml (lmdb_l);
 	toml.put_child ("lmdb", lmdb_l);
 
+	nano::tomlconfig rpc_cache_l;
+	rpc_cache_config.serialize_toml (rpc_cache_l);
+	toml.put_child ("rpc_cache", rpc_cache_l);
+
 	return toml.get_error ();
 }
 
@@ -225,6 +233,12 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 			rocksdb_config.deserialize_toml (rocksdb_config_l);
 		}
 
+		if (toml.has_key ("rpc_cache"))
+		{
+			auto rpc_cache_config_l (toml.get_required_child ("rpc_cache"));
+			rpc_cache_config.deserialize_toml (rpc_cache_config_l);
+		}
+
 		if (toml.has_key ("work_peers"))
 		{
 			work_peers.clear ();
@@ -295,6 +309,8 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 
 		toml.get<unsigned> ("vote_generator_threshold", vote_generator_threshold);
 
+		toml.get<unsigned> ("vote_signing_threads", vote_signing_threads);
+
 		auto block_processor_batch_max_time_l = block_processor_batch_max_time.count ();
 		toml.get ("block_processor_batch_max_time", block_processor_batch_max_time_l);
 		block_processor_batch_max_time = std::chrono::milliseconds (block_processor_batch_max_time_l);
@@ -333,11 +349,17 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		external_address = external_address_l.to_string ();
 		toml.get<uint16_t> ("external_port", external_port);
 		toml.get<unsigned> ("tcp_incoming_connections_max", tcp_incoming_connections_max);
+		toml.get<size_t> ("peer_message_rate", peer_message_rate);
 
 		auto pow_sleep_interval_l (pow_sleep_interval.count ());
 		toml.get (pow_sleep_interval_key, pow_sleep_interval_l);
 		pow_sleep_interval = std::chrono::nanoseconds (pow_sleep_interval_l);
 		toml.get<bool> ("use_memory_pools", use_memory_pools);
+		toml.get<bool> ("udp_batched_io", udp_batched_io);
+
+		auto read_transaction_max_age_l (read_transaction_max_age.count ());
+		toml.get ("read_transaction_max_age", read_transaction_max_age_l);
+		read_transaction_max_age = std::chrono::milliseconds (read_transaction_max_age_l);
 		toml.get<size_t> ("confirmation_history_size", confirmation_history_size);
 		toml.get<size_t> ("active_elections_size", active_elections_size);
 		toml.get<size_t> ("bandwidth_limit", bandwidth_limit);
@@ -10,6 +10,7 @@
 #include <nano/lib/stats.hpp>
 #include <nano/node/ipc/ipc_config.hpp>
 #include <nano/node/logging.hpp>
+#include <nano/node/rpc_cache.hpp>
 #include <nano/node/websocketconfig.hpp>
 #include <nano/secure/common.hpp>
 
@@ -54,6 +55,8 @@ public:
 	nano::amount vote_minimum{ nano::Gxrb_ratio };
 	std::chrono::milliseconds vote_generator_delay{ std::chrono::milliseconds (100) };
 	unsigned vote_generator_threshold{ 3 };
+	/* Extra threads signing votes in parallel when many are generated at once, started the first time they are needed. The vote generator thread signs as well */
+	unsigned vote_signing_threads{ std::min<unsigned> (4, std::thread::hardware_concurrency () / 4) };
 	nano::amount online_weight_minimum{ 60000 * nano::Gxrb_ratio };
 	unsigned election_hint_weight_percent{ 10 };
 	unsigned password_fanout{ 1024 };
@@ -86,7 +89,13 @@ public:
 	size_t active_elections_size{ 5000 };
 	/** Default maximum incoming TCP connections, including realtime network & bootstrap */
 	unsigned tcp_incoming_connections_max{ 2048 };
+	/** Messages of each type accepted from a single peer per second, bursts of five seconds worth are allowed. 0 disables the limit */
+	size_t peer_message_rate{ 1000 };
 	bool use_memory_pools{ true };
+	/** Receive and send UDP datagrams in batches with recvmmsg/sendmmsg where available */
+	bool udp_batched_io{ false };
+	/** Maximum age of snapshots handed out by the read transaction pool. 0 always refreshes the snapshot when borrowed */
+	std::chrono::milliseconds read_transaction_max_age{ 0 };
 	static std::chrono::seconds constexpr keepalive_period = std::chrono::seconds (60);
 	static std::chrono::seconds constexpr keepalive_cutoff = keepalive_period * 5;
 	static std::chrono::minutes constexpr wallet_backup_interval = std::chrono::minutes (5);
@@ -104,6 +113,7 @@ public:
 	uint64_t max_pruning_depth{ 0 };
 	nano::rocksdb_config rocksdb_config;
 	nano::lmdb_config lmdb_config;
+	nano::rpc_cache_config rpc_cache_config;
 	nano::frontiers_confirmation_mode frontiers_confirmation{ nano::frontiers_confirmation_mode::automatic };
 	std::string serialize_frontiers_confirmation (nano::frontiers_confirmation_mode) const;
 	nano::frontiers_confirmation_mode deserialize_frontiers_confirmation (std::string const &);
@@ -145,6 +155,7 @@ public:
 	bool force_use_write_database_queue{ false }; // For testing only. RocksDB does not use the database queue, but some tests rely on it being used.
 	bool disable_search_pending{ false }; // For testing only
 	bool enable_pruning{ false };
+	bool enable_account_height_index{ false };
 	bool fast_bootstrap{ false };
 	bool read_only{ false };
 	bool disable_connection_cleanup{ false };
@@ -0,0 +1,148 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/read_transaction_pool.hpp>
+
+std::chrono::seconds constexpr nano::read_transaction_pool::idle_cutoff;
+
+nano::pooled_read_transaction::pooled_read_transaction (nano::read_transaction_pool & pool_a, nano::read_transaction const & transaction_a) :
+	pool (pool_a),
+	transaction (transaction_a)
+{
+}
+
+nano::pooled_read_transaction::~pooled_read_transaction ()
+{
+	pool.release ();
+}
+
+nano::pooled_read_transaction::operator nano::read_transaction const & () const
+{
+	return transaction;
+}
+
+nano::read_transaction const & nano::pooled_read_transaction::get () const
+{
+	return transaction;
+}
+
+nano::read_transaction_pool::read_transaction_pool (nano::store & store_a, nano::stat & stats_a, std::chrono::milliseconds max_age_a) :
+	max_age (max_age_a),
+	store (store_a),
+	stats (stats_a)
+{
+}
+
+nano::pooled_read_transaction nano::read_transaction_pool::borrow (bool fresh_a)
+{
+	auto now (std::chrono::steady_clock::now ());
+	entry * entry_l (nullptr);
+	bool first (false);
+	{
+		nano::lock_guard<nano::mutex> guard (mutex);
+		auto & existing (entries[std::this_thread::get_id ()]);
+		if (existing == nullptr)
+		{
+			existing = std::make_unique<entry> ();
+		}
+		entry_l = existing.get ();
+		first = entry_l->borrowed++ == 0;
+	}
+	// While borrowed the entry is only accessed by this thread, cleanup skips it
+	if (!first)
+	{
+		stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_reuse);
+	}
+	else if (entry_l->transaction == nullptr)
+	{
+		entry_l->transaction = std::make_unique<nano::read_transaction> (store.tx_begin_read ());
+		entry_l->renewed = now;
+		entry_l->active = true;
+		stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_open);
+	}
+	else if (!entry_l->active)
+	{
+		entry_l->transaction->renew ();
+		entry_l->renewed = now;
+		entry_l->active = true;
+		stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_renew);
+	}
+	else if (fresh_a || now - entry_l->renewed >= max_age)
+	{
+		record_age (*entry_l, now);
+		entry_l->transaction->refresh ();
+		entry_l->renewed = now;
+		stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_refresh);
+	}
+	else
+	{
+		stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_reuse);
+	}
+	return nano::pooled_read_transaction (*this, *entry_l->transaction);
+}
+
+void nano::read_transaction_pool::release ()
+{
+	auto now (std::chrono::steady_clock::now ());
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto existing (entries.find (std::this_thread::get_id ()));
+	debug_assert (existing != entries.end ());
+	auto & entry_l (*existing->second);
+	debug_assert (entry_l.borrowed > 0);
+	entry_l.last_used = now;
+	// Do not keep a snapshot around which would need refreshing on the next borrow anyway
+	if (--entry_l.borrowed == 0 && now - entry_l.renewed >= max_age)
+	{
+		reset (entry_l, now);
+	}
+}
+
+void nano::read_transaction_pool::cleanup ()
+{
+	auto now (std::chrono::steady_clock::now ());
+	nano::lock_guard<nano::mutex> guard (mutex);
+	for (auto i (entries.begin ()); i != entries.end ();)
+	{
+		auto & entry_l (*i->second);
+		if (entry_l.borrowed == 0 && now - entry_l.last_used >= idle_cutoff)
+		{
+			stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_evict);
+			i = entries.erase (i);
+		}
+		else
+		{
+			if (entry_l.borrowed == 0 && entry_l.active && now - entry_l.renewed >= max_age)
+			{
+				reset (entry_l, now);
+			}
+			++i;
+		}
+	}
+}
+
+size_t nano::read_transaction_pool::size ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return entries.size ();
+}
+
+void nano::read_transaction_pool::reset (entry & entry_a, std::chrono::steady_clock::time_point const & now_a)
+{
+	debug_assert (entry_a.active);
+	record_age (entry_a, now_a);
+	entry_a.transaction->reset ();
+	entry_a.active = false;
+	stats.inc (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_reset);
+}
+
+void nano::read_transaction_pool::record_age (entry const & entry_a, std::chrono::steady_clock::time_point const & now_a)
+{
+	// Total milliseconds snapshots were held, divided by txn_refresh + txn_reset this gives the average age
+	stats.add (nano::stat::type::read_transaction_pool, nano::stat::detail::txn_age_ms, nano::stat::dir::in, std::chrono::duration_cast<std::chrono::milliseconds> (now_a - entry_a.renewed).count ());
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (nano::read_transaction_pool & pool, std::string const & name)
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "transactions", pool.size (), sizeof (nano::read_transaction) }));
+	return composite;
+}
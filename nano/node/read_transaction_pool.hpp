@@ -0,0 +1,75 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/secure/store.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+namespace nano
+{
+class container_info_component;
+class read_transaction_pool;
+class stat;
+
+/**
+ * Read transaction borrowed from a read_transaction_pool, it is returned to the pool when this goes out of scope.
+ * Converts to nano::read_transaction so it can be passed wherever a transaction is expected.
+ */
+class pooled_read_transaction final
+{
+public:
+	pooled_read_transaction (nano::read_transaction_pool &, nano::read_transaction const &);
+	pooled_read_transaction (nano::pooled_read_transaction const &) = delete;
+	~pooled_read_transaction ();
+	operator nano::read_transaction const & () const;
+	nano::read_transaction const & get () const;
+
+private:
+	nano::read_transaction_pool & pool;
+	nano::read_transaction const & transaction;
+};
+
+/**
+ * Keeps a read transaction per thread so handlers do not begin and end a transaction for every request.
+ * A borrowed transaction sees a snapshot which is at most max_age old, older snapshots are refreshed with reset/renew when borrowed.
+ * Borrowing again on a thread which already holds a borrowed transaction returns the same transaction without refreshing it.
+ * Only read only code which tolerates data up to max_age stale should borrow from the pool, a max_age of 0 always gives a fresh snapshot.
+ */
+class read_transaction_pool final
+{
+public:
+	read_transaction_pool (nano::store &, nano::stat &, std::chrono::milliseconds max_age);
+	/** fresh_a gives a new snapshot regardless of max_age, unless this thread already holds a borrowed transaction */
+	nano::pooled_read_transaction borrow (bool fresh_a = false);
+	/** Resets snapshots left idle past max_age and destroys transactions of threads which have not borrowed for idle_cutoff */
+	void cleanup ();
+	size_t size ();
+	std::chrono::milliseconds const max_age;
+	static std::chrono::seconds constexpr idle_cutoff = std::chrono::seconds (60);
+
+private:
+	class entry final
+	{
+	public:
+		std::unique_ptr<nano::read_transaction> transaction;
+		std::chrono::steady_clock::time_point renewed;
+		std::chrono::steady_clock::time_point last_used;
+		unsigned borrowed{ 0 };
+		bool active{ false };
+	};
+	void release ();
+	void reset (entry &, std::chrono::steady_clock::time_point const &);
+	void record_age (entry const &, std::chrono::steady_clock::time_point const &);
+	nano::store & store;
+	nano::stat & stats;
+	nano::mutex mutex;
+	std::unordered_map<std::thread::id, std::unique_ptr<entry>> entries;
+
+	friend class nano::pooled_read_transaction;
+};
+
+std::unique_ptr<nano::container_info_component> collect_container_info (nano::read_transaction_pool &, std::string const &);
+}
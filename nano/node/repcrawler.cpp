@@ -66,6 +66,10 @@ void nano::rep_crawler::validate ()
 					probable_reps.emplace (nano::representative (vote->account, rep_weight, channel));
 					updated_or_inserted = true;
 				}
+				if (updated_or_inserted)
+				{
+					update_snapshot ();
+				}
 				lock.unlock ();
 				if (updated_or_inserted)
 				{
@@ -216,21 +220,7 @@ bool nano::rep_crawler::response (std::shared_ptr<nano::transport::channel> cons
 
 nano::uint128_t nano::rep_crawler::total_weight () const
 {
-	nano::lock_guard<nano::mutex> lock (probable_reps_mutex);
-	nano::uint128_t result (0);
-	for (auto i (probable_reps.get<tag_weight> ().begin ()), n (probable_reps.get<tag_weight> ().end ()); i != n; ++i)
-	{
-		auto weight (i->weight.number ());
-		if (weight > 0)
-		{
-			result = result + weight;
-		}
-		else
-		{
-			break;
-		}
-	}
-	return result;
+	return snapshot ()->total_weight;
 }
 
 void nano::rep_crawler::on_rep_request (std::shared_ptr<nano::transport::channel> const & channel_a)
@@ -257,6 +247,7 @@ void nano::rep_crawler::cleanup_reps ()
 	{
 		// Check known rep channels
 		nano::lock_guard<nano::mutex> lock (probable_reps_mutex);
+		auto erased (false);
 		auto iterator (probable_reps.get<tag_last_request> ().begin ());
 		while (iterator != probable_reps.get<tag_last_request> ().end ())
 		{
@@ -269,8 +260,13 @@ void nano::rep_crawler::cleanup_reps ()
 			{
 				// Remove reps with closed channels
 				iterator = probable_reps.get<tag_last_request> ().erase (iterator);
+				erased = true;
 			}
 		}
+		if (erased)
+		{
+			update_snapshot ();
+		}
 	}
 	// Remove reps with inactive channels
 	for (auto const & i : channels)
@@ -295,7 +291,10 @@ void nano::rep_crawler::cleanup_reps ()
 		if (!equal)
 		{
 			nano::lock_guard<nano::mutex> lock (probable_reps_mutex);
-			probable_reps.get<tag_channel_ref> ().erase (*i);
+			if (probable_reps.get<tag_channel_ref> ().erase (*i) > 0)
+			{
+				update_snapshot ();
+			}
 		}
 	}
 }
@@ -303,6 +302,7 @@ void nano::rep_crawler::cleanup_reps ()
 void nano::rep_crawler::update_weights ()
 {
 	nano::lock_guard<nano::mutex> lock (probable_reps_mutex);
+	auto changed (false);
 	for (auto i (probable_reps.get<tag_last_request> ().begin ()), n (probable_reps.get<tag_last_request> ().end ()); i != n;)
 	{
 		auto weight (node.ledger.weight (i->account));
@@ -313,6 +313,7 @@ void nano::rep_crawler::update_weights ()
 				probable_reps.get<tag_last_request> ().modify (i, [weight] (nano::representative & info) {
 					info.weight = weight;
 				});
+				changed = true;
 			}
 			++i;
 		}
@@ -320,18 +321,62 @@ void nano::rep_crawler::update_weights ()
 		{
 			// Erase non representatives
 			i = probable_reps.get<tag_last_request> ().erase (i);
+			changed = true;
 		}
 	}
+	if (changed)
+	{
+		update_snapshot ();
+	}
+}
+
+void nano::rep_crawler::update_snapshot ()
+{
+	auto current (std::atomic_load (&snapshot_m));
+	auto snapshot_l (std::make_shared<nano::representatives_snapshot> ());
+	snapshot_l->epoch = current->epoch + 1;
+	snapshot_l->representatives.reserve (probable_reps.size ());
+	std::unordered_map<nano::endpoint, nano::uint128_t> endpoint_weights;
+	for (auto const & rep : probable_reps.get<tag_weight> ())
+	{
+		snapshot_l->representatives.push_back (rep);
+		snapshot_l->total_weight += rep.weight.number ();
+		endpoint_weights[nano::transport::map_endpoint_to_v6 (rep.channel->get_endpoint ())] += rep.weight.number ();
+	}
+	auto const total (snapshot_l->total_weight);
+	for (auto const & [endpoint, weight] : endpoint_weights)
+	{
+		// Peers whose representatives have no weight keep the default weight of 1
+		if (weight > 0)
+		{
+			size_t const queue_weight (weight >= total / 20 ? 8 : weight >= total / 100 ? 4 : weight >= total / 1000 ? 2 : 1);
+			snapshot_l->queue_weights.emplace (endpoint, queue_weight);
+		}
+	}
+	std::atomic_store (&snapshot_m, std::shared_ptr<nano::representatives_snapshot const> (std::move (snapshot_l)));
+}
+
+std::shared_ptr<nano::representatives_snapshot const> nano::rep_crawler::snapshot () const
+{
+	return std::atomic_load (&snapshot_m);
+}
+
+size_t nano::rep_crawler::queue_weight (nano::endpoint const & endpoint_a) const
+{
+	auto snapshot_l (snapshot ());
+	auto existing (snapshot_l->queue_weights.find (nano::transport::map_endpoint_to_v6 (endpoint_a)));
+	return existing != snapshot_l->queue_weights.end () ? existing->second : 1;
 }
 
 std::vector<nano::representative> nano::rep_crawler::representatives (size_t count_a, nano::uint128_t const weight_a, boost::optional<decltype (nano::protocol_constants::protocol_version)> const & opt_version_min_a)
 {
 	auto version_min (opt_version_min_a.value_or (node.network_params.protocol.protocol_version_min ()));
 	std::vector<representative> result;
-	nano::lock_guard<nano::mutex> lock (probable_reps_mutex);
-	for (auto i (probable_reps.get<tag_weight> ().begin ()), n (probable_reps.get<tag_weight> ().end ()); i != n && result.size () < count_a; ++i)
+	auto snapshot_l (snapshot ());
+	// Sorted by descending weight, so stop at the first representative below the requested weight
+	for (auto i (snapshot_l->representatives.begin ()), n (snapshot_l->representatives.end ()); i != n && result.size () < count_a && i->weight > weight_a; ++i)
 	{
-		if (i->weight > weight_a && i->channel->get_network_version () >= version_min)
+		if (i->channel->get_network_version () >= version_min)
 		{
 			result.push_back (*i);
 		}
@@ -13,6 +13,7 @@
 
 #include <chrono>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mi = boost::multi_index;
@@ -48,6 +49,21 @@ public:
 	std::chrono::steady_clock::time_point last_response{ std::chrono::steady_clock::time_point () };
 };
 
+/**
+ * Immutable list of probable representatives sorted by descending weight. A new snapshot with a higher epoch is published
+ * whenever the set of representatives, their weights or their channels change, so readers never have to lock or sort.
+ * Request and response timestamps of the representatives are not kept up to date.
+ */
+class representatives_snapshot final
+{
+public:
+	uint64_t epoch{ 0 };
+	std::vector<nano::representative> representatives;
+	nano::uint128_t total_weight{ 0 };
+	/** Fair queuing weight of each endpoint with representatives, see rep_crawler::queue_weight */
+	std::unordered_map<nano::endpoint, size_t> queue_weights;
+};
+
 /**
  * Crawls the network for representatives. Queries are performed by requesting confirmation of a
  * random block and observing the corresponding vote.
@@ -117,6 +133,15 @@ public:
 	/** Total number of representatives */
 	size_t representative_count ();
 
+	/** Current representatives snapshot, never null */
+	std::shared_ptr<nano::representatives_snapshot const> snapshot () const;
+
+	/**
+	 * Weight of \p endpoint_a when queuing inbound traffic fairly across peers. 1 for peers without representatives,
+	 * 2, 4 or 8 for peers whose representatives hold at least 0.1%, 1% or 5% of the known representative weight
+	 */
+	size_t queue_weight (nano::endpoint const & endpoint_a) const;
+
 private:
 	nano::node & node;
 
@@ -150,9 +175,16 @@ private:
 	/** Probable representatives */
 	probably_rep_t probable_reps;
 
+	/** Publishes a new snapshot of probable_reps, probable_reps_mutex must be held */
+	void update_snapshot ();
+
+	/** Latest snapshot of probable_reps, accessed with atomic shared_ptr operations */
+	std::shared_ptr<nano::representatives_snapshot const> snapshot_m{ std::make_shared<nano::representatives_snapshot> () };
+
 	friend class active_transactions_confirm_active_Test;
 	friend class active_transactions_confirm_frontier_Test;
 	friend class rep_crawler_local_Test;
+	friend class rep_crawler_snapshot_Test;
 	friend class node_online_reps_rep_crawler_Test;
 
 	std::deque<std::pair<std::shared_ptr<nano::transport::channel>, std::shared_ptr<nano::vote>>> responses;
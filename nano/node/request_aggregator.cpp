@@ -4,6 +4,7 @@
 #include <nano/node/common.hpp>
 #include <nano/node/network.hpp>
 #include <nano/node/nodeconfig.hpp>
+#include <nano/node/read_transaction_pool.hpp>
 #include <nano/node/request_aggregator.hpp>
 #include <nano/node/transport/udp.hpp>
 #include <nano/node/voting.hpp>
@@ -11,13 +12,14 @@
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/store.hpp>
 
-nano::request_aggregator::request_aggregator (nano::network_constants const & network_constants_a, nano::node_config const & config_a, nano::stat & stats_a, nano::vote_generator & generator_a, nano::vote_generator & final_generator_a, nano::local_vote_history & history_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::active_transactions & active_a) :
+nano::request_aggregator::request_aggregator (nano::network_constants const & network_constants_a, nano::node_config const & config_a, nano::stat & stats_a, nano::vote_generator & generator_a, nano::vote_generator & final_generator_a, nano::local_vote_history & history_a, nano::ledger & ledger_a, nano::read_transaction_pool & read_transactions_a, nano::wallets & wallets_a, nano::active_transactions & active_a) :
 	max_delay (network_constants_a.is_dev_network () ? 50 : 300),
 	small_delay (network_constants_a.is_dev_network () ? 10 : 50),
 	max_channel_requests (config_a.max_queued_requests),
 	stats (stats_a),
 	local_votes (history_a),
 	ledger (ledger_a),
+	read_transactions (read_transactions_a),
 	wallets (wallets_a),
 	active (active_a),
 	generator (generator_a),
@@ -167,7 +169,7 @@ void nano::request_aggregator::erase_duplicates (std::vector<std::pair<nano::blo
 
 std::pair<std::vector<std::shared_ptr<nano::block>>, std::vector<std::shared_ptr<nano::block>>> nano::request_aggregator::aggregate (std::vector<std::pair<nano::block_hash, nano::root>> const & requests_a, std::shared_ptr<nano::transport::channel> & channel_a) const
 {
-	auto transaction (ledger.store.tx_begin_read ());
+	auto transaction (read_transactions.borrow ());
 	size_t cached_hashes = 0;
 	std::vector<std::shared_ptr<nano::block>> to_generate;
 	std::vector<std::shared_ptr<nano::block>> to_generate_final;
@@ -76,6 +76,7 @@ nano::rocksdb_store::rocksdb_store (nano::logger_mt & logger_a, boost::filesyste
 		peer_store_partial,
 		confirmation_height_store_partial,
 		final_vote_store_partial,
+		account_height_store_partial,
 		version_rocksdb_store
 	},
 	// clang-format on
@@ -89,6 +90,7 @@ nano::rocksdb_store::rocksdb_store (nano::logger_mt & logger_a, boost::filesyste
 	peer_store_partial{ *this },
 	confirmation_height_store_partial{ *this },
 	final_vote_store_partial{ *this },
+	account_height_store_partial{ *this },
 	version_rocksdb_store{ *this },
 	logger{ logger_a },
 	rocksdb_config{ rocksdb_config_a },
@@ -126,7 +128,8 @@ std::unordered_map<const char *, nano::tables> nano::rocksdb_store::create_cf_na
 		{ "peers", tables::peers },
 		{ "confirmation_height", tables::confirmation_height },
 		{ "pruned", tables::pruned },
-		{ "final_votes", tables::final_votes } };
+		{ "final_votes", tables::final_votes },
+		{ "account_heights", tables::account_heights } };
 
 	debug_assert (map.size () == all_tables ().size () + 1);
 	return map;
@@ -299,6 +302,12 @@ rocksdb::ColumnFamilyOptions nano::rocksdb_store::get_cf_options (std::string co
 		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes * 2)));
 		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
 	}
+	else if (cf_name_a == "account_heights")
+	{
+		// Grows with the blocks table, deletions only come from rollbacks and pruning
+		std::shared_ptr<rocksdb::TableFactory> table_factory (rocksdb::NewBlockBasedTableFactory (get_active_table_options (block_cache_size_bytes)));
+		cf_options = get_active_cf_options (table_factory, memtable_size_bytes);
+	}
 	else if (cf_name_a == rocksdb::kDefaultColumnFamilyName)
 	{
 		// Do nothing.
@@ -389,6 +398,8 @@ rocksdb::ColumnFamilyHandle * nano::rocksdb_store::table_to_column_family (table
 			return get_handle ("confirmation_height");
 		case tables::final_votes:
 			return get_handle ("final_votes");
+		case tables::account_heights:
+			return get_handle ("account_heights");
 		default:
 			release_assert (false);
 			return get_handle ("");
@@ -481,6 +492,35 @@ int nano::rocksdb_store::get (nano::transaction const & transaction_a, tables ta
 	return status.code ();
 }
 
+std::vector<int> nano::rocksdb_store::multi_get (nano::transaction const & transaction_a, tables table_a, std::vector<nano::rocksdb_val> const & keys_a, std::vector<nano::rocksdb_val> & values_a) const
+{
+	std::vector<rocksdb::ColumnFamilyHandle *> handles (keys_a.size (), table_to_column_family (table_a));
+	std::vector<rocksdb::Slice> keys (keys_a.begin (), keys_a.end ());
+	std::vector<std::string> values;
+	std::vector<rocksdb::Status> statuses;
+	if (is_read (transaction_a))
+	{
+		statuses = db->MultiGet (snapshot_options (transaction_a), handles, keys, &values);
+	}
+	else
+	{
+		statuses = tx (transaction_a)->MultiGet (rocksdb::ReadOptions (), handles, keys, &values);
+	}
+	std::vector<int> result;
+	result.reserve (statuses.size ());
+	values_a.resize (keys_a.size ());
+	for (size_t i (0), n (statuses.size ()); i < n; ++i)
+	{
+		if (statuses[i].ok ())
+		{
+			values_a[i].buffer = std::make_shared<std::vector<uint8_t>> (values[i].begin (), values[i].end ());
+			values_a[i].convert_buffer_to_value ();
+		}
+		result.push_back (statuses[i].code ());
+	}
+	return result;
+}
+
 int nano::rocksdb_store::put (nano::write_transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a, nano::rocksdb_val const & value_a)
 {
 	debug_assert (transaction_a.contains (table_a));
@@ -536,6 +576,11 @@ uint64_t nano::rocksdb_store::count (nano::transaction const & transaction_a, ta
 	{
 		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
 	}
+	// This is only an estimation, the index is only counted for diagnostics
+	else if (table_a == tables::account_heights)
+	{
+		db->GetIntProperty (table_to_column_family (table_a), "rocksdb.estimate-num-keys", &sum);
+	}
 	// Accounts and blocks should only be used in tests and CLI commands to check database consistency
 	// otherwise there can be performance issues.
 	else if (table_a == tables::accounts)
@@ -789,7 +834,7 @@ void nano::rocksdb_store::on_flush (rocksdb::FlushJobInfo const & flush_job_info
 
 std::vector<nano::tables> nano::rocksdb_store::all_tables () const
 {
-	return std::vector<nano::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::unchecked, tables::vote };
+	return std::vector<nano::tables>{ tables::account_heights, tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::frontiers, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::unchecked, tables::vote };
 }
 
 bool nano::rocksdb_store::copy_db (boost::filesystem::path const & destination_path)
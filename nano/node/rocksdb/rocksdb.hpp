@@ -67,6 +67,7 @@ private:
 	nano::peer_store_partial<rocksdb::Slice, rocksdb_store> peer_store_partial;
 	nano::confirmation_height_store_partial<rocksdb::Slice, rocksdb_store> confirmation_height_store_partial;
 	nano::final_vote_store_partial<rocksdb::Slice, rocksdb_store> final_vote_store_partial;
+	nano::account_height_store_partial<rocksdb::Slice, rocksdb_store> account_height_store_partial;
 	nano::version_rocksdb_store version_rocksdb_store;
 
 public:
@@ -84,6 +85,8 @@ public:
 
 	bool exists (nano::transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a) const;
 	int get (nano::transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a, nano::rocksdb_val & value_a) const;
+	/** Looks up keys_a with a single MultiGet, values_a and the returned statuses are in the order of keys_a */
+	std::vector<int> multi_get (nano::transaction const & transaction_a, tables table_a, std::vector<nano::rocksdb_val> const & keys_a, std::vector<nano::rocksdb_val> & values_a) const;
 	int put (nano::write_transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a, nano::rocksdb_val const & value_a);
 	int del (nano::write_transaction const & transaction_a, tables table_a, nano::rocksdb_val const & key_a);
 
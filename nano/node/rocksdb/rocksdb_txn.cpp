@@ -16,9 +16,11 @@ nano::read_rocksdb_txn::~read_rocksdb_txn ()
 
 void nano::read_rocksdb_txn::reset ()
 {
-	if (db)
+	// Transactions may be destroyed after being reset, do not release the snapshot twice
+	if (db && options.snapshot != nullptr)
 	{
 		db->ReleaseSnapshot (options.snapshot);
+		options.snapshot = nullptr;
 	}
 }
 
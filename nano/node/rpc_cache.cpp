@@ -0,0 +1,213 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/tomlconfig.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/rpc_cache.hpp>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+/** Read only actions which clients commonly poll with identical parameters */
+std::unordered_set<std::string> const cached_actions{
+	"account_balance",
+	"account_info",
+	"block_info",
+	"active_difficulty",
+	"confirmation_quorum",
+	"representatives_online",
+	"telemetry"
+};
+}
+
+nano::error nano::rpc_cache_config::serialize_toml (nano::tomlconfig & toml) const
+{
+	toml.put ("enable", enable, "Cache responses of frequently polled read only RPC actions: account_balance, account_info, block_info, active_difficulty, confirmation_quorum, representatives_online and telemetry.\ntype:bool");
+	toml.put ("max_size", max_size, "Maximum total size of cached responses in bytes.\ntype:uint64");
+	toml.put ("ledger_ttl", ledger_ttl.count (), "Maximum age of cached account and block responses. These are also invalidated when the account changes.\ntype:seconds");
+	toml.put ("network_ttl", network_ttl.count (), "Maximum age of cached network state responses.\ntype:milliseconds");
+	return toml.get_error ();
+}
+
+nano::error nano::rpc_cache_config::deserialize_toml (nano::tomlconfig & toml)
+{
+	toml.get_optional<bool> ("enable", enable);
+	toml.get_optional<size_t> ("max_size", max_size);
+	auto ledger_ttl_l (ledger_ttl.count ());
+	toml.get_optional ("ledger_ttl", ledger_ttl_l);
+	ledger_ttl = std::chrono::seconds (ledger_ttl_l);
+	auto network_ttl_l (network_ttl.count ());
+	toml.get_optional ("network_ttl", network_ttl_l);
+	network_ttl = std::chrono::milliseconds (network_ttl_l);
+	return toml.get_error ();
+}
+
+nano::rpc_cache::rpc_cache (nano::rpc_cache_config const & config_a, nano::stat & stats_a) :
+	config (config_a),
+	stats (stats_a)
+{
+}
+
+std::string nano::rpc_cache::key (std::string const & action_a, boost::property_tree::ptree const & request_a) const
+{
+	std::string result;
+	auto existing (cached_actions.find (action_a));
+	// Representative weight changes with blocks of other accounts, which do not invalidate the entry
+	auto weight (action_a == "account_info" && request_a.get<bool> ("weight", false));
+	if (existing != cached_actions.end () && !weight)
+	{
+		std::vector<std::pair<std::string, std::string>> parameters;
+		bool nested (false);
+		for (auto const & [name, value] : request_a)
+		{
+			nested = nested || !value.empty ();
+			if (name == "account")
+			{
+				// Accounts may be given with either underscore prefix. The deprecated dash prefixes are kept apart, their responses carry deprecated_account_format
+				auto const & text (value.data ());
+				auto deprecated (text.size () > 4 && (text[3] == '-' || text[4] == '-'));
+				nano::account account;
+				parameters.emplace_back (name, deprecated || account.decode_account (text) ? text : account.to_account ());
+			}
+			else if (name != "action")
+			{
+				parameters.emplace_back (name, value.data ());
+			}
+		}
+		if (!nested)
+		{
+			std::sort (parameters.begin (), parameters.end ());
+			result = action_a;
+			for (auto const & [name, value] : parameters)
+			{
+				result.append (1, '\0').append (name).append (1, '=').append (value);
+			}
+		}
+	}
+	return result;
+}
+
+std::shared_ptr<std::string const> nano::rpc_cache::get (std::string const & key_a)
+{
+	std::shared_ptr<std::string const> result;
+	nano::lock_guard<nano::mutex> guard (mutex);
+	auto & by_key (entries.get<tag_key> ());
+	auto existing (by_key.find (key_a));
+	if (existing != by_key.end ())
+	{
+		if (existing->expiry > std::chrono::steady_clock::now ())
+		{
+			result = existing->response;
+			// Move to the back of the eviction order
+			entries.relocate (entries.end (), entries.project<tag_sequence> (existing));
+		}
+		else
+		{
+			bytes -= existing->size ();
+			by_key.erase (existing);
+			stats.inc (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_expired);
+		}
+	}
+	stats.inc (nano::stat::type::rpc_cache, result != nullptr ? nano::stat::detail::rpc_cache_hit : nano::stat::detail::rpc_cache_miss);
+	return result;
+}
+
+uint64_t nano::rpc_cache::generation ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return generation_m;
+}
+
+void nano::rpc_cache::put (std::string const & key_a, uint64_t generation_a, nano::account const & account_a, std::string const & response_a)
+{
+	auto ttl (account_a.is_zero () ? std::chrono::duration_cast<std::chrono::steady_clock::duration> (config.network_ttl) : std::chrono::duration_cast<std::chrono::steady_clock::duration> (config.ledger_ttl));
+	entry entry_l{ key_a, account_a, std::chrono::steady_clock::now () + ttl, std::make_shared<std::string const> (response_a) };
+	nano::lock_guard<nano::mutex> guard (mutex);
+	// The response may have been read from a snapshot older than an invalidation which has since happened
+	if ((account_a.is_zero () || bucket (account_a) <= generation_a) && entry_l.size () <= config.max_size)
+	{
+		auto & by_key (entries.get<tag_key> ());
+		auto existing (by_key.find (key_a));
+		if (existing != by_key.end ())
+		{
+			bytes -= existing->size ();
+			by_key.erase (existing);
+		}
+		bytes += entry_l.size ();
+		entries.push_back (std::move (entry_l));
+		while (bytes > config.max_size)
+		{
+			erase_lru ();
+		}
+	}
+}
+
+void nano::rpc_cache::invalidate (nano::account const & account_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	bucket (account_a) = ++generation_m;
+	auto & by_account (entries.get<tag_account> ());
+	auto [begin, end] = by_account.equal_range (account_a);
+	for (auto i (begin); i != end; ++i)
+	{
+		bytes -= i->size ();
+		stats.inc (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_invalidated);
+	}
+	by_account.erase (begin, end);
+}
+
+void nano::rpc_cache::invalidate (nano::block const & block_a)
+{
+	invalidate (block_a.account ().is_zero () ? block_a.sideband ().account : block_a.account ());
+	if (!block_a.destination ().is_zero ())
+	{
+		invalidate (block_a.destination ());
+	}
+	else if (block_a.type () == nano::block_type::state)
+	{
+		// Only sends link to an account, invalidating the link of other subtypes is harmless
+		invalidate (block_a.link ().as_account ());
+	}
+}
+
+size_t nano::rpc_cache::size ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return entries.size ();
+}
+
+void nano::rpc_cache::erase_lru ()
+{
+	debug_assert (!entries.empty ());
+	bytes -= entries.front ().size ();
+	entries.pop_front ();
+	stats.inc (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_evicted);
+}
+
+uint64_t & nano::rpc_cache::bucket (nano::account const & account_a)
+{
+	return invalidated[account_a.qwords[0] % invalidated.size ()];
+}
+
+size_t nano::rpc_cache::entry::size () const
+{
+	return sizeof (entry) + key.size () + response->size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (rpc_cache & rpc_cache, std::string const & name)
+{
+	size_t bytes;
+	size_t count;
+	{
+		nano::lock_guard<nano::mutex> guard (rpc_cache.mutex);
+		bytes = rpc_cache.bytes;
+		count = rpc_cache.entries.size ();
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "entries", count, count == 0 ? 0 : bytes / count }));
+	return composite;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <nano/lib/errors.hpp>
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace nano
+{
+class block;
+class container_info_component;
+class stat;
+class tomlconfig;
+
+class rpc_cache_config final
+{
+public:
+	nano::error serialize_toml (nano::tomlconfig &) const;
+	nano::error deserialize_toml (nano::tomlconfig &);
+	bool enable{ false };
+	/** Maximum total size of cached requests and responses in bytes */
+	size_t max_size{ 64 * 1024 * 1024 };
+	/** Responses about accounts and blocks are invalidated by ledger changes, this bounds their age regardless */
+	std::chrono::seconds ledger_ttl{ 60 };
+	/** Responses about network state are only invalidated by age */
+	std::chrono::milliseconds network_ttl{ 1000 };
+};
+
+/**
+ * Caches responses of read only RPC actions which clients poll with identical parameters.
+ * Responses depending on an account are dropped when a block of that account, or a send to it, is processed, cemented or rolled back.
+ * The least recently used responses are evicted once max_size bytes are held.
+ */
+class rpc_cache final
+{
+public:
+	rpc_cache (nano::rpc_cache_config const &, nano::stat &);
+	/** Returns the normalized key of a request, or an empty string if the response should not be cached */
+	std::string key (std::string const & action, boost::property_tree::ptree const & request) const;
+	/** Returns the cached response for key, or nullptr if there is no live entry */
+	std::shared_ptr<std::string const> get (std::string const & key);
+	/** Generation to pass to put, taken before the response is computed */
+	uint64_t generation ();
+	/**
+	 * Caches a response which depends on the ledger state of account, zero if it only depends on network state.
+	 * The response is discarded if account may have been invalidated after generation_a.
+	 */
+	void put (std::string const & key, uint64_t generation_a, nano::account const & account, std::string const & response);
+	void invalidate (nano::account const &);
+	/** Invalidates the account of the block and the destination of a send */
+	void invalidate (nano::block const &);
+	size_t size ();
+	nano::rpc_cache_config const config;
+
+private:
+	class entry final
+	{
+	public:
+		std::string key;
+		nano::account account;
+		std::chrono::steady_clock::time_point expiry;
+		std::shared_ptr<std::string const> response;
+		size_t size () const;
+	};
+	void erase_lru ();
+	uint64_t & bucket (nano::account const &);
+	nano::stat & stats;
+	nano::mutex mutex;
+	// clang-format off
+	class tag_sequence {};
+	class tag_key {};
+	class tag_account {};
+	boost::multi_index_container<entry,
+	boost::multi_index::indexed_by<
+		boost::multi_index::sequenced<boost::multi_index::tag<tag_sequence>>,
+		boost::multi_index::hashed_unique<boost::multi_index::tag<tag_key>,
+			boost::multi_index::member<entry, std::string, &entry::key>>,
+		boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_account>,
+			boost::multi_index::member<entry, nano::account, &entry::account>, std::hash<nano::account>>>>
+	entries;
+	// clang-format on
+	size_t bytes{ 0 };
+	uint64_t generation_m{ 0 };
+	/** Generation each group of accounts was last invalidated at, responses computed before then are not inserted */
+	std::array<uint64_t, 4096> invalidated{};
+
+	friend std::unique_ptr<nano::container_info_component> collect_container_info (rpc_cache &, std::string const &);
+};
+
+std::unique_ptr<nano::container_info_component> collect_container_info (rpc_cache &, std::string const &);
+}
@@ -68,35 +68,71 @@ void nano::socket::async_read (std::shared_ptr<std::vector<uint8_t>> const & buf
 	}
 }
 
-void nano::socket::async_write (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a)
+void nano::socket::async_read_some (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, size_t offset_a, size_t size_a, std::function<void (boost::system::error_code const &, size_t)> callback_a)
 {
-	if (!closed)
+	if (size_a > 0 && offset_a + size_a <= buffer_a->size ())
 	{
-		++queue_size;
-		boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback_a, this_l = shared_from_this ()] () {
-			if (!this_l->closed)
-			{
-				this_l->start_timer ();
-				nano::async_write (this_l->tcp_socket, buffer_a,
+		auto this_l (shared_from_this ());
+		if (!closed)
+		{
+			start_timer ();
+			boost::asio::post (strand, boost::asio::bind_executor (strand, [buffer_a, callback_a, offset_a, size_a, this_l] () {
+				this_l->tcp_socket.async_read_some (boost::asio::buffer (buffer_a->data () + offset_a, size_a),
 				boost::asio::bind_executor (this_l->strand,
-				[buffer_a, callback_a, this_l] (boost::system::error_code ec, std::size_t size_a) {
-					--this_l->queue_size;
-					this_l->node.stats.add (nano::stat::type::traffic_tcp, nano::stat::dir::out, size_a);
+				[this_l, buffer_a, callback_a] (boost::system::error_code const & ec, size_t size_a) {
+					this_l->node.stats.add (nano::stat::type::traffic_tcp, nano::stat::dir::in, size_a);
 					this_l->stop_timer ();
-					if (callback_a)
-					{
-						callback_a (ec, size_a);
-					}
+					callback_a (ec, size_a);
 				}));
+			}));
+		}
+	}
+	else
+	{
+		debug_assert (false && "nano::socket::async_read_some called with incorrect buffer size");
+		boost::system::error_code ec_buffer = boost::system::errc::make_error_code (boost::system::errc::no_buffer_space);
+		callback_a (ec_buffer, 0);
+	}
+}
+
+void nano::socket::async_write (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::write_priority priority_a)
+{
+	queue_write (buffer_a, callback_a, priority_a, std::numeric_limits<size_t>::max ());
+}
+
+bool nano::socket::try_async_write (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy policy_a, nano::write_priority priority_a)
+{
+	auto const limit (policy_a == nano::buffer_drop_policy::no_socket_drop ? queue_size_max * 2 : queue_size_max);
+	return queue_write (buffer_a, callback_a, priority_a, limit);
+}
+
+bool nano::socket::queue_write (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::write_priority priority_a, size_t limit_a)
+{
+	bool queued (true);
+	if (!closed)
+	{
+		bool start (false);
+		{
+			nano::lock_guard<nano::mutex> guard (write_mutex);
+			// Drop policies are applied when queueing, against the buffers still waiting to be written
+			if (queue_size < limit_a)
+			{
+				++queue_size;
+				write_queue[static_cast<size_t> (priority_a)].push_back ({ buffer_a, callback_a });
+				start = !writing;
+				writing = true;
 			}
 			else
 			{
-				if (callback_a)
-				{
-					callback_a (boost::system::errc::make_error_code (boost::system::errc::not_supported), 0);
-				}
+				queued = false;
 			}
-		}));
+		}
+		if (start)
+		{
+			boost::asio::post (strand, boost::asio::bind_executor (strand, [this_l = shared_from_this ()] () {
+				this_l->write_queued ();
+			}));
+		}
 	}
 	else if (callback_a)
 	{
@@ -104,6 +140,68 @@ void nano::socket::async_write (nano::shared_const_buffer const & buffer_a, std:
 			callback_a (boost::system::errc::make_error_code (boost::system::errc::not_supported), 0);
 		});
 	}
+	return queued;
+}
+
+void nano::socket::write_queued ()
+{
+	debug_assert (strand.running_in_this_thread ());
+	auto items (std::make_shared<std::vector<queue_item>> ());
+	{
+		nano::lock_guard<nano::mutex> guard (write_mutex);
+		size_t bytes (0);
+		for (auto & lane : write_queue)
+		{
+			while (!lane.empty () && items->size () < write_buffers_max && (items->empty () || bytes + lane.front ().buffer.size () <= write_bytes_max))
+			{
+				bytes += lane.front ().buffer.size ();
+				items->push_back (std::move (lane.front ()));
+				lane.pop_front ();
+			}
+		}
+		writing = !items->empty ();
+	}
+	if (!items->empty ())
+	{
+		if (!closed)
+		{
+			std::vector<boost::asio::const_buffer> buffers;
+			buffers.reserve (items->size ());
+			for (auto const & item : *items)
+			{
+				buffers.insert (buffers.end (), item.buffer.begin (), item.buffer.end ());
+			}
+			start_timer ();
+			// The items hold the underlying data until the write completes
+			boost::asio::async_write (tcp_socket, buffers,
+			boost::asio::bind_executor (strand,
+			[items, this_l = shared_from_this ()] (boost::system::error_code ec, std::size_t size_a) {
+				this_l->queue_size -= items->size ();
+				this_l->node.stats.add (nano::stat::type::traffic_tcp, nano::stat::dir::out, size_a);
+				this_l->stop_timer ();
+				for (auto const & item : *items)
+				{
+					if (item.callback)
+					{
+						item.callback (ec, !ec ? item.buffer.size () : 0);
+					}
+				}
+				this_l->write_queued ();
+			}));
+		}
+		else
+		{
+			queue_size -= items->size ();
+			for (auto const & item : *items)
+			{
+				if (item.callback)
+				{
+					item.callback (boost::system::errc::make_error_code (boost::system::errc::not_supported), 0);
+				}
+			}
+			write_queued ();
+		}
+	}
 }
 
 void nano::socket::start_timer ()
@@ -3,9 +3,11 @@
 #include <nano/boost/asio/ip/tcp.hpp>
 #include <nano/boost/asio/strand.hpp>
 #include <nano/lib/asio.hpp>
+#include <nano/lib/locks.hpp>
 
 #include <boost/optional.hpp>
 
+#include <array>
 #include <chrono>
 #include <deque>
 #include <memory>
@@ -24,6 +26,16 @@ enum class buffer_drop_policy
 	no_socket_drop
 };
 
+/** Lane of the socket write queue, queued buffers are written from the highest priority lane first */
+enum class write_priority
+{
+	/** Latency sensitive traffic such as votes and confirmation requests */
+	high,
+	normal,
+	/** Bulk traffic such as flooded blocks */
+	low
+};
+
 class node;
 class server_socket;
 
@@ -50,7 +62,15 @@ public:
 	virtual ~socket ();
 	void async_connect (boost::asio::ip::tcp::endpoint const &, std::function<void (boost::system::error_code const &)>);
 	void async_read (std::shared_ptr<std::vector<uint8_t>> const &, size_t, std::function<void (boost::system::error_code const &, size_t)>);
-	void async_write (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr);
+	/** Read whatever is available, at least one byte and at most \p size_a, into \p buffer_a starting at \p offset_a */
+	void async_read_some (std::shared_ptr<std::vector<uint8_t>> const & buffer_a, size_t offset_a, size_t size_a, std::function<void (boost::system::error_code const &, size_t)> callback_a);
+	/** Queue a buffer for writing, it is never dropped */
+	void async_write (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::write_priority = nano::write_priority::normal);
+	/**
+	 * Queue a buffer for writing unless the write queue is too full for \p policy_a
+	 * @return false if the buffer was dropped, in which case the callback is not called
+	 */
+	bool try_async_write (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const &, nano::buffer_drop_policy policy_a, nano::write_priority = nano::write_priority::normal);
 
 	void close ();
 	boost::asio::ip::tcp::endpoint remote_endpoint () const;
@@ -97,12 +117,22 @@ protected:
 	std::atomic<uint64_t> last_completion_time;
 	std::atomic<bool> timed_out{ false };
 	boost::optional<std::chrono::seconds> io_timeout;
+	/** Number of buffers queued or being written */
 	std::atomic<size_t> queue_size{ 0 };
+	/** Protects write_queue and writing */
+	nano::mutex write_mutex;
+	/** One lane per nano::write_priority */
+	std::array<std::deque<queue_item>, 3> write_queue;
+	/** Set while a vectored write is in progress or scheduled on the strand */
+	bool writing{ false };
 
 	/** Set by close() - completion handlers must check this. This is more reliable than checking
 	 error codes as the OS may have already completed the async operation. */
 	std::atomic<bool> closed{ false };
 	void close_internal ();
+	bool queue_write (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const &, nano::write_priority, size_t);
+	/** Gather queued buffers into a single vectored write, must be called from the strand */
+	void write_queued ();
 	void start_timer ();
 	void stop_timer ();
 	void checkup ();
@@ -112,6 +142,9 @@ private:
 
 public:
 	static size_t constexpr queue_size_max = 128;
+	/** Limits of a single vectored write */
+	static size_t constexpr write_buffers_max = 64;
+	static size_t constexpr write_bytes_max = 64 * 1024;
 };
 
 /** Socket class for TCP servers */
@@ -65,6 +65,7 @@ void nano::telemetry::set (nano::telemetry_ack const & message_a, nano::transpor
 
 		if (!error)
 		{
+			aggregator.add (endpoint, message_a.data, std::chrono::steady_clock::now ());
 			// Received telemetry data from a peer which hasn't disabled providing telemetry metrics and there's no errors with the data
 			lk.unlock ();
 			observers.notify (message_a.data, endpoint);
@@ -186,6 +187,7 @@ void nano::telemetry::ongoing_req_all_peers (std::chrono::milliseconds next_requ
 					{
 						if (!it->undergoing_request && !this_l->within_cache_cutoff (*it) && peers.count (it->endpoint) == 0)
 						{
+							this_l->aggregator.erase (it->endpoint);
 							it = this_l->recent_or_initial_request_telemetry_data.erase (it);
 						}
 						else
@@ -260,6 +262,24 @@ std::unordered_map<nano::endpoint, nano::telemetry_data> nano::telemetry::get_me
 	return telemetry_data;
 }
 
+nano::telemetry_data nano::telemetry::get_consolidated_metrics ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return aggregator.consolidated (std::chrono::steady_clock::now ());
+}
+
+std::vector<std::pair<std::string, nano::telemetry_metric_summary>> nano::telemetry::get_metric_summaries ()
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return aggregator.summaries (std::chrono::steady_clock::now ());
+}
+
+std::vector<nano::telemetry_data> nano::telemetry::get_metrics_history (nano::endpoint const & endpoint_a)
+{
+	nano::lock_guard<nano::mutex> guard (mutex);
+	return aggregator.history (endpoint_a);
+}
+
 void nano::telemetry::get_metrics_single_peer_async (std::shared_ptr<nano::transport::channel> const & channel_a, std::function<void (telemetry_data_response const &)> const & callback_a)
 {
 	auto invoke_callback_with_error = [&callback_a, &workers = this->workers, channel_a] () {
@@ -401,6 +421,7 @@ void nano::telemetry::channel_processed (nano::endpoint const & endpoint_a, bool
 		else
 		{
 			recent_or_initial_request_telemetry_data.erase (endpoint_a);
+			aggregator.erase (endpoint_a);
 		}
 		flush_callbacks_async (endpoint_a, error_a);
 	}
@@ -480,6 +501,10 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (te
 
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "recent_or_initial_request_telemetry_data", telemetry.telemetry_data_size (), sizeof (decltype (telemetry.recent_or_initial_request_telemetry_data)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "callbacks", callbacks_count, sizeof (decltype (telemetry.callbacks)::value_type::second_type) }));
+	{
+		nano::lock_guard<nano::mutex> guard (telemetry.mutex);
+		composite->add_component (collect_container_info (telemetry.aggregator, "aggregator"));
+	}
 
 	return composite;
 }
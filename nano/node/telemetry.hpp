@@ -2,6 +2,7 @@
 
 #include <nano/lib/utility.hpp>
 #include <nano/node/common.hpp>
+#include <nano/node/telemetry_aggregator.hpp>
 #include <nano/secure/common.hpp>
 
 #include <boost/multi_index/hashed_index.hpp>
@@ -74,6 +75,21 @@ public:
 	 */
 	std::unordered_map<nano::endpoint, nano::telemetry_data> get_metrics ();
 
+	/*
+	 * Consolidated (average or mode) metrics of all cached peers, from aggregates maintained as metrics are set or expire
+	 */
+	nano::telemetry_data get_consolidated_metrics ();
+
+	/*
+	 * Quantiles of each numeric metric across the cached peers
+	 */
+	std::vector<std::pair<std::string, nano::telemetry_metric_summary>> get_metric_summaries ();
+
+	/*
+	 * Recent metrics received from this peer, oldest first
+	 */
+	std::vector<nano::telemetry_data> get_metrics_history (nano::endpoint const &);
+
 	/*
 	 * This makes a telemetry request to the specific channel.
 	 * Error is set for: no response received, no payload received, invalid signature or unsound metrics in message (e.g different genesis block) 
@@ -130,6 +146,9 @@ private:
 	// The maximum time spent waiting for a response to a telemetry request
 	std::chrono::seconds const response_time_cutoff{ network_params.network.is_dev_network () ? (is_sanitizer_build || nano::running_within_valgrind () ? 6 : 3) : 10 };
 
+	// Rolling aggregation of the same data as get_metrics ()
+	nano::telemetry_aggregator aggregator{ cache_plus_buffer_cutoff_time () };
+
 	std::unordered_map<nano::endpoint, std::vector<std::function<void (telemetry_data_response const &)>>> callbacks;
 
 	void ongoing_req_all_peers (std::chrono::milliseconds);
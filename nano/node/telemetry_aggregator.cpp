@@ -0,0 +1,415 @@
+#include <nano/node/telemetry.hpp>
+#include <nano/node/telemetry_aggregator.hpp>
+
+#include <boost/numeric/conversion/cast.hpp>
+
+#include <cmath>
+
+namespace
+{
+std::array<char const *, nano::telemetry_aggregator::metric_count> const metric_names{ "account_count", "block_count", "cemented_count", "unchecked_count", "peer_count", "bandwidth_cap", "uptime", "active_difficulty" };
+size_t constexpr account_count_index = 0;
+size_t constexpr block_count_index = 1;
+size_t constexpr cemented_count_index = 2;
+size_t constexpr unchecked_count_index = 3;
+size_t constexpr peer_count_index = 4;
+size_t constexpr bandwidth_cap_index = 5;
+size_t constexpr uptime_index = 6;
+size_t constexpr active_difficulty_index = 7;
+}
+
+nano::quantile_sketch::quantile_sketch (double relative_accuracy_a) :
+	gamma ((1 + relative_accuracy_a) / (1 - relative_accuracy_a)),
+	log_gamma (std::log (gamma))
+{
+	debug_assert (relative_accuracy_a > 0 && relative_accuracy_a < 1);
+}
+
+int nano::quantile_sketch::bucket (uint64_t value_a) const
+{
+	debug_assert (value_a != 0);
+	return static_cast<int> (std::ceil (std::log (static_cast<double> (value_a)) / log_gamma));
+}
+
+uint64_t nano::quantile_sketch::value (int bucket_a) const
+{
+	// Midpoint of the bucket (gamma^(i-1), gamma^i], within the relative accuracy of every value it holds
+	auto result (2 * std::pow (gamma, bucket_a) / (gamma + 1));
+	return result >= static_cast<double> (std::numeric_limits<uint64_t>::max ()) ? std::numeric_limits<uint64_t>::max () : static_cast<uint64_t> (std::llround (result));
+}
+
+void nano::quantile_sketch::insert (uint64_t value_a)
+{
+	++total;
+	if (value_a == 0)
+	{
+		++zero_count;
+	}
+	else
+	{
+		++buckets[bucket (value_a)];
+	}
+}
+
+void nano::quantile_sketch::erase (uint64_t value_a)
+{
+	if (value_a == 0)
+	{
+		debug_assert (zero_count > 0);
+		--zero_count;
+		--total;
+	}
+	else
+	{
+		auto existing (buckets.find (bucket (value_a)));
+		debug_assert (existing != buckets.end ());
+		if (existing != buckets.end ())
+		{
+			--total;
+			if (--existing->second == 0)
+			{
+				buckets.erase (existing);
+			}
+		}
+	}
+}
+
+uint64_t nano::quantile_sketch::quantile (double q_a) const
+{
+	uint64_t result (0);
+	if (total > 0)
+	{
+		auto rank (static_cast<uint64_t> (std::clamp (q_a, 0.0, 1.0) * (total - 1)));
+		if (rank >= zero_count)
+		{
+			auto seen (zero_count);
+			for (auto const & [bucket_l, count_l] : buckets)
+			{
+				seen += count_l;
+				if (seen > rank)
+				{
+					result = value (bucket_l);
+					break;
+				}
+			}
+		}
+	}
+	return result;
+}
+
+uint64_t nano::quantile_sketch::size () const
+{
+	return total;
+}
+
+size_t nano::quantile_sketch::bucket_count () const
+{
+	return buckets.size () + (zero_count > 0 ? 1 : 0);
+}
+
+void nano::trimmed_sum::insert (uint64_t value_a)
+{
+	// Keep every low value <= every kept value <= every high value, rebalance moves values across the boundaries
+	if (!low.empty () && value_a < *low.rbegin ())
+	{
+		low.insert (value_a);
+	}
+	else if (!high.empty () && value_a > *high.begin ())
+	{
+		high.insert (value_a);
+	}
+	else
+	{
+		kept.insert (value_a);
+		kept_sum += value_a;
+	}
+	rebalance ();
+}
+
+void nano::trimmed_sum::erase (uint64_t value_a)
+{
+	auto existing (kept.find (value_a));
+	if (existing != kept.end ())
+	{
+		kept.erase (existing);
+		kept_sum -= value_a;
+	}
+	else if ((existing = low.find (value_a)) != low.end ())
+	{
+		low.erase (existing);
+	}
+	else
+	{
+		existing = high.find (value_a);
+		debug_assert (existing != high.end ());
+		if (existing != high.end ())
+		{
+			high.erase (existing);
+		}
+	}
+	rebalance ();
+}
+
+void nano::trimmed_sum::trim (size_t trim_a)
+{
+	trimmed = trim_a;
+	rebalance ();
+}
+
+void nano::trimmed_sum::rebalance ()
+{
+	auto const total (low.size () + kept.size () + high.size ());
+	auto const low_target (std::min (trimmed, total));
+	auto const high_target (std::min (trimmed, total - low_target));
+	while (low.size () > low_target)
+	{
+		auto value (std::prev (low.end ()));
+		kept_sum += *value;
+		kept.insert (kept.begin (), *value);
+		low.erase (value);
+	}
+	while (high.size () > high_target)
+	{
+		auto value (high.begin ());
+		kept_sum += *value;
+		kept.insert (kept.end (), *value);
+		high.erase (value);
+	}
+	while (low.size () < low_target)
+	{
+		// Only the high values are left when everything is trimmed
+		auto & source (kept.empty () ? high : kept);
+		auto value (source.begin ());
+		if (&source == &kept)
+		{
+			kept_sum -= *value;
+		}
+		low.insert (low.end (), *value);
+		source.erase (value);
+	}
+	while (high.size () < high_target)
+	{
+		auto value (std::prev (kept.end ()));
+		kept_sum -= *value;
+		high.insert (high.begin (), *value);
+		kept.erase (value);
+	}
+}
+
+nano::uint128_t nano::trimmed_sum::sum () const
+{
+	return kept_sum;
+}
+
+size_t nano::trimmed_sum::size () const
+{
+	return kept.size ();
+}
+
+nano::telemetry_aggregator::peer_entry::peer_entry (size_t history_size_a) :
+	samples (history_size_a)
+{
+}
+
+nano::telemetry_aggregator::telemetry_aggregator (std::chrono::milliseconds expiry_a, size_t history_size_a) :
+	expiry (expiry_a),
+	history_size (std::max<size_t> (history_size_a, 1))
+{
+}
+
+std::array<uint64_t, nano::telemetry_aggregator::metric_count> nano::telemetry_aggregator::metric_values (nano::telemetry_data const & data_a)
+{
+	return { data_a.account_count, data_a.block_count, data_a.cemented_count, data_a.unchecked_count, data_a.peer_count, data_a.bandwidth_cap, data_a.uptime, data_a.active_difficulty };
+}
+
+std::array<uint8_t, 5> nano::telemetry_aggregator::version (nano::telemetry_data const & data_a)
+{
+	return { data_a.major_version, data_a.minor_version, data_a.patch_version, data_a.pre_release_version, data_a.maker };
+}
+
+void nano::telemetry_aggregator::insert_metrics (nano::telemetry_data const & data_a)
+{
+	auto values (metric_values (data_a));
+	for (size_t i (0); i < metric_count; ++i)
+	{
+		// 0 means an unlimited bandwidth cap, don't let it skew the distribution
+		if (i != bandwidth_cap_index || values[i] != 0)
+		{
+			sketches[i].insert (values[i]);
+			sums[i].insert (values[i]);
+		}
+	}
+	timestamps.insert (std::chrono::duration_cast<std::chrono::milliseconds> (data_a.timestamp.time_since_epoch ()).count ());
+	bandwidth_caps.insert (data_a.bandwidth_cap);
+	protocol_versions.insert (data_a.protocol_version);
+	genesis_blocks.insert (data_a.genesis_block);
+	versions.insert (version (data_a));
+}
+
+void nano::telemetry_aggregator::erase_metrics (nano::telemetry_data const & data_a)
+{
+	auto values (metric_values (data_a));
+	for (size_t i (0); i < metric_count; ++i)
+	{
+		if (i != bandwidth_cap_index || values[i] != 0)
+		{
+			sketches[i].erase (values[i]);
+			sums[i].erase (values[i]);
+		}
+	}
+	timestamps.erase (std::chrono::duration_cast<std::chrono::milliseconds> (data_a.timestamp.time_since_epoch ()).count ());
+	bandwidth_caps.erase (data_a.bandwidth_cap);
+	protocol_versions.erase (data_a.protocol_version);
+	genesis_blocks.erase (data_a.genesis_block);
+	versions.erase (version (data_a));
+}
+
+void nano::telemetry_aggregator::retrim ()
+{
+	auto const trim (peers.size () / 10);
+	for (auto & sum : sums)
+	{
+		sum.trim (trim);
+	}
+	timestamps.trim (trim);
+}
+
+void nano::telemetry_aggregator::add (nano::endpoint const & endpoint_a, nano::telemetry_data const & data_a, std::chrono::steady_clock::time_point now_a)
+{
+	auto existing (peers.find (endpoint_a));
+	if (existing == peers.end ())
+	{
+		existing = peers.emplace (endpoint_a, peer_entry (history_size)).first;
+	}
+	else
+	{
+		debug_assert (!existing->second.samples.empty ());
+		erase_metrics (existing->second.samples.back ());
+	}
+	existing->second.samples.push_back (data_a);
+	existing->second.last_update = now_a;
+	insert_metrics (data_a);
+	retrim ();
+	oldest_update = std::min (oldest_update, now_a);
+}
+
+void nano::telemetry_aggregator::erase (nano::endpoint const & endpoint_a)
+{
+	auto existing (peers.find (endpoint_a));
+	if (existing != peers.end ())
+	{
+		erase_metrics (existing->second.samples.back ());
+		peers.erase (existing);
+		retrim ();
+	}
+}
+
+void nano::telemetry_aggregator::purge_expired (std::chrono::steady_clock::time_point now_a)
+{
+	// Only walk the peers when the oldest sample has expired
+	if (!peers.empty () && oldest_update < now_a - expiry)
+	{
+		oldest_update = std::chrono::steady_clock::time_point::max ();
+		for (auto i (peers.begin ()); i != peers.end ();)
+		{
+			if (i->second.last_update + expiry < now_a)
+			{
+				erase_metrics (i->second.samples.back ());
+				i = peers.erase (i);
+			}
+			else
+			{
+				oldest_update = std::min (oldest_update, i->second.last_update);
+				++i;
+			}
+		}
+		retrim ();
+	}
+}
+
+nano::telemetry_data nano::telemetry_aggregator::consolidated (std::chrono::steady_clock::time_point now_a)
+{
+	purge_expired (now_a);
+	nano::telemetry_data result;
+	if (peers.size () == 1)
+	{
+		result = peers.begin ()->second.samples.back ();
+	}
+	else if (!peers.empty ())
+	{
+		// Every peer contributes to these, so they all keep the same number of values after trimming
+		auto const size (sums[account_count_index].size ());
+		auto mean = [this, size] (size_t index_a) {
+			return sums[index_a].sum () / size;
+		};
+		result.account_count = boost::numeric_cast<decltype (result.account_count)> (mean (account_count_index));
+		result.block_count = boost::numeric_cast<decltype (result.block_count)> (mean (block_count_index));
+		result.cemented_count = boost::numeric_cast<decltype (result.cemented_count)> (mean (cemented_count_index));
+		result.peer_count = boost::numeric_cast<decltype (result.peer_count)> (mean (peer_count_index));
+		result.uptime = boost::numeric_cast<decltype (result.uptime)> (mean (uptime_index));
+		result.unchecked_count = boost::numeric_cast<decltype (result.unchecked_count)> (mean (unchecked_count_index));
+		result.active_difficulty = boost::numeric_cast<decltype (result.active_difficulty)> (mean (active_difficulty_index));
+		result.timestamp = std::chrono::system_clock::time_point (std::chrono::milliseconds (boost::numeric_cast<uint64_t> (timestamps.sum () / timestamps.size ())));
+
+		// Use the mode for the bandwidth cap if 2 or more peers share it, the average of limited caps otherwise
+		auto bandwidth_cap (bandwidth_caps.mode ());
+		result.bandwidth_cap = bandwidth_cap.second > 1 ? bandwidth_cap.first : boost::numeric_cast<decltype (result.bandwidth_cap)> (mean (bandwidth_cap_index));
+		result.protocol_version = protocol_versions.mode ().first;
+		result.genesis_block = genesis_blocks.mode ().first;
+		auto const version_l (versions.mode ().first);
+		result.major_version = version_l[0];
+		result.minor_version = version_l[1];
+		result.patch_version = version_l[2];
+		result.pre_release_version = version_l[3];
+		result.maker = version_l[4];
+	}
+	return result;
+}
+
+std::vector<std::pair<std::string, nano::telemetry_metric_summary>> nano::telemetry_aggregator::summaries (std::chrono::steady_clock::time_point now_a)
+{
+	purge_expired (now_a);
+	std::vector<std::pair<std::string, nano::telemetry_metric_summary>> result;
+	result.reserve (metric_count);
+	for (size_t i (0); i < metric_count; ++i)
+	{
+		auto const & sketch (sketches[i]);
+		result.emplace_back (metric_names[i], nano::telemetry_metric_summary{ sketch.quantile (0.10), sketch.quantile (0.50), sketch.quantile (0.90), sketch.quantile (0.99), sketch.size () });
+	}
+	return result;
+}
+
+std::vector<nano::telemetry_data> nano::telemetry_aggregator::history (nano::endpoint const & endpoint_a) const
+{
+	std::vector<nano::telemetry_data> result;
+	auto existing (peers.find (endpoint_a));
+	if (existing != peers.end ())
+	{
+		result.assign (existing->second.samples.begin (), existing->second.samples.end ());
+	}
+	return result;
+}
+
+size_t nano::telemetry_aggregator::size () const
+{
+	return peers.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::collect_container_info (telemetry_aggregator & aggregator, std::string const & name)
+{
+	size_t samples (0);
+	for (auto const & peer : aggregator.peers)
+	{
+		samples += peer.second.samples.size ();
+	}
+	size_t buckets (0);
+	for (auto const & sketch : aggregator.sketches)
+	{
+		buckets += sketch.bucket_count ();
+	}
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "peers", aggregator.peers.size (), sizeof (decltype (aggregator.peers)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "samples", samples, sizeof (nano::telemetry_data) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "sketch_buckets", buckets, sizeof (std::pair<int, uint64_t>) }));
+	return composite;
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <nano/lib/utility.hpp>
+#include <nano/node/common.hpp>
+
+#include <boost/circular_buffer.hpp>
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nano
+{
+/*
+ * Log bucketed histogram giving quantiles within a fixed relative error. Memory is bounded by the number of distinct
+ * buckets (logarithmic in the value range) rather than the number of samples, and samples can be removed again.
+ */
+class quantile_sketch final
+{
+public:
+	explicit quantile_sketch (double relative_accuracy = 0.01);
+	void insert (uint64_t);
+	void erase (uint64_t);
+	/** Value at quantile \p q in the range [0, 1], 0 when empty */
+	uint64_t quantile (double q) const;
+	uint64_t size () const;
+	size_t bucket_count () const;
+
+private:
+	int bucket (uint64_t) const;
+	uint64_t value (int) const;
+
+	double gamma;
+	double log_gamma;
+	uint64_t zero_count{ 0 };
+	uint64_t total{ 0 };
+	std::map<int, uint64_t> buckets;
+};
+
+/*
+ * Multiset maintaining the sum of its values excluding a number of the lowest and highest ones, so trimmed means can be
+ * read without walking the values. Values are partitioned into low, kept and high sets, updating is logarithmic in the
+ * number of values plus the change of the trimmed count.
+ */
+class trimmed_sum final
+{
+public:
+	void insert (uint64_t);
+	void erase (uint64_t);
+	/** Excludes the \p trim_a lowest and highest values, or as many as there are */
+	void trim (size_t trim_a);
+	/** Sum of the values not trimmed */
+	nano::uint128_t sum () const;
+	/** Number of values not trimmed */
+	size_t size () const;
+
+private:
+	void rebalance ();
+	size_t trimmed{ 0 };
+	std::multiset<uint64_t> low;
+	std::multiset<uint64_t> kept;
+	std::multiset<uint64_t> high;
+	nano::uint128_t kept_sum{ 0 };
+};
+
+/*
+ * Counts occurrences of values and keeps them ordered by count, so the most frequent value can be read directly.
+ * Ties go to the lowest value.
+ */
+template <typename T>
+class mode_counter final
+{
+public:
+	void insert (T const & value_a)
+	{
+		auto & count (counts[value_a]);
+		if (count > 0)
+		{
+			by_count.erase ({ count, value_a });
+		}
+		by_count.insert ({ ++count, value_a });
+	}
+
+	void erase (T const & value_a)
+	{
+		auto existing (counts.find (value_a));
+		debug_assert (existing != counts.end ());
+		if (existing != counts.end ())
+		{
+			by_count.erase ({ existing->second, value_a });
+			if (--existing->second == 0)
+			{
+				counts.erase (existing);
+			}
+			else
+			{
+				by_count.insert ({ existing->second, value_a });
+			}
+		}
+	}
+
+	/** Most frequent value and its count, the value is default constructed when empty */
+	std::pair<T, size_t> mode () const
+	{
+		std::pair<T, size_t> result{ T{}, 0 };
+		if (!by_count.empty ())
+		{
+			result = { by_count.begin ()->second, by_count.begin ()->first };
+		}
+		return result;
+	}
+
+private:
+	class count_order final
+	{
+	public:
+		bool operator() (std::pair<size_t, T> const & lhs, std::pair<size_t, T> const & rhs) const
+		{
+			return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+		}
+	};
+	std::map<T, size_t> counts;
+	std::set<std::pair<size_t, T>, count_order> by_count;
+};
+
+class telemetry_metric_summary final
+{
+public:
+	uint64_t p10{ 0 };
+	uint64_t p50{ 0 };
+	uint64_t p90{ 0 };
+	uint64_t p99{ 0 };
+	uint64_t samples{ 0 };
+};
+
+/*
+ * Rolling aggregation of telemetry metrics received from peers. Keeps a bounded history per peer, and trimmed sums, mode
+ * counters and quantile sketches over the latest sample of every peer. These are updated in logarithmic time as responses
+ * arrive, so reading the consolidated metrics or quantiles does not walk the peers.
+ * This class is not thread safe, the owner is expected to serialize access.
+ */
+class telemetry_aggregator final
+{
+public:
+	telemetry_aggregator (std::chrono::milliseconds expiry, size_t history_size = 16);
+	void add (nano::endpoint const &, nano::telemetry_data const &, std::chrono::steady_clock::time_point);
+	void erase (nano::endpoint const &);
+	/**
+	 * Same as nano::consolidate_telemetry_data over the latest, non-expired sample of each peer, except that ties between
+	 * the most frequent versions, genesis blocks or bandwidth caps go to the lowest value
+	 */
+	nano::telemetry_data consolidated (std::chrono::steady_clock::time_point);
+	std::vector<std::pair<std::string, nano::telemetry_metric_summary>> summaries (std::chrono::steady_clock::time_point);
+	/** Past samples of a peer, oldest first */
+	std::vector<nano::telemetry_data> history (nano::endpoint const &) const;
+	size_t size () const;
+
+	static size_t constexpr metric_count = 8;
+
+private:
+	class peer_entry final
+	{
+	public:
+		explicit peer_entry (size_t);
+		boost::circular_buffer<nano::telemetry_data> samples;
+		std::chrono::steady_clock::time_point last_update;
+	};
+
+	void insert_metrics (nano::telemetry_data const &);
+	void erase_metrics (nano::telemetry_data const &);
+	void purge_expired (std::chrono::steady_clock::time_point);
+	/** Trims the sums to the lowest and highest tenth of the peers, as nano::consolidate_telemetry_data does */
+	void retrim ();
+	static std::array<uint64_t, metric_count> metric_values (nano::telemetry_data const &);
+	static std::array<uint8_t, 5> version (nano::telemetry_data const &);
+
+	std::chrono::milliseconds const expiry;
+	size_t const history_size;
+	std::unordered_map<nano::endpoint, peer_entry> peers;
+	std::array<nano::quantile_sketch, metric_count> sketches;
+	std::array<nano::trimmed_sum, metric_count> sums;
+	nano::trimmed_sum timestamps;
+	nano::mode_counter<uint64_t> bandwidth_caps;
+	nano::mode_counter<uint8_t> protocol_versions;
+	nano::mode_counter<nano::block_hash> genesis_blocks;
+	nano::mode_counter<std::array<uint8_t, 5>> versions;
+	std::chrono::steady_clock::time_point oldest_update{ std::chrono::steady_clock::time_point::max () };
+
+	friend std::unique_ptr<nano::container_info_component> collect_container_info (telemetry_aggregator &, std::string const &);
+};
+
+std::unique_ptr<nano::container_info_component> collect_container_info (telemetry_aggregator & aggregator, std::string const & name);
+}
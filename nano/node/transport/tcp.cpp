@@ -1,6 +1,7 @@
 #include <nano/lib/stats.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/transport/tcp.hpp>
+#include <nano/node/xorshift.hpp>
 
 #include <boost/format.hpp>
 
@@ -45,32 +46,30 @@ bool nano::transport::channel_tcp::operator== (nano::transport::channel const &
 	return result;
 }
 
-void nano::transport::channel_tcp::send_buffer (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy policy_a)
+void nano::transport::channel_tcp::send_buffer (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy policy_a, nano::write_priority priority_a)
 {
 	if (auto socket_l = socket.lock ())
 	{
-		if (!socket_l->max () || (policy_a == nano::buffer_drop_policy::no_socket_drop && !socket_l->full ()))
-		{
-			socket_l->async_write (
-			buffer_a, [endpoint_a = socket_l->remote_endpoint (), node = std::weak_ptr<nano::node> (node.shared ()), callback_a] (boost::system::error_code const & ec, size_t size_a) {
-				if (auto node_l = node.lock ())
+		auto queued (socket_l->try_async_write (
+		buffer_a, [endpoint_a = socket_l->remote_endpoint (), node = std::weak_ptr<nano::node> (node.shared ()), callback_a] (boost::system::error_code const & ec, size_t size_a) {
+			if (auto node_l = node.lock ())
+			{
+				if (!ec)
 				{
-					if (!ec)
-					{
-						node_l->network.tcp_channels.update (endpoint_a);
-					}
-					if (ec == boost::system::errc::host_unreachable)
-					{
-						node_l->stats.inc (nano::stat::type::error, nano::stat::detail::unreachable_host, nano::stat::dir::out);
-					}
-					if (callback_a)
-					{
-						callback_a (ec, size_a);
-					}
+					node_l->network.tcp_channels.update (endpoint_a);
 				}
-			});
-		}
-		else
+				if (ec == boost::system::errc::host_unreachable)
+				{
+					node_l->stats.inc (nano::stat::type::error, nano::stat::detail::unreachable_host, nano::stat::dir::out);
+				}
+				if (callback_a)
+				{
+					callback_a (ec, size_a);
+				}
+			}
+		},
+		policy_a, priority_a));
+		if (!queued)
 		{
 			if (policy_a == nano::buffer_drop_policy::no_socket_drop)
 			{
@@ -110,6 +109,15 @@ void nano::transport::channel_tcp::set_endpoint ()
 	}
 }
 
+std::pair<nano::transport::channels_snapshot::const_iterator, nano::transport::channels_snapshot::const_iterator> nano::transport::channels_snapshot::range (uint8_t minimum_version_a, bool include_temporary_channels_a) const
+{
+	auto const & entries (include_temporary_channels_a ? all : permanent);
+	auto begin (std::lower_bound (entries.begin (), entries.end (), minimum_version_a, [] (entry const & entry_a, uint8_t version_a) {
+		return entry_a.network_version < version_a;
+	}));
+	return { begin, entries.end () };
+}
+
 nano::transport::tcp_channels::tcp_channels (nano::node & node, std::function<void (nano::message const &, std::shared_ptr<nano::transport::channel> const &)> sink) :
 	node{ node },
 	sink{ sink }
@@ -135,6 +143,7 @@ bool nano::transport::tcp_channels::insert (std::shared_ptr<nano::transport::cha
 			}
 			channels.get<endpoint_tag> ().emplace (channel_a, socket_a, bootstrap_server_a);
 			attempts.get<endpoint_tag> ().erase (endpoint);
+			update_snapshot ();
 			error = false;
 			lock.unlock ();
 			node.network.channel_observer (channel_a);
@@ -150,7 +159,10 @@ bool nano::transport::tcp_channels::insert (std::shared_ptr<nano::transport::cha
 void nano::transport::tcp_channels::erase (nano::tcp_endpoint const & endpoint_a)
 {
 	nano::lock_guard<nano::mutex> lock (mutex);
-	channels.get<endpoint_tag> ().erase (endpoint_a);
+	if (channels.get<endpoint_tag> ().erase (endpoint_a) > 0)
+	{
+		update_snapshot ();
+	}
 }
 
 size_t nano::transport::tcp_channels::size () const
@@ -174,24 +186,20 @@ std::shared_ptr<nano::transport::channel_tcp> nano::transport::tcp_channels::fin
 std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::transport::tcp_channels::random_set (size_t count_a, uint8_t min_version, bool include_temporary_channels_a) const
 {
 	std::unordered_set<std::shared_ptr<nano::transport::channel>> result;
-	result.reserve (count_a);
-	nano::lock_guard<nano::mutex> lock (mutex);
-	// Stop trying to fill result with random samples after this many attempts
-	auto random_cutoff (count_a * 2);
-	auto peers_size (channels.size ());
-	// Usually count_a will be much smaller than peers.size()
-	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
-	{
-		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
+	auto snapshot_l (snapshot ());
+	auto [begin, end] = snapshot_l->range (min_version, include_temporary_channels_a);
+	size_t const size (std::distance (begin, end));
+	auto const count (std::min (count_a, size));
+	result.reserve (count);
+	auto & random (nano::thread_xorshift ());
+	// Floyd's algorithm, picks count distinct channels with exactly count draws
+	for (auto i (size - count); i < size; ++i)
+	{
+		auto index (random.next () % (i + 1));
+		if (!result.insert (begin[index].channel).second)
 		{
-			auto index (nano::random_pool::generate_word32 (0, static_cast<CryptoPP::word32> (peers_size - 1)));
-
-			auto channel = channels.get<random_access_tag> ()[index].channel;
-			if (channel->get_network_version () >= min_version && (include_temporary_channels_a || !channel->temporary))
-			{
-				result.insert (channel);
-			}
+			// Every channel picked so far has an index below i
+			result.insert (begin[i].channel);
 		}
 	}
 	return result;
@@ -277,6 +285,32 @@ nano::tcp_endpoint nano::transport::tcp_channels::bootstrap_peer (uint8_t connec
 	return result;
 }
 
+std::vector<nano::tcp_endpoint> nano::transport::tcp_channels::bootstrap_peers (uint8_t connection_protocol_version_min, size_t count_a, std::function<bool (nano::tcp_endpoint const &)> const & filter_a) const
+{
+	std::vector<nano::tcp_endpoint> result;
+	nano::lock_guard<nano::mutex> lock (mutex);
+	for (auto i (channels.get<last_bootstrap_attempt_tag> ().begin ()), n (channels.get<last_bootstrap_attempt_tag> ().end ()); i != n && result.size () < count_a; ++i)
+	{
+		if (i->channel->get_network_version () >= connection_protocol_version_min && filter_a (i->endpoint ()))
+		{
+			result.push_back (i->endpoint ());
+		}
+	}
+	return result;
+}
+
+void nano::transport::tcp_channels::bootstrap_attempted (nano::tcp_endpoint const & endpoint_a)
+{
+	nano::lock_guard<nano::mutex> lock (mutex);
+	auto existing (channels.get<endpoint_tag> ().find (endpoint_a));
+	if (existing != channels.get<endpoint_tag> ().end ())
+	{
+		channels.get<endpoint_tag> ().modify (existing, [] (channel_tcp_wrapper & wrapper_a) {
+			wrapper_a.channel->set_last_bootstrap_attempt (std::chrono::steady_clock::now ());
+		});
+	}
+}
+
 void nano::transport::tcp_channels::process_messages ()
 {
 	while (!stopped)
@@ -363,6 +397,7 @@ void nano::transport::tcp_channels::stop ()
 		}
 	}
 	channels.clear ();
+	update_snapshot ();
 	node_id_handshake_sockets.clear ();
 }
 
@@ -435,6 +470,7 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 	// Check if any tcp channels belonging to old protocol versions which may still be alive due to async operations
 	auto lower_bound = channels.get<version_tag> ().lower_bound (node.network_params.protocol.protocol_version_min ());
 	channels.get<version_tag> ().erase (channels.get<version_tag> ().begin (), lower_bound);
+	update_snapshot ();
 
 	// Cleanup any sockets which may still be existing from failed node id handshakes
 	node_id_handshake_sockets.erase (std::remove_if (node_id_handshake_sockets.begin (), node_id_handshake_sockets.end (), [this] (auto socket) {
@@ -448,6 +484,7 @@ void nano::transport::tcp_channels::ongoing_keepalive ()
 	nano::keepalive message;
 	node.network.random_fill (message.peers);
 	nano::unique_lock<nano::mutex> lock (mutex);
+	update_snapshot ();
 	// Wake up channels
 	std::vector<std::shared_ptr<nano::transport::channel_tcp>> send_list;
 	auto keepalive_sent_cutoff (channels.get<last_packet_sent_tag> ().lower_bound (std::chrono::steady_clock::now () - node.network_params.node.period));
@@ -498,12 +535,9 @@ void nano::transport::tcp_channels::list_below_version (std::vector<std::shared_
 
 void nano::transport::tcp_channels::list (std::deque<std::shared_ptr<nano::transport::channel>> & deque_a, uint8_t minimum_version_a, bool include_temporary_channels_a)
 {
-	nano::lock_guard<nano::mutex> lock (mutex);
-	// clang-format off
-	nano::transform_if (channels.get<random_access_tag> ().begin (), channels.get<random_access_tag> ().end (), std::back_inserter (deque_a),
-		[include_temporary_channels_a, minimum_version_a](auto & channel_a) { return channel_a.channel->get_network_version () >= minimum_version_a && (include_temporary_channels_a || !channel_a.channel->temporary); },
-		[](const auto & channel) { return channel.channel; });
-	// clang-format on
+	auto snapshot_l (snapshot ());
+	auto [begin, end] = snapshot_l->range (minimum_version_a, include_temporary_channels_a);
+	std::transform (begin, end, std::back_inserter (deque_a), [] (nano::transport::channels_snapshot::entry const & entry_a) { return entry_a.channel; });
 }
 
 void nano::transport::tcp_channels::modify (std::shared_ptr<nano::transport::channel_tcp> const & channel_a, std::function<void (std::shared_ptr<nano::transport::channel_tcp> const &)> modify_callback_a)
@@ -515,6 +549,8 @@ void nano::transport::tcp_channels::modify (std::shared_ptr<nano::transport::cha
 		channels.get<endpoint_tag> ().modify (existing, [modify_callback_a] (channel_tcp_wrapper & wrapper_a) {
 			modify_callback_a (wrapper_a.channel);
 		});
+		// The callback may change fields the snapshot is partitioned by, such as temporary or network version
+		update_snapshot ();
 	}
 }
 
@@ -530,6 +566,28 @@ void nano::transport::tcp_channels::update (nano::tcp_endpoint const & endpoint_
 	}
 }
 
+std::shared_ptr<nano::transport::channels_snapshot const> nano::transport::tcp_channels::snapshot () const
+{
+	return std::atomic_load (&snapshot_m);
+}
+
+void nano::transport::tcp_channels::update_snapshot ()
+{
+	auto snapshot_l (std::make_shared<nano::transport::channels_snapshot> ());
+	snapshot_l->all.reserve (channels.size ());
+	for (auto const & wrapper : channels.get<random_access_tag> ())
+	{
+		snapshot_l->all.push_back ({ wrapper.channel->get_network_version (), wrapper.channel });
+	}
+	std::sort (snapshot_l->all.begin (), snapshot_l->all.end (), [] (auto const & lhs, auto const & rhs) {
+		return lhs.network_version < rhs.network_version;
+	});
+	std::copy_if (snapshot_l->all.begin (), snapshot_l->all.end (), std::back_inserter (snapshot_l->permanent), [] (auto const & entry_a) {
+		return !entry_a.channel->temporary;
+	});
+	std::atomic_store (&snapshot_m, std::shared_ptr<nano::transport::channels_snapshot const> (std::move (snapshot_l)));
+}
+
 bool nano::transport::tcp_channels::node_id_handhake_sockets_empty () const
 {
 	nano::lock_guard<nano::mutex> guard (mutex);
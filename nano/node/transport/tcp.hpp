@@ -11,6 +11,7 @@
 #include <boost/multi_index_container.hpp>
 
 #include <unordered_set>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -37,7 +38,7 @@ namespace transport
 		~channel_tcp ();
 		size_t hash_code () const override;
 		bool operator== (nano::transport::channel const &) const override;
-		void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter) override;
+		void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter, nano::write_priority = nano::write_priority::normal) override;
 		std::string to_string () const override;
 		bool operator== (nano::transport::channel_tcp const & other_a) const
 		{
@@ -70,6 +71,28 @@ namespace transport
 	private:
 		nano::tcp_endpoint endpoint{ boost::asio::ip::address_v6::any (), 0 };
 	};
+	/**
+	 * Immutable view of the tcp channels grouped by temporary flag and sorted by protocol version, so channels can be sampled
+	 * or listed without taking the channels mutex. A new snapshot is published whenever channels are added or removed and
+	 * it is refreshed periodically to pick up version changes.
+	 */
+	class channels_snapshot final
+	{
+	public:
+		class entry final
+		{
+		public:
+			uint8_t network_version;
+			std::shared_ptr<nano::transport::channel_tcp> channel;
+		};
+		using const_iterator = std::vector<entry>::const_iterator;
+		/** Channels with at least \p minimum_version_a from the permanent or all channels */
+		std::pair<const_iterator, const_iterator> range (uint8_t minimum_version_a, bool include_temporary_channels_a) const;
+		/** Non temporary channels by ascending network version */
+		std::vector<entry> permanent;
+		/** All channels by ascending network version */
+		std::vector<entry> all;
+	};
 	class tcp_channels final
 	{
 		friend class nano::transport::channel_tcp;
@@ -87,6 +110,9 @@ namespace transport
 		std::shared_ptr<nano::transport::channel_tcp> find_node_id (nano::account const &);
 		// Get the next peer for attempting a tcp connection
 		nano::tcp_endpoint bootstrap_peer (uint8_t connection_protocol_version_min);
+		// Peers accepted by filter, least recently attempted first, without marking them as attempted. filter_a is called with the mutex held
+		std::vector<nano::tcp_endpoint> bootstrap_peers (uint8_t connection_protocol_version_min, size_t count_a, std::function<bool (nano::tcp_endpoint const &)> const & filter_a) const;
+		void bootstrap_attempted (nano::tcp_endpoint const &);
 		void receive ();
 		void start ();
 		void stop ();
@@ -109,9 +135,13 @@ namespace transport
 		void push_node_id_handshake_socket (std::shared_ptr<nano::socket> const & socket_a);
 		void remove_node_id_handshake_socket (std::shared_ptr<nano::socket> const & socket_a);
 		bool node_id_handhake_sockets_empty () const;
+		/** Current channels snapshot, never null */
+		std::shared_ptr<nano::transport::channels_snapshot const> snapshot () const;
 		nano::node & node;
 
 	private:
+		/** Publishes a new snapshot of channels, mutex must be held */
+		void update_snapshot ();
 		std::function<void (nano::message const &, std::shared_ptr<nano::transport::channel> const &)> sink;
 		class endpoint_tag
 		{
@@ -231,6 +261,8 @@ namespace transport
 		// clang-format on
 		// This owns the sockets until the node_id_handshake has been completed. Needed to prevent self referencing callbacks, they are periodically removed if any are dangling.
 		std::vector<std::shared_ptr<nano::socket>> node_id_handshake_sockets;
+		/** Latest snapshot of channels, accessed with atomic shared_ptr operations */
+		std::shared_ptr<nano::transport::channels_snapshot const> snapshot_m{ std::make_shared<nano::transport::channels_snapshot> () };
 		std::atomic<bool> stopped{ false };
 
 		friend class network_peer_max_tcp_attempts_subnetwork_Test;
@@ -6,57 +6,40 @@
 
 #include <numeric>
 
-namespace
+nano::stat::detail nano::transport::message_detail (nano::message const & message_a)
 {
-class callback_visitor : public nano::message_visitor
+	return message_detail (message_a.header.type);
+}
+
+nano::stat::detail nano::transport::message_detail (nano::message_type type_a)
 {
-public:
-	void keepalive (nano::keepalive const & message_a) override
-	{
-		result = nano::stat::detail::keepalive;
-	}
-	void publish (nano::publish const & message_a) override
-	{
-		result = nano::stat::detail::publish;
-	}
-	void confirm_req (nano::confirm_req const & message_a) override
-	{
-		result = nano::stat::detail::confirm_req;
-	}
-	void confirm_ack (nano::confirm_ack const & message_a) override
-	{
-		result = nano::stat::detail::confirm_ack;
-	}
-	void bulk_pull (nano::bulk_pull const & message_a) override
-	{
-		result = nano::stat::detail::bulk_pull;
-	}
-	void bulk_pull_account (nano::bulk_pull_account const & message_a) override
+	switch (type_a)
 	{
-		result = nano::stat::detail::bulk_pull_account;
+		case nano::message_type::keepalive:
+			return nano::stat::detail::keepalive;
+		case nano::message_type::publish:
+			return nano::stat::detail::publish;
+		case nano::message_type::confirm_req:
+			return nano::stat::detail::confirm_req;
+		case nano::message_type::confirm_ack:
+			return nano::stat::detail::confirm_ack;
+		case nano::message_type::bulk_pull:
+			return nano::stat::detail::bulk_pull;
+		case nano::message_type::bulk_pull_account:
+			return nano::stat::detail::bulk_pull_account;
+		case nano::message_type::bulk_push:
+			return nano::stat::detail::bulk_push;
+		case nano::message_type::frontier_req:
+			return nano::stat::detail::frontier_req;
+		case nano::message_type::node_id_handshake:
+			return nano::stat::detail::node_id_handshake;
+		case nano::message_type::telemetry_req:
+			return nano::stat::detail::telemetry_req;
+		case nano::message_type::telemetry_ack:
+			return nano::stat::detail::telemetry_ack;
+		default:
+			return nano::stat::detail::all;
 	}
-	void bulk_push (nano::bulk_push const & message_a) override
-	{
-		result = nano::stat::detail::bulk_push;
-	}
-	void frontier_req (nano::frontier_req const & message_a) override
-	{
-		result = nano::stat::detail::frontier_req;
-	}
-	void node_id_handshake (nano::node_id_handshake const & message_a) override
-	{
-		result = nano::stat::detail::node_id_handshake;
-	}
-	void telemetry_req (nano::telemetry_req const & message_a) override
-	{
-		result = nano::stat::detail::telemetry_req;
-	}
-	void telemetry_ack (nano::telemetry_ack const & message_a) override
-	{
-		result = nano::stat::detail::telemetry_ack;
-	}
-	nano::stat::detail result;
-};
 }
 
 nano::endpoint nano::transport::map_endpoint_to_v6 (nano::endpoint const & endpoint_a)
@@ -102,15 +85,13 @@ nano::transport::channel::channel (nano::node & node_a) :
 
 void nano::transport::channel::send (nano::message const & message_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a)
 {
-	callback_visitor visitor;
-	message_a.visit (visitor);
 	auto buffer (message_a.to_shared_const_buffer ());
-	auto detail (visitor.result);
+	auto detail (message_detail (message_a));
 	auto is_droppable_by_limiter = drop_policy_a == nano::buffer_drop_policy::limiter;
 	auto should_drop (node.network.limiter.should_drop (buffer.size ()));
 	if (!is_droppable_by_limiter || !should_drop)
 	{
-		send_buffer (buffer, callback_a, drop_policy_a);
+		send_buffer (buffer, callback_a, drop_policy_a, nano::transport::write_priority (message_a.header.type));
 		node.stats.inc (nano::stat::type::message, detail, nano::stat::dir::out);
 	}
 	else
@@ -149,7 +130,7 @@ bool nano::transport::channel_loopback::operator== (nano::transport::channel con
 	return endpoint == other_a.get_endpoint ();
 }
 
-void nano::transport::channel_loopback::send_buffer (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a)
+void nano::transport::channel_loopback::send_buffer (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a, nano::write_priority priority_a)
 {
 	release_assert (false && "sending to a loopback channel is not supported");
 }
@@ -278,6 +259,11 @@ bool nano::bandwidth_limiter::should_drop (const size_t & message_size_a)
 	return !bucket.try_consume (nano::narrow_cast<unsigned int> (message_size_a));
 }
 
+size_t nano::bandwidth_limiter::allowance (size_t message_size_a, size_t count_a)
+{
+	return bucket.try_consume_many (nano::narrow_cast<unsigned int> (message_size_a), count_a);
+}
+
 void nano::bandwidth_limiter::reset (const double limit_burst_ratio_a, const size_t limit_a)
 {
 	bucket.reset (static_cast<size_t> (limit_a * limit_burst_ratio_a), limit_a);
@@ -16,6 +16,8 @@ public:
 	// initialize with limit 0 = unbounded
 	bandwidth_limiter (const double, const size_t);
 	bool should_drop (const size_t &);
+	/** Number of the \p count_a copies of a \p message_size_a byte message that can be sent without exceeding the limit */
+	size_t allowance (size_t message_size_a, size_t count_a);
 	void reset (const double, const size_t);
 
 private:
@@ -32,6 +34,11 @@ namespace transport
 	boost::asio::ip::address ipv4_address_or_ipv6_subnet (boost::asio::ip::address const &);
 	// Unassigned, reserved, self
 	bool reserved_address (nano::endpoint const &, bool = false);
+	/** Statistics detail counting messages of the type of \p message_a */
+	nano::stat::detail message_detail (nano::message const &);
+	nano::stat::detail message_detail (nano::message_type);
+	/** Votes and vote requests are written ahead of other traffic queued on the same socket, flooded blocks last */
+	nano::write_priority write_priority (nano::message_type);
 	static std::chrono::seconds constexpr syn_cookie_cutoff = std::chrono::seconds (5);
 	enum class transport_type : uint8_t
 	{
@@ -48,7 +55,7 @@ namespace transport
 		virtual size_t hash_code () const = 0;
 		virtual bool operator== (nano::transport::channel const &) const = 0;
 		void send (nano::message const & message_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a = nullptr, nano::buffer_drop_policy policy_a = nano::buffer_drop_policy::limiter);
-		virtual void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter) = 0;
+		virtual void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter, nano::write_priority = nano::write_priority::normal) = 0;
 		virtual std::string to_string () const = 0;
 		virtual nano::endpoint get_endpoint () const = 0;
 		virtual nano::tcp_endpoint get_tcp_endpoint () const = 0;
@@ -144,7 +151,7 @@ namespace transport
 		channel_loopback (nano::node &);
 		size_t hash_code () const override;
 		bool operator== (nano::transport::channel const &) const override;
-		void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter) override;
+		void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter, nano::write_priority = nano::write_priority::normal) override;
 		std::string to_string () const override;
 		bool operator== (nano::transport::channel_loopback const & other_a) const
 		{
@@ -2,11 +2,29 @@
 #include <nano/boost/asio/dispatch.hpp>
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/stats.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/node/node.hpp>
 #include <nano/node/transport/udp.hpp>
 
 #include <boost/format.hpp>
 
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/socket.h>
+#endif
+
+namespace
+{
+#if defined(__linux__)
+bool constexpr batched_io_supported = true;
+#else
+bool constexpr batched_io_supported = false;
+#endif
+}
+
 nano::transport::channel_udp::channel_udp (nano::transport::udp_channels & channels_a, nano::endpoint const & endpoint_a, uint8_t protocol_version_a) :
 	channel (channels_a.node),
 	endpoint (endpoint_a),
@@ -33,7 +51,7 @@ bool nano::transport::channel_udp::operator== (nano::transport::channel const &
 	return result;
 }
 
-void nano::transport::channel_udp::send_buffer (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a)
+void nano::transport::channel_udp::send_buffer (nano::shared_const_buffer const & buffer_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a, nano::buffer_drop_policy drop_policy_a, nano::write_priority priority_a)
 {
 	set_last_packet_sent (std::chrono::steady_clock::now ());
 	channels.send (buffer_a, endpoint, [node = std::weak_ptr<nano::node> (channels.node.shared ()), callback_a] (boost::system::error_code const & ec, size_t size_a) {
@@ -63,8 +81,9 @@ std::string nano::transport::channel_udp::to_string () const
 
 nano::transport::udp_channels::udp_channels (nano::node & node_a, uint16_t port_a, std::function<void (nano::message const &, std::shared_ptr<nano::transport::channel> const &)> sink) :
 	node{ node_a },
-	strand{ node_a.io_ctx.get_executor () },
-	sink{ sink }
+	sink{ sink },
+	batched_io{ batched_io_supported && node_a.config.udp_batched_io },
+	strand{ node_a.io_ctx.get_executor () }
 {
 	if (!node.flags.disable_udp)
 	{
@@ -86,14 +105,95 @@ nano::transport::udp_channels::udp_channels (nano::node & node_a, uint16_t port_
 
 void nano::transport::udp_channels::send (nano::shared_const_buffer const & buffer_a, nano::endpoint endpoint_a, std::function<void (boost::system::error_code const &, size_t)> const & callback_a)
 {
-	boost::asio::post (strand,
-	[this, buffer_a, endpoint_a, callback_a] () {
-		if (!this->stopped)
+	if (batched_io)
+	{
+		bool schedule (false);
 		{
-			this->socket->async_send_to (buffer_a, endpoint_a,
-			boost::asio::bind_executor (strand, callback_a));
+			nano::lock_guard<nano::mutex> lock (send_mutex);
+			send_queue.push_back (send_item{ buffer_a, endpoint_a, callback_a });
+			schedule = !sending;
+			sending = true;
 		}
-	});
+		if (schedule)
+		{
+			// Datagrams queued by the same flood while this is pending go out in the same system call
+			boost::asio::post (strand, [this] () {
+				send_queued ();
+			});
+		}
+	}
+	else
+	{
+		boost::asio::post (strand,
+		[this, buffer_a, endpoint_a, callback_a] () {
+			if (!this->stopped)
+			{
+				this->socket->async_send_to (buffer_a, endpoint_a,
+				boost::asio::bind_executor (strand, callback_a));
+			}
+		});
+	}
+}
+
+void nano::transport::udp_channels::send_queued ()
+{
+	std::vector<send_item> items;
+	items.reserve (batch_size);
+	auto more (false);
+	{
+		nano::lock_guard<nano::mutex> lock (send_mutex);
+		while (!send_queue.empty () && items.size () < batch_size)
+		{
+			items.push_back (std::move (send_queue.front ()));
+			send_queue.pop_front ();
+		}
+		more = !send_queue.empty ();
+		sending = more;
+	}
+	if (!stopped)
+	{
+		size_t sent (0);
+#if defined(__linux__)
+		std::array<mmsghdr, batch_size> headers{};
+		std::array<iovec, batch_size> iovecs{};
+		for (size_t i (0); i < items.size (); ++i)
+		{
+			auto & item (items[i]);
+			debug_assert (std::distance (item.buffer.begin (), item.buffer.end ()) == 1);
+			iovecs[i].iov_base = const_cast<void *> (item.buffer.begin ()->data ());
+			iovecs[i].iov_len = item.buffer.begin ()->size ();
+			headers[i].msg_hdr.msg_name = item.endpoint.data ();
+			headers[i].msg_hdr.msg_namelen = static_cast<socklen_t> (item.endpoint.size ());
+			headers[i].msg_hdr.msg_iov = &iovecs[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+		}
+		auto const result (::sendmmsg (socket->native_handle (), headers.data (), static_cast<unsigned> (items.size ()), MSG_DONTWAIT));
+		if (result > 0)
+		{
+			sent = static_cast<size_t> (result);
+			node.stats.inc (nano::stat::type::udp, nano::stat::detail::batch_syscall, nano::stat::dir::out);
+			node.stats.add (nano::stat::type::udp, nano::stat::detail::batch_packets, nano::stat::dir::out, sent);
+			for (size_t i (0); i < sent; ++i)
+			{
+				if (items[i].callback)
+				{
+					items[i].callback (boost::system::error_code{}, headers[i].msg_len);
+				}
+			}
+		}
+#endif
+		// Whatever the socket did not take right away is sent through asio, which waits for the socket and reports errors
+		for (auto i (items.begin () + sent), n (items.end ()); i != n; ++i)
+		{
+			socket->async_send_to (i->buffer, i->endpoint, boost::asio::bind_executor (strand, i->callback));
+		}
+	}
+	if (more)
+	{
+		boost::asio::post (strand, [this] () {
+			send_queued ();
+		});
+	}
 }
 
 std::shared_ptr<nano::transport::channel_udp> nano::transport::udp_channels::insert (nano::endpoint const & endpoint_a, unsigned network_version_a)
@@ -313,20 +413,103 @@ void nano::transport::udp_channels::receive ()
 void nano::transport::udp_channels::start ()
 {
 	debug_assert (!node.flags.disable_udp);
-	for (size_t i = 0; i < node.config.io_threads && !stopped; ++i)
+	if (batched_io)
 	{
-		boost::asio::post (strand, [this] () {
-			receive ();
+		reader_thread = std::thread ([this] () {
+			run_reader ();
 		});
 	}
+	else
+	{
+		for (size_t i = 0; i < node.config.io_threads && !stopped; ++i)
+		{
+			boost::asio::post (strand, [this] () {
+				receive ();
+			});
+		}
+	}
 	ongoing_keepalive ();
 }
 
+void nano::transport::udp_channels::run_reader ()
+{
+	nano::thread_role::set (nano::thread_role::name::udp_reader);
+#if defined(__linux__)
+	auto const descriptor (socket->native_handle ());
+	// Buffers are held across iterations until a datagram has been received into them
+	std::array<nano::message_buffer *, batch_size> buffers{};
+	std::array<mmsghdr, batch_size> headers{};
+	std::array<iovec, batch_size> iovecs{};
+	while (!stopped)
+	{
+		pollfd poll_descriptor{ descriptor, POLLIN, 0 };
+		// Wake up periodically to notice stop ()
+		if (::poll (&poll_descriptor, 1, 100) > 0 && !stopped)
+		{
+			size_t count (0);
+			for (; count < batch_size; ++count)
+			{
+				auto & data (buffers[count]);
+				if (data == nullptr)
+				{
+					data = node.network.buffer_container.allocate ();
+					if (data == nullptr)
+					{
+						// The buffer container was stopped
+						break;
+					}
+				}
+				iovecs[count].iov_base = data->buffer;
+				iovecs[count].iov_len = nano::network::buffer_size;
+				headers[count].msg_hdr.msg_name = data->endpoint.data ();
+				headers[count].msg_hdr.msg_namelen = static_cast<socklen_t> (data->endpoint.capacity ());
+				headers[count].msg_hdr.msg_iov = &iovecs[count];
+				headers[count].msg_hdr.msg_iovlen = 1;
+			}
+			auto const received (count > 0 ? ::recvmmsg (descriptor, headers.data (), static_cast<unsigned> (count), MSG_DONTWAIT, nullptr) : -1);
+			if (received > 0)
+			{
+				node.stats.inc (nano::stat::type::udp, nano::stat::detail::batch_syscall, nano::stat::dir::in);
+				node.stats.add (nano::stat::type::udp, nano::stat::detail::batch_packets, nano::stat::dir::in, static_cast<uint64_t> (received));
+				for (auto i (0); i < received; ++i)
+				{
+					auto data (buffers[i]);
+					data->size = headers[i].msg_len;
+					data->endpoint.resize (headers[i].msg_hdr.msg_namelen);
+					node.network.buffer_container.enqueue (data);
+					buffers[i] = nullptr;
+				}
+			}
+			else if (count > 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			{
+				if (node.config.logging.network_logging ())
+				{
+					node.logger.try_log (boost::str (boost::format ("UDP Receive error: %1%") % std::strerror (errno)));
+				}
+				std::this_thread::sleep_for (std::chrono::milliseconds (100));
+			}
+		}
+	}
+	for (auto data : buffers)
+	{
+		if (data != nullptr)
+		{
+			node.network.buffer_container.release (data);
+		}
+	}
+#endif
+}
+
 void nano::transport::udp_channels::stop ()
 {
 	// Stop and invalidate local endpoint
 	if (!stopped.exchange (true))
 	{
+		// The reader thread must be done with the socket before it is closed
+		if (reader_thread.joinable ())
+		{
+			reader_thread.join ();
+		}
 		nano::lock_guard<nano::mutex> lock (mutex);
 		local_endpoint = nano::endpoint (boost::asio::ip::address_v6::loopback (), 0);
 
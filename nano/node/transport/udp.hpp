@@ -10,7 +10,9 @@
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <deque>
 #include <mutex>
+#include <thread>
 #include <unordered_set>
 
 namespace mi = boost::multi_index;
@@ -29,7 +31,7 @@ namespace transport
 		channel_udp (nano::transport::udp_channels &, nano::endpoint const &, uint8_t protocol_version);
 		size_t hash_code () const override;
 		bool operator== (nano::transport::channel const &) const override;
-		void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter) override;
+		void send_buffer (nano::shared_const_buffer const &, std::function<void (boost::system::error_code const &, size_t)> const & = nullptr, nano::buffer_drop_policy = nano::buffer_drop_policy::limiter, nano::write_priority = nano::write_priority::normal) override;
 		std::string to_string () const override;
 		bool operator== (nano::transport::channel_udp const & other_a) const
 		{
@@ -108,8 +110,24 @@ namespace transport
 		nano::node & node;
 		std::function<void (nano::message const &, std::shared_ptr<nano::transport::channel> const &)> sink;
 
+		/** Whether datagrams are received by a dedicated thread and sent in batches, see nano::node_config::udp_batched_io */
+		bool const batched_io;
+		/** Maximum number of datagrams moved by one recvmmsg or sendmmsg call */
+		static size_t constexpr batch_size = 32;
+
 	private:
 		void close_socket ();
+		/** Receive loop of the reader thread in batched mode */
+		void run_reader ();
+		/** Send queued datagrams in batches, must be called from the strand */
+		void send_queued ();
+		class send_item final
+		{
+		public:
+			nano::shared_const_buffer buffer;
+			nano::endpoint endpoint;
+			std::function<void (boost::system::error_code const &, size_t)> callback;
+		};
 		class endpoint_tag
 		{
 		};
@@ -218,6 +236,11 @@ namespace transport
 		std::unique_ptr<boost::asio::ip::udp::socket> socket;
 		nano::endpoint local_endpoint;
 		std::atomic<bool> stopped{ false };
+		nano::mutex send_mutex;
+		std::deque<send_item> send_queue;
+		/** Set while send_queued is scheduled on the strand */
+		bool sending{ false };
+		std::thread reader_thread;
 	};
 } // namespace transport
 } // namespace nano
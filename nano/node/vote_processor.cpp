@@ -27,6 +27,7 @@ nano::vote_processor::vote_processor (nano::signature_checker & checker_a, nano:
 	ledger (ledger_a),
 	network_params (network_params_a),
 	max_votes (flags_a.vote_processor_capacity),
+	votes ([&rep_crawler_a] (nano::endpoint const & endpoint_a) { return rep_crawler_a.queue_weight (endpoint_a); }),
 	started (false),
 	stopped (false),
 	is_active (false),
@@ -55,8 +56,11 @@ void nano::vote_processor::process_loop ()
 	{
 		if (!votes.empty ())
 		{
-			decltype (votes) votes_l;
-			votes_l.swap (votes);
+			std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes_l;
+			while (!votes.empty () && votes_l.size () < batch_max)
+			{
+				votes_l.push_back (votes.pop ());
+			}
 
 			log_this_iteration = false;
 			if (config.logging.network_logging () && votes_l.size () > 50)
@@ -120,7 +124,7 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote_a, std
 		}
 		if (process)
 		{
-			votes.emplace_back (vote_a, channel_a);
+			votes.push (channel_a->get_endpoint (), std::make_pair (vote_a, channel_a));
 			lock.unlock ();
 			condition.notify_all ();
 			// Lock no longer required
@@ -133,7 +137,7 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote_a, std
 	return !process;
 }
 
-void nano::vote_processor::verify_votes (decltype (votes) const & votes_a)
+void nano::vote_processor::verify_votes (std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> const & votes_a)
 {
 	auto size (votes_a.size ());
 	std::vector<unsigned char const *> messages;
@@ -297,7 +301,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (vo
 	}
 
 	auto composite = std::make_unique<container_info_composite> (name);
-	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (decltype (vote_processor.votes)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "votes", votes_count, sizeof (std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1_count, sizeof (decltype (vote_processor.representatives_1)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2_count, sizeof (decltype (vote_processor.representatives_2)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3_count, sizeof (decltype (vote_processor.representatives_3)::value_type) }));
@@ -2,6 +2,8 @@
 
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/node/common.hpp>
+#include <nano/node/fair_queue.hpp>
 #include <nano/secure/common.hpp>
 
 #include <deque>
@@ -65,7 +67,10 @@ private:
 	nano::ledger & ledger;
 	nano::network_params & network_params;
 	size_t max_votes;
-	std::deque<std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
+	/** Queued votes are processed in weighted round robin order across the channels they arrived from */
+	nano::fair_queue<nano::endpoint, std::pair<std::shared_ptr<nano::vote>, std::shared_ptr<nano::transport::channel>>> votes;
+	/** Maximum number of votes taken from the queue per processing cycle */
+	static size_t constexpr batch_max = 1024;
 	/** Representatives levels for random early detection */
 	std::unordered_set<nano::account> representatives_1;
 	std::unordered_set<nano::account> representatives_2;
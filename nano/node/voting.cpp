@@ -228,6 +228,10 @@ void nano::vote_generator::stop ()
 	{
 		thread.join ();
 	}
+	if (signing_pool)
+	{
+		signing_pool->stop ();
+	}
 }
 
 size_t nano::vote_generator::generate (std::vector<std::shared_ptr<nano::block>> const & blocks_a, std::shared_ptr<nano::transport::channel> const & channel_a)
@@ -297,7 +301,7 @@ void nano::vote_generator::broadcast (nano::unique_lock<nano::mutex> & lock_a)
 	if (!hashes.empty ())
 	{
 		lock_a.unlock ();
-		vote (hashes, roots, [this] (auto const & vote_a) {
+		vote ({ { hashes, roots } }, [this] (auto const & vote_a) {
 			this->broadcast_action (vote_a);
 			this->stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts);
 		});
@@ -309,6 +313,9 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 {
 	lock_a.unlock ();
 	std::unordered_set<std::shared_ptr<nano::vote>> cached_sent;
+	std::unordered_set<nano::root> roots_seen;
+	std::vector<batch_t> batches;
+	size_t generated_hashes (0);
 	auto i (request_a.first.cbegin ());
 	auto n (request_a.first.cend ());
 	while (i != n && !stopped)
@@ -328,9 +335,10 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 					stats.add (nano::stat::type::requests, nano::stat::detail::requests_cached_late_hashes, stat::dir::in, cached_vote->blocks.size ());
 					stats.inc (nano::stat::type::requests, nano::stat::detail::requests_cached_late_votes, stat::dir::in);
 					reply_action (cached_vote, request_a.second);
+					network.coalescer.confirm_ack_sent (*request_a.second, cached_vote->blocks.size ());
 				}
 			}
-			if (cached_votes.empty () && std::find (roots.begin (), roots.end (), root) == roots.end ())
+			if (cached_votes.empty () && roots_seen.insert (root).second)
 			{
 				if (spacing.votable (root, hash))
 				{
@@ -345,34 +353,121 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 		}
 		if (!hashes.empty ())
 		{
-			stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes, stat::dir::in, hashes.size ());
-			vote (hashes, roots, [this, &channel = request_a.second] (std::shared_ptr<nano::vote> const & vote_a) {
-				this->reply_action (vote_a, channel);
-				this->stats.inc (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in);
-			});
+			generated_hashes += hashes.size ();
+			batches.emplace_back (std::move (hashes), std::move (roots));
 		}
 	}
+	if (!batches.empty ())
+	{
+		// Votes for all batches are signed together so they can be signed in parallel
+		stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes, stat::dir::in, generated_hashes);
+		vote (batches, [this, &channel = request_a.second] (std::shared_ptr<nano::vote> const & vote_a) {
+			this->reply_action (vote_a, channel);
+			this->network.coalescer.confirm_ack_sent (*channel, vote_a->blocks.size ());
+			this->stats.inc (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in);
+		});
+	}
 	stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_replies);
 	lock_a.lock ();
 }
 
-void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (std::shared_ptr<nano::vote> const &)> const & action_a)
+void nano::vote_generator::coalesce (request_t & request_a)
+{
+	// Merge queued requests from the same channel so replies carry as many hashes per vote as possible, without waiting for more requests
+	size_t scanned (0);
+	for (auto i (requests.begin ()); i != requests.end () && scanned < max_coalesce_scan && request_a.first.size () < max_coalesce_candidates; ++scanned)
+	{
+		if (i->second == request_a.second)
+		{
+			request_a.first.insert (request_a.first.end (), i->first.begin (), i->first.end ());
+			i = requests.erase (i);
+			stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_replies_coalesced);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void nano::vote_generator::vote (std::vector<batch_t> const & batches_a, std::function<void (std::shared_ptr<nano::vote> const &)> const & action_a)
+{
+	auto votes_l (sign (batches_a));
+	for (size_t i (0), n (batches_a.size ()); i < n; ++i)
+	{
+		auto const & [hashes, roots] = batches_a[i];
+		debug_assert (hashes.size () == roots.size ());
+		for (auto const & vote_l : votes_l[i])
+		{
+			for (size_t j (0), m (hashes.size ()); j != m; ++j)
+			{
+				history.add (roots[j], hashes[j], vote_l);
+				spacing.flag (roots[j], hashes[j]);
+			}
+			action_a (vote_l);
+		}
+	}
+}
+
+std::vector<std::vector<std::shared_ptr<nano::vote>>> nano::vote_generator::sign (std::vector<batch_t> const & batches_a)
 {
-	debug_assert (hashes_a.size () == roots_a.size ());
-	std::vector<std::shared_ptr<nano::vote>> votes_l;
-	wallets.foreach_representative ([this, &hashes_a, &votes_l] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
-		auto timestamp (this->is_final ? std::numeric_limits<uint64_t>::max () : nano::milliseconds_since_epoch ());
-		votes_l.emplace_back (std::make_shared<nano::vote> (pub_a, prv_a, timestamp, hashes_a));
+	std::vector<std::pair<nano::public_key, nano::raw_key>> keys;
+	wallets.foreach_representative ([&keys] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
+		keys.emplace_back (pub_a, prv_a);
 	});
-	for (auto const & vote_l : votes_l)
+	std::vector<std::vector<std::shared_ptr<nano::vote>>> result (batches_a.size (), std::vector<std::shared_ptr<nano::vote>> (keys.size ()));
+	auto const timestamp (is_final ? std::numeric_limits<uint64_t>::max () : nano::milliseconds_since_epoch ());
+	auto const total (batches_a.size () * keys.size ());
+	auto sign_one = [&result, &keys, &batches_a, timestamp] (size_t index_a) {
+		auto const & [pub, prv] = keys[index_a % keys.size ()];
+		result[index_a / keys.size ()][index_a % keys.size ()] = std::make_shared<nano::vote> (pub, prv, timestamp, batches_a[index_a / keys.size ()].first);
+	};
+	if (signing_pool == nullptr && config.vote_signing_threads > 0 && total > 1)
+	{
+		// Started on the first batch needing several signatures, so nodes which do not vote never start these threads
+		signing_pool = std::make_unique<nano::thread_pool> (config.vote_signing_threads, nano::thread_role::name::vote_signing);
+	}
+	if (signing_pool != nullptr && total > 1)
+	{
+		// Signatures are claimed one at a time by the pool threads and this thread, which also guarantees progress if the pool is stopped
+		class signing_state final
+		{
+		public:
+			std::atomic<size_t> next{ 0 };
+			size_t completed{ 0 };
+			nano::mutex mutex;
+			nano::condition_variable condition;
+		};
+		auto state (std::make_shared<signing_state> ());
+		auto work = [state, total, &sign_one] () {
+			for (size_t index; (index = state->next++) < total;)
+			{
+				sign_one (index);
+				{
+					nano::lock_guard<nano::mutex> guard (state->mutex);
+					++state->completed;
+				}
+				state->condition.notify_all ();
+			}
+		};
+		auto const helpers (std::min<size_t> (signing_pool->get_num_threads (), total - 1));
+		for (size_t i (0); i < helpers; ++i)
+		{
+			signing_pool->push_task (work);
+		}
+		work ();
+		nano::unique_lock<nano::mutex> lock (state->mutex);
+		state->condition.wait (lock, [&state, total] () { return state->completed == total; });
+	}
+	else
 	{
-		for (size_t i (0), n (hashes_a.size ()); i != n; ++i)
+		for (size_t i (0); i < total; ++i)
 		{
-			history.add (roots_a[i], hashes_a[i], vote_l);
-			spacing.flag (roots_a[i], hashes_a[i]);
+			sign_one (i);
 		}
-		action_a (vote_l);
 	}
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_votes_signed, nano::stat::dir::in, total);
+	return result;
 }
 
 void nano::vote_generator::broadcast_action (std::shared_ptr<nano::vote> const & vote_a) const
@@ -400,6 +495,7 @@ void nano::vote_generator::run ()
 		{
 			auto request (requests.front ());
 			requests.pop_front ();
+			coalesce (request);
 			reply (lock, std::move (request));
 		}
 		else
@@ -2,6 +2,7 @@
 
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/threading.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/wallet.hpp>
 #include <nano/secure/common.hpp>
@@ -118,6 +119,7 @@ class vote_generator final
 private:
 	using candidate_t = std::pair<nano::root, nano::block_hash>;
 	using request_t = std::pair<std::vector<candidate_t>, std::shared_ptr<nano::transport::channel>>;
+	using batch_t = std::pair<std::vector<nano::block_hash>, std::vector<nano::root>>;
 
 public:
 	vote_generator (nano::node_config const & config_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::local_vote_history & history_a, nano::network & network_a, nano::stat & stats_a, bool is_final_a);
@@ -132,7 +134,12 @@ private:
 	void run ();
 	void broadcast (nano::unique_lock<nano::mutex> &);
 	void reply (nano::unique_lock<nano::mutex> &, request_t &&);
-	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (std::shared_ptr<nano::vote> const &)> const &);
+	/** Merge queued requests from the same channel into \p request_a, mutex must be held */
+	void coalesce (request_t & request_a);
+	/** Vote for every batch, signing them in parallel */
+	void vote (std::vector<batch_t> const &, std::function<void (std::shared_ptr<nano::vote> const &)> const &);
+	/** Sign a vote for each batch with every local representative */
+	std::vector<std::vector<std::shared_ptr<nano::vote>>> sign (std::vector<batch_t> const &);
 	void broadcast_action (std::shared_ptr<nano::vote> const &) const;
 	std::function<void (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> &)> reply_action; // must be set only during initialization by using set_reply_action
 	nano::node_config const & config;
@@ -146,11 +153,15 @@ private:
 	mutable nano::mutex mutex;
 	nano::condition_variable condition;
 	static size_t constexpr max_requests{ 2048 };
+	static size_t constexpr max_coalesce_scan{ 64 };
+	static size_t constexpr max_coalesce_candidates{ 96 }; // Eight full confirm_ack messages
 	std::deque<request_t> requests;
 	std::deque<candidate_t> candidates;
 	nano::network_params network_params;
 	std::atomic<bool> stopped{ false };
 	bool started{ false };
+	/** Signs votes in parallel when a batch needs several signatures, created by the generator thread the first time one does */
+	std::unique_ptr<nano::thread_pool> signing_pool;
 	std::thread thread;
 	bool is_final;
 
@@ -1,5 +1,9 @@
 #pragma once
+
+#include <nano/crypto_lib/random_pool.hpp>
+
 #include <array>
+#include <cstdint>
 
 namespace nano
 {
@@ -21,4 +25,15 @@ public:
 		return (s[pn] = s0 ^ s1) * 1181783497276652981LL;
 	}
 };
+
+/** Generator local to the calling thread, seeded from the random pool on first use. Not suitable for cryptographic purposes */
+inline nano::xorshift1024star & thread_xorshift ()
+{
+	thread_local nano::xorshift1024star generator = [] () {
+		nano::xorshift1024star result;
+		nano::random_pool::generate_block (reinterpret_cast<unsigned char *> (result.s.data ()), sizeof (result.s));
+		return result;
+	} ();
+	return generator;
+}
 }
@@ -4,6 +4,7 @@
 #include <nano/rpc/rpc_connection.hpp>
 
 #include <boost/format.hpp>
+#include <boost/property_tree/ptree.hpp>
 
 #include <iostream>
 
@@ -55,7 +56,7 @@ void nano::rpc::start ()
 
 void nano::rpc::accept ()
 {
-	auto connection (std::make_shared<nano::rpc_connection> (config, io_ctx, logger, rpc_handler_interface));
+	auto connection (std::make_shared<nano::rpc_connection> (config, io_ctx, logger, rpc_handler_interface, connection_stats));
 	acceptor.async_accept (connection->socket, boost::asio::bind_executor (connection->strand, [this, connection] (boost::system::error_code const & ec) {
 		if (ec != boost::asio::error::operation_aborted && acceptor.is_open ())
 		{
@@ -63,6 +64,7 @@ void nano::rpc::accept ()
 		}
 		if (!ec)
 		{
+			++connection_stats.connections;
 			connection->parse_connection ();
 		}
 		else
@@ -72,10 +74,24 @@ void nano::rpc::accept ()
 	}));
 }
 
+void nano::rpc_connection_stats::serialize (boost::property_tree::ptree & tree_a) const
+{
+	tree_a.put ("connections", connections.load ());
+	tree_a.put ("requests", requests.load ());
+	tree_a.put ("reused", reused.load ());
+	tree_a.put ("pipelined", pipelined.load ());
+	tree_a.put ("throttled", throttled.load ());
+	tree_a.put ("idle_timeouts", idle_timeouts.load ());
+}
+
 void nano::rpc::stop ()
 {
 	stopped = true;
 	acceptor.close ();
+	if (config.rpc_logging.log_rpc)
+	{
+		logger.always_log (boost::str (boost::format ("RPC served %1% requests on %2% connections, %3% on reused connections, %4% pipelined, reading throttled %5% times, %6% idle timeouts") % connection_stats.requests % connection_stats.connections % connection_stats.reused % connection_stats.pipelined % connection_stats.throttled % connection_stats.idle_timeouts));
+	}
 }
 
 std::unique_ptr<nano::rpc> nano::get_rpc (boost::asio::io_context & io_ctx_a, nano::rpc_config const & config_a, nano::rpc_handler_interface & rpc_handler_interface_a)
@@ -5,6 +5,10 @@
 #include <nano/lib/rpc_handler_interface.hpp>
 #include <nano/lib/rpcconfig.hpp>
 
+#include <boost/property_tree/ptree_fwd.hpp>
+
+#include <atomic>
+
 namespace boost
 {
 namespace asio
@@ -17,6 +21,22 @@ namespace nano
 {
 class rpc_handler_interface;
 
+/** Counters of connection reuse, shared by all connections of an RPC server */
+class rpc_connection_stats final
+{
+public:
+	std::atomic<uint64_t> connections{ 0 };
+	std::atomic<uint64_t> requests{ 0 };
+	/** Requests served on a connection which already served an earlier request */
+	std::atomic<uint64_t> reused{ 0 };
+	/** Requests read while earlier requests on the same connection were still being processed */
+	std::atomic<uint64_t> pipelined{ 0 };
+	/** Times reading was paused because a connection had max_concurrent_requests in progress */
+	std::atomic<uint64_t> throttled{ 0 };
+	std::atomic<uint64_t> idle_timeouts{ 0 };
+	void serialize (boost::property_tree::ptree &) const;
+};
+
 class rpc
 {
 public:
@@ -31,6 +51,7 @@ public:
 	nano::logger_mt logger;
 	boost::asio::io_context & io_ctx;
 	nano::rpc_handler_interface & rpc_handler_interface;
+	nano::rpc_connection_stats connection_stats;
 	bool stopped{ false };
 };
 
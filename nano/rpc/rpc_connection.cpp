@@ -1,9 +1,11 @@
 #include <nano/boost/asio/bind_executor.hpp>
+#include <nano/boost/asio/post.hpp>
 #include <nano/lib/json_error_response.hpp>
 #include <nano/lib/logger_mt.hpp>
 #include <nano/lib/rpc_handler_interface.hpp>
 #include <nano/lib/rpcconfig.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/rpc/rpc.hpp>
 #include <nano/rpc/rpc_connection.hpp>
 #include <nano/rpc/rpc_handler.hpp>
 
@@ -14,15 +16,16 @@
 #endif
 #include <boost/format.hpp>
 
-nano::rpc_connection::rpc_connection (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface) :
+nano::rpc_connection::rpc_connection (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface, nano::rpc_connection_stats & stats_a) :
 	socket (io_ctx),
 	strand (io_ctx.get_executor ()),
 	io_ctx (io_ctx),
 	logger (logger),
 	rpc_config (rpc_config),
-	rpc_handler_interface (rpc_handler_interface)
+	rpc_handler_interface (rpc_handler_interface),
+	stats (stats_a),
+	idle_timer (io_ctx)
 {
-	responded.clear ();
 }
 
 void nano::rpc_connection::parse_connection ()
@@ -30,30 +33,27 @@ void nano::rpc_connection::parse_connection ()
 	read (socket);
 }
 
-void nano::rpc_connection::prepare_head (unsigned version, boost::beast::http::status status)
+std::shared_ptr<nano::rpc_connection::response_type> nano::rpc_connection::prepare_head (unsigned version, bool keep_alive, boost::beast::http::status status) const
 {
-	res.version (version);
-	res.result (status);
-	res.set (boost::beast::http::field::allow, "POST, OPTIONS");
-	res.set (boost::beast::http::field::content_type, "application/json");
-	res.set (boost::beast::http::field::access_control_allow_origin, "*");
-	res.set (boost::beast::http::field::access_control_allow_methods, "POST, OPTIONS");
-	res.set (boost::beast::http::field::access_control_allow_headers, "Accept, Accept-Language, Content-Language, Content-Type");
-	res.set (boost::beast::http::field::connection, "close");
+	auto res (std::make_shared<response_type> ());
+	res->version (version);
+	res->result (status);
+	res->set (boost::beast::http::field::allow, "POST, OPTIONS");
+	res->set (boost::beast::http::field::content_type, "application/json");
+	res->set (boost::beast::http::field::access_control_allow_origin, "*");
+	res->set (boost::beast::http::field::access_control_allow_methods, "POST, OPTIONS");
+	res->set (boost::beast::http::field::access_control_allow_headers, "Accept, Accept-Language, Content-Language, Content-Type");
+	res->keep_alive (keep_alive);
+	return res;
 }
 
-void nano::rpc_connection::write_result (std::string body, unsigned version, boost::beast::http::status status)
+std::shared_ptr<nano::rpc_connection::response_type> nano::rpc_connection::make_result (std::string const & body, unsigned version, bool keep_alive, boost::beast::http::status status) const
 {
-	if (!responded.test_and_set ())
-	{
-		prepare_head (version, status);
-		res.body () = body;
-		res.prepare_payload ();
-	}
-	else
-	{
-		debug_assert (false && "RPC already responded and should only respond once");
-	}
+	auto res (prepare_head (version, keep_alive, status));
+	// The only copy of the body, the response is shared with the write operation rather than copied
+	res->body () = body;
+	res->prepare_payload ();
+	return res;
 }
 
 void nano::rpc_connection::write_completion_handler (std::shared_ptr<nano::rpc_connection> const & rpc_connection)
@@ -61,17 +61,51 @@ void nano::rpc_connection::write_completion_handler (std::shared_ptr<nano::rpc_c
 	// Intentional no-op
 }
 
+uint64_t nano::rpc_connection::in_flight () const
+{
+	return read_sequence - write_sequence;
+}
+
+void nano::rpc_connection::arm_idle_timer ()
+{
+	auto this_l (shared_from_this ());
+	idle_timer.expires_after (rpc_config.http.keep_alive_timeout);
+	idle_timer.async_wait (boost::asio::bind_executor (strand, [this_l] (boost::system::error_code const & ec) {
+		// The timer may have been rearmed after this handler was queued
+		if (!ec && this_l->idle_timer.expiry () <= std::chrono::steady_clock::now () && !this_l->closing && this_l->in_flight () == 0)
+		{
+			++this_l->stats.idle_timeouts;
+			this_l->close ();
+		}
+	}));
+}
+
+void nano::rpc_connection::close ()
+{
+	closing = true;
+	idle_timer.cancel ();
+	boost::system::error_code ec;
+	socket.cancel (ec);
+}
+
 template <typename STREAM_TYPE>
 void nano::rpc_connection::read (STREAM_TYPE & stream)
 {
 	auto this_l (shared_from_this ());
+	reading = true;
+	if (read_sequence > 0 && in_flight () == 0)
+	{
+		arm_idle_timer ();
+	}
 	auto header_parser (std::make_shared<boost::beast::http::request_parser<boost::beast::http::empty_body>> ());
 	header_parser->body_limit (rpc_config.max_request_size);
 
 	boost::beast::http::async_read_header (stream, buffer, *header_parser, boost::asio::bind_executor (strand, [this_l, &stream, header_parser] (boost::system::error_code const & ec, size_t bytes_transferred) {
+		this_l->idle_timer.cancel ();
 		if (!ec)
 		{
-			if (boost::iequals (header_parser->get ()[boost::beast::http::field::expect], "100-continue"))
+			// Writing this while a pipelined response is being written would interleave the two, clients then send the body after their own timeout
+			if (boost::iequals (header_parser->get ()[boost::beast::http::field::expect], "100-continue") && this_l->in_flight () == 0)
 			{
 				auto continue_response (std::make_shared<boost::beast::http::response<boost::beast::http::empty_body>> ());
 				continue_response->version (11);
@@ -82,16 +116,22 @@ void nano::rpc_connection::read (STREAM_TYPE & stream)
 
 			this_l->parse_request (stream, header_parser);
 		}
+		else if (this_l->read_sequence > 0 && (ec == boost::beast::http::error::end_of_stream || ec == boost::asio::error::eof || ec == boost::asio::error::operation_aborted || ec == boost::asio::error::connection_reset))
+		{
+			// The client closed a persistent connection between requests, or it was idle for too long
+			this_l->reading = false;
+			this_l->closing = true;
+		}
 		else
 		{
 			this_l->logger.always_log ("RPC header error: ", ec.message ());
+			this_l->reading = false;
+			this_l->closing = true;
 
 			// Respond with the reason for the invalid header
-			auto response_handler ([this_l, &stream] (std::string const & tree_a) {
-				this_l->write_result (tree_a, 11);
-				boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
-					this_l->write_completion_handler (this_l);
-				}));
+			auto sequence (this_l->read_sequence++);
+			auto response_handler ([this_l, &stream, sequence] (std::string const & tree_a) {
+				this_l->respond (stream, sequence, this_l->make_result (tree_a, 11, false));
 			});
 			nano::json_error_response (response_handler, std::string ("Invalid header: ") + ec.message ());
 		}
@@ -107,21 +147,44 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 	auto body_parser (std::make_shared<boost::beast::http::request_parser<boost::beast::http::string_body>> (std::move (*header_parser)));
 	auto path_l (body_parser->get ().target ().to_string ());
 	boost::beast::http::async_read (stream, buffer, *body_parser, boost::asio::bind_executor (strand, [this_l, body_parser, header_field_credentials_l, header_corr_id_l, path_l, &stream] (boost::system::error_code const & ec, size_t bytes_transferred) {
+		this_l->reading = false;
 		if (!ec)
 		{
-			this_l->io_ctx.post ([this_l, body_parser, header_field_credentials_l, header_corr_id_l, path_l, &stream] () {
+			auto sequence (this_l->read_sequence++);
+			++this_l->stats.requests;
+			if (sequence > 0)
+			{
+				++this_l->stats.reused;
+			}
+			if (this_l->in_flight () > 1)
+			{
+				++this_l->stats.pipelined;
+			}
+			auto const & http_config (this_l->rpc_config.http);
+			auto keep_alive (http_config.keep_alive && body_parser->get ().keep_alive () && (http_config.max_requests_per_connection == 0 || this_l->read_sequence < http_config.max_requests_per_connection));
+			if (!keep_alive)
+			{
+				this_l->closing = true;
+			}
+			else if (this_l->in_flight () < http_config.max_concurrent_requests)
+			{
+				// Read the next request while this one is processed
+				this_l->read (stream);
+			}
+			else
+			{
+				// Reading resumes once a response has been written
+				++this_l->stats.throttled;
+			}
+			this_l->io_ctx.post ([this_l, body_parser, header_field_credentials_l, header_corr_id_l, path_l, sequence, keep_alive, &stream] () {
 				auto & req (body_parser->get ());
 				auto start (std::chrono::steady_clock::now ());
 				auto version (req.version ());
 				std::stringstream ss;
-				ss << std::hex << std::showbase << reinterpret_cast<uintptr_t> (this_l.get ());
+				ss << std::hex << std::showbase << reinterpret_cast<uintptr_t> (this_l.get ()) << std::dec << '.' << sequence;
 				auto request_id = ss.str ();
-				auto response_handler ([this_l, version, start, request_id, &stream] (std::string const & tree_a) {
-					auto body = tree_a;
-					this_l->write_result (body, version);
-					boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
-						this_l->write_completion_handler (this_l);
-					}));
+				auto response_handler ([this_l, version, keep_alive, sequence, start, request_id, &stream] (std::string const & tree_a) {
+					this_l->respond (stream, sequence, this_l->make_result (tree_a, version, keep_alive));
 
 					std::stringstream ss;
 					if (this_l->rpc_config.rpc_logging.log_rpc)
@@ -139,7 +202,7 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 				{
 					case boost::beast::http::verb::post:
 					{
-						auto handler (std::make_shared<nano::rpc_handler> (this_l->rpc_config, req.body (), request_id, response_handler, this_l->rpc_handler_interface, this_l->logger));
+						auto handler (std::make_shared<nano::rpc_handler> (this_l->rpc_config, req.body (), request_id, response_handler, this_l->rpc_handler_interface, this_l->logger, this_l->stats));
 						nano::rpc_handler_request_params request_params;
 						request_params.rpc_version = rpc_version_l;
 						request_params.credentials = header_field_credentials_l.to_string ();
@@ -151,11 +214,9 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 					}
 					case boost::beast::http::verb::options:
 					{
-						this_l->prepare_head (version);
-						this_l->res.prepare_payload ();
-						boost::beast::http::async_write (stream, this_l->res, boost::asio::bind_executor (this_l->strand, [this_l] (boost::system::error_code const & ec, size_t bytes_transferred) {
-							this_l->write_completion_handler (this_l);
-						}));
+						auto res (this_l->prepare_head (version, keep_alive));
+						res->prepare_payload ();
+						this_l->respond (stream, sequence, res);
 						break;
 					}
 					default:
@@ -169,10 +230,63 @@ void nano::rpc_connection::parse_request (STREAM_TYPE & stream, std::shared_ptr<
 		else
 		{
 			this_l->logger.always_log ("RPC read error: ", ec.message ());
+			this_l->closing = true;
 		}
 	}));
 }
 
+template <typename STREAM_TYPE>
+void nano::rpc_connection::respond (STREAM_TYPE & stream, uint64_t sequence_a, std::shared_ptr<response_type> const & response_a)
+{
+	auto this_l (shared_from_this ());
+	boost::asio::post (strand, [this_l, &stream, sequence_a, response_a] () {
+		debug_assert (sequence_a >= this_l->write_sequence && this_l->ready.count (sequence_a) == 0 && "RPC already responded and should only respond once");
+		this_l->ready.emplace (sequence_a, response_a);
+		this_l->write_next (stream);
+	});
+}
+
+template <typename STREAM_TYPE>
+void nano::rpc_connection::write_next (STREAM_TYPE & stream)
+{
+	if (!writing && !ready.empty () && ready.begin ()->first == write_sequence)
+	{
+		writing = true;
+		auto response (ready.begin ()->second);
+		ready.erase (ready.begin ());
+		auto this_l (shared_from_this ());
+		boost::beast::http::async_write (stream, *response, boost::asio::bind_executor (strand, [this_l, response, &stream] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			this_l->writing = false;
+			++this_l->write_sequence;
+			if (ec)
+			{
+				this_l->close ();
+			}
+			else if (!this_l->closing && !this_l->reading)
+			{
+				// Reading was paused by max_concurrent_requests
+				this_l->read (stream);
+			}
+			else if (this_l->reading && this_l->in_flight () == 0)
+			{
+				this_l->arm_idle_timer ();
+			}
+			if (this_l->closing && !this_l->reading && this_l->in_flight () == 0)
+			{
+				this_l->idle_timer.cancel ();
+				if (!ec)
+				{
+					this_l->write_completion_handler (this_l);
+				}
+			}
+			else
+			{
+				this_l->write_next (stream);
+			}
+		}));
+	}
+}
+
 template void nano::rpc_connection::read (socket_type &);
 template void nano::rpc_connection::parse_request (socket_type &, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> const &);
 #ifdef NANO_SECURE_RPC
@@ -1,13 +1,14 @@
 #pragma once
 
 #include <nano/boost/asio/ip/tcp.hpp>
+#include <nano/boost/asio/steady_timer.hpp>
 #include <nano/boost/asio/strand.hpp>
 #include <nano/boost/beast/core/flat_buffer.hpp>
 #include <nano/boost/beast/http.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
 
-#include <atomic>
+#include <map>
 
 /* Boost v1.70 introduced breaking changes; the conditional compilation allows 1.6x to be supported as well. */
 #if BOOST_VERSION < 107000
@@ -20,33 +21,66 @@ namespace nano
 {
 class logger_mt;
 class rpc_config;
+class rpc_connection_stats;
 class rpc_handler_interface;
 
+/**
+ * Serves HTTP requests on an accepted connection.
+ * With keep-alive enabled, further requests are read while earlier ones are processed, and responses are written in request order.
+ */
 class rpc_connection : public std::enable_shared_from_this<nano::rpc_connection>
 {
 public:
-	rpc_connection (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface_a);
+	rpc_connection (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface_a, nano::rpc_connection_stats & stats_a);
 	virtual ~rpc_connection () = default;
 	virtual void parse_connection ();
+	/** Called after the last response on the connection has been written */
 	virtual void write_completion_handler (std::shared_ptr<nano::rpc_connection> const & rpc_connection);
-	void prepare_head (unsigned version, boost::beast::http::status status = boost::beast::http::status::ok);
-	void write_result (std::string body, unsigned version, boost::beast::http::status status = boost::beast::http::status::ok);
 
 	socket_type socket;
 	boost::beast::flat_buffer buffer;
-	boost::beast::http::response<boost::beast::http::string_body> res;
 	boost::asio::strand<boost::asio::io_context::executor_type> strand;
-	std::atomic_flag responded;
 	boost::asio::io_context & io_ctx;
 	nano::logger_mt & logger;
 	nano::rpc_config const & rpc_config;
 	nano::rpc_handler_interface & rpc_handler_interface;
+	nano::rpc_connection_stats & stats;
 
 protected:
+	using response_type = boost::beast::http::response<boost::beast::http::string_body>;
+
 	template <typename STREAM_TYPE>
 	void read (STREAM_TYPE & stream);
 
 	template <typename STREAM_TYPE>
 	void parse_request (STREAM_TYPE & stream, std::shared_ptr<boost::beast::http::request_parser<boost::beast::http::empty_body>> const & header_parser);
+
+	/** Queues the response to request number sequence_a, thread safe */
+	template <typename STREAM_TYPE>
+	void respond (STREAM_TYPE & stream, uint64_t sequence_a, std::shared_ptr<response_type> const & response_a);
+
+	template <typename STREAM_TYPE>
+	void write_next (STREAM_TYPE & stream);
+
+	std::shared_ptr<response_type> prepare_head (unsigned version, bool keep_alive, boost::beast::http::status status = boost::beast::http::status::ok) const;
+	std::shared_ptr<response_type> make_result (std::string const & body, unsigned version, bool keep_alive, boost::beast::http::status status = boost::beast::http::status::ok) const;
+	/** Requests which have been read and not yet responded to */
+	uint64_t in_flight () const;
+	void arm_idle_timer ();
+	/** Stops reading further requests and aborts any read in progress */
+	void close ();
+
+	// The members below are only accessed through the strand
+	boost::asio::steady_timer idle_timer;
+	/** Number of requests read, also the sequence of the next request */
+	uint64_t read_sequence{ 0 };
+	/** Sequence of the next response to write */
+	uint64_t write_sequence{ 0 };
+	/** Responses waiting for the responses to earlier requests to be written */
+	std::map<uint64_t, std::shared_ptr<response_type>> ready;
+	bool reading{ false };
+	bool writing{ false };
+	/** Set once no further requests will be read */
+	bool closing{ false };
 };
 }
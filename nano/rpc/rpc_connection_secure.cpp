@@ -4,8 +4,8 @@
 
 #include <boost/polymorphic_pointer_cast.hpp>
 
-nano::rpc_connection_secure::rpc_connection_secure (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface, boost::asio::ssl::context & ssl_context) :
-	nano::rpc_connection (rpc_config, io_ctx, logger, rpc_handler_interface),
+nano::rpc_connection_secure::rpc_connection_secure (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface, nano::rpc_connection_stats & stats_a, boost::asio::ssl::context & ssl_context) :
+	nano::rpc_connection (rpc_config, io_ctx, logger, rpc_handler_interface, stats_a),
 	stream (socket, ssl_context)
 {
 }
@@ -22,7 +22,7 @@ void nano::rpc_connection_secure::parse_connection ()
 
 void nano::rpc_connection_secure::on_shutdown (const boost::system::error_code & error)
 {
-	// No-op. We initiate the shutdown (since the RPC server kills the connection after each request)
+	// No-op. We initiate the shutdown (since the RPC server closes the connection after its last response)
 	// and we'll thus get an expected EOF error. If the client disconnects, a short-read error will be expected.
 }
 
@@ -13,7 +13,7 @@ namespace nano
 class rpc_connection_secure : public rpc_connection
 {
 public:
-	rpc_connection_secure (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface_a, boost::asio::ssl::context & ssl_context);
+	rpc_connection_secure (nano::rpc_config const & rpc_config, boost::asio::io_context & io_ctx, nano::logger_mt & logger, nano::rpc_handler_interface & rpc_handler_interface_a, nano::rpc_connection_stats & stats_a, boost::asio::ssl::context & ssl_context);
 	void parse_connection () override;
 	void write_completion_handler (std::shared_ptr<nano::rpc_connection> const & rpc) override;
 	/** The TLS handshake callback */
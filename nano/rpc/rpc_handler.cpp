@@ -5,6 +5,7 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/rpc_handler_interface.hpp>
 #include <nano/lib/rpcconfig.hpp>
+#include <nano/rpc/rpc.hpp>
 #include <nano/rpc/rpc_handler.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
@@ -18,13 +19,14 @@ std::unordered_set<std::string> rpc_control_impl_set = create_rpc_control_impls
 std::string filter_request (boost::property_tree::ptree tree_a);
 }
 
-nano::rpc_handler::rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void (std::string const &)> const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger) :
+nano::rpc_handler::rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void (std::string const &)> const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger, nano::rpc_connection_stats const & connection_stats_a) :
 	body (body_a),
 	request_id (request_id_a),
 	response (response_a),
 	rpc_config (rpc_config),
 	rpc_handler_interface (rpc_handler_interface_a),
-	logger (logger)
+	logger (logger),
+	connection_stats (connection_stats_a)
 {
 }
 
@@ -74,6 +76,7 @@ void nano::rpc_handler::process_request (nano::rpc_handler_request_params const
 				std::error_code rpc_control_disabled_ec = nano::error_rpc::rpc_control_disabled;
 
 				bool error = false;
+				bool handled = false;
 				auto found = rpc_control_impl_set.find (action);
 				if (found != rpc_control_impl_set.cend () && !rpc_config.enable_control)
 				{
@@ -83,13 +86,24 @@ void nano::rpc_handler::process_request (nano::rpc_handler_request_params const
 				else
 				{
 					// Special case with stats, type -> objects
-					if (action == "stats" && !rpc_config.enable_control)
+					if (action == "stats")
 					{
-						if (request.get<std::string> ("type") == "objects")
+						auto type (request.get<std::string> ("type", ""));
+						if (type == "objects" && !rpc_config.enable_control)
 						{
 							json_error_response (response, rpc_control_disabled_ec.message ());
 							error = true;
 						}
+						// Connection counters are kept by this server rather than the node
+						else if (type == "rpc")
+						{
+							boost::property_tree::ptree response_l;
+							connection_stats.serialize (response_l);
+							std::stringstream ostream;
+							boost::property_tree::write_json (ostream, response_l);
+							response (ostream.str ());
+							handled = true;
+						}
 					}
 					else if (action == "process")
 					{
@@ -114,7 +128,7 @@ void nano::rpc_handler::process_request (nano::rpc_handler_request_params const
 					}
 				}
 
-				if (!error)
+				if (!error && !handled)
 				{
 					rpc_handler_interface.process_request (action, body, this->response);
 				}
@@ -122,8 +136,7 @@ void nano::rpc_handler::process_request (nano::rpc_handler_request_params const
 			else if (request_params.rpc_version == 2)
 			{
 				rpc_handler_interface.process_request_v2 (request_params, body, [response = response] (std::shared_ptr<std::string> const & body) {
-					std::string body_l = *body;
-					response (body_l);
+					response (*body);
 				});
 			}
 			else
@@ -8,6 +8,7 @@
 namespace nano
 {
 class rpc_config;
+class rpc_connection_stats;
 class rpc_handler_interface;
 class logger_mt;
 class rpc_handler_request_params;
@@ -15,7 +16,7 @@ class rpc_handler_request_params;
 class rpc_handler : public std::enable_shared_from_this<nano::rpc_handler>
 {
 public:
-	rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void (std::string const &)> const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger);
+	rpc_handler (nano::rpc_config const & rpc_config, std::string const & body_a, std::string const & request_id_a, std::function<void (std::string const &)> const & response_a, nano::rpc_handler_interface & rpc_handler_interface_a, nano::logger_mt & logger, nano::rpc_connection_stats const & connection_stats_a);
 	void process_request (nano::rpc_handler_request_params const & request_params);
 
 private:
@@ -26,5 +27,6 @@ private:
 	nano::rpc_config const & rpc_config;
 	nano::rpc_handler_interface & rpc_handler_interface;
 	nano::logger_mt & logger;
+	nano::rpc_connection_stats const & connection_stats;
 };
 }
@@ -5,25 +5,28 @@
 
 #include <boost/endian/conversion.hpp>
 
+#include <algorithm>
+
+std::chrono::seconds constexpr nano::rpc_request_processor::negotiation_timeout;
+
 nano::rpc_request_processor::rpc_request_processor (boost::asio::io_context & io_ctx, nano::rpc_config & rpc_config) :
+	io_ctx (io_ctx),
 	ipc_address (rpc_config.rpc_process.ipc_address),
 	ipc_port (rpc_config.rpc_process.ipc_port),
+	io_timeout (rpc_config.rpc_process.io_timeout),
 	thread ([this] () {
 		nano::thread_role::set (nano::thread_role::name::rpc_request_processor);
 		this->run ();
 	})
 {
-	nano::lock_guard<nano::mutex> lk (this->request_mutex);
-	this->connections.reserve (rpc_config.rpc_process.num_ipc_connections);
-	for (auto i = 0u; i < rpc_config.rpc_process.num_ipc_connections; ++i)
+	nano::lock_guard<nano::mutex> lk (this->connections_mutex);
+	// Requests are multiplexed if the node supports it, then a single connection is enough. More connections spread the IO.
+	auto const num_connections (std::max (1u, rpc_config.rpc_process.num_ipc_connections));
+	this->connections.reserve (num_connections);
+	for (auto i = 0u; i < num_connections; ++i)
 	{
-		connections.push_back (std::make_shared<nano::ipc_connection> (nano::ipc::ipc_client (io_ctx), false));
-		auto connection = this->connections.back ();
-		connection->client.async_connect (ipc_address, ipc_port, [connection, &connections_mutex = this->connections_mutex] (nano::error err) {
-			// Even if there is an error this needs to be set so that another attempt can be made to connect with the ipc connection
-			nano::lock_guard<nano::mutex> lk (connections_mutex);
-			connection->is_available = true;
-		});
+		connections.push_back (std::make_shared<nano::ipc_connection> (nano::ipc::ipc_client (io_ctx)));
+		connect (connections.back ());
 	}
 }
 
@@ -38,6 +41,21 @@ void nano::rpc_request_processor::stop ()
 		nano::lock_guard<nano::mutex> lock (request_mutex);
 		stopped = true;
 	}
+	{
+		// Deadline handlers only touch the processor when their timer was not cancelled
+		nano::lock_guard<nano::mutex> lk (connections_mutex);
+		for (auto const & connection : connections)
+		{
+			for (auto const & [request_id, pending] : connection->requests)
+			{
+				pending.deadline->cancel ();
+			}
+			if (connection->probe_timer != nullptr)
+			{
+				connection->probe_timer->cancel ();
+			}
+		}
+	}
 	condition.notify_one ();
 	if (thread.joinable ())
 	{
@@ -54,123 +72,335 @@ void nano::rpc_request_processor::add (std::shared_ptr<rpc_request> const & requ
 	condition.notify_one ();
 }
 
-void nano::rpc_request_processor::read_payload (std::shared_ptr<nano::ipc_connection> const & connection, std::shared_ptr<std::vector<uint8_t>> const & res, std::shared_ptr<nano::rpc_request> const & rpc_request)
+// Must be called with connections_mutex held
+void nano::rpc_request_processor::connect (std::shared_ptr<nano::ipc_connection> const & connection)
 {
-	uint32_t payload_size_l = boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ()));
-	res->resize (payload_size_l);
-	// Read JSON payload
-	connection->client.async_read (res, payload_size_l, [this, connection, res, rpc_request] (nano::error err_read_a, size_t size_read_a) {
-		// We need 2 sequential reads to get both the header and payload, so only allow other writes
-		// when they have both been read.
-		make_available (*connection);
-		if (!err_read_a && size_read_a != 0)
+	debug_assert (!connection->connected && !connection->connecting);
+	connection->connecting = true;
+	connection->multiplexed = false;
+	auto generation (++connection->generation);
+	connection->client.async_connect (ipc_address, ipc_port, [this, connection, generation] (nano::error err) {
+		if (!err)
 		{
-			rpc_request->response (std::string (res->begin (), res->end ()));
-			if (rpc_request->action == "stop")
+			nano::lock_guard<nano::mutex> lk (connections_mutex);
+			if (connection->generation == generation)
 			{
-				this->stop_callback ();
+				connection->connecting = false;
+				connection->connected = true;
+				switch (multiplexing_support)
+				{
+					case multiplexing::unknown:
+						read_response (connection, generation);
+						send_probe (connection);
+						break;
+					case multiplexing::supported:
+						connection->multiplexed = true;
+						read_response (connection, generation);
+						break;
+					case multiplexing::unsupported:
+						break;
+				}
+				// Send the requests which arrived while connecting
+				write_unsent (connection);
 			}
 		}
 		else
 		{
-			json_error_response (rpc_request->response, "Failed to read payload");
+			fail_requests (connection, generation, "There is a problem connecting to the node. Make sure ipc->tcp is enabled in the node config, ipc ports match and ipc_address is the ip where the node is located");
 		}
 	});
 }
 
-void nano::rpc_request_processor::make_available (nano::ipc_connection & connection)
+// Must be called with connections_mutex held. Nodes without multiplexing never answer the probe, they stop reading from the connection instead.
+void nano::rpc_request_processor::send_probe (std::shared_ptr<nano::ipc_connection> const & connection)
 {
-	nano::lock_guard<nano::mutex> lk (connections_mutex);
-	connection.is_available = true; // Allow people to use it now
+	auto request_id (next_request_id++);
+	auto generation (connection->generation);
+	connection->probe = request_id;
+	connection->probe_timer = std::make_shared<boost::asio::steady_timer> (io_ctx, std::min (io_timeout, std::chrono::seconds (negotiation_timeout)));
+	connection->probe_timer->async_wait ([this, connection, generation, request_id] (boost::system::error_code const & ec) {
+		if (!ec)
+		{
+			nano::lock_guard<nano::mutex> lk (connections_mutex);
+			if (connection->generation == generation && connection->probe == request_id)
+			{
+				// Fall back to one request at a time, on a new connection as this one is stuck
+				multiplexing_support = multiplexing::unsupported;
+				connection->probe = boost::none;
+				connection->connected = false;
+				connection->client.close ();
+				connect (connection);
+			}
+		}
+	});
+	auto req (nano::ipc::prepare_multiplexed_request (nano::ipc::payload_encoding::json_v1, request_id, R"({"action":"version"})"));
+	connection->client.async_write (req, [this, connection, generation] (nano::error err_a, size_t size_a) {
+		if (err_a || size_a == 0)
+		{
+			fail_requests (connection, generation, "Cannot write to the node");
+		}
+	});
 }
 
-// Connection does not exist or has been closed, try to connect to it again and then resend IPC request
-void nano::rpc_request_processor::try_reconnect_and_execute_request (std::shared_ptr<nano::ipc_connection> const & connection, nano::shared_const_buffer const & req, std::shared_ptr<std::vector<uint8_t>> const & res, std::shared_ptr<nano::rpc_request> const & rpc_request)
+// Must be called with connections_mutex held
+void nano::rpc_request_processor::write_unsent (std::shared_ptr<nano::ipc_connection> const & connection)
 {
-	connection->client.async_connect (ipc_address, ipc_port, [this, connection, req, res, rpc_request] (nano::error err) {
-		if (!err)
+	// A connection still probing may be stuck on the probe, it is replaced before sending anything
+	auto const single (multiplexing_support == multiplexing::unsupported && !connection->probe);
+	if (connection->connected && (connection->multiplexed || (single && !connection->in_flight)))
+	{
+		while (!connection->unsent.empty ())
 		{
-			connection->client.async_write (req, [this, connection, res, rpc_request] (nano::error err_a, size_t size_a) {
-				if (size_a != 0 && !err_a)
+			auto request_id (connection->unsent.front ());
+			connection->unsent.pop_front ();
+			// Requests may have expired while waiting
+			auto existing (connection->requests.find (request_id));
+			if (existing != connection->requests.end ())
+			{
+				if (connection->multiplexed)
 				{
-					// Read length
-					connection->client.async_read (res, sizeof (uint32_t), [this, connection, res, rpc_request] (nano::error err_read_a, size_t size_read_a) {
-						if (size_read_a != 0 && !err_read_a)
-						{
-							this->read_payload (connection, res, rpc_request);
-						}
-						else
+					write_request (connection, request_id, existing->second.request);
+				}
+				else
+				{
+					write_single_request (connection, request_id, existing->second.request);
+					break;
+				}
+			}
+		}
+	}
+}
+
+// Must be called with connections_mutex held
+void nano::rpc_request_processor::write_request (std::shared_ptr<nano::ipc_connection> const & connection, uint32_t request_id, std::shared_ptr<nano::rpc_request> const & rpc_request)
+{
+	auto encoding (rpc_request->rpc_api_version == 1 ? nano::ipc::payload_encoding::json_v1 : nano::ipc::payload_encoding::flatbuffers_json);
+	auto req (nano::ipc::prepare_multiplexed_request (encoding, request_id, rpc_request->body));
+	auto generation (connection->generation);
+	connection->client.async_write (req, [this, connection, generation] (nano::error err_a, size_t size_a) {
+		if (err_a || size_a == 0)
+		{
+			fail_requests (connection, generation, "Cannot write to the node");
+		}
+	});
+}
+
+// Must be called with connections_mutex held. Writes a request without multiplexing, the response is the next message on the connection.
+void nano::rpc_request_processor::write_single_request (std::shared_ptr<nano::ipc_connection> const & connection, uint32_t request_id, std::shared_ptr<nano::rpc_request> const & rpc_request)
+{
+	connection->in_flight = request_id;
+	auto encoding (rpc_request->rpc_api_version == 1 ? nano::ipc::payload_encoding::json_v1 : nano::ipc::payload_encoding::flatbuffers_json);
+	auto req (nano::ipc::prepare_request (encoding, rpc_request->body));
+	auto generation (connection->generation);
+	connection->client.async_write (req, [this, connection, generation, request_id] (nano::error err_a, size_t size_a) {
+		if (err_a || size_a == 0)
+		{
+			single_request_failed (connection, generation, request_id, "Cannot write to the node");
+		}
+		else
+		{
+			auto res (std::make_shared<std::vector<uint8_t>> ());
+			connection->client.async_read_message (res, io_timeout, [this, connection, generation, request_id, res] (nano::error err_read_a, size_t size_read_a) {
+				if (!err_read_a && size_read_a != 0)
+				{
+					std::shared_ptr<nano::rpc_request> rpc_request;
+					{
+						nano::lock_guard<nano::mutex> lk (connections_mutex);
+						if (connection->generation == generation)
 						{
-							json_error_response (rpc_request->response, "Connection to node has failed");
-							make_available (*connection);
+							auto existing (connection->requests.find (request_id));
+							if (existing != connection->requests.end ())
+							{
+								rpc_request = existing->second.request;
+								existing->second.deadline->cancel ();
+								connection->requests.erase (existing);
+							}
+							connection->in_flight = boost::none;
+							write_unsent (connection);
 						}
-					});
+					}
+					if (rpc_request != nullptr)
+					{
+						respond (rpc_request, std::string (res->begin (), res->end ()));
+					}
 				}
 				else
 				{
-					json_error_response (rpc_request->response, "Cannot write to the node");
-					make_available (*connection);
+					single_request_failed (connection, generation, request_id, "Connection to node has failed");
 				}
 			});
 		}
+	});
+}
+
+// Only the request in flight fails, the others are sent on a new connection
+void nano::rpc_request_processor::single_request_failed (std::shared_ptr<nano::ipc_connection> const & connection, uint64_t generation, uint32_t request_id, std::string const & message)
+{
+	std::shared_ptr<nano::rpc_request> rpc_request;
+	{
+		nano::lock_guard<nano::mutex> lk (connections_mutex);
+		if (connection->generation == generation)
+		{
+			auto existing (connection->requests.find (request_id));
+			if (existing != connection->requests.end ())
+			{
+				rpc_request = existing->second.request;
+				existing->second.deadline->cancel ();
+				connection->requests.erase (existing);
+			}
+			connection->in_flight = boost::none;
+			connection->connected = false;
+			if (!connection->requests.empty ())
+			{
+				connect (connection);
+			}
+		}
+	}
+	if (rpc_request != nullptr)
+	{
+		json_error_response (rpc_request->response, message);
+	}
+}
+
+// Must be called with connections_mutex held. Responses arrive in completion order and are matched with requests by id.
+void nano::rpc_request_processor::read_response (std::shared_ptr<nano::ipc_connection> const & connection, uint64_t generation)
+{
+	auto res (std::make_shared<std::vector<uint8_t>> ());
+	// Idle connections are kept open, every request has its own deadline
+	connection->client.async_read_message (res, std::chrono::seconds::max (), [this, connection, generation, res] (nano::error err_read_a, size_t size_read_a) {
+		if (!err_read_a && res->size () >= sizeof (uint32_t))
+		{
+			uint32_t request_id (boost::endian::big_to_native (*reinterpret_cast<uint32_t *> (res->data ())));
+			std::shared_ptr<nano::rpc_request> rpc_request;
+			{
+				nano::lock_guard<nano::mutex> lk (connections_mutex);
+				if (connection->generation == generation)
+				{
+					if (connection->probe == request_id)
+					{
+						multiplexing_support = multiplexing::supported;
+						connection->probe = boost::none;
+						connection->probe_timer->cancel ();
+						connection->multiplexed = true;
+						write_unsent (connection);
+					}
+					auto existing (connection->requests.find (request_id));
+					if (existing != connection->requests.end ())
+					{
+						rpc_request = existing->second.request;
+						existing->second.deadline->cancel ();
+						connection->requests.erase (existing);
+					}
+					read_response (connection, generation);
+				}
+			}
+			if (rpc_request != nullptr)
+			{
+				respond (rpc_request, std::string (res->begin () + sizeof (uint32_t), res->end ()));
+			}
+		}
 		else
 		{
-			json_error_response (rpc_request->response, "There is a problem connecting to the node. Make sure ipc->tcp is enabled in the node config, ipc ports match and ipc_address is the ip where the node is located");
-			make_available (*connection);
+			fail_requests (connection, generation, "Connection to node has failed");
+		}
+	});
+}
+
+void nano::rpc_request_processor::expire (std::shared_ptr<nano::ipc_connection> const & connection, uint32_t request_id)
+{
+	std::shared_ptr<nano::rpc_request> rpc_request;
+	{
+		nano::lock_guard<nano::mutex> lk (connections_mutex);
+		auto existing (connection->requests.find (request_id));
+		if (existing != connection->requests.end ())
+		{
+			rpc_request = existing->second.request;
+			connection->requests.erase (existing);
+			if (connection->in_flight == request_id)
+			{
+				// A late response would be taken for the one to the next request, failing the read reconnects
+				connection->client.close ();
+			}
+		}
+	}
+	if (rpc_request != nullptr)
+	{
+		json_error_response (rpc_request->response, "Timed out waiting for the node to respond");
+	}
+}
+
+// The connection is reestablished by the next request sent through it
+void nano::rpc_request_processor::fail_requests (std::shared_ptr<nano::ipc_connection> const & connection, uint64_t generation, std::string const & message)
+{
+	decltype (connection->requests) requests_l;
+	{
+		nano::lock_guard<nano::mutex> lk (connections_mutex);
+		if (connection->generation == generation)
+		{
+			connection->connected = false;
+			connection->connecting = false;
+			connection->multiplexed = false;
+			connection->in_flight = boost::none;
+			connection->unsent.clear ();
+			if (connection->probe)
+			{
+				connection->probe = boost::none;
+				connection->probe_timer->cancel ();
+			}
+			requests_l.swap (connection->requests);
+		}
+	}
+	for (auto const & [request_id, pending] : requests_l)
+	{
+		pending.deadline->cancel ();
+		json_error_response (pending.request->response, message);
+	}
+}
+
+void nano::rpc_request_processor::respond (std::shared_ptr<nano::rpc_request> const & rpc_request, std::string const & body)
+{
+	rpc_request->response (body);
+	if (rpc_request->action == "stop")
+	{
+		this->stop_callback ();
+	}
+}
+
+void nano::rpc_request_processor::send (std::shared_ptr<nano::rpc_request> const & rpc_request)
+{
+	nano::lock_guard<nano::mutex> lk (connections_mutex);
+	auto connection (connections[next_connection++ % connections.size ()]);
+	auto request_id (next_request_id++);
+	auto deadline (std::make_shared<boost::asio::steady_timer> (io_ctx, io_timeout));
+	deadline->async_wait ([this, connection, request_id] (boost::system::error_code const & ec) {
+		if (!ec)
+		{
+			expire (connection, request_id);
 		}
 	});
+	connection->requests.emplace (request_id, nano::ipc_pending_request{ rpc_request, deadline });
+	connection->unsent.push_back (request_id);
+	if (connection->connected)
+	{
+		write_unsent (connection);
+	}
+	else if (!connection->connecting)
+	{
+		connect (connection);
+	}
 }
 
 void nano::rpc_request_processor::run ()
 {
-	// This should be a conditioned wait
 	nano::unique_lock<nano::mutex> lk (request_mutex);
 	while (!stopped)
 	{
 		if (!requests.empty ())
 		{
+			auto rpc_request (requests.front ());
+			requests.pop_front ();
 			lk.unlock ();
-			nano::unique_lock<nano::mutex> conditions_lk (connections_mutex);
-			// Find the first free ipc_client
-			auto it = std::find_if (connections.begin (), connections.end (), [] (auto connection) -> bool {
-				return connection->is_available;
-			});
-
-			if (it != connections.cend ())
-			{
-				// Successfully found one
-				lk.lock ();
-				auto rpc_request = requests.front ();
-				requests.pop_front ();
-				lk.unlock ();
-				auto connection = *it;
-				connection->is_available = false; // Make sure no one else can take it
-				conditions_lk.unlock ();
-				auto encoding (rpc_request->rpc_api_version == 1 ? nano::ipc::payload_encoding::json_v1 : nano::ipc::payload_encoding::flatbuffers_json);
-				auto req (nano::ipc::prepare_request (encoding, rpc_request->body));
-				auto res (std::make_shared<std::vector<uint8_t>> ());
-
-				// Have we tried to connect yet?
-				connection->client.async_write (req, [this, connection, req, res, rpc_request] (nano::error err_a, size_t size_a) {
-					if (!err_a)
-					{
-						connection->client.async_read (res, sizeof (uint32_t), [this, connection, req, res, rpc_request] (nano::error err_read_a, size_t size_read_a) {
-							if (size_read_a != 0 && !err_read_a)
-							{
-								this->read_payload (connection, res, rpc_request);
-							}
-							else
-							{
-								this->try_reconnect_and_execute_request (connection, req, res, rpc_request);
-							}
-						});
-					}
-					else
-					{
-						try_reconnect_and_execute_request (connection, req, res, rpc_request);
-					}
-				});
-			}
+			send (rpc_request);
 			lk.lock ();
 		}
 		else
@@ -1,25 +1,18 @@
 #pragma once
 
+#include <nano/boost/asio/steady_timer.hpp>
 #include <nano/lib/ipc_client.hpp>
 #include <nano/lib/rpc_handler_interface.hpp>
 #include <nano/lib/rpcconfig.hpp>
 #include <nano/rpc/rpc.hpp>
 
+#include <boost/optional.hpp>
+
 #include <deque>
+#include <unordered_map>
 
 namespace nano
 {
-struct ipc_connection
-{
-	ipc_connection (nano::ipc::ipc_client && client_a, bool is_available_a) :
-		client (std::move (client_a)), is_available (is_available_a)
-	{
-	}
-
-	nano::ipc::ipc_client client;
-	bool is_available{ false };
-};
-
 struct rpc_request
 {
 	rpc_request (const std::string & action_a, const std::string & body_a, std::function<void (std::string const &)> response_a) :
@@ -43,6 +36,40 @@ struct rpc_request
 	std::function<void (std::string const &)> response;
 };
 
+/** A request forwarded to the node which has not been answered yet */
+struct ipc_pending_request
+{
+	std::shared_ptr<nano::rpc_request> request;
+	/** Fails the request once it expires */
+	std::shared_ptr<boost::asio::steady_timer> deadline;
+};
+
+/** IPC connection carrying any number of multiplexed requests, or one request at a time if the node does not support multiplexing */
+struct ipc_connection
+{
+	explicit ipc_connection (nano::ipc::ipc_client && client_a) :
+		client (std::move (client_a))
+	{
+	}
+
+	nano::ipc::ipc_client client;
+	bool connected{ false };
+	bool connecting{ false };
+	/** Set once the node answered a multiplexed request on this connection */
+	bool multiplexed{ false };
+	/** Incremented on every connection attempt so callbacks from an earlier attempt can be told apart */
+	uint64_t generation{ 0 };
+	/** Requests written to the connection or awaiting the connection, by request id */
+	std::unordered_map<uint32_t, nano::ipc_pending_request> requests;
+	/** Ids of the requests not written yet, oldest first */
+	std::deque<uint32_t> unsent;
+	/** Id of the request awaiting its response when the connection is not multiplexed */
+	boost::optional<uint32_t> in_flight;
+	/** Id of the request testing whether the node supports multiplexing */
+	boost::optional<uint32_t> probe;
+	std::shared_ptr<boost::asio::steady_timer> probe_timer;
+};
+
 class rpc_request_processor
 {
 public:
@@ -52,20 +79,45 @@ public:
 	void add (std::shared_ptr<rpc_request> const & request);
 	std::function<void ()> stop_callback;
 
+	/** A node which does not answer a multiplexed request within this time, or io_timeout if shorter, is assumed not to support it */
+	static std::chrono::seconds constexpr negotiation_timeout{ 5 };
+
 private:
-	void run ();
-	void read_payload (std::shared_ptr<nano::ipc_connection> const & connection, std::shared_ptr<std::vector<uint8_t>> const & res, std::shared_ptr<nano::rpc_request> const & rpc_request);
-	void try_reconnect_and_execute_request (std::shared_ptr<nano::ipc_connection> const & connection, nano::shared_const_buffer const & req, std::shared_ptr<std::vector<uint8_t>> const & res, std::shared_ptr<nano::rpc_request> const & rpc_request);
-	void make_available (nano::ipc_connection & connection);
+	/** Whether the node supports payload_encoding::multiplexed, learned from the first connection established */
+	enum class multiplexing
+	{
+		unknown,
+		supported,
+		unsupported
+	};
 
+	void run ();
+	void send (std::shared_ptr<nano::rpc_request> const & rpc_request);
+	void connect (std::shared_ptr<nano::ipc_connection> const & connection);
+	void send_probe (std::shared_ptr<nano::ipc_connection> const & connection);
+	void write_unsent (std::shared_ptr<nano::ipc_connection> const & connection);
+	void write_request (std::shared_ptr<nano::ipc_connection> const & connection, uint32_t request_id, std::shared_ptr<nano::rpc_request> const & rpc_request);
+	void write_single_request (std::shared_ptr<nano::ipc_connection> const & connection, uint32_t request_id, std::shared_ptr<nano::rpc_request> const & rpc_request);
+	void read_response (std::shared_ptr<nano::ipc_connection> const & connection, uint64_t generation);
+	void single_request_failed (std::shared_ptr<nano::ipc_connection> const & connection, uint64_t generation, uint32_t request_id, std::string const & message);
+	void expire (std::shared_ptr<nano::ipc_connection> const & connection, uint32_t request_id);
+	void fail_requests (std::shared_ptr<nano::ipc_connection> const & connection, uint64_t generation, std::string const & message);
+	void respond (std::shared_ptr<nano::rpc_request> const & rpc_request, std::string const & body);
+
+	boost::asio::io_context & io_ctx;
 	std::vector<std::shared_ptr<nano::ipc_connection>> connections;
 	nano::mutex request_mutex;
+	/** Protects the connections and their pending requests */
 	nano::mutex connections_mutex;
 	bool stopped{ false };
 	std::deque<std::shared_ptr<nano::rpc_request>> requests;
 	nano::condition_variable condition;
 	const std::string ipc_address;
 	const uint16_t ipc_port;
+	std::chrono::seconds const io_timeout;
+	multiplexing multiplexing_support{ multiplexing::unknown };
+	size_t next_connection{ 0 };
+	uint32_t next_request_id{ 0 };
 	std::thread thread;
 };
 
@@ -1,3 +1,5 @@
+#include <nano/boost/asio/read.hpp>
+#include <nano/boost/asio/write.hpp>
 #include <nano/boost/beast/core/flat_buffer.hpp>
 #include <nano/boost/beast/http.hpp>
 #include <nano/lib/rpcconfig.hpp>
@@ -13,10 +15,12 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/endian/conversion.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #include <algorithm>
+#include <thread>
 #include <tuple>
 
 using namespace std::chrono_literals;
@@ -124,6 +128,41 @@ void reset_confirmation_height (nano::store & store, nano::account const & accou
 	}
 }
 
+/** Reads an IPC request on behalf of a fake node, returning its encoding and payload. The request id is set for multiplexed requests. */
+std::pair<nano::ipc::payload_encoding, std::string> read_ipc_request (boost::asio::ip::tcp::socket & socket_a, uint32_t & request_id_a)
+{
+	std::array<uint8_t, 4> preamble;
+	boost::asio::read (socket_a, boost::asio::buffer (preamble));
+	auto encoding (static_cast<nano::ipc::payload_encoding> (preamble[nano::ipc::preamble_offset::encoding]));
+	if (encoding == nano::ipc::payload_encoding::multiplexed)
+	{
+		boost::asio::read (socket_a, boost::asio::buffer (&request_id_a, sizeof (request_id_a)));
+		boost::endian::big_to_native_inplace (request_id_a);
+		// Preamble of the enclosed request
+		boost::asio::read (socket_a, boost::asio::buffer (preamble));
+	}
+	uint32_t length (0);
+	boost::asio::read (socket_a, boost::asio::buffer (&length, sizeof (length)));
+	std::string body (boost::endian::big_to_native (length), '\0');
+	boost::asio::read (socket_a, boost::asio::buffer (&body[0], body.size ()));
+	return { encoding, body };
+}
+
+/** Writes a response to an IPC request, prefixed with \p request_id_a if set */
+void write_ipc_response (boost::asio::ip::tcp::socket & socket_a, std::string const & body_a, boost::optional<uint32_t> request_id_a = boost::none)
+{
+	std::vector<uint8_t> buffer;
+	auto big_length (boost::endian::native_to_big (static_cast<uint32_t> (body_a.size () + (request_id_a ? sizeof (uint32_t) : 0))));
+	buffer.insert (buffer.end (), reinterpret_cast<uint8_t *> (&big_length), reinterpret_cast<uint8_t *> (&big_length) + sizeof (big_length));
+	if (request_id_a)
+	{
+		auto big_request_id (boost::endian::native_to_big (*request_id_a));
+		buffer.insert (buffer.end (), reinterpret_cast<uint8_t *> (&big_request_id), reinterpret_cast<uint8_t *> (&big_request_id) + sizeof (big_request_id));
+	}
+	buffer.insert (buffer.end (), body_a.begin (), body_a.end ());
+	boost::asio::write (socket_a, boost::asio::buffer (buffer));
+}
+
 void wait_response_impl (nano::system & system, std::shared_ptr<nano::rpc> const & rpc, boost::property_tree::ptree & request, const std::chrono::duration<double, std::nano> & time, boost::property_tree::ptree & response_json)
 {
 	test_response response (request, rpc->config.port, system.io_ctx);
@@ -269,6 +308,122 @@ TEST (rpc, account_balance)
 	}
 }
 
+TEST (rpc, account_balance_cached)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.rpc_cache_config.enable = true;
+	auto node = add_ipc_enabled_node (system, node_config);
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "account_balance");
+	request.put ("account", nano::dev_genesis_key.pub.to_account ());
+	request.put ("include_only_confirmed", false);
+	{
+		auto response (wait_response (system, rpc, request));
+		ASSERT_EQ (nano::genesis_amount.convert_to<std::string> (), response.get<std::string> ("balance"));
+	}
+	// Both account prefixes share an entry
+	request.put ("account", nano::dev_genesis_key.pub.to_account ().replace (0, 4, "xrb"));
+	{
+		auto response (wait_response (system, rpc, request));
+		ASSERT_EQ (nano::genesis_amount.convert_to<std::string> (), response.get<std::string> ("balance"));
+	}
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_miss));
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_hit));
+	ASSERT_EQ (1, node->rpc_cache.size ());
+	// Processing a block of the account invalidates its responses
+	auto send1 = nano::state_block_builder ()
+				 .account (nano::dev_genesis_key.pub)
+				 .previous (nano::genesis_hash)
+				 .representative (nano::dev_genesis_key.pub)
+				 .balance (nano::genesis_amount - 1)
+				 .link (nano::dev_genesis_key.pub)
+				 .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+				 .work (*system.work.generate (nano::genesis_hash))
+				 .build_shared ();
+	node->process_active (send1);
+	node->block_processor.flush ();
+	ASSERT_TIMELY (5s, node->rpc_cache.size () == 0);
+	{
+		auto response (wait_response (system, rpc, request));
+		ASSERT_EQ ((nano::genesis_amount - 1).convert_to<std::string> (), response.get<std::string> ("balance"));
+		ASSERT_EQ ("1", response.get<std::string> ("pending"));
+	}
+	ASSERT_EQ (2, node->stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_miss));
+	ASSERT_EQ (1, node->stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_invalidated));
+}
+
+// Only responses to accounts in a deprecated format carry deprecated_account_format, so those are cached apart
+TEST (rpc, account_info_cached_deprecated_format)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.rpc_cache_config.enable = true;
+	auto node = add_ipc_enabled_node (system, node_config);
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	auto account_text (nano::dev_genesis_key.pub.to_account ());
+	auto deprecated_text (account_text);
+	deprecated_text[4] = '-';
+	auto flagged = [&system, &rpc = rpc] (std::string const & account_a) {
+		boost::property_tree::ptree request;
+		request.put ("action", "account_info");
+		request.put ("account", account_a);
+		auto response (wait_response (system, rpc, request));
+		EXPECT_EQ (nano::genesis_hash.to_string (), response.get<std::string> ("frontier"));
+		return response.get_optional<std::string> ("deprecated_account_format").is_initialized ();
+	};
+	ASSERT_TRUE (flagged (deprecated_text));
+	ASSERT_FALSE (flagged (account_text));
+	ASSERT_FALSE (flagged (nano::dev_genesis_key.pub.to_account ().replace (0, 4, "xrb")));
+	ASSERT_TRUE (flagged (deprecated_text));
+	ASSERT_EQ (2, node->stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_miss));
+	ASSERT_EQ (2, node->stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_hit));
+	ASSERT_EQ (2, node->rpc_cache.size ());
+}
+
+// Cached responses are computed from a fresh snapshot even when pooled read transactions may be stale
+TEST (rpc, account_info_cached_pooled_transaction)
+{
+	nano::system system;
+	nano::node_config node_config (nano::get_available_port (), system.logging);
+	node_config.rpc_cache_config.enable = true;
+	node_config.read_transaction_max_age = std::chrono::hours (1);
+	auto & node = *add_ipc_enabled_node (system, node_config);
+	nano::node_rpc_config node_rpc_config;
+	std::string const body (R"({"action": "account_info", "account": ")" + nano::dev_genesis_key.pub.to_account () + R"("})");
+	// The handler runs on this thread, so every request borrows the same pooled transaction
+	auto frontier = [&node, &node_rpc_config, &body] () {
+		std::string frontier_l;
+		auto handler (std::make_shared<nano::json_handler> (node, node_rpc_config, body, [&frontier_l] (std::string const & response_a) {
+			std::stringstream istream (response_a);
+			boost::property_tree::ptree json_l;
+			boost::property_tree::read_json (istream, json_l);
+			frontier_l = json_l.get<std::string> ("frontier", "");
+		}));
+		handler->process_request ();
+		return frontier_l;
+	};
+	ASSERT_EQ (nano::genesis_hash.to_string (), frontier ());
+	ASSERT_EQ (1, node.rpc_cache.size ());
+	auto send1 = nano::state_block_builder ()
+				 .account (nano::dev_genesis_key.pub)
+				 .previous (nano::genesis_hash)
+				 .representative (nano::dev_genesis_key.pub)
+				 .balance (nano::genesis_amount - 1)
+				 .link (nano::dev_genesis_key.pub)
+				 .sign (nano::dev_genesis_key.prv, nano::dev_genesis_key.pub)
+				 .work (*system.work.generate (nano::genesis_hash))
+				 .build_shared ();
+	node.process_active (send1);
+	node.block_processor.flush ();
+	ASSERT_TIMELY (5s, node.rpc_cache.size () == 0);
+	ASSERT_EQ (send1->hash ().to_string (), frontier ());
+	// Served from the cache
+	ASSERT_EQ (send1->hash ().to_string (), frontier ());
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::rpc_cache, nano::stat::detail::rpc_cache_hit));
+}
+
 TEST (rpc, account_block_count)
 {
 	nano::system system;
@@ -4180,6 +4335,44 @@ TEST (rpc, ledger)
 	}
 }
 
+TEST (rpc, ledger_sorting_ranges)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto const count (nano::json_handler::parallel_scan_count);
+	// Enough accounts in the first range for it to keep only the largest balances while scanning and at the end
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (uint64_t i (0); i < 2 * count + 100; ++i)
+		{
+			node->store.account.put (transaction, nano::account (i + 2), nano::account_info (nano::genesis_hash, nano::dev_genesis_key.pub, nano::genesis_hash, i + 1, 0, 1, nano::epoch::epoch_0));
+		}
+	}
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "ledger");
+	request.put ("account", nano::account (0).to_account ());
+	request.put ("sorting", true);
+	request.put ("count", std::to_string (count));
+	auto response (wait_response (system, rpc, request));
+	// Accounts are sorted by balance across ranges, the genesis account first
+	std::vector<std::string> accounts;
+	std::vector<std::string> balances;
+	for (auto & [account, info] : response.get_child ("accounts"))
+	{
+		accounts.push_back (account);
+		balances.push_back (info.get<std::string> ("balance"));
+	}
+	ASSERT_EQ (count, accounts.size ());
+	ASSERT_EQ (nano::dev_genesis_key.pub.to_account (), accounts.front ());
+	for (uint64_t i (1); i < count; ++i)
+	{
+		auto balance (2 * count + 100 - i + 1);
+		ASSERT_EQ (nano::account (balance + 1).to_account (), accounts[i]);
+		ASSERT_EQ (std::to_string (balance), balances[i]);
+	}
+}
+
 TEST (rpc, accounts_create)
 {
 	nano::system system;
@@ -5120,6 +5313,77 @@ TEST (rpc, unopened)
 	}
 }
 
+TEST (rpc, unopened_ranges)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	// An account whose pending entries straddle the boundary between the first two ranges scanned in parallel
+	nano::uint512_union boundary (std::numeric_limits<nano::uint512_t>::max () / nano::json_handler::scan_ranges);
+	nano::account split_account (boundary.uint256s[0].number ());
+	std::map<nano::account, nano::uint128_t> expected;
+	{
+		auto transaction (node->store.tx_begin_write ());
+		for (auto i (0); i < 100; ++i)
+		{
+			nano::keypair key;
+			node->store.pending.put (transaction, nano::pending_key (key.pub, 1), nano::pending_info (nano::dev_genesis_key.pub, 1 + i, nano::epoch::epoch_0));
+			expected[key.pub] = 1 + i;
+		}
+		// Enough accounts in the first range for it to stop on count
+		for (uint64_t i (0); i < nano::json_handler::parallel_scan_count + 100; ++i)
+		{
+			nano::account account (i + 2);
+			node->store.pending.put (transaction, nano::pending_key (account, 1), nano::pending_info (nano::dev_genesis_key.pub, 1, nano::epoch::epoch_0));
+			expected[account] = 1;
+		}
+		node->store.pending.put (transaction, nano::pending_key (split_account, 0), nano::pending_info (nano::dev_genesis_key.pub, 1000, nano::epoch::epoch_0));
+		node->store.pending.put (transaction, nano::pending_key (split_account, std::numeric_limits<nano::uint256_t>::max ()), nano::pending_info (nano::dev_genesis_key.pub, 1000, nano::epoch::epoch_0));
+		expected[split_account] = 2000;
+	}
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	{
+		// Results are in account order across ranges
+		boost::property_tree::ptree request;
+		request.put ("action", "unopened");
+		auto response (wait_response (system, rpc, request));
+		auto & accounts (response.get_child ("accounts"));
+		ASSERT_EQ (expected.size (), accounts.size ());
+		auto existing (expected.begin ());
+		for (auto & [account, amount] : accounts)
+		{
+			ASSERT_EQ (existing->first.to_account (), account);
+			ASSERT_EQ (existing->second.convert_to<std::string> (), amount.get<std::string> (""));
+			++existing;
+		}
+	}
+	{
+		// The scan stops once count accounts are found, which are the first ones
+		boost::property_tree::ptree request;
+		request.put ("action", "unopened");
+		request.put ("count", std::to_string (nano::json_handler::parallel_scan_count));
+		auto response (wait_response (system, rpc, request));
+		auto & accounts (response.get_child ("accounts"));
+		ASSERT_EQ (nano::json_handler::parallel_scan_count, accounts.size ());
+		auto existing (expected.begin ());
+		for (auto & [account, amount] : accounts)
+		{
+			ASSERT_EQ (existing->first.to_account (), account);
+			ASSERT_EQ (existing->second.convert_to<std::string> (), amount.get<std::string> (""));
+			++existing;
+		}
+	}
+	{
+		// Only the combined amount of the split account reaches the threshold
+		boost::property_tree::ptree request;
+		request.put ("action", "unopened");
+		request.put ("threshold", 1500);
+		auto response (wait_response (system, rpc, request));
+		auto & accounts (response.get_child ("accounts"));
+		ASSERT_EQ (1, accounts.size ());
+		ASSERT_EQ ("2000", accounts.get<std::string> (split_account.to_account ()));
+	}
+}
+
 TEST (rpc, unopened_burn)
 {
 	nano::system system;
@@ -5550,6 +5814,95 @@ TEST (rpc, simultaneous_calls)
 	runner.join ();
 }
 
+TEST (rpc, keep_alive_pipelining)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	scoped_io_thread_name_change scoped_thread_name_io;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc_server (*node, node_rpc_config);
+	nano::rpc_config rpc_config (nano::get_available_port (), true);
+	rpc_config.rpc_process.ipc_port = node->config.ipc_config.transport_tcp.port;
+	rpc_config.http.keep_alive = true;
+	rpc_config.http.max_requests_per_connection = 2;
+	nano::ipc_rpc_processor ipc_rpc_processor (system.io_ctx, rpc_config);
+	nano::rpc rpc (system.io_ctx, rpc_config, ipc_rpc_processor);
+	rpc.start ();
+	std::string body (R"({"action": "block_count"})");
+	std::string request ("POST / HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string (body.size ()) + "\r\n\r\n" + body);
+	// Both requests are sent before reading any response
+	auto requests (request + request);
+	boost::asio::ip::tcp::socket socket (system.io_ctx);
+	boost::beast::flat_buffer buffer;
+	std::array<boost::beast::http::response<boost::beast::http::string_body>, 3> responses;
+	size_t read_count (0);
+	std::atomic<bool> done{ false };
+	std::function<void ()> read_next = [&] () {
+		boost::beast::http::async_read (socket, buffer, responses[read_count], [&] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			if (!ec && ++read_count < responses.size ())
+			{
+				read_next ();
+			}
+			else
+			{
+				done = true;
+			}
+		});
+	};
+	socket.async_connect (nano::tcp_endpoint (boost::asio::ip::address_v6::loopback (), rpc.config.port), [&] (boost::system::error_code const & ec) {
+		ASSERT_FALSE (ec);
+		boost::asio::async_write (socket, boost::asio::buffer (requests), [&] (boost::system::error_code const & ec, size_t bytes_transferred) {
+			ASSERT_FALSE (ec);
+			read_next ();
+		});
+	});
+	ASSERT_TIMELY (10s, done);
+	// The connection is closed after max_requests_per_connection
+	ASSERT_EQ (2, read_count);
+	for (auto i (0); i < 2; ++i)
+	{
+		ASSERT_EQ (boost::beast::http::status::ok, responses[i].result ());
+		boost::property_tree::ptree json;
+		std::stringstream ss (responses[i].body ());
+		boost::property_tree::read_json (ss, json);
+		ASSERT_EQ ("1", json.get<std::string> ("count"));
+	}
+	ASSERT_TRUE (responses[0].keep_alive ());
+	ASSERT_FALSE (responses[1].keep_alive ());
+	ASSERT_EQ (1, rpc.connection_stats.connections);
+	ASSERT_EQ (2, rpc.connection_stats.requests);
+	ASSERT_EQ (1, rpc.connection_stats.reused);
+}
+
+TEST (rpc, stats_rpc_connections)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "block_count");
+	wait_response (system, rpc, request);
+	// Served by the RPC server while it runs, counting the stats request itself
+	request.put ("action", "stats");
+	request.put ("type", "rpc");
+	auto response (wait_response (system, rpc, request));
+	ASSERT_EQ (2, response.get<uint64_t> ("connections"));
+	ASSERT_EQ (2, response.get<uint64_t> ("requests"));
+	ASSERT_EQ (0, response.get<uint64_t> ("reused"));
+	ASSERT_EQ (0, response.get<uint64_t> ("idle_timeouts"));
+}
+
+TEST (rpc, stats_missing_type)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "stats");
+	auto response (wait_response (system, rpc, request));
+	ASSERT_EQ (std::error_code (nano::error_rpc::invalid_missing_type).message (), response.get<std::string> ("error"));
+}
+
 // This tests that the inprocess RPC (i.e without using IPC) works correctly
 TEST (rpc, in_process)
 {
@@ -5628,6 +5981,46 @@ TEST (rpc, deprecated_account_format)
 	ASSERT_TRUE (deprecated_account_format2.is_initialized ());
 }
 
+/** Responses written without a property tree still flag deprecated account formats */
+TEST (rpc, deprecated_account_format_streamed)
+{
+	nano::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto [rpc, rpc_ctx] = add_rpc (system, node);
+	std::string account_text (nano::dev_genesis_key.pub.to_account ());
+	account_text[4] = '-';
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "ledger");
+		request.put ("account", account_text);
+		request.put ("count", "1");
+		auto response (wait_response (system, rpc, request));
+		ASSERT_EQ ("1", response.get<std::string> ("deprecated_account_format"));
+		ASSERT_EQ (nano::genesis_hash.to_string (), response.get<std::string> ("accounts." + nano::dev_genesis_key.pub.to_account () + ".frontier"));
+	}
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "accounts_balances");
+		boost::property_tree::ptree accounts;
+		boost::property_tree::ptree entry;
+		entry.put ("", account_text);
+		accounts.push_back (std::make_pair ("", entry));
+		request.add_child ("accounts", accounts);
+		auto response (wait_response (system, rpc, request));
+		ASSERT_EQ ("1", response.get<std::string> ("deprecated_account_format"));
+		ASSERT_EQ (nano::genesis_amount.convert_to<std::string> (), response.get<std::string> ("balances." + nano::dev_genesis_key.pub.to_account () + ".balance"));
+	}
+	{
+		boost::property_tree::ptree request;
+		request.put ("action", "account_history");
+		request.put ("account", account_text);
+		request.put ("count", "1");
+		auto response (wait_response (system, rpc, request));
+		ASSERT_EQ ("1", response.get<std::string> ("deprecated_account_format"));
+		ASSERT_EQ (1, response.get_child ("history").size ());
+	}
+}
+
 TEST (rpc, epoch_upgrade)
 {
 	nano::system system;
@@ -6263,3 +6656,82 @@ TEST (rpc, confirmation_info)
 		ASSERT_EQ (0, response.get<unsigned> ("total_tally"));
 	}
 }
+
+TEST (rpc, ipc_without_multiplexing)
+{
+	nano::system system;
+	boost::asio::io_context server_ctx;
+	boost::asio::ip::tcp::acceptor acceptor (server_ctx, boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), 0));
+	nano::rpc_config rpc_config;
+	rpc_config.rpc_process.ipc_port = acceptor.local_endpoint ().port ();
+	rpc_config.rpc_process.num_ipc_connections = 1;
+	// Longer than the negotiation timeout, so the request outlives the probe
+	rpc_config.rpc_process.io_timeout = 10s;
+	std::atomic<bool> probed{ false };
+	// Emulates a node predating multiplexing, it stops reading after an unknown encoding
+	std::thread node ([&] () {
+		boost::asio::ip::tcp::socket stuck (server_ctx);
+		acceptor.accept (stuck);
+		std::array<uint8_t, 64> ignored;
+		probed = stuck.read_some (boost::asio::buffer (ignored)) > 0 && ignored[nano::ipc::preamble_offset::encoding] == static_cast<uint8_t> (nano::ipc::payload_encoding::multiplexed);
+		boost::system::error_code ec;
+		while (!ec)
+		{
+			stuck.read_some (boost::asio::buffer (ignored), ec);
+		}
+		boost::asio::ip::tcp::socket socket (server_ctx);
+		acceptor.accept (socket);
+		uint32_t request_id (0);
+		auto request (read_ipc_request (socket, request_id));
+		write_ipc_response (socket, request.first == nano::ipc::payload_encoding::json_v1 ? R"({"encoding":"json_v1"})" : R"({"encoding":"other"})");
+	});
+	nano::ipc_rpc_processor processor (system.io_ctx, rpc_config);
+	std::string response;
+	processor.process_request ("block_count", R"({"action":"block_count"})", [&response] (std::string const & response_a) {
+		response = response_a;
+	});
+	ASSERT_TIMELY (15s, !response.empty ());
+	node.join ();
+	ASSERT_TRUE (probed);
+	// The request was answered without multiplexing, on a new connection
+	ASSERT_EQ (R"({"encoding":"json_v1"})", response);
+	processor.stop ();
+}
+
+TEST (rpc, ipc_request_deadline)
+{
+	nano::system system;
+	boost::asio::io_context server_ctx;
+	boost::asio::ip::tcp::acceptor acceptor (server_ctx, boost::asio::ip::tcp::endpoint (boost::asio::ip::address_v6::loopback (), 0));
+	nano::rpc_config rpc_config;
+	rpc_config.rpc_process.ipc_port = acceptor.local_endpoint ().port ();
+	rpc_config.rpc_process.num_ipc_connections = 1;
+	rpc_config.rpc_process.io_timeout = 1s;
+	std::atomic<bool> done{ false };
+	// Answers the multiplexing probe, then never responds
+	std::thread node ([&] () {
+		boost::asio::ip::tcp::socket socket (server_ctx);
+		acceptor.accept (socket);
+		uint32_t request_id (0);
+		read_ipc_request (socket, request_id);
+		write_ipc_response (socket, R"({"node_vendor":"fake"})", request_id);
+		read_ipc_request (socket, request_id);
+		while (!done)
+		{
+			std::this_thread::sleep_for (10ms);
+		}
+	});
+	nano::ipc_rpc_processor processor (system.io_ctx, rpc_config);
+	std::string response;
+	processor.process_request ("block_count", R"({"action":"block_count"})", [&response] (std::string const & response_a) {
+		response = response_a;
+	});
+	ASSERT_TIMELY (10s, !response.empty ());
+	done = true;
+	node.join ();
+	std::stringstream body (response);
+	boost::property_tree::ptree json;
+	boost::property_tree::read_json (body, json);
+	ASSERT_EQ ("Timed out waiting for the node to respond", json.get<std::string> ("error"));
+	processor.stop ();
+}
@@ -399,6 +399,21 @@ uint16_t nano::endpoint_key::port () const
 	return boost::endian::big_to_native (network_port);
 }
 
+nano::account_height_key::account_height_key (nano::account const & account_a, uint64_t height_a) :
+	account_m (account_a), network_height (boost::endian::native_to_big (height_a))
+{
+}
+
+nano::account const & nano::account_height_key::account () const
+{
+	return account_m;
+}
+
+uint64_t nano::account_height_key::height () const
+{
+	return boost::endian::big_to_native (network_height);
+}
+
 nano::confirmation_height_info::confirmation_height_info (uint64_t confirmation_height_a, nano::block_hash const & confirmed_frontier_a) :
 	height (confirmation_height_a),
 	frontier (confirmed_frontier_a)
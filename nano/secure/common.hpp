@@ -162,6 +162,32 @@ private:
 	uint16_t network_port{ 0 };
 };
 
+/**
+ * Key of the account height index, entries of an account are adjacent and ordered by height
+ */
+class account_height_key final
+{
+public:
+	account_height_key () = default;
+
+	/*
+	 * @param height_a This should be in host byte order
+	 */
+	account_height_key (nano::account const & account_a, uint64_t height_a);
+
+	nano::account const & account () const;
+
+	/*
+	 * @return The height in host byte order
+	 */
+	uint64_t height () const;
+
+private:
+	nano::account account_m{ 0 };
+	// Stored in network byte order so keys compare by height
+	uint64_t network_height{ 0 };
+};
+
 enum class no_value
 {
 	dummy
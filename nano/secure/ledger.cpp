@@ -736,6 +736,9 @@ ledger_processor::ledger_processor (nano::ledger & ledger_a, nano::write_transac
 }
 } // namespace
 
+// A cursor is an account and a block hash, all bits set is out of reach of both
+nano::uint512_union const nano::ledger::account_heights_complete_cursor{ std::numeric_limits<nano::uint512_t>::max () };
+
 nano::ledger::ledger (nano::store & store_a, nano::stat & stat_a, nano::generate_cache const & generate_cache_a) :
 	store (store_a),
 	stats (stat_a),
@@ -868,6 +871,10 @@ nano::process_return nano::ledger::process (nano::write_transaction const & tran
 	if (processor.result.code == nano::process_result::progress)
 	{
 		++cache.block_count;
+		if (account_heights)
+		{
+			store.account_height.put (transaction_a, store.block.account_calculated (block_a), block_a.sideband ().height, block_a.hash ());
+		}
 	}
 	return processor.result;
 }
@@ -1056,6 +1063,11 @@ bool nano::ledger::rollback (nano::write_transaction const & transaction_a, nano
 			if (!error)
 			{
 				--cache.block_count;
+				// Blocks processed before the index was enabled may not be indexed yet
+				if (account_heights && store.account_height.exists (transaction_a, account_l, block->sideband ().height))
+				{
+					store.account_height.del (transaction_a, account_l, block->sideband ().height);
+				}
 			}
 		}
 		else
@@ -1347,6 +1359,14 @@ uint64_t nano::ledger::pruning_action (nano::write_transaction & transaction_a,
 		auto block (store.block.get (transaction_a, hash));
 		if (block != nullptr)
 		{
+			if (account_heights)
+			{
+				auto const account_l (store.block.account_calculated (*block));
+				if (store.account_height.exists (transaction_a, account_l, block->sideband ().height))
+				{
+					store.account_height.del (transaction_a, account_l, block->sideband ().height);
+				}
+			}
 			store.block.del (transaction_a, hash);
 			store.pruned.put (transaction_a, hash);
 			hash = block->previous ();
@@ -1371,6 +1391,107 @@ uint64_t nano::ledger::pruning_action (nano::write_transaction & transaction_a,
 	return pruned_count;
 }
 
+boost::optional<nano::block_hash> nano::ledger::hash_at_offset (nano::transaction const & transaction_a, nano::account const & account_a, uint64_t height_a, uint64_t offset_a, bool descending_a) const
+{
+	boost::optional<nano::block_hash> result;
+	if (account_heights_complete)
+	{
+		uint64_t target (0);
+		if (descending_a)
+		{
+			target = offset_a < height_a ? height_a - offset_a : 0;
+		}
+		else
+		{
+			nano::account_info info;
+			if (!store.account.get (transaction_a, account_a, info) && offset_a <= info.block_count - height_a)
+			{
+				target = height_a + offset_a;
+			}
+		}
+		if (target != 0)
+		{
+			auto hash (store.account_height.get (transaction_a, account_a, target));
+			// Pruned blocks have no entry, walking the chain stops at them the same way
+			if (!hash.is_zero ())
+			{
+				result = hash;
+			}
+		}
+		else if (!pruning)
+		{
+			result = nano::block_hash (0);
+		}
+	}
+	return result;
+}
+
+bool nano::ledger::account_heights_build (nano::write_transaction const & transaction_a, size_t max_blocks_a)
+{
+	auto cursor (store.account_height.cursor (transaction_a));
+	debug_assert (cursor != account_heights_complete_cursor);
+	// The cursor is the account being indexed and the next block of its chain to index, zero to start from its head
+	nano::account const account_l (cursor.uint256s[0].number ());
+	nano::block_hash hash (cursor.uint256s[1].number ());
+	size_t blocks (0);
+	auto i (store.account.begin (transaction_a, account_l));
+	auto n (store.account.end ());
+	if (i != n && i->first != account_l)
+	{
+		hash.clear ();
+	}
+	for (; i != n && blocks < max_blocks_a; ++i)
+	{
+		if (hash.is_zero ())
+		{
+			hash = i->second.head;
+		}
+		while (!hash.is_zero () && blocks < max_blocks_a)
+		{
+			auto block (store.block.get (transaction_a, hash));
+			if (block != nullptr)
+			{
+				store.account_height.put (transaction_a, i->first, block->sideband ().height, hash);
+				hash = block->previous ();
+				++blocks;
+			}
+			else if (store.pruned.exists (transaction_a, hash))
+			{
+				// Everything below a pruned block is pruned too, drop entries left from before the index was marked incomplete
+				std::vector<uint64_t> stale;
+				for (auto j (store.account_height.begin (transaction_a, nano::account_height_key (i->first, 0))), m (store.account_height.end ()); j != m && j->first.account () == i->first; ++j)
+				{
+					if (!store.block.exists (transaction_a, j->second))
+					{
+						stale.push_back (j->first.height ());
+					}
+				}
+				for (auto height : stale)
+				{
+					store.account_height.del (transaction_a, i->first, height);
+				}
+				hash.clear ();
+			}
+			else
+			{
+				// Rolled back since the previous call, blocks processed since then were indexed by ledger::process
+				hash = i->second.head;
+			}
+		}
+		if (!hash.is_zero ())
+		{
+			break;
+		}
+	}
+	auto const complete (i == n);
+	store.account_height.cursor_put (transaction_a, complete ? account_heights_complete_cursor : nano::uint512_union (i->first, hash));
+	if (complete)
+	{
+		account_heights_complete = true;
+	}
+	return complete;
+}
+
 std::multimap<uint64_t, nano::uncemented_info, std::greater<>> nano::ledger::unconfirmed_frontiers () const
 {
 	nano::locked<std::multimap<uint64_t, nano::uncemented_info, std::greater<>>> result;
@@ -1490,6 +1611,8 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (boost::filesystem::path const & data
 			}
 		});
 
+		// The account height index is not copied, nodes enabling it build it again in the background
+
 		store.final_vote.for_each_par (
 		[&rocksdb_store] (nano::read_transaction const & /*unused*/, auto i, auto n) {
 			for (; i != n; ++i)
@@ -67,6 +67,10 @@ public:
 	nano::link const & epoch_link (nano::epoch) const;
 	std::multimap<uint64_t, uncemented_info, std::greater<>> unconfirmed_frontiers () const;
 	bool migrate_lmdb_to_rocksdb (boost::filesystem::path const &) const;
+	/** Hash \p offset_a blocks after the block at \p height_a in the chain of \p account_a, or before it if \p descending_a. Zero past either end of the chain, none if the account height index cannot answer */
+	boost::optional<nano::block_hash> hash_at_offset (nano::transaction const &, nano::account const &, uint64_t height_a, uint64_t offset_a, bool descending_a) const;
+	/** Indexes the chains of existing accounts from where the previous call stopped, writing about \p max_blocks_a entries. Returns true once every account is indexed */
+	bool account_heights_build (nano::write_transaction const &, size_t max_blocks_a);
 	static nano::uint128_t const unit;
 	nano::network_params network_params;
 	nano::store & store;
@@ -77,6 +81,12 @@ public:
 	uint64_t bootstrap_weight_max_blocks{ 1 };
 	std::atomic<bool> check_bootstrap_weights;
 	bool pruning{ false };
+	/** Maintain the account height index when processing, rolling back and pruning blocks */
+	bool account_heights{ false };
+	/** The account height index covers every account and can be read */
+	std::atomic<bool> account_heights_complete{ false };
+	/** Build cursor of a complete account height index */
+	static nano::uint512_union const account_heights_complete_cursor;
 
 private:
 	void initialize (nano::generate_cache const &);
@@ -117,6 +117,7 @@ nano::store::store (
 	nano::peer_store & peer_store_a,
 	nano::confirmation_height_store & confirmation_height_store_a,
 	nano::final_vote_store & final_vote_store_a,
+	nano::account_height_store & account_height_store_a,
 	nano::version_store & version_store_a
 ) :
 	block (block_store_a),
@@ -129,6 +130,7 @@ nano::store::store (
 	peer (peer_store_a),
 	confirmation_height (confirmation_height_store_a),
 	final_vote (final_vote_store_a),
+	account_height (account_height_store_a),
 	version (version_store_a)
 {
 }
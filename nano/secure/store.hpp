@@ -135,6 +135,12 @@ public:
 		static_assert (std::is_standard_layout<nano::block_info>::value, "Standard layout is required");
 	}
 
+	db_val (nano::account_height_key const & val_a) :
+		db_val (sizeof (val_a), const_cast<nano::account_height_key *> (&val_a))
+	{
+		static_assert (std::is_standard_layout<nano::account_height_key>::value, "Standard layout is required");
+	}
+
 	db_val (nano::endpoint_key const & val_a) :
 		db_val (sizeof (val_a), const_cast<nano::endpoint_key *> (&val_a))
 	{
@@ -286,6 +292,14 @@ public:
 		return result;
 	}
 
+	explicit operator nano::account_height_key () const
+	{
+		nano::account_height_key result;
+		debug_assert (size () == sizeof (result));
+		std::copy (reinterpret_cast<uint8_t const *> (data ()), reinterpret_cast<uint8_t const *> (data ()) + sizeof (result), reinterpret_cast<uint8_t *> (&result));
+		return result;
+	}
+
 	explicit operator nano::endpoint_key () const
 	{
 		nano::endpoint_key result;
@@ -539,6 +553,7 @@ private:
 // Keep this in alphabetical order
 enum class tables
 {
+	account_heights,
 	accounts,
 	blocks,
 	confirmation_height,
@@ -643,6 +658,8 @@ class account_store
 public:
 	virtual void put (nano::write_transaction const &, nano::account const &, nano::account_info const &) = 0;
 	virtual bool get (nano::transaction const &, nano::account const &, nano::account_info &) = 0;
+	/** Looks up accounts in ascending order in one pass, results are in the order of the argument and empty for accounts which are not found */
+	virtual std::vector<boost::optional<nano::account_info>> get_many (nano::transaction const &, std::vector<nano::account> const &) const = 0;
 	virtual void del (nano::write_transaction const &, nano::account const &) = 0;
 	virtual bool exists (nano::transaction const &, nano::account const &) = 0;
 	virtual size_t count (nano::transaction const &) = 0;
@@ -774,6 +791,28 @@ public:
 	virtual void for_each_par (std::function<void (nano::read_transaction const &, nano::store_iterator<nano::qualified_root, nano::block_hash>, nano::store_iterator<nano::qualified_root, nano::block_hash>)> const & action_a) const = 0;
 };
 
+/**
+ * Manages the (account, height) -> block hash index
+ */
+class account_height_store
+{
+public:
+	virtual void put (nano::write_transaction const &, nano::account const &, uint64_t, nano::block_hash const &) = 0;
+	/** Returns zero if there is no entry */
+	virtual nano::block_hash get (nano::transaction const &, nano::account const &, uint64_t) const = 0;
+	virtual void del (nano::write_transaction const &, nano::account const &, uint64_t) = 0;
+	virtual bool exists (nano::transaction const &, nano::account const &, uint64_t) const = 0;
+	virtual size_t count (nano::transaction const &) const = 0;
+	/** Removes every entry and the build cursor */
+	virtual void clear (nano::write_transaction const &) = 0;
+	/** Progress of nano::ledger::account_heights_build, zero if the index was never built or has been marked incomplete */
+	virtual nano::uint512_union cursor (nano::transaction const &) const = 0;
+	virtual void cursor_put (nano::write_transaction const &, nano::uint512_union const &) = 0;
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> begin (nano::transaction const &, nano::account_height_key const &) const = 0;
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> begin (nano::transaction const &) const = 0;
+	virtual nano::store_iterator<nano::account_height_key, nano::block_hash> end () const = 0;
+};
+
 /**
  * Manages version storage
  */
@@ -795,6 +834,8 @@ public:
 	virtual nano::block_hash successor (nano::transaction const &, nano::block_hash const &) const = 0;
 	virtual void successor_clear (nano::write_transaction const &, nano::block_hash const &) = 0;
 	virtual std::shared_ptr<nano::block> get (nano::transaction const &, nano::block_hash const &) const = 0;
+	/** Looks up hashes in ascending order in one pass, results are in the order of the argument and nullptr for blocks which are not found */
+	virtual std::vector<std::shared_ptr<nano::block>> get_many (nano::transaction const &, std::vector<nano::block_hash> const &) const = 0;
 	virtual std::shared_ptr<nano::block> get_no_sideband (nano::transaction const &, nano::block_hash const &) const = 0;
 	virtual std::shared_ptr<nano::block> random (nano::transaction const &) = 0;
 	virtual void del (nano::write_transaction const &, nano::block_hash const &) = 0;
@@ -830,6 +871,7 @@ public:
 		nano::peer_store &,
 		nano::confirmation_height_store &,
 		nano::final_vote_store &,
+		nano::account_height_store &,
 		nano::version_store &
 	);
 	// clang-format on
@@ -847,6 +889,7 @@ public:
 	peer_store & peer;
 	confirmation_height_store & confirmation_height;
 	final_vote_store & final_vote;
+	account_height_store & account_height;
 	version_store & version;
 
 	virtual unsigned max_block_write_batch_num () const = 0;
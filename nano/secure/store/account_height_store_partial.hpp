@@ -0,0 +1,109 @@
+#pragma once
+
+#include <nano/secure/store_partial.hpp>
+
+namespace nano
+{
+template <typename Val, typename Derived_Store>
+class store_partial;
+
+template <typename Val, typename Derived_Store>
+void release_assert_success (store_partial<Val, Derived_Store> const & store, const int status);
+
+template <typename Val, typename Derived_Store>
+class account_height_store_partial : public account_height_store
+{
+private:
+	nano::store_partial<Val, Derived_Store> & store;
+
+	/** The build cursor lives in the meta table next to the version, which uses key 1 */
+	nano::uint256_union const cursor_key{ 2 };
+
+	friend void release_assert_success<Val, Derived_Store> (store_partial<Val, Derived_Store> const &, const int);
+
+public:
+	explicit account_height_store_partial (nano::store_partial<Val, Derived_Store> & store_a) :
+		store (store_a){};
+
+	void put (nano::write_transaction const & transaction_a, nano::account const & account_a, uint64_t height_a, nano::block_hash const & hash_a) override
+	{
+		auto status (store.put (transaction_a, tables::account_heights, nano::account_height_key (account_a, height_a), hash_a));
+		release_assert_success (store, status);
+	}
+
+	nano::block_hash get (nano::transaction const & transaction_a, nano::account const & account_a, uint64_t height_a) const override
+	{
+		nano::db_val<Val> value;
+		auto status (store.get (transaction_a, tables::account_heights, nano::db_val<Val> (nano::account_height_key (account_a, height_a)), value));
+		release_assert (store.success (status) || store.not_found (status));
+		nano::block_hash result (0);
+		if (store.success (status))
+		{
+			result = static_cast<nano::block_hash> (value);
+		}
+		return result;
+	}
+
+	void del (nano::write_transaction const & transaction_a, nano::account const & account_a, uint64_t height_a) override
+	{
+		auto status (store.del (transaction_a, tables::account_heights, nano::account_height_key (account_a, height_a)));
+		release_assert_success (store, status);
+	}
+
+	bool exists (nano::transaction const & transaction_a, nano::account const & account_a, uint64_t height_a) const override
+	{
+		return store.exists (transaction_a, tables::account_heights, nano::db_val<Val> (nano::account_height_key (account_a, height_a)));
+	}
+
+	size_t count (nano::transaction const & transaction_a) const override
+	{
+		return store.count (transaction_a, tables::account_heights);
+	}
+
+	void clear (nano::write_transaction const & transaction_a) override
+	{
+		auto status (store.drop (transaction_a, tables::account_heights));
+		release_assert_success (store, status);
+		if (store.exists (transaction_a, tables::meta, nano::db_val<Val> (cursor_key)))
+		{
+			status = store.del (transaction_a, tables::meta, nano::db_val<Val> (cursor_key));
+			release_assert_success (store, status);
+		}
+	}
+
+	nano::uint512_union cursor (nano::transaction const & transaction_a) const override
+	{
+		nano::db_val<Val> value;
+		auto status (store.get (transaction_a, tables::meta, nano::db_val<Val> (cursor_key), value));
+		release_assert (store.success (status) || store.not_found (status));
+		nano::uint512_union result (0);
+		if (store.success (status))
+		{
+			result = static_cast<nano::uint512_union> (value);
+		}
+		return result;
+	}
+
+	void cursor_put (nano::write_transaction const & transaction_a, nano::uint512_union const & cursor_a) override
+	{
+		auto status (store.put (transaction_a, tables::meta, nano::db_val<Val> (cursor_key), nano::db_val<Val> (cursor_a)));
+		release_assert_success (store, status);
+	}
+
+	nano::store_iterator<nano::account_height_key, nano::block_hash> begin (nano::transaction const & transaction_a, nano::account_height_key const & key_a) const override
+	{
+		return store.template make_iterator<nano::account_height_key, nano::block_hash> (transaction_a, tables::account_heights, nano::db_val<Val> (key_a));
+	}
+
+	nano::store_iterator<nano::account_height_key, nano::block_hash> begin (nano::transaction const & transaction_a) const override
+	{
+		return store.template make_iterator<nano::account_height_key, nano::block_hash> (transaction_a, tables::account_heights);
+	}
+
+	nano::store_iterator<nano::account_height_key, nano::block_hash> end () const override
+	{
+		return nano::store_iterator<nano::account_height_key, nano::block_hash> (nullptr);
+	}
+};
+
+}
@@ -51,6 +51,19 @@ public:
 		return result;
 	}
 
+	std::vector<boost::optional<nano::account_info>> get_many (nano::transaction const & transaction_a, std::vector<nano::account> const & accounts_a) const override
+	{
+		std::vector<boost::optional<nano::account_info>> result (accounts_a.size ());
+		store.get_many (transaction_a, tables::accounts, accounts_a, [&result] (size_t index_a, nano::db_val<Val> const & value_a) {
+			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value_a.data ()), value_a.size ());
+			nano::account_info info;
+			auto error (info.deserialize (stream));
+			release_assert (!error);
+			result[index_a] = info;
+		});
+		return result;
+	}
+
 	void del (nano::write_transaction const & transaction_a, nano::account const & account_a) override
 	{
 		auto status = store.del (transaction_a, tables::accounts, account_a);
@@ -103,6 +103,25 @@ public:
 		return result;
 	}
 
+	std::vector<std::shared_ptr<nano::block>> get_many (nano::transaction const & transaction_a, std::vector<nano::block_hash> const & hashes_a) const override
+	{
+		std::vector<std::shared_ptr<nano::block>> result (hashes_a.size ());
+		store.get_many (transaction_a, tables::blocks, hashes_a, [&result] (size_t index_a, nano::db_val<Val> const & value_a) {
+			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value_a.data ()), value_a.size ());
+			nano::block_type type;
+			auto error (try_read (stream, type));
+			release_assert (!error);
+			auto block (nano::deserialize_block (stream, type));
+			release_assert (block != nullptr);
+			nano::block_sideband sideband;
+			error = sideband.deserialize (stream, type);
+			release_assert (!error);
+			block->sideband_set (sideband);
+			result[index_a] = block;
+		});
+		return result;
+	}
+
 	std::shared_ptr<nano::block> get_no_sideband (nano::transaction const & transaction_a, nano::block_hash const & hash_a) const override
 	{
 		auto value (block_raw_get (transaction_a, hash_a));
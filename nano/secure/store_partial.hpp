@@ -6,6 +6,7 @@
 #include <nano/lib/timer.hpp>
 #include <nano/secure/buffer.hpp>
 #include <nano/secure/store.hpp>
+#include <nano/secure/store/account_height_store_partial.hpp>
 #include <nano/secure/store/account_store_partial.hpp>
 #include <nano/secure/store/block_store_partial.hpp>
 #include <nano/secure/store/confirmation_height_store_partial.hpp>
@@ -20,6 +21,8 @@
 
 #include <crypto/cryptopp/words.h>
 
+#include <algorithm>
+#include <numeric>
 #include <thread>
 
 class store_partial;
@@ -52,6 +55,9 @@ class unchecked_store_partial;
 template <typename Val, typename Derived_Store>
 class block_store_partial;
 
+template <typename Val, typename Derived_Store>
+class account_height_store_partial;
+
 /** This base class implements the store interface functions which have DB agnostic functionality. It also maps all the store classes. */
 template <typename Val, typename Derived_Store>
 class store_partial : public store
@@ -67,6 +73,7 @@ class store_partial : public store
 	friend class nano::peer_store_partial<Val, Derived_Store>;
 	friend class nano::confirmation_height_store_partial<Val, Derived_Store>;
 	friend class nano::final_vote_store_partial<Val, Derived_Store>;
+	friend class nano::account_height_store_partial<Val, Derived_Store>;
 	friend class nano::version_store_partial<Val, Derived_Store>;
 
 public:
@@ -82,6 +89,7 @@ public:
 		nano::peer_store_partial<Val, Derived_Store> & peer_store_partial_a,
 		nano::confirmation_height_store_partial<Val, Derived_Store> & confirmation_height_store_partial_a,
 		nano::final_vote_store_partial<Val, Derived_Store> & final_vote_store_partial_a,
+		nano::account_height_store_partial<Val, Derived_Store> & account_height_store_partial_a,
 		nano::version_store_partial<Val, Derived_Store> & version_store_partial_a) :
 		store{
 			block_store_partial_a,
@@ -94,6 +102,7 @@ public:
 			peer_store_partial_a,
 			confirmation_height_store_partial_a,
 			final_vote_store_partial_a,
+			account_height_store_partial_a,
 			version_store_partial_a
 		}
 	{}
@@ -133,7 +142,7 @@ public:
 
 protected:
 	nano::network_params network_params;
-	int const version_number{ 21 };
+	int const version_number{ 22 };
 
 	template <typename Key, typename Value>
 	nano::store_iterator<Key, Value> make_iterator (nano::transaction const & transaction_a, tables table_a, bool const direction_asc = true) const
@@ -162,6 +171,36 @@ protected:
 		return static_cast<Derived_Store const &> (*this).get (transaction_a, table_a, key_a, value_a);
 	}
 
+	/**
+	 * Looks up keys_a in ascending key order with a single cursor or batch read, calling action_a with the index into keys_a and the value of each key found.
+	 * Consecutive sorted lookups mostly land on pages the previous lookup already visited.
+	 */
+	template <typename Key>
+	void get_many (nano::transaction const & transaction_a, tables table_a, std::vector<Key> const & keys_a, std::function<void (size_t, nano::db_val<Val> const &)> const & action_a) const
+	{
+		std::vector<size_t> order (keys_a.size ());
+		std::iota (order.begin (), order.end (), 0);
+		std::sort (order.begin (), order.end (), [&keys_a] (size_t const lhs, size_t const rhs) {
+			return keys_a[lhs] < keys_a[rhs];
+		});
+		std::vector<nano::db_val<Val>> keys;
+		keys.reserve (keys_a.size ());
+		for (auto index : order)
+		{
+			keys.emplace_back (keys_a[index]);
+		}
+		std::vector<nano::db_val<Val>> values;
+		auto statuses (static_cast<Derived_Store const &> (*this).multi_get (transaction_a, table_a, keys, values));
+		for (size_t i (0), n (statuses.size ()); i < n; ++i)
+		{
+			release_assert (success (statuses[i]) || not_found (statuses[i]));
+			if (success (statuses[i]))
+			{
+				action_a (order[i], values[i]);
+			}
+		}
+	}
+
 	int put (nano::write_transaction const & transaction_a, tables table_a, nano::db_val<Val> const & key_a, nano::db_val<Val> const & value_a)
 	{
 		return static_cast<Derived_Store &> (*this).put (transaction_a, table_a, key_a, value_a);